@@ -6,6 +6,7 @@
 #define INCLUDED_OCIO_OPENCOLORIO_H
 
 #include <cstddef>
+#include <future>
 #include <iosfwd>
 #include <limits>
 #include <stdexcept>
@@ -114,6 +115,28 @@ public:
  */
 extern OCIOEXPORT void ClearAllCaches();
 
+/**
+ * \brief Control the cache of the LUT files read by the FileTransform instances.
+ *
+ * The cache is bounded by a memory budget in bytes where the size of a cached file is
+ * estimated using the size of the file on disk. The budget applies to the whole cache:
+ * when over budget, the least recently used files are evicted until the cache fits again
+ * (the file being added is never evicted, even if larger than the budget). A zero budget
+ * (the default) means no limit. \ref ClearAllCaches empties the cache and resets its
+ * statistics.
+ */
+extern OCIOEXPORT void SetFileTransformCacheMaxSize(size_t maxNumBytes);
+extern OCIOEXPORT size_t GetFileTransformCacheMaxSize();
+/// Estimated size in bytes of the cached files.
+extern OCIOEXPORT size_t GetFileTransformCacheSize();
+extern OCIOEXPORT size_t GetFileTransformCacheNumEntries();
+/// Number of file reads served from the cache since the last clear.
+extern OCIOEXPORT size_t GetFileTransformCacheNumHits();
+/// Number of file reads which had to load the file since the last clear.
+extern OCIOEXPORT size_t GetFileTransformCacheNumMisses();
+/// Number of files evicted to stay within the budget since the last clear.
+extern OCIOEXPORT size_t GetFileTransformCacheNumEvictions();
+
 /**
  * \brief Get the version number for the library, as a dot-delimited string 
  *     (e.g., "1.0.0").
@@ -816,6 +839,18 @@ public:
      */
     bool filepathOnlyMatchesDefaultRule(const char * filePath) const;
 
+    /**
+     * \brief Get the color spaces of a list of file paths.
+     *
+     * This is equivalent to calling getColorSpaceFromFilepath on each file path but the
+     * file rules are only prepared once for the whole list. The colorSpaces array must hold
+     * numFilePaths entries, as well as the ruleIndices array unless it is null.
+     */
+    void getColorSpacesFromFilepaths(const char * const * filePaths,
+                                     size_t numFilePaths,
+                                     const char ** colorSpaces,
+                                     size_t * ruleIndices) const;
+
     //
     // Processors
     //
@@ -868,6 +903,62 @@ public:
                                      const ConstTransformRcPtr & transform,
                                      TransformDirection direction) const;
 
+    /**
+     * \brief Control the cache of the processors built by the getProcessor() methods.
+     *
+     * The cache is enabled by default. A processor is cached using the config and context
+     * cache IDs and the requested transform and direction, so any edit of the config or of
+     * the context leads to a new processor. Processors having dynamic properties and
+     * processors for Lut1DTransform or Lut3DTransform instances are never cached.
+     * Disabling the cache also empties it, and \ref ClearAllCaches invalidates it.
+     */
+    void setProcessorCacheEnabled(bool enabled);
+    bool isProcessorCacheEnabled() const;
+    /// Set the maximum number of cached processors; the least recently used ones are evicted.
+    void setProcessorCacheSize(size_t maxNumProcessors);
+    size_t getProcessorCacheSize() const;
+    /// Empty the processor cache and reset its hit and miss counters.
+    void clearProcessorCache() const;
+    /// Number of getProcessor() calls served from the cache since the last clear.
+    size_t getProcessorCacheNumHits() const;
+    /// Number of getProcessor() calls which had to build a processor since the last clear.
+    size_t getProcessorCacheNumMisses() const;
+
+    /**
+     * \brief Set a directory where the processors are also cached on disk.
+     *
+     * When set, a processor missing from the in-memory cache is looked up in the directory
+     * before being built, and a newly built processor is written there using
+     * \ref Processor::serialize. The files are keyed by the config and context cache IDs
+     * (which include the file references) and the request so that several processes, e.g.
+     * farm tasks, sharing the directory only build each processor once. Files which cannot
+     * be read or written are ignored. An empty string (the default) disables the disk cache.
+     */
+    void setProcessorCacheDirectory(const char * dirname);
+    const char * getProcessorCacheDirectory() const;
+
+    /**
+     * \brief Load in the background the LUT files used by the config.
+     *
+     * The files referenced by the FileTransform instances of the color spaces, looks and
+     * view transforms are resolved using the context (or the current context if null) and
+     * loaded in parallel into the FileTransform cache, so that building the processors later
+     * does not wait for the file reads. The returned future becomes ready once all the files
+     * are loaded. The files which could not be resolved or read are skipped, the errors are
+     * reported when building the processors.
+     *
+     * The method only collects the file references of the config, the file paths are
+     * resolved (i.e. the search paths are scanned) and the files are loaded by the
+     * background threads.
+     *
+     * \note
+     *    The call is only non-blocking if the caller keeps the returned future alive
+     *    (e.g. until the processors are built) as, like for std::async, destroying the
+     *    future waits for the loads to complete. Ignoring the returned value therefore
+     *    makes the call synchronous.
+     */
+    std::future<void> prefetchFiles(const ConstContextRcPtr & context) const;
+
     /**
      * \brief Get a processor to convert between color spaces in two separate
      *      configs.
@@ -1792,6 +1883,22 @@ public:
     static const char * getFormatNameByIndex(int index);
     static const char * getFormatExtensionByIndex(int index);
 
+    /**
+     * \brief Write the processor in a compact binary form.
+     *
+     * The finalized ops (i.e. their parameters and LUT arrays), the format metadata and the
+     * processor metadata are written so that \ref Processor::CreateFromStream can rebuild
+     * the processor without parsing any config or LUT file. The data is only meant to be read
+     * back by the same library version on a machine with the same byte order.
+     */
+    void serialize(std::ostream & os) const;
+
+    /**
+     * Create a processor from the data written by \ref Processor::serialize. An exception
+     * is thrown if the data is corrupted or was written by another library version.
+     */
+    static ConstProcessorRcPtr CreateFromStream(std::istream & is);
+
     // TODO: Revisit the dynamic property access.
     // Access to dynamic properties.
     
@@ -1871,6 +1978,17 @@ public:
                                                     BitDepth outBitDepth,
                                                     OptimizationFlags oFlags) const;
 
+    /**
+     * \brief Get a CPU processor whose apply methods accumulate op timings (refer to
+     * CPUProcessor::isOpTimingEnabled()).
+     *
+     * Unlike the methods above, each call creates a new instance which is never cached, so
+     * the timings only account for the apply calls of the caller.
+     */
+    ConstCPUProcessorRcPtr getTimedCPUProcessor(BitDepth inBitDepth,
+                                                BitDepth outBitDepth,
+                                                OptimizationFlags oFlags) const;
+
     ~Processor();
 
 private:
@@ -1926,6 +2044,98 @@ public:
     void apply(ImageDesc & imgDesc) const;
     void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
 
+    /**
+     * \brief Apply to an image using several threads.
+     *
+     * The image is split into bands of scanlines processed concurrently, each thread
+     * using its own intermediate buffers. The result is identical to the one of
+     * \ref CPUProcessor::apply. A numThreads of 0 means one thread per hardware thread.
+     *
+     * \note
+     *    The calling thread is one of the worker threads and the method only returns
+     *    once the whole image is processed.
+     */
+    void applyParallel(ImageDesc & imgDesc, unsigned numThreads = 0) const;
+    void applyParallel(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                       unsigned numThreads = 0) const;
+
+    /**
+     * \brief Pre-allocate the intermediate buffers used by the apply methods.
+     *
+     * The processor keeps the intermediate scanline buffers from one apply call to the
+     * next. This method allocates them upfront for images up to width pixels wide
+     * processed by numThreads concurrent threads (0 means one per hardware thread), so
+     * that even the first calls do not allocate memory.
+     */
+    void reserveScanlineBuffers(long width, unsigned numThreads = 1) const;
+
+    /**
+     * \brief Number of pixels of a scanline processed by the whole list of ops before
+     * moving to the next pixels.
+     *
+     * Processing blocks small enough to stay in the CPU caches avoids streaming the
+     * complete scanline through the memory once per op. A block size of 0 processes
+     * the complete scanline by each op. The default is 512 pixels.
+     *
+     * \note
+     *    The block size does not change the results so it could be changed at any time,
+     *    even on a processor shared by several threads.
+     */
+    long getBlockSize() const;
+    void setBlockSize(long numPixels) const;
+
+    /**
+     * \brief Instrumentation of the apply methods to find the expensive ops of the processor.
+     *
+     * When enabled, the apply and applyParallel methods accumulate for each stage of the
+     * CPU processing the number of calls, the number of processed pixels and the elapsed
+     * time. The first stage converts the input pixels to the packed RGBA 32-bit float
+     * intermediate buffer (possibly also processing the first op), the last stage converts
+     * them back to the output pixels (possibly also processing the last op) and the stages
+     * in between are the remaining ops.
+     *
+     * The timing is only enabled for the CPU processors created by
+     * Processor::getTimedCPUProcessor(). The other ones are shared by all the callers of
+     * a processor so their timing is always disabled, and their timings stay at zero.
+     *
+     * \note
+     *    The single pixel methods are not instrumented. With several threads the times
+     *    of all the threads add up, and the timing adds one clock read per op and per
+     *    block of pixels.
+     */
+    bool isOpTimingEnabled() const;
+    /// Reset all the accumulated timings to zero.
+    void resetOpTimings() const;
+
+    /// Number of timed stages, including the input and output conversions.
+    int getNumOpTimings() const;
+    /// Description of the stage i.e. the info of its op and the bit-depth for the conversions.
+    const char * getOpTimingName(int index) const;
+    unsigned long long getOpTimingNumCalls(int index) const;
+    unsigned long long getOpTimingNumPixels(int index) const;
+    unsigned long long getOpTimingNanoseconds(int index) const;
+
+    /// Write the processed ops with their accumulated timings, one stage per line.
+    void serializeOpTimings(std::ostream & os) const;
+
+    /**
+     * \brief Accuracy of the half-domain 1D LUT built by the
+     * OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32 optimization.
+     *
+     * Return false if the optimization was not requested or found no costly separable ops
+     * to replace. Otherwise, return the maximum error between the LUT and the ops (absolute
+     * below 1 and relative above), the input value where it happens, and whether the LUT
+     * replaced the ops (i.e. the error is within the tolerance).
+     *
+     * \note
+     *    The error is only measured for the finite normal half float inputs. The inputs
+     *    outside of that range (i.e. very small, very large or non-finite values) are
+     *    processed by the LUT without any check.
+     */
+    bool getSeparablePrefixF32Accuracy(float & maxError,
+                                       float & maxErrorInput,
+                                       bool & replaced) const;
+
     /**
      * Apply to a single pixel respecting that the input and output bit-depths
      * be 32-bit float and the image buffer be packed RGB/RGBA.
@@ -2138,6 +2348,15 @@ public:
      */
     void setCubeSize(int cubesize);
 
+    unsigned getNumThreads() const;
+    /**
+     * Set the number of threads used to build the processors, to evaluate the LUT samples
+     * and to format the output values. A numThreads of 0 means one thread per hardware
+     * thread.
+     * default: 1
+     */
+    void setNumThreads(unsigned numThreads);
+
     /// Bake the LUT into the output stream.
     void bake(std::ostream & os) const;
 
@@ -2172,6 +2391,95 @@ private:
 };
 
 
+/**
+ * Bake a list of LUTs from the same config. The jobs share their work: the processors
+ * are created once per distinct transform, the identity lattices are only generated once
+ * per size, and the LUTs sharing a shaper (i.e. the CSP format) only evaluate it once.
+ * The jobs are baked in parallel.
+ *
+ * \note
+ *    Apart from the shaper, each LUT is evaluated with a single processor from its input
+ *    space to its target space. For instance, the jobs baking several displays from the
+ *    same camera space do not share the camera to reference conversion.
+ *
+ * **Usage Example:** *Bake a CSP and a cube viewer LUT for two displays*
+ *
+ * \code{.cpp}
+ *
+ *    OCIO::ConstConfigRcPtr config = OCIO::Config::CreateFromEnv();
+ *    OCIO::BatchBakerRcPtr batch = OCIO::BatchBaker::Create();
+ *    batch->setConfig(config);
+ *    std::ofstream srgbCsp("srgb.csp"), srgbCube("srgb.cube"), p3Cube("p3.cube");
+ *    batch->addJob("cinespace", "lnf", "log", "", "sRGB", -1, 33, srgbCsp);
+ *    batch->addJob("iridas_cube", "lnf", "", "", "sRGB", -1, 33, srgbCube);
+ *    batch->addJob("iridas_cube", "lnf", "", "", "P3", -1, 33, p3Cube);
+ *    batch->bake();
+ *
+ * \endcode
+ */
+class OCIOEXPORT BatchBaker
+{
+public:
+    /// Create a new BatchBaker.
+    static BatchBakerRcPtr Create();
+
+    ConstConfigRcPtr getConfig() const;
+    /// Set the config used by all the jobs.
+    void setConfig(const ConstConfigRcPtr & config);
+
+    const FormatMetadata & getFormatMetadata() const;
+    /// Get the editable *optional* format metadata of all the jobs (refer to Baker).
+    FormatMetadata & getFormatMetadata();
+
+    /**
+     * Add a LUT to bake into the output stream. The arguments match the Baker ones where
+     * an empty shaperSpace or looks means none and a size of -1 means the format default.
+     * The output stream must stay valid until the bake.
+     */
+    void addJob(const char * formatName,
+                const char * inputSpace,
+                const char * shaperSpace,
+                const char * looks,
+                const char * targetSpace,
+                int shaperSize,
+                int cubeSize,
+                std::ostream & os);
+
+    int getNumJobs() const;
+    /// Remove all the jobs.
+    void clearJobs();
+
+    unsigned getNumThreads() const;
+    /**
+     * Set the number of threads used to bake the jobs. A numThreads of 0 means one thread
+     * per hardware thread.
+     * default: 0
+     */
+    void setNumThreads(unsigned numThreads);
+
+    /**
+     * Bake all the jobs. If some jobs fail, the other ones are still baked and the error of
+     * the first failing job is thrown.
+     */
+    void bake() const;
+
+    ~BatchBaker();
+
+private:
+    BatchBaker();
+
+    BatchBaker(const BatchBaker &);
+    BatchBaker& operator= (const BatchBaker &);
+
+    static void deleter(BatchBaker* o);
+
+    class Impl;
+    Impl * m_impl;
+    Impl * getImpl() { return m_impl; }
+    const Impl * getImpl() const { return m_impl; }
+};
+
+
 ///////////////////////////////////////////////////////////////////////////
 // ImageDesc
 
@@ -79,6 +79,10 @@ class OCIOEXPORT Baker;
 typedef OCIO_SHARED_PTR<const Baker> ConstBakerRcPtr;
 typedef OCIO_SHARED_PTR<Baker> BakerRcPtr;
 
+class OCIOEXPORT BatchBaker;
+typedef OCIO_SHARED_PTR<const BatchBaker> ConstBatchBakerRcPtr;
+typedef OCIO_SHARED_PTR<BatchBaker> BatchBakerRcPtr;
+
 class OCIOEXPORT ImageDesc;
 typedef OCIO_SHARED_PTR<ImageDesc> ImageDescRcPtr;
 typedef OCIO_SHARED_PTR<const ImageDesc> ConstImageDescRcPtr;
@@ -471,6 +475,20 @@ enum OptimizationFlags : unsigned long
      */
     OPTIMIZATION_NO_DYNAMIC_PROPERTIES           = 0x00020000,
 
+    /**
+     * For the F32 bit-depth, replace a prefix of separable ops that includes some
+     * costly functions (i.e. log, gamma, exponent or CDL) by a single half-domain
+     * 1D LUT which is interpolated. The replacement is only done if the LUT matches
+     * the original ops within a small tolerance for the finite normal half inputs.
+     * The inputs outside of that range (e.g. above 65504, subnormals, inf or NaN)
+     * are not checked so the flag must be explicitly requested i.e. it is ignored
+     * when the highest (unused) bit is also set. Hence the flag is not part of any
+     * optimization level, and OPTIMIZATION_ALL, OPTIMIZATION_DRAFT or any value derived
+     * from them (e.g. "0xFFFFFFFF" in OCIO_OPTIMIZATION_FLAGS) do not enable it.
+     * Refer to CPUProcessor::getSeparablePrefixF32Accuracy().
+     */
+    OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32       = 0x00040000,
+
     /// Apply all possible optimizations.
     OPTIMIZATION_ALL                             = 0xFFFFFFFF,
 
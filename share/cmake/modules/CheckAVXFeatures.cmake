@@ -0,0 +1,68 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright Contributors to the OpenColorIO Project.
+
+# Check whether the compiler can build the AVX2 and AVX-512 kernels, and the F16C half
+# float conversions. These are selected at runtime so only their translation units are
+# compiled with these flags.
+#
+# Sets HAVE_AVX2 / HAVE_AVX512 / HAVE_F16C and OCIO_AVX2_COMPILE_FLAGS /
+# OCIO_AVX512_COMPILE_FLAGS / OCIO_F16C_COMPILE_FLAGS.
+
+include(CheckCXXSourceCompiles)
+
+if (MSVC)
+    set(OCIO_AVX2_COMPILE_FLAGS "/arch:AVX2")
+    set(OCIO_AVX512_COMPILE_FLAGS "/arch:AVX512")
+    set(OCIO_F16C_COMPILE_FLAGS "/arch:AVX")
+else ()
+    # Contractions are disabled so that the results stay identical to the SSE2 ones.
+    set(OCIO_AVX2_COMPILE_FLAGS "-mavx2 -ffp-contract=off")
+    set(OCIO_AVX512_COMPILE_FLAGS "-mavx512f -ffp-contract=off")
+    set(OCIO_F16C_COMPILE_FLAGS "-mavx -mf16c")
+endif ()
+
+set(_OCIO_SAVED_REQUIRED_FLAGS "${CMAKE_REQUIRED_FLAGS}")
+
+set(CMAKE_REQUIRED_FLAGS "${OCIO_AVX2_COMPILE_FLAGS}")
+check_cxx_source_compiles ("
+    #include <immintrin.h>
+    int main ()
+    {
+        float vals[8] = {0};
+        __m256 a = _mm256_loadu_ps(vals);
+        __m256i b = _mm256_srli_epi32(_mm256_castps_si256(a), 23);
+        a = _mm256_add_ps(a, _mm256_castsi256_ps(b));
+        _mm256_storeu_ps(vals, a);
+        return (0);
+    }"
+    HAVE_AVX2)
+
+set(CMAKE_REQUIRED_FLAGS "${OCIO_AVX512_COMPILE_FLAGS}")
+check_cxx_source_compiles ("
+    #include <immintrin.h>
+    int main ()
+    {
+        float vals[16] = {0};
+        __m512 a = _mm512_loadu_ps(vals);
+        __mmask16 m = _mm512_cmp_ps_mask(a, a, _CMP_GT_OQ);
+        a = _mm512_mask_blend_ps(m, a, _mm512_permute_ps(a, 0x55));
+        _mm512_storeu_ps(vals, a);
+        return (0);
+    }"
+    HAVE_AVX512)
+
+set(CMAKE_REQUIRED_FLAGS "${OCIO_F16C_COMPILE_FLAGS}")
+check_cxx_source_compiles ("
+    #include <immintrin.h>
+    int main ()
+    {
+        float vals[8] = {0};
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(vals), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_ps(vals, _mm256_cvtph_ps(h));
+        return (0);
+    }"
+    HAVE_F16C)
+
+set(CMAKE_REQUIRED_FLAGS "${_OCIO_SAVED_REQUIRED_FLAGS}")
+
+MARK_AS_ADVANCED (HAVE_AVX2 HAVE_AVX512 HAVE_F16C)
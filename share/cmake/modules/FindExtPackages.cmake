@@ -6,6 +6,10 @@
 # by the OCIO_INSTALL_EXT_PACKAGES option.
 #
 
+# Threads
+# Used by the multi-threaded CPU processing.
+find_package(Threads REQUIRED)
+
 # expat
 # https://github.com/libexpat/libexpat
 find_package(expat 2.2.8 REQUIRED)
@@ -2,17 +2,79 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
-#include "transforms/FileTransform.h"
+#include "BakingUtils.h"
 #include "MathUtils.h"
+#include "ParallelUtils.h"
+#include "transforms/FileTransform.h"
 
 
 namespace OCIO_NAMESPACE
 {
 
+namespace
+{
+
+// A single bake needs at most a few lattices i.e. the identities and the processed ones.
+constexpr size_t BAKER_CACHE_SIZE = 8;
+constexpr size_t BATCH_BAKER_CACHE_SIZE = 32;
+
+void BakeWithCache(const Baker & baker, std::ostream & os, BakingCache & cache)
+{
+    const std::string formatName(baker.getFormat());
+    FileFormat * fmt = FormatRegistry::GetInstance().getFileFormatByName(formatName);
+
+    if(!fmt)
+    {
+        std::ostringstream err;
+        err << "The format named '" << formatName;
+        err << "' could not be found. ";
+        throw Exception(err.str().c_str());
+    }
+
+    if(!baker.getConfig())
+    {
+        throw Exception("No OCIO config has been set");
+    }
+
+    // The thread count also bounds the processor creation (e.g. a Lut3D inversion).
+    ThreadLimitGuard threadLimit(baker.getNumThreads());
+
+    try
+    {
+        fmt->bake(baker, formatName, os, cache);
+    }
+    catch(std::exception & e)
+    {
+        std::ostringstream err;
+        err << "Error baking " << formatName << ":";
+        err << e.what();
+        throw Exception(err.str().c_str());
+    }
+
+    // 
+    // TODO:
+    // 
+    // - throw exception when we don't have inputSpace and targetSpace
+    //   at least set
+    // - check limits of shaper and target, throw exception if we can't
+    //   write that much data in x format
+    // - check that the shaper is 1D transform only, throw exception
+    // - check the file format supports shapers, 1D and 3D
+    // - add some checks to make sure we are monotonic
+    // - deal with the case of writing out non cube formats (1D only)
+    // - do a compare between OCIO transform and output LUT transform
+    //   throw error if we going beyond tolerance
+    //
+}
+
+} // anon.
+
 BakerRcPtr Baker::Create()
 {
     return BakerRcPtr(new Baker(), &deleter);
@@ -36,10 +98,12 @@ public:
     std::string m_targetSpace;
     int m_shapersize;
     int m_cubesize;
+    unsigned m_numThreads;
 
     Impl() :
         m_shapersize(-1),
-        m_cubesize(-1)
+        m_cubesize(-1),
+        m_numThreads(1)
     {
     }
 
@@ -62,6 +126,7 @@ public:
             m_targetSpace = rhs.m_targetSpace;
             m_shapersize = rhs.m_shapersize;
             m_cubesize = rhs.m_cubesize;
+            m_numThreads = rhs.m_numThreads;
         }
         return *this;
     }
@@ -208,49 +273,208 @@ int Baker::getCubeSize() const
     return getImpl()->m_cubesize;
 }
 
+void Baker::setNumThreads(unsigned numThreads)
+{
+    getImpl()->m_numThreads = numThreads;
+}
+
+unsigned Baker::getNumThreads() const
+{
+    return getImpl()->m_numThreads;
+}
+
 void Baker::bake(std::ostream & os) const
 {
-    FileFormat* fmt = FormatRegistry::GetInstance().getFileFormatByName(getImpl()->m_formatName);
+    BakingCache cache(BAKER_CACHE_SIZE);
+    BakeWithCache(*this, os, cache);
+}
 
-    if(!fmt)
+
+BatchBakerRcPtr BatchBaker::Create()
+{
+    return BatchBakerRcPtr(new BatchBaker(), &deleter);
+}
+
+void BatchBaker::deleter(BatchBaker* c)
+{
+    delete c;
+}
+
+class BatchBaker::Impl
+{
+public:
+
+    struct Job
+    {
+        std::string m_formatName;
+        std::string m_inputSpace;
+        std::string m_shaperSpace;
+        std::string m_looks;
+        std::string m_targetSpace;
+        int m_shaperSize;
+        int m_cubeSize;
+        std::ostream * m_os;
+    };
+
+    ConstConfigRcPtr m_config;
+    FormatMetadataImpl m_formatMetadata{ METADATA_ROOT, "" };
+    std::vector<Job> m_jobs;
+    unsigned m_numThreads;
+
+    Impl() :
+        m_numThreads(0)
     {
-        std::ostringstream err;
-        err << "The format named '" << getImpl()->m_formatName;
-        err << "' could not be found. ";
-        throw Exception(err.str().c_str());
     }
 
-    if(!getConfig())
+    Impl(const Impl &) = delete;
+    Impl& operator= (const Impl &) = delete;
+
+    ~Impl()
     {
-        throw Exception("No OCIO config has been set");
     }
+};
 
-    try
+BatchBaker::BatchBaker()
+: m_impl(new BatchBaker::Impl)
+{
+}
+
+BatchBaker::~BatchBaker()
+{
+    delete m_impl;
+    m_impl = NULL;
+}
+
+void BatchBaker::setConfig(const ConstConfigRcPtr & config)
+{
+    getImpl()->m_config = config;
+}
+
+ConstConfigRcPtr BatchBaker::getConfig() const
+{
+    return getImpl()->m_config;
+}
+
+const FormatMetadata & BatchBaker::getFormatMetadata() const
+{
+    return getImpl()->m_formatMetadata;
+}
+
+FormatMetadata & BatchBaker::getFormatMetadata()
+{
+    return getImpl()->m_formatMetadata;
+}
+
+void BatchBaker::addJob(const char * formatName,
+                        const char * inputSpace,
+                        const char * shaperSpace,
+                        const char * looks,
+                        const char * targetSpace,
+                        int shaperSize,
+                        int cubeSize,
+                        std::ostream & os)
+{
+    // Report an unsupported format now rather than at the bake.
+    Baker::Create()->setFormat(formatName);
+
+    Impl::Job job;
+    job.m_formatName = formatName;
+    job.m_inputSpace = inputSpace ? inputSpace : "";
+    job.m_shaperSpace = shaperSpace ? shaperSpace : "";
+    job.m_looks = looks ? looks : "";
+    job.m_targetSpace = targetSpace ? targetSpace : "";
+    job.m_shaperSize = shaperSize;
+    job.m_cubeSize = cubeSize;
+    job.m_os = &os;
+
+    getImpl()->m_jobs.push_back(job);
+}
+
+int BatchBaker::getNumJobs() const
+{
+    return static_cast<int>(getImpl()->m_jobs.size());
+}
+
+void BatchBaker::clearJobs()
+{
+    getImpl()->m_jobs.clear();
+}
+
+void BatchBaker::setNumThreads(unsigned numThreads)
+{
+    getImpl()->m_numThreads = numThreads;
+}
+
+unsigned BatchBaker::getNumThreads() const
+{
+    return getImpl()->m_numThreads;
+}
+
+void BatchBaker::bake() const
+{
+    if(!getImpl()->m_config)
     {
-        fmt->bake(*this, getImpl()->m_formatName, os);
+        throw Exception("No OCIO config has been set");
     }
-    catch(std::exception & e)
+
+    const auto & jobs = getImpl()->m_jobs;
+    if(jobs.empty())
     {
-        std::ostringstream err;
-        err << "Error baking " << getImpl()->m_formatName << ":";
-        err << e.what();
-        throw Exception(err.str().c_str());
+        return;
     }
 
-    // 
-    // TODO:
-    // 
-    // - throw exception when we don't have inputSpace and targetSpace
-    //   at least set
-    // - check limits of shaper and target, throw exception if we can't
-    //   write that much data in x format
-    // - check that the shaper is 1D transform only, throw exception
-    // - check the file format supports shapers, 1D and 3D
-    // - add some checks to make sure we are monotonic
-    // - deal with the case of writing out non cube formats (1D only)
-    // - do a compare between OCIO transform and output LUT transform
-    //   throw error if we going beyond tolerance
-    //
+    // All the bakers share the same config copy, and so its processor cache.
+    BakerRcPtr prototype = Baker::Create();
+    prototype->setConfig(getImpl()->m_config);
+    dynamic_cast<FormatMetadataImpl &>(prototype->getFormatMetadata())
+        = getImpl()->m_formatMetadata;
+
+    // The jobs are distributed across the threads and the remaining threads help
+    // evaluating the lattices of each job.
+    const unsigned numThreads = GetNumThreads(getImpl()->m_numThreads);
+    const unsigned numJobThreads
+        = std::min(numThreads, static_cast<unsigned>(jobs.size()));
+    const unsigned numLatticeThreads = std::max(1u, numThreads / numJobThreads);
+
+    BakingCache cache(BATCH_BAKER_CACHE_SIZE);
+    std::vector<std::string> errors(jobs.size());
+
+    ParallelFor(numJobThreads, static_cast<long>(jobs.size()), 1,
+                [&](unsigned /*threadIdx*/, long begin, long end)
+    {
+        for (long idx = begin; idx < end; ++idx)
+        {
+            const Impl::Job & job = jobs[idx];
+            try
+            {
+                BakerRcPtr baker = prototype->createEditableCopy();
+                baker->setFormat(job.m_formatName.c_str());
+                baker->setInputSpace(job.m_inputSpace.c_str());
+                baker->setShaperSpace(job.m_shaperSpace.c_str());
+                baker->setLooks(job.m_looks.c_str());
+                baker->setTargetSpace(job.m_targetSpace.c_str());
+                baker->setShaperSize(job.m_shaperSize);
+                baker->setCubeSize(job.m_cubeSize);
+                baker->setNumThreads(numLatticeThreads);
+
+                BakeWithCache(*baker, *job.m_os, cache);
+            }
+            catch(std::exception & e)
+            {
+                errors[idx] = e.what();
+            }
+        }
+    });
+
+    for (size_t idx = 0; idx < errors.size(); ++idx)
+    {
+        if (!errors[idx].empty())
+        {
+            std::ostringstream err;
+            err << "Error baking the job " << idx << ": " << errors[idx];
+            throw Exception(err.str().c_str());
+        }
+    }
 }
 
 } // namespace OCIO_NAMESPACE
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <sstream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "BakingUtils.h"
+#include "ops/lut1d/Lut1DOp.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+BakingCache::BakingCache(size_t maxNumLattices)
+    :   m_lattices(maxNumLattices)
+{
+}
+
+ConstLutValuesRcPtr BakingCache::getLut1D(int size,
+                                          const ConstCPUProcessorRcPtrVec & cpus,
+                                          unsigned numThreads)
+{
+    std::ostringstream key;
+    key << "1D " << size;
+
+    auto generate = [size](std::vector<float> & result)
+    {
+        result.resize(size_t(size) * 3);
+        GenerateIdentityLut1D(result.data(), size, 3);
+    };
+    ConstLutValuesRcPtr values = getLattice(key.str(), generate);
+
+    return getProcessedLattice(key.str(), values, size, 1, cpus, numThreads);
+}
+
+ConstLutValuesRcPtr BakingCache::getLut3D(int edgeLen,
+                                          Lut3DOrder order,
+                                          const ConstCPUProcessorRcPtrVec & cpus,
+                                          unsigned numThreads)
+{
+    std::ostringstream key;
+    key << "3D " << edgeLen << " " << order;
+
+    auto generate = [edgeLen, order](std::vector<float> & result)
+    {
+        result.resize(size_t(edgeLen) * edgeLen * edgeLen * 3);
+        GenerateIdentityLut3D(result.data(), edgeLen, 3, order);
+    };
+    ConstLutValuesRcPtr values = getLattice(key.str(), generate);
+
+    // The rows of the lattice are split across the threads.
+    return getProcessedLattice(key.str(), values, long(edgeLen) * edgeLen, edgeLen,
+                               cpus, numThreads);
+}
+
+ConstLutValuesRcPtr BakingCache::getLattice(const std::string & key,
+                                            const LatticeEvaluator & evaluate)
+{
+    LatticeRcPtr lattice;
+    {
+        AutoMutex guard(m_mutex);
+        if (!m_lattices.get(key, lattice))
+        {
+            lattice = std::make_shared<Lattice>();
+            m_lattices.add(key, lattice);
+        }
+    }
+
+    // Only block the requests of the same lattice while it is evaluated.
+    AutoMutex guard(lattice->m_mutex);
+    if (!lattice->m_values)
+    {
+        auto values = std::make_shared<std::vector<float>>();
+        evaluate(*values);
+        lattice->m_values = values;
+    }
+
+    return lattice->m_values;
+}
+
+ConstLutValuesRcPtr BakingCache::getProcessedLattice(std::string key,
+                                                     ConstLutValuesRcPtr values,
+                                                     long width,
+                                                     long height,
+                                                     const ConstCPUProcessorRcPtrVec & cpus,
+                                                     unsigned numThreads)
+{
+    for (size_t idx = 0; idx < cpus.size(); ++idx)
+    {
+        const ConstCPUProcessorRcPtr & cpu = cpus[idx];
+
+        auto process = [&values, &cpu, width, height, numThreads](std::vector<float> & result)
+        {
+            result = *values;
+            PackedImageDesc img(result.data(), width, height, 3);
+            cpu->applyParallel(img, numThreads);
+        };
+
+        // The complete sequence gives the baked LUT which is only used once, so only the
+        // prefixes (which other LUTs could share) are cached.
+        if (idx + 1 == cpus.size())
+        {
+            auto result = std::make_shared<std::vector<float>>();
+            process(*result);
+            return result;
+        }
+
+        key += " ";
+        key += cpu->getCacheID();
+        values = getLattice(key, process);
+    }
+
+    return values;
+}
+
+} // namespace OCIO_NAMESPACE
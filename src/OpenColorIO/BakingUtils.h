@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_BAKINGUTILS_H
+#define INCLUDED_OCIO_BAKINGUTILS_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Caching.h"
+#include "Mutex.h"
+#include "ops/lut3d/Lut3DOp.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+typedef std::vector<ConstCPUProcessorRcPtr> ConstCPUProcessorRcPtrVec;
+typedef std::shared_ptr<const std::vector<float>> ConstLutValuesRcPtr;
+
+// Evaluated LUT lattices shared by the LUT bakers, e.g. by all the jobs of a BatchBaker.
+// A lattice is an identity LUT (refer to GenerateIdentityLut1D() & GenerateIdentityLut3D())
+// with 3 channels, processed by a sequence of CPU processors. The identity lattice and each
+// strict prefix of the sequence are cached so lattices only differing by their last
+// processors share the evaluation of the first ones, the complete sequence is not cached.
+// The least recently used lattices are evicted to bound the memory usage. The methods are
+// thread-safe, and a cached lattice requested concurrently is only evaluated once.
+//
+// Note that only the sequences of the bakers share prefixes i.e. the shaper of the CSP
+// format. The other formats bake a single processor from the input to the target space, so
+// for instance several displays baked from the same camera space do not share the input to
+// reference conversion.
+class BakingCache
+{
+public:
+    BakingCache() = delete;
+    BakingCache(const BakingCache &) = delete;
+    BakingCache & operator=(const BakingCache &) = delete;
+
+    explicit BakingCache(size_t maxNumLattices);
+    ~BakingCache() = default;
+
+    // The processors are applied from numThreads threads (refer to GetNumThreads()).
+    ConstLutValuesRcPtr getLut1D(int size,
+                                 const ConstCPUProcessorRcPtrVec & cpus,
+                                 unsigned numThreads);
+    ConstLutValuesRcPtr getLut3D(int edgeLen,
+                                 Lut3DOrder order,
+                                 const ConstCPUProcessorRcPtrVec & cpus,
+                                 unsigned numThreads);
+
+    size_t getNumHits() const { return m_lattices.getNumHits(); }
+    size_t getNumMisses() const { return m_lattices.getNumMisses(); }
+
+private:
+    struct Lattice
+    {
+        Mutex m_mutex;
+        ConstLutValuesRcPtr m_values;
+    };
+
+    typedef std::shared_ptr<Lattice> LatticeRcPtr;
+    typedef std::function<void(std::vector<float> &)> LatticeEvaluator;
+
+    ConstLutValuesRcPtr getLattice(const std::string & key, const LatticeEvaluator & evaluate);
+
+    ConstLutValuesRcPtr getProcessedLattice(std::string key,
+                                            ConstLutValuesRcPtr values,
+                                            long width,
+                                            long height,
+                                            const ConstCPUProcessorRcPtrVec & cpus,
+                                            unsigned numThreads);
+
+    GenericCache<std::string, LatticeRcPtr> m_lattices;
+    Mutex m_mutex; // Makes the lattice lookup and insertion atomic.
+};
+
+} // namespace OCIO_NAMESPACE
+
+#endif
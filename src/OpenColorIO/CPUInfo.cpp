@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "CPUInfo.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OCIO_ARCH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+namespace OCIO_NAMESPACE
+{
+
+namespace
+{
+
+#ifdef OCIO_ARCH_X86
+
+// Registers returned by the cpuid instruction.
+struct CPUIDRegs
+{
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+};
+
+CPUIDRegs GetCPUID(unsigned leaf, unsigned subleaf)
+{
+    CPUIDRegs regs;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    regs.eax = (unsigned)info[0];
+    regs.ebx = (unsigned)info[1];
+    regs.ecx = (unsigned)info[2];
+    regs.edx = (unsigned)info[3];
+#else
+    __cpuid_count(leaf, subleaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+#endif
+    return regs;
+}
+
+// Read the XCR0 register i.e. the register states the operating system saves.
+unsigned long long GetXCR0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+
+inline bool IsBitSet(unsigned reg, unsigned bit)
+{
+    return (reg & (1u << bit)) != 0;
+}
+
+CPUInfo DetectCPUInfo()
+{
+    CPUInfo info;
+
+    const unsigned maxLeaf = GetCPUID(0, 0).eax;
+    if (maxLeaf < 1)
+    {
+        return info;
+    }
+
+    const CPUIDRegs leaf1 = GetCPUID(1, 0);
+    info.m_hasSSE2 = IsBitSet(leaf1.edx, 26);
+
+    // The AVX registers are only usable when the operating system saves them.
+    const bool hasOSXSAVE = IsBitSet(leaf1.ecx, 27);
+    const unsigned long long xcr0 = hasOSXSAVE ? GetXCR0() : 0;
+
+    // XMM and YMM states.
+    const bool hasOSAVX = (xcr0 & 0x6) == 0x6;
+    // Opmask, upper ZMM0-15 and ZMM16-31 states.
+    const bool hasOSAVX512 = hasOSAVX && (xcr0 & 0xE0) == 0xE0;
+
+    info.m_hasAVX  = hasOSAVX && IsBitSet(leaf1.ecx, 28);
+    info.m_hasFMA  = info.m_hasAVX && IsBitSet(leaf1.ecx, 12);
+    info.m_hasF16C = info.m_hasAVX && IsBitSet(leaf1.ecx, 29);
+
+    if (maxLeaf >= 7)
+    {
+        const CPUIDRegs leaf7 = GetCPUID(7, 0);
+        info.m_hasAVX2    = info.m_hasAVX && IsBitSet(leaf7.ebx, 5);
+        info.m_hasAVX512F = hasOSAVX512 && IsBitSet(leaf7.ebx, 16);
+    }
+
+    return info;
+}
+
+#else
+
+CPUInfo DetectCPUInfo()
+{
+    return CPUInfo();
+}
+
+#endif
+
+} // anon.
+
+const CPUInfo & CPUInfo::Instance()
+{
+    static const CPUInfo info = DetectCPUInfo();
+    return info;
+}
+
+} // namespace OCIO_NAMESPACE
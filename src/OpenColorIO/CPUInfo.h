@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_CPUINFO_H
+#define INCLUDED_OCIO_CPUINFO_H
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Instruction set extensions of the running CPU. The AVX flags are only set when the
+// operating system also saves the corresponding registers on context switches.
+struct CPUInfo
+{
+    bool m_hasSSE2    = false;
+    bool m_hasAVX     = false;
+    bool m_hasAVX2    = false;
+    bool m_hasFMA     = false;
+    bool m_hasF16C    = false;
+    bool m_hasAVX512F = false;
+
+    // The features are detected once, on first use.
+    static const CPUInfo & Instance();
+};
+
+} // namespace OCIO_NAMESPACE
+
+#endif
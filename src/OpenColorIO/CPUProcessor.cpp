@@ -1,17 +1,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <chrono>
+#include <sstream>
 #include <string.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
 #include "CPUProcessor.h"
+#include "HalfConversion.h"
 #include "ops/lut1d/Lut1DOpCPU.h"
 #include "ops/lut3d/Lut3DOpCPU.h"
 #include "ops/matrix/MatrixOp.h"
 #include "ops/range/RangeOpCPU.h"
+#include "ParallelUtils.h"
 #include "ScanlineHelper.h"
+#include "utils/StringUtils.h"
 
 
 namespace OCIO_NAMESPACE
@@ -65,6 +71,54 @@ public:
     }
 };
 
+// The half float conversions are done in bulk (i.e. using F16C when available).
+
+template<>
+class BitDepthCast<BIT_DEPTH_F16, BIT_DEPTH_F32> : public OpCPU
+{
+public:
+    BitDepthCast() = default;
+    ~BitDepthCast() override {};
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        ConvertHalfToFloat(reinterpret_cast<const half*>(inImg),
+                           reinterpret_cast<float*>(outImg),
+                           4 * numPixels);
+    }
+};
+
+template<>
+class BitDepthCast<BIT_DEPTH_F32, BIT_DEPTH_F16> : public OpCPU
+{
+public:
+    BitDepthCast() = default;
+    ~BitDepthCast() override {};
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        ConvertFloatToHalf(reinterpret_cast<const float*>(inImg),
+                           reinterpret_cast<half*>(outImg),
+                           4 * numPixels);
+    }
+};
+
+template<>
+class BitDepthCast<BIT_DEPTH_F16, BIT_DEPTH_F16> : public OpCPU
+{
+public:
+    BitDepthCast() = default;
+    ~BitDepthCast() override {};
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        if(inImg!=outImg)
+        {
+            memcpy(outImg, inImg, 4*numPixels*sizeof(half));
+        }
+    }
+};
+
 ConstOpCPURcPtr CreateGenericBitDepthHelper(BitDepth in, BitDepth out)
 {
 
@@ -127,8 +181,17 @@ void CreateCPUEngine(const OpRcPtrVec & ops,
                      // The remaining CPU Ops.
                      ConstOpCPURcPtrVec & cpuOps,
                      // The bit-depth 'cast' or the last CPU Op.
-                     ConstOpCPURcPtr & outBitDepthOp)
+                     ConstOpCPURcPtr & outBitDepthOp,
+                     // The description of the in, cpu & out ops (in that order).
+                     StringUtils::StringVec & cpuOpNames)
 {
+    const std::string inName  = std::string("Input ") + BitDepthToString(in);
+    const std::string outName = std::string("Output ") + BitDepthToString(out);
+
+    std::string inOpName  = inName;
+    std::string outOpName = outName;
+    StringUtils::StringVec opNames;
+
     const size_t maxOps = ops.size();
     for(size_t idx=0; idx<maxOps; ++idx)
     {
@@ -141,15 +204,18 @@ void CreateCPUEngine(const OpRcPtrVec & ops,
             {
                 ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
                 inBitDepthOp = GetLut1DRenderer(lut, in, BIT_DEPTH_F32);
+                inOpName += ": " + op->getInfo();
             }
             else if(in==BIT_DEPTH_F32)
             {
                 inBitDepthOp = op->getCPUOp();
+                inOpName += ": " + op->getInfo();
             }
             else
             {
                 inBitDepthOp = CreateGenericBitDepthHelper(in, BIT_DEPTH_F32);
                 cpuOps.push_back(op->getCPUOp());
+                opNames.push_back(op->getInfo());
             }
 
             if(maxOps==1)
@@ -163,22 +229,31 @@ void CreateCPUEngine(const OpRcPtrVec & ops,
             {
                 ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
                 outBitDepthOp = GetLut1DRenderer(lut, BIT_DEPTH_F32, out);
+                outOpName += ": " + op->getInfo();
             }
             else if(out==BIT_DEPTH_F32)
             {
                 outBitDepthOp = op->getCPUOp();
+                outOpName += ": " + op->getInfo();
             }
             else
             {
                 outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
                 cpuOps.push_back(op->getCPUOp());
+                opNames.push_back(op->getInfo());
             }
         }
         else
         {
             cpuOps.push_back(op->getCPUOp());
+            opNames.push_back(op->getInfo());
         }
     }
+
+    cpuOpNames.clear();
+    cpuOpNames.push_back(inOpName);
+    cpuOpNames.insert(cpuOpNames.end(), opNames.begin(), opNames.end());
+    cpuOpNames.push_back(outOpName);
 }
 
 
@@ -262,15 +337,16 @@ DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType
 
 void FinalizeOpsForCPU(OpRcPtrVec & ops, const OpRcPtrVec & rawOps,
                        BitDepth in, BitDepth out,
-                       OptimizationFlags oFlags)
+                       OptimizationFlags oFlags, HalfDomainLutAccuracy & accuracy)
 {
     ops = rawOps;
+    accuracy = HalfDomainLutAccuracy();
 
     if(!ops.empty())
     {
         // Optimize the ops.
         ops.finalize(oFlags);
-        ops.optimizeForBitdepth(in, out, oFlags);
+        ops.optimizeForBitdepth(in, out, oFlags, &accuracy);
     }
 
     if(ops.empty())
@@ -306,7 +382,7 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     AutoMutex lock(m_mutex);
 
     OpRcPtrVec ops;
-    FinalizeOpsForCPU(ops, rawOps, in, out, oFlags);
+    FinalizeOpsForCPU(ops, rawOps, in, out, oFlags, m_halfDomainLutAccuracy);
 
     m_inBitDepth  = in;
     m_outBitDepth = out;
@@ -322,7 +398,18 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     m_cpuOps.clear();
     m_inBitDepthOp = nullptr;
     m_outBitDepthOp = nullptr;
-    CreateCPUEngine(ops, in, out, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
+    StringUtils::StringVec cpuOpNames;
+    CreateCPUEngine(ops, in, out, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp, cpuOpNames);
+
+    // Prepare the per-stage timings.
+
+    std::vector<OpTiming> opTimings(cpuOpNames.size());
+    for(size_t i = 0; i < cpuOpNames.size(); ++i)
+    {
+        opTimings[i].m_name = cpuOpNames[i];
+    }
+    m_opTimings.swap(opTimings);
+    m_opsDescription = SerializeOpVec(ops, 4);
 
     // Compute the cache id.
 
@@ -339,62 +426,332 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     m_cacheID = ss.str();
 }
 
-void CPUProcessor::Impl::apply(ImageDesc & imgDesc) const
-{   
-    // Get the ScanlineHelper for this thread (no significant performance impact).
-    std::unique_ptr<ScanlineHelper> 
-        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                             m_outBitDepth, m_outBitDepthOp));
+void CPUProcessor::Impl::setBlockSize(long numPixels) const
+{
+    if (numPixels < 0)
+    {
+        throw Exception("CPU Processor: the block size cannot be negative.");
+    }
 
-    // Prepare the processing.
-    scanlineBuilder->init(imgDesc);
+    m_blockSize = numPixels;
+}
+
+void CPUProcessor::Impl::resetOpTimings() const noexcept
+{
+    for(const auto & timing : m_opTimings)
+    {
+        timing.m_numCalls    = 0;
+        timing.m_numPixels   = 0;
+        timing.m_nanoseconds = 0;
+    }
+}
+
+const CPUProcessor::Impl::OpTiming & CPUProcessor::Impl::getOpTiming(int index) const
+{
+    if (index < 0 || index >= getNumOpTimings())
+    {
+        std::ostringstream oss;
+        oss << "CPU Processor: invalid op timing index " << index
+            << " where the number of op timings is " << getNumOpTimings() << ".";
+        throw Exception(oss.str().c_str());
+    }
+
+    return m_opTimings[index];
+}
+
+void CPUProcessor::Impl::serializeOpTimings(std::ostream & os) const
+{
+    os << "CPU Processor ops:\n" << m_opsDescription;
+    os << "CPU Processor op timings:\n";
 
+    for(const auto & timing : m_opTimings)
+    {
+        const unsigned long long numPixels   = timing.m_numPixels;
+        const unsigned long long nanoseconds = timing.m_nanoseconds;
+
+        os << "    " << timing.m_name
+           << " calls:" << timing.m_numCalls
+           << " pixels:" << numPixels
+           << " ns:" << nanoseconds
+           << " ns/pixel:" << (numPixels ? double(nanoseconds) / double(numPixels) : 0.0)
+           << "\n";
+    }
+}
+
+namespace
+{
+
+typedef std::chrono::steady_clock OpTimingClock;
+
+inline unsigned long long ElapsedNanoseconds(const OpTimingClock::time_point & start,
+                                             const OpTimingClock::time_point & end)
+{
+    return (unsigned long long)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+// Accumulate the statistics of one apply call into the shared ones.
+struct LocalOpTiming
+{
+    unsigned long long m_numCalls    = 0;
+    unsigned long long m_numPixels   = 0;
+    unsigned long long m_nanoseconds = 0;
+};
+
+} // anon.
+
+void CPUProcessor::Impl::applyScanlinesTimed(ScanlineHelper & scanlineBuilder) const
+{
     float * rgbaBuffer = nullptr;
     long numPixels = 0;
 
+    const size_t numOps = m_cpuOps.size();
+    const long blockSize = m_blockSize;
+
+    // The first and last timings are the input and output conversions.
+    std::vector<LocalOpTiming> timings(numOps + 2);
+
     while(true)
     {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
+        OpTimingClock::time_point start = OpTimingClock::now();
+        scanlineBuilder.prepRGBAScanline(&rgbaBuffer, numPixels);
+        OpTimingClock::time_point end = OpTimingClock::now();
         if(numPixels == 0) break;
 
-        const size_t numOps = m_cpuOps.size();
-        for(size_t i = 0; i<numOps; ++i)
+        timings[0].m_numCalls    += 1;
+        timings[0].m_numPixels   += numPixels;
+        timings[0].m_nanoseconds += ElapsedNanoseconds(start, end);
+
+        const long numBlockPixels
+            = (numOps > 1 && blockSize > 0) ? std::min(blockSize, numPixels) : numPixels;
+
+        for(long startPixel = 0; startPixel < numPixels; startPixel += numBlockPixels)
         {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            float * block = rgbaBuffer + 4 * startPixel;
+            const long numPixelsInBlock = std::min(numBlockPixels, numPixels - startPixel);
+
+            start = OpTimingClock::now();
+            for(size_t i = 0; i<numOps; ++i)
+            {
+                m_cpuOps[i]->apply(block, block, numPixelsInBlock);
+
+                end = OpTimingClock::now();
+                timings[i + 1].m_numCalls    += 1;
+                timings[i + 1].m_numPixels   += numPixelsInBlock;
+                timings[i + 1].m_nanoseconds += ElapsedNanoseconds(start, end);
+                start = end;
+            }
         }
 
-        scanlineBuilder->finishRGBAScanline();
+        start = OpTimingClock::now();
+        scanlineBuilder.finishRGBAScanline();
+        end = OpTimingClock::now();
+
+        timings[numOps + 1].m_numCalls    += 1;
+        timings[numOps + 1].m_numPixels   += numPixels;
+        timings[numOps + 1].m_nanoseconds += ElapsedNanoseconds(start, end);
+    }
+
+    for(size_t i = 0; i < timings.size() && i < m_opTimings.size(); ++i)
+    {
+        m_opTimings[i].m_numCalls    += timings[i].m_numCalls;
+        m_opTimings[i].m_numPixels   += timings[i].m_numPixels;
+        m_opTimings[i].m_nanoseconds += timings[i].m_nanoseconds;
     }
 }
 
-void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
+void CPUProcessor::Impl::applyScanlines(ScanlineHelper & scanlineBuilder) const
 {
-    // Get the ScanlineHelper for this thread (no significant performance impact).
-    std::unique_ptr<ScanlineHelper> 
-        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                             m_outBitDepth, m_outBitDepthOp));
-
-    // Prepare the processing.
-    scanlineBuilder->init(srcImgDesc, dstImgDesc);
+    if(m_opTimingEnabled)
+    {
+        applyScanlinesTimed(scanlineBuilder);
+        return;
+    }
 
     float * rgbaBuffer = nullptr;
     long numPixels = 0;
 
+    const size_t numOps = m_cpuOps.size();
+    const long blockSize = m_blockSize;
+
     while(true)
     {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
+        scanlineBuilder.prepRGBAScanline(&rgbaBuffer, numPixels);
         if(numPixels == 0) break;
 
-        const size_t numOps = m_cpuOps.size();
-        for(size_t i = 0; i<numOps; ++i)
+        // Run the whole op chain on a block of pixels small enough to stay in the cache
+        // before moving to the next block, rather than streaming the complete scanline
+        // through the memory once per op.
+        const long numBlockPixels
+            = (numOps > 1 && blockSize > 0) ? std::min(blockSize, numPixels) : numPixels;
+
+        for(long start = 0; start < numPixels; start += numBlockPixels)
+        {
+            float * block = rgbaBuffer + 4 * start;
+            const long numPixelsInBlock = std::min(numBlockPixels, numPixels - start);
+
+            for(size_t i = 0; i<numOps; ++i)
+            {
+                m_cpuOps[i]->apply(block, block, numPixelsInBlock);
+            }
+        }
+
+        scanlineBuilder.finishRGBAScanline();
+    }
+}
+
+std::unique_ptr<ScanlineHelper> CPUProcessor::Impl::acquireScanlineHelper() const
+{
+    {
+        AutoMutex lock(m_scanlineHelpersMutex);
+
+        if (!m_scanlineHelpers.empty())
+        {
+            std::unique_ptr<ScanlineHelper> helper = std::move(m_scanlineHelpers.back());
+            m_scanlineHelpers.pop_back();
+            return helper;
+        }
+    }
+
+    return std::unique_ptr<ScanlineHelper>(
+        CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp, m_outBitDepth, m_outBitDepthOp));
+}
+
+void CPUProcessor::Impl::releaseScanlineHelper(std::unique_ptr<ScanlineHelper> helper) const
+{
+    // Keep at most one idle helper per hardware thread (or per reserved thread) so that
+    // the memory held by the processor stays bounded.
+    const unsigned numHardwareThreads = GetNumThreads(0);
+
+    AutoMutex lock(m_scanlineHelpersMutex);
+
+    if (helper && m_scanlineHelpers.size() < std::max(numHardwareThreads, m_maxScanlineHelpers))
+    {
+        m_scanlineHelpers.push_back(std::move(helper));
+    }
+}
+
+void CPUProcessor::Impl::reserveScanlineBuffers(long width, unsigned numThreads) const
+{
+    numThreads = GetNumThreads(numThreads);
+
+    std::vector<std::unique_ptr<ScanlineHelper>> helpers;
+    {
+        AutoMutex lock(m_scanlineHelpersMutex);
+        m_maxScanlineHelpers = std::max(m_maxScanlineHelpers, numThreads);
+    }
+
+    for (unsigned idx = 0; idx < numThreads; ++idx)
+    {
+        helpers.push_back(acquireScanlineHelper());
+        helpers.back()->reserve(width);
+    }
+
+    for (auto & helper : helpers)
+    {
+        releaseScanlineHelper(std::move(helper));
+    }
+}
+
+void CPUProcessor::Impl::apply(ImageDesc & imgDesc) const
+{   
+    // Note: In case of error, the helper is not given back to the pool.
+    std::unique_ptr<ScanlineHelper> scanlineBuilder = acquireScanlineHelper();
+
+    // Prepare the processing.
+    scanlineBuilder->init(imgDesc);
+
+    applyScanlines(*scanlineBuilder);
+
+    releaseScanlineHelper(std::move(scanlineBuilder));
+}
+
+void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
+{
+    // Note: In case of error, the helper is not given back to the pool.
+    std::unique_ptr<ScanlineHelper> scanlineBuilder = acquireScanlineHelper();
+
+    // Prepare the processing.
+    scanlineBuilder->init(srcImgDesc, dstImgDesc);
+
+    applyScanlines(*scanlineBuilder);
+
+    releaseScanlineHelper(std::move(scanlineBuilder));
+}
+
+namespace
+{
+// Number of row bands handed out to each thread. Having more bands than threads balances
+// the work when some rows are more expensive than others (e.g. NaNs or branches in the ops).
+constexpr long BANDS_PER_THREAD = 4;
+}
+
+void CPUProcessor::Impl::applyParallel(const ImageDesc * srcImgDesc, ImageDesc & dstImgDesc,
+                                       unsigned numThreads) const
+{
+    const long height = dstImgDesc.getHeight();
+
+    numThreads = GetNumThreads(numThreads);
+    numThreads = (unsigned)std::min<long>(numThreads, std::max(1L, height));
+
+    if (numThreads <= 1)
+    {
+        if (srcImgDesc)
+        {
+            apply(*srcImgDesc, dstImgDesc);
+        }
+        else
+        {
+            apply(dstImgDesc);
+        }
+        return;
+    }
+
+    // Each thread owns its ScanlineHelper (i.e. its intermediate buffers) and processes
+    // several row bands of the image.
+    std::vector<std::unique_ptr<ScanlineHelper>> scanlineBuilders(numThreads);
+
+    const long rowsPerBand = std::max(1L, height / (long(numThreads) * BANDS_PER_THREAD));
+
+    ParallelFor(numThreads, height, rowsPerBand,
+                [&](unsigned threadIdx, long yBegin, long yEnd)
+    {
+        std::unique_ptr<ScanlineHelper> & scanlineBuilder = scanlineBuilders[threadIdx];
+        if (!scanlineBuilder)
         {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            scanlineBuilder = acquireScanlineHelper();
+            if (srcImgDesc)
+            {
+                scanlineBuilder->init(*srcImgDesc, dstImgDesc);
+            }
+            else
+            {
+                scanlineBuilder->init(dstImgDesc);
+            }
         }
 
-        scanlineBuilder->finishRGBAScanline();
+        scanlineBuilder->setRowRange(yBegin, yEnd);
+
+        applyScanlines(*scanlineBuilder);
+    });
+
+    for (auto & scanlineBuilder : scanlineBuilders)
+    {
+        releaseScanlineHelper(std::move(scanlineBuilder));
     }
 }
 
+void CPUProcessor::Impl::applyParallel(ImageDesc & imgDesc, unsigned numThreads) const
+{
+    applyParallel(nullptr, imgDesc, numThreads);
+}
+
+void CPUProcessor::Impl::applyParallel(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                       unsigned numThreads) const
+{
+    applyParallel(&srcImgDesc, dstImgDesc, numThreads);
+}
+
 void CPUProcessor::Impl::applyRGB(float * pixel) const
 {
     float v[4]{pixel[0], pixel[1], pixel[2], 0.0f};
@@ -496,6 +853,85 @@ void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) c
     getImpl()->apply(srcImgDesc, dstImgDesc);
 }
 
+void CPUProcessor::applyParallel(ImageDesc & imgDesc, unsigned numThreads) const
+{
+    getImpl()->applyParallel(imgDesc, numThreads);
+}
+
+void CPUProcessor::applyParallel(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                 unsigned numThreads) const
+{
+    getImpl()->applyParallel(srcImgDesc, dstImgDesc, numThreads);
+}
+
+void CPUProcessor::reserveScanlineBuffers(long width, unsigned numThreads) const
+{
+    getImpl()->reserveScanlineBuffers(width, numThreads);
+}
+
+long CPUProcessor::getBlockSize() const
+{
+    return getImpl()->getBlockSize();
+}
+
+void CPUProcessor::setBlockSize(long numPixels) const
+{
+    getImpl()->setBlockSize(numPixels);
+}
+
+bool CPUProcessor::isOpTimingEnabled() const
+{
+    return getImpl()->isOpTimingEnabled();
+}
+
+void CPUProcessor::resetOpTimings() const
+{
+    getImpl()->resetOpTimings();
+}
+
+int CPUProcessor::getNumOpTimings() const
+{
+    return getImpl()->getNumOpTimings();
+}
+
+const char * CPUProcessor::getOpTimingName(int index) const
+{
+    return getImpl()->getOpTiming(index).m_name.c_str();
+}
+
+unsigned long long CPUProcessor::getOpTimingNumCalls(int index) const
+{
+    return getImpl()->getOpTiming(index).m_numCalls;
+}
+
+unsigned long long CPUProcessor::getOpTimingNumPixels(int index) const
+{
+    return getImpl()->getOpTiming(index).m_numPixels;
+}
+
+unsigned long long CPUProcessor::getOpTimingNanoseconds(int index) const
+{
+    return getImpl()->getOpTiming(index).m_nanoseconds;
+}
+
+void CPUProcessor::serializeOpTimings(std::ostream & os) const
+{
+    getImpl()->serializeOpTimings(os);
+}
+
+bool CPUProcessor::getSeparablePrefixF32Accuracy(float & maxError,
+                                                 float & maxErrorInput,
+                                                 bool & replaced) const
+{
+    const HalfDomainLutAccuracy & accuracy = getImpl()->getHalfDomainLutAccuracy();
+
+    maxError      = accuracy.m_maxError;
+    maxErrorInput = accuracy.m_maxErrorInput;
+    replaced      = accuracy.m_replaced;
+
+    return accuracy.m_evaluated;
+}
+
 void CPUProcessor::applyRGB(float * pixel) const
 {
     getImpl()->applyRGB(pixel);
@@ -6,16 +6,20 @@
 #define INCLUDED_OCIO_CPUPROCESSOR_H
 
 
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Op.h"
+#include "ScanlineHelper.h"
 
 
 namespace OCIO_NAMESPACE
 {
 
-class ScanlineHelper;
-
 class CPUProcessor::Impl
 {
 public:
@@ -44,6 +48,38 @@ public:
     void apply(ImageDesc & imgDesc) const;
     void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
 
+    void applyParallel(ImageDesc & imgDesc, unsigned numThreads) const;
+    void applyParallel(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                       unsigned numThreads) const;
+
+    void reserveScanlineBuffers(long width, unsigned numThreads) const;
+
+    long getBlockSize() const noexcept { return m_blockSize; }
+    void setBlockSize(long numPixels) const;
+
+    // Accumulated statistics of one stage of the CPU processing.
+    struct OpTiming
+    {
+        std::string m_name;
+        mutable std::atomic<unsigned long long> m_numCalls{ 0 };
+        mutable std::atomic<unsigned long long> m_numPixels{ 0 };
+        mutable std::atomic<unsigned long long> m_nanoseconds{ 0 };
+    };
+
+    bool isOpTimingEnabled() const noexcept { return m_opTimingEnabled; }
+    void resetOpTimings() const noexcept;
+
+    int getNumOpTimings() const noexcept { return static_cast<int>(m_opTimings.size()); }
+    const OpTiming & getOpTiming(int index) const;
+
+    void serializeOpTimings(std::ostream & os) const;
+
+    // Report of the OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32 optimization.
+    const HalfDomainLutAccuracy & getHalfDomainLutAccuracy() const noexcept
+    {
+        return m_halfDomainLutAccuracy;
+    }
+
     // Note that the method only accepts one packed RGB and 32-bit float pixel.
     void applyRGB(float * pixel) const;
     // Note that the method only accepts one packed RGBA and 32-bit float pixel.
@@ -55,7 +91,24 @@ public:
 
     void finalize(const OpRcPtrVec & rawOps, BitDepth in, BitDepth out, OptimizationFlags oFlags);
 
+    // Only call it before sharing the instance (refer to Processor::getTimedCPUProcessor()).
+    void setOpTimingEnabled(bool enabled) noexcept { m_opTimingEnabled = enabled; }
+
 private:
+    // Process all the remaining scanlines of the helper.
+    void applyScanlines(ScanlineHelper & scanlineBuilder) const;
+    // Same as above but also accumulates the time spent in each stage.
+    void applyScanlinesTimed(ScanlineHelper & scanlineBuilder) const;
+
+    // The source image is optional i.e. in-place processing when null.
+    void applyParallel(const ImageDesc * srcImgDesc, ImageDesc & dstImgDesc,
+                       unsigned numThreads) const;
+
+    // Get an idle helper (or create one) so that its intermediate buffers are reused from
+    // one apply call to the next, and give it back once the processing is done.
+    std::unique_ptr<ScanlineHelper> acquireScanlineHelper() const;
+    void releaseScanlineHelper(std::unique_ptr<ScanlineHelper> helper) const;
+
     ConstOpCPURcPtr    m_inBitDepthOp; // Converts from in to F32. It could be done by the first op.
     ConstOpCPURcPtrVec m_cpuOps;       // It could be empty if the OpVec only contains a 1D LUT op
                                        // (e.g. the 1D LUT CPUOp instance would be in the m_inBitDepthOp).
@@ -68,6 +121,20 @@ private:
     bool               m_hasChannelCrosstalk = true;
     std::string        m_cacheID;
     Mutex              m_mutex;
+
+    // Idle helpers i.e. at most one per thread which concurrently processed an image.
+    mutable std::vector<std::unique_ptr<ScanlineHelper>> m_scanlineHelpers;
+    mutable unsigned   m_maxScanlineHelpers = 0;
+    mutable Mutex      m_scanlineHelpersMutex;
+
+    // Number of pixels processed by the whole op chain before moving to the next ones.
+    mutable std::atomic<long> m_blockSize{ 512 };
+
+    // One timing per stage i.e. the input conversion, the m_cpuOps and the output conversion.
+    std::vector<OpTiming> m_opTimings;
+    std::string           m_opsDescription; // The serialized finalized op list.
+    HalfDomainLutAccuracy m_halfDomainLutAccuracy;
+    bool                  m_opTimingEnabled = false;
 };
 
 } // namespace OCIO_NAMESPACE
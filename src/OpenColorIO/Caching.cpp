@@ -1,14 +1,28 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <atomic>
+
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Caching.h"
 #include "transforms/CDLTransform.h"
 #include "PathUtils.h"
 #include "transforms/FileTransform.h"
 
 namespace OCIO_NAMESPACE
 {
+
+namespace
+{
+std::atomic<unsigned long long> g_clearAllCachesCount{ 0 };
+}
+
+unsigned long long GetClearAllCachesCount()
+{
+    return g_clearAllCachesCount.load();
+}
+
 // TODO: Processors which the user hangs onto have local caches.
 // Should these be cleared?
 
@@ -17,5 +31,6 @@ void ClearAllCaches()
     ClearPathCaches();
     ClearFileTransformCaches();
     ClearCDLTransformFileCache();
+    ++g_clearAllCachesCount;
 }
 } // namespace OCIO_NAMESPACE
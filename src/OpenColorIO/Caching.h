@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_CACHING_H
+#define INCLUDED_OCIO_CACHING_H
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Mutex.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Number of ClearAllCaches() calls so far. Caches holding objects built from external
+// files (e.g. processors) use it to drop entries which predate the last clear.
+unsigned long long GetClearAllCachesCount();
+
+// A thread-safe and bounded cache using a least recently used eviction policy. It also
+// collects the number of hits and misses to help tuning its size.
+template<typename Key, typename Value>
+class GenericCache
+{
+public:
+    GenericCache() = delete;
+    GenericCache(const GenericCache &) = delete;
+    GenericCache & operator=(const GenericCache &) = delete;
+
+    explicit GenericCache(size_t maxNumEntries)
+        :   m_maxNumEntries(maxNumEntries)
+    {
+    }
+
+    ~GenericCache() = default;
+
+    bool isEnabled() const
+    {
+        AutoMutex guard(m_mutex);
+        return m_enabled;
+    }
+
+    // Disabling the cache also empties it.
+    void setEnabled(bool enabled)
+    {
+        AutoMutex guard(m_mutex);
+        m_enabled = enabled;
+        if (!m_enabled)
+        {
+            clearEntries();
+        }
+    }
+
+    size_t getMaxNumEntries() const
+    {
+        AutoMutex guard(m_mutex);
+        return m_maxNumEntries;
+    }
+
+    // Least recently used entries are evicted if the cache is shrunk.
+    void setMaxNumEntries(size_t maxNumEntries)
+    {
+        AutoMutex guard(m_mutex);
+        m_maxNumEntries = maxNumEntries;
+        evict();
+    }
+
+    // Return true and the cached value if the key is found. Note that a disabled cache
+    // neither finds nor counts anything.
+    bool get(const Key & key, Value & value)
+    {
+        AutoMutex guard(m_mutex);
+
+        if (!m_enabled)
+        {
+            return false;
+        }
+
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            ++m_numMisses;
+            return false;
+        }
+
+        // The entry becomes the most recently used one.
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        ++m_numHits;
+        value = it->second->second;
+        return true;
+    }
+
+    // Add or replace the value for the key.
+    void add(const Key & key, const Value & value)
+    {
+        AutoMutex guard(m_mutex);
+
+        if (!m_enabled)
+        {
+            return;
+        }
+
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            it->second->second = value;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return;
+        }
+
+        m_entries.emplace_front(key, value);
+        m_index[key] = m_entries.begin();
+
+        evict();
+    }
+
+    // Empty the cache and reset the statistics.
+    void clear()
+    {
+        AutoMutex guard(m_mutex);
+        clearEntries();
+        m_numHits   = 0;
+        m_numMisses = 0;
+    }
+
+    size_t getNumEntries() const
+    {
+        AutoMutex guard(m_mutex);
+        return m_entries.size();
+    }
+
+    size_t getNumHits() const
+    {
+        AutoMutex guard(m_mutex);
+        return m_numHits;
+    }
+
+    size_t getNumMisses() const
+    {
+        AutoMutex guard(m_mutex);
+        return m_numMisses;
+    }
+
+private:
+    typedef std::list<std::pair<Key, Value>> Entries;
+
+    void clearEntries()
+    {
+        m_index.clear();
+        m_entries.clear();
+    }
+
+    void evict()
+    {
+        while (m_entries.size() > m_maxNumEntries)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    Entries m_entries; // The most recently used entry is the first one.
+    std::unordered_map<Key, typename Entries::iterator> m_index;
+
+    size_t m_maxNumEntries = 0;
+    bool m_enabled = true;
+
+    size_t m_numHits   = 0;
+    size_t m_numMisses = 0;
+
+    mutable Mutex m_mutex;
+};
+
+} // namespace OCIO_NAMESPACE
+
+#endif
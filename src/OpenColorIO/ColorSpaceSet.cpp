@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <string>
+#include <unordered_map>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -30,6 +31,7 @@ public:
             {
                 m_colorSpaces.push_back(cs->createEditableCopy());
             }
+            m_index = rhs.m_index;
         }
         return *this;
     }
@@ -89,13 +91,10 @@ public:
     {
         if (csName && *csName)
         {
-            const std::string str = StringUtils::Lower(csName);
-            for (size_t idx = 0; idx < m_colorSpaces.size(); ++idx)
+            const auto it = m_index.find(StringUtils::Lower(csName));
+            if (it != m_index.end())
             {
-                if (StringUtils::Lower(m_colorSpaces[idx]->getName()) == str)
-                {
-                    return static_cast<int>(idx);
-                }
+                return static_cast<int>(it->second);
             }
         }
 
@@ -115,16 +114,15 @@ public:
             throw Exception("Cannot add a color space with an empty name.");
         }
 
-        for (auto & entry : m_colorSpaces)
+        const auto it = m_index.find(csName);
+        if (it != m_index.end())
         {
-            if (StringUtils::Lower(entry->getName()) == csName)
-            {
-                // The color space replaces the existing one.
-                entry = cs->createEditableCopy();
-                return;
-            }
+            // The color space replaces the existing one.
+            m_colorSpaces[it->second] = cs->createEditableCopy();
+            return;
         }
 
+        m_index[csName] = m_colorSpaces.size();
         m_colorSpaces.push_back(cs->createEditableCopy());
     }
 
@@ -141,12 +139,17 @@ public:
         const std::string name = StringUtils::Lower(csName);
         if (name.empty()) return;
 
-        for (auto itr = m_colorSpaces.begin(); itr != m_colorSpaces.end(); ++itr)
+        const auto it = m_index.find(name);
+        if (it != m_index.end())
         {
-            if (StringUtils::Lower((*itr)->getName())==name)
+            const size_t pos = it->second;
+            m_colorSpaces.erase(m_colorSpaces.begin() + pos);
+            m_index.erase(it);
+
+            // The following color spaces moved by one.
+            for (size_t idx = pos; idx < m_colorSpaces.size(); ++idx)
             {
-                m_colorSpaces.erase(itr);
-                return;
+                m_index[StringUtils::Lower(m_colorSpaces[idx]->getName())] = idx;
             }
         }
     }
@@ -162,11 +165,15 @@ public:
     void clear()
     {
         m_colorSpaces.clear();
+        m_index.clear();
     }
 
 private:
     typedef std::vector<ColorSpaceRcPtr> ColorSpaceVec;
     ColorSpaceVec m_colorSpaces;
+
+    // Position in m_colorSpaces of the lower-case color space names.
+    std::unordered_map<std::string, size_t> m_index;
 };
 
 
@@ -2,16 +2,28 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <fstream>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Caching.h"
 #include "Display.h"
 #include "FileRules.h"
 #include "HashUtils.h"
@@ -21,11 +33,15 @@
 #include "Mutex.h"
 #include "OCIOYaml.h"
 #include "OpBuilders.h"
+#include "OpSerialization.h"
+#include "ParallelUtils.h"
 #include "ParseUtils.h"
 #include "PathUtils.h"
 #include "Platform.h"
 #include "PrivateTypes.h"
 #include "Processor.h"
+#include "pystring/pystring.h"
+#include "transforms/FileTransform.h"
 #include "utils/StringUtils.h"
 #include "ViewingRules.h"
 
@@ -90,27 +106,39 @@ int GetVersionHex()
 
 namespace
 {
+// The current config is only read and swapped using the atomic shared_ptr functions so
+// the readers never block. The mutex only serializes its lazy creation.
 ConstConfigRcPtr g_currentConfig;
 Mutex g_currentConfigLock;
 }
 
 ConstConfigRcPtr GetCurrentConfig()
 {
+    ConstConfigRcPtr config = std::atomic_load(&g_currentConfig);
+    if(config)
+    {
+        return config;
+    }
+
     AutoMutex lock(g_currentConfigLock);
 
-    if(!g_currentConfig)
+    config = std::atomic_load(&g_currentConfig);
+    if(!config)
     {
-        g_currentConfig = Config::CreateFromEnv();
+        config = Config::CreateFromEnv();
+        std::atomic_store(&g_currentConfig, config);
     }
 
-    return g_currentConfig;
+    return config;
 }
 
 void SetCurrentConfig(const ConstConfigRcPtr & config)
 {
+    ConstConfigRcPtr copy = config->createEditableCopy();
+
     AutoMutex lock(g_currentConfigLock);
 
-    g_currentConfig = config->createEditableCopy();
+    std::atomic_store(&g_currentConfig, copy);
 }
 
 namespace
@@ -152,6 +180,27 @@ void GetFileReferences(std::set<std::string> & files, const ConstTransformRcPtr
     }
 }
 
+// Write the fast hashes of the files, resolved using the context.
+void WriteFileHashes(std::ostream & os, const std::set<std::string> & files,
+                     const ConstContextRcPtr & context)
+{
+    for (const auto & file : files)
+    {
+        if (file.empty()) continue;
+        os << file << "=";
+
+        try
+        {
+            const std::string resolvedLocation = context->resolveFileLocation(file.c_str());
+            os << GetFastFileHash(resolvedLocation) << " ";
+        }
+        catch(...)
+        {
+            os << "? ";
+        }
+    }
+}
+
 void GetColorSpaceReferences(std::set<std::string> & colorSpaceNames,
                              const ConstTransformRcPtr & transform,
                              const ConstContextRcPtr & context)
@@ -185,6 +234,151 @@ void GetColorSpaceReferences(std::set<std::string> & colorSpaceNames,
     }
 }
 
+// Default maximum number of processors kept by the processor cache of a config.
+constexpr size_t DEFAULT_PROCESSOR_CACHE_SIZE = 256;
+
+// Read a processor from the disk cache, return null if the file is missing or unusable.
+ConstProcessorRcPtr ReadCachedProcessor(const std::string & filepath)
+{
+    std::ifstream is(filepath, std::ios_base::in | std::ios_base::binary);
+    if (!is)
+    {
+        return ConstProcessorRcPtr();
+    }
+
+    try
+    {
+        return Processor::CreateFromStream(is);
+    }
+    catch (const Exception & e)
+    {
+        std::ostringstream oss;
+        oss << "Ignoring the cached processor '" << filepath << "': " << e.what();
+        LogDebug(oss.str());
+    }
+    return ConstProcessorRcPtr();
+}
+
+// Write a processor to the disk cache. The data goes to a temporary file which is then
+// renamed so that the concurrent readers (possibly from other processes) never see a
+// partially written file.
+void WriteCachedProcessor(const std::string & filepath, const ConstProcessorRcPtr & processor)
+{
+    static std::atomic<unsigned> counter{ 0 };
+
+    std::ostringstream tmp;
+    tmp << filepath << "."
+        << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+        << std::chrono::steady_clock::now().time_since_epoch().count() << "."
+        << counter++ << ".tmp";
+    const std::string tmpFilepath = tmp.str();
+
+    try
+    {
+        {
+            std::ofstream os(tmpFilepath, std::ios_base::out | std::ios_base::binary);
+            if (!os)
+            {
+                return;
+            }
+            processor->serialize(os);
+        }
+
+        if (0 == std::rename(tmpFilepath.c_str(), filepath.c_str()))
+        {
+            return;
+        }
+    }
+    catch (const Exception & e)
+    {
+        std::ostringstream oss;
+        oss << "Could not cache the processor '" << filepath << "': " << e.what();
+        LogDebug(oss.str());
+    }
+
+    std::remove(tmpFilepath.c_str());
+}
+
+void WriteFormatMetadata(std::ostream & os, const FormatMetadata & data)
+{
+    os << "<" << data.getName() << " " << data.getValue();
+    for (int i = 0; i < data.getNumAttributes(); ++i)
+    {
+        os << " " << data.getAttributeName(i) << "=" << data.getAttributeValue(i);
+    }
+    for (int i = 0; i < data.getNumChildrenElements(); ++i)
+    {
+        WriteFormatMetadata(os, data.getChildElement(i));
+    }
+    os << ">";
+}
+
+template<typename T>
+bool WriteTransformFormatMetadata(std::ostream & os, const ConstTransformRcPtr & transform)
+{
+    auto typedTransform = DynamicPtrCast<const T>(transform);
+    if (typedTransform)
+    {
+        WriteFormatMetadata(os, typedTransform->getFormatMetadata());
+        return true;
+    }
+    return false;
+}
+
+// Write the transform part of a processor cache key. The transform serialization holds all
+// the parameters except the format metadata (which ends up in the processor) and the LUT
+// values, so returns false for transforms which cannot be identified by their content.
+bool WriteTransformCacheKey(std::ostream & os, const ConstTransformRcPtr & transform)
+{
+    if (!transform)
+    {
+        return true;
+    }
+
+    if (DynamicPtrCast<const Lut1DTransform>(transform)
+        || DynamicPtrCast<const Lut3DTransform>(transform))
+    {
+        return false;
+    }
+
+    if (ConstGroupTransformRcPtr group = DynamicPtrCast<const GroupTransform>(transform))
+    {
+        os << "<GroupTransform direction=" << TransformDirectionToString(group->getDirection());
+        WriteFormatMetadata(os, group->getFormatMetadata());
+        for (int i = 0; i < group->getNumTransforms(); ++i)
+        {
+            if (!WriteTransformCacheKey(os, group->getTransform(i)))
+            {
+                return false;
+            }
+        }
+        os << ">";
+        return true;
+    }
+
+    os << *transform;
+
+    WriteTransformFormatMetadata<CDLTransform>(os, transform)
+        || WriteTransformFormatMetadata<ExponentTransform>(os, transform)
+        || WriteTransformFormatMetadata<ExponentWithLinearTransform>(os, transform)
+        || WriteTransformFormatMetadata<ExposureContrastTransform>(os, transform)
+        || WriteTransformFormatMetadata<FixedFunctionTransform>(os, transform)
+        || WriteTransformFormatMetadata<LogAffineTransform>(os, transform)
+        || WriteTransformFormatMetadata<LogCameraTransform>(os, transform)
+        || WriteTransformFormatMetadata<LogTransform>(os, transform)
+        || WriteTransformFormatMetadata<MatrixTransform>(os, transform)
+        || WriteTransformFormatMetadata<RangeTransform>(os, transform);
+
+    return true;
+}
+
+bool WriteColorSpaceCacheKey(std::ostream & os, const ConstColorSpaceRcPtr & cs)
+{
+    os << *cs;
+    return WriteTransformCacheKey(os, cs->getTransform(COLORSPACE_DIR_TO_REFERENCE))
+        && WriteTransformCacheKey(os, cs->getTransform(COLORSPACE_DIR_FROM_REFERENCE));
+}
+
 static constexpr char AddedDefault[]{ "added_default_rule_colorspace" };
 
 void FindAvailableName(const ColorSpaceSetRcPtr & colorspaces, std::string & csname)
@@ -241,6 +435,32 @@ std::ostringstream GetDisplayViewPrefixErrorMsg(const std::string & display, con
 
 } // namespace
 
+// Snapshot of the display & view lists. It is built on the first request and then never
+// modified, a config change only replaces it.
+struct DisplayCache
+{
+    // The active displays.
+    StringUtils::StringVec m_displays;
+    // The active views of all the displays (i.e. even the inactive ones) keyed on the
+    // lower-case display name.
+    std::map<std::string, ViewPtrVec> m_views;
+};
+
+typedef std::shared_ptr<const DisplayCache> ConstDisplayCacheRcPtr;
+
+// Snapshot of the config cache IDs. A new entry creates a new snapshot and the values are
+// shared between the successive snapshots so the returned cache IDs stay valid until the
+// next config change.
+struct CacheIDs
+{
+    // Hash of the config serialization.
+    std::string m_cacheIDNoContext;
+    // Cache IDs keyed on the context cache ID.
+    std::map<std::string, std::shared_ptr<const std::string>> m_cacheIDs;
+};
+
+typedef std::shared_ptr<const CacheIDs> ConstCacheIDsRcPtr;
+
 
 static constexpr unsigned FirstSupportedMajorVersion = 1;
 static constexpr unsigned LastSupportedMajorVersion = OCIO_VERSION_MAJOR;
@@ -272,6 +492,8 @@ public:
 
     ColorSpaceSetRcPtr m_allColorSpaces; // All the color spaces (i.e. no filtering).
     StringUtils::StringVec m_activeColorSpaceNames; // A built list of active color space names.
+    // Index in the active color space names of the lower-case names.
+    std::unordered_map<std::string, int> m_activeColorSpaceIndices;
 
     std::string m_inactiveColorSpaceNamesAPI;  // Inactive color space filter from API request. 
     std::string m_inactiveColorSpaceNamesEnv;  // Inactive color space filter from env. variable.
@@ -290,9 +512,14 @@ public:
 
     std::vector<ViewTransformRcPtr> m_viewTransforms;
 
-    mutable std::string m_activeDisplaysStr;
-    mutable std::string m_activeViewsStr;
-    mutable StringUtils::StringVec m_displayCache;
+    std::string m_activeDisplaysStr;
+    std::string m_activeViewsStr;
+
+    // The read-mostly states are immutable snapshots only accessed using the atomic
+    // shared_ptr functions so that concurrent readers never block. Refer to
+    // getDisplayCache() and Config::getCacheID().
+    mutable ConstDisplayCacheRcPtr m_displayCache;
+    mutable ConstColorSpaceNameMatcherRcPtr m_colorSpaceNameMatcher;
 
     // Misc
     std::vector<double> m_defaultLumaCoefs;
@@ -302,10 +529,15 @@ public:
     mutable std::string m_sanitytext;
 
     mutable Mutex m_cacheidMutex;
-    mutable StringMap m_cacheids;
-    mutable std::string m_cacheidnocontext;
+    mutable ConstCacheIDsRcPtr m_cacheids;
     FileRulesRcPtr m_fileRules;
 
+    // Processors built by the getProcessor() methods, keyed on a hash of the config,
+    // context and requested transform.
+    mutable GenericCache<std::string, ConstProcessorRcPtr> m_processorCache;
+    // Optional directory where the processors are also cached on disk.
+    std::string m_processorCacheDirectory;
+
     Impl() :
         m_majorVersion(FirstSupportedMajorVersion),
         m_minorVersion(0),
@@ -314,7 +546,9 @@ public:
         m_viewingRules(ViewingRules::Create()),
         m_strictParsing(true),
         m_sanity(SANITY_UNKNOWN),
-        m_fileRules(FileRules::Create())
+        m_cacheids(std::make_shared<CacheIDs>()),
+        m_fileRules(FileRules::Create()),
+        m_processorCache(DEFAULT_PROCESSOR_CACHE_SIZE)
     {
         std::string activeDisplays;
         Platform::Getenv(OCIO_ACTIVE_DISPLAYS_ENVVAR, activeDisplays);
@@ -358,6 +592,7 @@ public:
 
             m_allColorSpaces = rhs.m_allColorSpaces; // Deep copy the colorspaces
             m_activeColorSpaceNames       = rhs.m_activeColorSpaceNames;
+            m_activeColorSpaceIndices     = rhs.m_activeColorSpaceIndices;
             m_inactiveColorSpaceNamesConf = rhs.m_inactiveColorSpaceNamesConf;
             m_inactiveColorSpaceNamesEnv  = rhs.m_inactiveColorSpaceNamesEnv;
             m_inactiveColorSpaceNamesAPI  = rhs.m_inactiveColorSpaceNamesAPI;
@@ -379,7 +614,9 @@ public:
             m_activeViewsEnvOverride = rhs.m_activeViewsEnvOverride;
             m_activeDisplaysEnvOverride = rhs.m_activeDisplaysEnvOverride;
             m_activeDisplaysStr = rhs.m_activeDisplaysStr;
-            m_displayCache = rhs.m_displayCache;
+            m_activeViewsStr = rhs.m_activeViewsStr;
+            // The snapshot points to the views of rhs so it is not copied.
+            resetDisplayCache();
             m_viewingRules = rhs.m_viewingRules->createEditableCopy();
             m_sharedViews = rhs.m_sharedViews;
 
@@ -397,10 +634,18 @@ public:
             m_sanity = rhs.m_sanity;
             m_sanitytext = rhs.m_sanitytext;
 
-            m_cacheids = rhs.m_cacheids;
-            m_cacheidnocontext = rhs.m_cacheidnocontext;
+            std::atomic_store(&m_cacheids, std::atomic_load(&rhs.m_cacheids));
+            // The active color spaces are the same so the matcher could be shared.
+            std::atomic_store(&m_colorSpaceNameMatcher,
+                              std::atomic_load(&rhs.m_colorSpaceNameMatcher));
 
             m_fileRules = rhs.m_fileRules->createEditableCopy();
+
+            // The cached processors are not copied but the cache settings are.
+            m_processorCache.clear();
+            m_processorCache.setEnabled(rhs.m_processorCache.isEnabled());
+            m_processorCache.setMaxNumEntries(rhs.m_processorCache.getMaxNumEntries());
+            m_processorCacheDirectory = rhs.m_processorCacheDirectory;
         }
         return *this;
     }
@@ -489,6 +734,15 @@ public:
     // thread safe manner by acquiring the m_cacheidMutex.
     void resetCacheIDs();
 
+    // Return the cached processor for the request if any, otherwise build it (and cache it).
+    // An empty request means the processor cannot be cached. The request files are the
+    // files directly referenced by the request i.e. not through the config.
+    ConstProcessorRcPtr getProcessor(const Config & config,
+                                     const ConstContextRcPtr & context,
+                                     const std::string & request,
+                                     const std::set<std::string> & requestFiles,
+                                     const std::function<ProcessorRcPtr()> & build) const;
+
     // Get all internal transforms (to generate cacheIDs, validation, etc).
     // This currently crawls colorspaces + looks + view transforms.
     void getAllInternalTransforms(ConstTransformVec & transformVec) const;
@@ -853,16 +1107,78 @@ public:
         return filteredActiveViews;
     }
 
-    void updateDisplayCache() const
+    // Get the display & view lists snapshot, building it if needed.
+    ConstDisplayCacheRcPtr getDisplayCache() const
+    {
+        ConstDisplayCacheRcPtr cache = std::atomic_load(&m_displayCache);
+        if (cache)
+        {
+            return cache;
+        }
+
+        auto newCache = std::make_shared<DisplayCache>();
+
+        ComputeDisplays(newCache->m_displays,
+                        m_displays,
+                        m_activeDisplays,
+                        m_activeDisplaysEnvOverride);
+
+        for (const auto & display : m_displays)
+        {
+            const ViewPtrVec views = getViews(display.second);
+
+            const StringUtils::StringVec masterViews{ GetViewNames(views) };
+            const StringUtils::StringVec activeViews{ getActiveViews(masterViews) };
+
+            ViewPtrVec & activeViewPtrs = newCache->m_views[StringUtils::Lower(display.first)];
+            for (const auto & view : activeViews)
+            {
+                const int idx = FindInStringVecCaseIgnore(masterViews, view);
+                if (idx >= 0 && static_cast<size_t>(idx) < views.size())
+                {
+                    activeViewPtrs.push_back(views[idx]);
+                }
+            }
+        }
+
+        // Concurrent readers could have built it at the same time so only the first
+        // published snapshot is kept (i.e. the strings returned to the other readers
+        // stay valid).
+        cache = newCache;
+        ConstDisplayCacheRcPtr expected;
+        if (!std::atomic_compare_exchange_strong(&m_displayCache, &expected, cache))
+        {
+            cache = expected;
+        }
+
+        return cache;
+    }
+
+    // Get the matcher of the active color space names, building it if needed.
+    ConstColorSpaceNameMatcherRcPtr getColorSpaceNameMatcher(const Config & config) const
     {
-        if (m_displayCache.empty())
+        ConstColorSpaceNameMatcherRcPtr matcher = std::atomic_load(&m_colorSpaceNameMatcher);
+        if (!matcher)
         {
-            ComputeDisplays(m_displayCache,
-                            m_displays,
-                            m_activeDisplays,
-                            m_activeDisplaysEnvOverride);
+            matcher = CreateColorSpaceNameMatcher(config);
+            std::atomic_store(&m_colorSpaceNameMatcher, matcher);
         }
+        return matcher;
+    }
 
+    void resetDisplayCache()
+    {
+        std::atomic_store(&m_displayCache, ConstDisplayCacheRcPtr());
+    }
+
+    // Return the active views of the display or null if the display does not exist.
+    static const ViewPtrVec * GetActiveViews(const ConstDisplayCacheRcPtr & cache,
+                                             const char * display)
+    {
+        if (!display || !*display) return nullptr;
+
+        const auto it = cache->m_views.find(StringUtils::Lower(display));
+        return it == cache->m_views.end() ? nullptr : &it->second;
     }
 };
 
@@ -1801,15 +2117,10 @@ int Config::getIndexForColorSpace(const char * name) const
     }
 
     // Check to see if the name is an active color space.
-    for (int idx = 0; idx < getNumColorSpaces(SEARCH_REFERENCE_SPACE_ALL,
-                                              COLORSPACE_ACTIVE); ++idx)
+    const auto it = getImpl()->m_activeColorSpaceIndices.find(StringUtils::Lower(cs->getName()));
+    if (it != getImpl()->m_activeColorSpaceIndices.end())
     {
-        if (std::string(getColorSpaceNameByIndex(SEARCH_REFERENCE_SPACE_ALL,
-                                                 COLORSPACE_ACTIVE, idx))
-                == std::string(cs->getName()))
-        {
-            return idx;
-        }
+        return it->second;
     }
 
     // Requests for an inactive color space or a role mapping 
@@ -1973,11 +2284,12 @@ void Config::clearColorSpaces()
 
 const char * Config::parseColorSpaceFromString(const char * str) const
 {
-    int rightMostColorSpaceIndex = ParseColorSpaceFromString(*this, str);
+    const int rightMostColorSpaceIndex
+        = getImpl()->getColorSpaceNameMatcher(*this)->findRightMost(str);
 
     if(rightMostColorSpaceIndex>=0)
     {
-        return getImpl()->m_allColorSpaces->getColorSpaceNameByIndex(rightMostColorSpaceIndex);
+        return getColorSpaceNameByIndex(rightMostColorSpaceIndex);
     }
 
     if(!getImpl()->m_strictParsing)
@@ -2097,7 +2409,7 @@ void Config::addSharedView(const char * view, const char * viewTransform,
     ViewVec & views = getImpl()->m_sharedViews;
     AddView(views, view, viewTransform, colorSpace, looks, rule, description);
 
-    getImpl()->m_displayCache.clear();
+    getImpl()->resetDisplayCache();
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -2117,7 +2429,7 @@ void Config::removeSharedView(const char * view)
     {
         views.erase(viewIt);
 
-        getImpl()->m_displayCache.clear();
+        getImpl()->resetDisplayCache();
 
         AutoMutex lock(getImpl()->m_cacheidMutex);
         getImpl()->resetCacheIDs();
@@ -2138,18 +2450,16 @@ const char * Config::getDefaultDisplay() const
 
 int Config::getNumDisplays() const
 {
-    getImpl()->updateDisplayCache();
-
-    return static_cast<int>(getImpl()->m_displayCache.size());
+    return static_cast<int>(getImpl()->getDisplayCache()->m_displays.size());
 }
 
 const char * Config::getDisplay(int index) const
 {
-    getImpl()->updateDisplayCache();
+    ConstDisplayCacheRcPtr cache = getImpl()->getDisplayCache();
 
-    if(index>=0 && index < static_cast<int>(getImpl()->m_displayCache.size()))
+    if(index>=0 && index < static_cast<int>(cache->m_displays.size()))
     {
-        return getImpl()->m_displayCache[index].c_str();
+        return cache->m_displays[index].c_str();
     }
 
     return "";
@@ -2162,43 +2472,26 @@ const char * Config::getDefaultView(const char * display) const
 
 int Config::getNumViews(const char * display) const
 {
-    if (!display || !*display) return 0;
+    ConstDisplayCacheRcPtr cache = getImpl()->getDisplayCache();
 
-    DisplayMap::const_iterator iter = FindDisplay(getImpl()->m_displays, display);
-    if(iter == getImpl()->m_displays.end()) return 0;
-
-    const ViewPtrVec views = getImpl()->getViews(iter->second);
-
-    const StringUtils::StringVec masterViews{ GetViewNames(views) };
-    StringUtils::StringVec activeViews = getImpl()->getActiveViews(masterViews);
-    return static_cast<int>(activeViews.size());
+    // Include all displays, do not limit to active displays. Consider active views only.
+    const ViewPtrVec * activeViews = Impl::GetActiveViews(cache, display);
+    return activeViews ? static_cast<int>(activeViews->size()) : 0;
 }
 
 const char * Config::getView(const char * display, int index) const
 {
-    if (!display || !*display) return "";
+    ConstDisplayCacheRcPtr cache = getImpl()->getDisplayCache();
 
     // Include all displays, do not limit to active displays. Consider active views only.
-    DisplayMap::const_iterator iter = FindDisplay(getImpl()->m_displays, display);
-    if(iter == getImpl()->m_displays.end()) return "";
+    const ViewPtrVec * activeViews = Impl::GetActiveViews(cache, display);
 
-    const ViewPtrVec views = getImpl()->getViews(iter->second);
-
-    const StringUtils::StringVec masterViews{ GetViewNames(views) };
-    StringUtils::StringVec activeViews = getImpl()->getActiveViews(masterViews);
-
-    if (index < 0 || static_cast<size_t>(index) >= activeViews.size())
+    if (!activeViews || index < 0 || static_cast<size_t>(index) >= activeViews->size())
     {
         return "";
     }
-    int idx = FindInStringVecCaseIgnore(masterViews, activeViews[index]);
-
-    if(idx >= 0 && static_cast<size_t>(idx) < views.size())
-    {
-        return views[idx]->m_name.c_str();
-    }
 
-    return "";
+    return (*activeViews)[index]->m_name.c_str();
 }
 
 int Config::getNumViews(const char * display, const char * colorspace) const
@@ -2306,7 +2599,6 @@ void Config::addDisplaySharedView(const char * display, const char * sharedView)
                         "is needed.");
     }
 
-    bool invalidateCache = false;
     DisplayMap::iterator iter = FindDisplay(getImpl()->m_displays, display);
     if (iter == getImpl()->m_displays.end())
     {
@@ -2314,7 +2606,6 @@ void Config::addDisplaySharedView(const char * display, const char * sharedView)
         getImpl()->m_displays.resize(curSize + 1);
         getImpl()->m_displays[curSize].first = display;
         iter = std::prev(getImpl()->m_displays.end());
-        invalidateCache = true;
     }
 
     const ViewVec & existingViews = iter->second.m_views;
@@ -2336,10 +2627,10 @@ void Config::addDisplaySharedView(const char * display, const char * sharedView)
         throw Exception(os.str().c_str());
     }
     views.push_back(sharedView);
-    if (invalidateCache)
-    {
-        getImpl()->m_displayCache.clear();
-    }
+
+    // Note that the cache also holds pointers to the views which could be reallocated.
+    getImpl()->resetDisplayCache();
+
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
 }
@@ -2379,7 +2670,6 @@ void Config::addDisplayView(const char * display, const char * view, const char
         getImpl()->m_displays[curSize].second.m_views.push_back(View(view, viewTransform,
                                                                      colorSpace, looks, rule,
                                                                      description));
-        getImpl()->m_displayCache.clear();
     }
     else
     {
@@ -2395,6 +2685,9 @@ void Config::addDisplayView(const char * display, const char * view, const char
         AddView(views, view, viewTransform, colorSpace, looks, rule, description);
     }
 
+    // Note that the cache also holds pointers to the views which could be reallocated.
+    getImpl()->resetDisplayCache();
+
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
 }
@@ -2448,7 +2741,7 @@ void Config::removeDisplayView(const char * display, const char * view)
         getImpl()->m_displays.erase(iter);
     }
 
-    getImpl()->m_displayCache.clear();
+    getImpl()->resetDisplayCache();
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -2457,7 +2750,7 @@ void Config::removeDisplayView(const char * display, const char * view)
 void Config::clearDisplays()
 {
     getImpl()->m_displays.clear();
-    getImpl()->m_displayCache.clear();
+    getImpl()->resetDisplayCache();
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -2467,8 +2760,9 @@ void Config::setActiveDisplays(const char * displays)
 {
     getImpl()->m_activeDisplays.clear();
     getImpl()->m_activeDisplays = SplitStringEnvStyle(displays);
+    getImpl()->m_activeDisplaysStr = JoinStringEnvStyle(getImpl()->m_activeDisplays);
 
-    getImpl()->m_displayCache.clear();
+    getImpl()->resetDisplayCache();
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -2476,7 +2770,6 @@ void Config::setActiveDisplays(const char * displays)
 
 const char * Config::getActiveDisplays() const
 {
-    getImpl()->m_activeDisplaysStr = JoinStringEnvStyle(getImpl()->m_activeDisplays);
     return getImpl()->m_activeDisplaysStr.c_str();
 }
 
@@ -2484,8 +2777,9 @@ void Config::setActiveViews(const char * views)
 {
     getImpl()->m_activeViews.clear();
     getImpl()->m_activeViews = SplitStringEnvStyle(views);
+    getImpl()->m_activeViewsStr = JoinStringEnvStyle(getImpl()->m_activeViews);
 
-    getImpl()->m_displayCache.clear();
+    getImpl()->resetDisplayCache();
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -2493,7 +2787,6 @@ void Config::setActiveViews(const char * views)
 
 const char * Config::getActiveViews() const
 {
-    getImpl()->m_activeViewsStr = JoinStringEnvStyle(getImpl()->m_activeViews);
     return getImpl()->m_activeViewsStr.c_str();
 }
 
@@ -2745,17 +3038,35 @@ void Config::setFileRules(ConstFileRulesRcPtr fileRules)
 
 const char * Config::getColorSpaceFromFilepath(const char * filePath) const
 {
-    return getImpl()->m_fileRules->getImpl()->getColorSpaceFromFilepath(*this, filePath);
+    return getImpl()->m_fileRules->getImpl()->getColorSpaceFromFilepath(
+        *getImpl()->getColorSpaceNameMatcher(*this), filePath);
 }
 
 const char * Config::getColorSpaceFromFilepath(const char * filePath, size_t & ruleIndex) const
 {
-    return getImpl()->m_fileRules->getImpl()->getColorSpaceFromFilepath(*this, filePath, ruleIndex);
+    return getImpl()->m_fileRules->getImpl()->getColorSpaceFromFilepath(
+        *getImpl()->getColorSpaceNameMatcher(*this), filePath, ruleIndex);
 }
 
 bool Config::filepathOnlyMatchesDefaultRule(const char * filePath) const
 {
-    return getImpl()->m_fileRules->getImpl()->filepathOnlyMatchesDefaultRule(*this, filePath);
+    return getImpl()->m_fileRules->getImpl()->filepathOnlyMatchesDefaultRule(
+        *getImpl()->getColorSpaceNameMatcher(*this), filePath);
+}
+
+void Config::getColorSpacesFromFilepaths(const char * const * filePaths,
+                                         size_t numFilePaths,
+                                         const char ** colorSpaces,
+                                         size_t * ruleIndices) const
+{
+    if (numFilePaths > 0 && (!filePaths || !colorSpaces))
+    {
+        throw Exception("Config: the file path and color space arrays can't be null.");
+    }
+
+    getImpl()->m_fileRules->getImpl()->getColorSpacesFromFilepaths(
+        *getImpl()->getColorSpaceNameMatcher(*this),
+        filePaths, numFilePaths, colorSpaces, ruleIndices);
 }
 
 
@@ -2781,10 +3092,27 @@ ConstProcessorRcPtr Config::getProcessor(const ConstContextRcPtr & context,
         throw Exception("Can't get processor: destination color space is null.");
     }
 
-    ProcessorRcPtr processor = Processor::Create();
-    processor->getImpl()->setColorSpaceConversion(*this, context, src, dst);
-    processor->getImpl()->computeMetadata();
-    return processor;
+    std::ostringstream request;
+    request.precision(std::numeric_limits<double>::max_digits10);
+    request << "ColorSpaceConversion ";
+    const bool cacheable = WriteColorSpaceCacheKey(request, src)
+                           && WriteColorSpaceCacheKey(request, dst);
+
+    // The color spaces do not have to be part of the config.
+    std::set<std::string> requestFiles;
+    GetFileReferences(requestFiles, src->getTransform(COLORSPACE_DIR_TO_REFERENCE));
+    GetFileReferences(requestFiles, src->getTransform(COLORSPACE_DIR_FROM_REFERENCE));
+    GetFileReferences(requestFiles, dst->getTransform(COLORSPACE_DIR_TO_REFERENCE));
+    GetFileReferences(requestFiles, dst->getTransform(COLORSPACE_DIR_FROM_REFERENCE));
+
+    return getImpl()->getProcessor(*this, context, cacheable ? request.str() : "", requestFiles,
+                                   [this, &context, &src, &dst]()
+    {
+        ProcessorRcPtr processor = Processor::Create();
+        processor->getImpl()->setColorSpaceConversion(*this, context, src, dst);
+        processor->getImpl()->computeMetadata();
+        return processor;
+    });
 }
 
 ConstProcessorRcPtr Config::getProcessor(const char * srcName,
@@ -2854,10 +3182,140 @@ ConstProcessorRcPtr Config::getProcessor(const ConstContextRcPtr & context,
                                             const ConstTransformRcPtr& transform,
                                             TransformDirection direction) const
 {
-    ProcessorRcPtr processor = Processor::Create();
-    processor->getImpl()->setTransform(*this, context, transform, direction);
-    processor->getImpl()->computeMetadata();
-    return processor;
+    if (!transform)
+    {
+        throw Exception("Can't get processor: transform is null.");
+    }
+
+    std::ostringstream request;
+    request.precision(std::numeric_limits<double>::max_digits10);
+    request << "Transform " << TransformDirectionToString(direction) << " ";
+    const bool cacheable = WriteTransformCacheKey(request, transform);
+
+    std::set<std::string> requestFiles;
+    GetFileReferences(requestFiles, transform);
+
+    return getImpl()->getProcessor(*this, context, cacheable ? request.str() : "", requestFiles,
+                                   [this, &context, &transform, direction]()
+    {
+        ProcessorRcPtr processor = Processor::Create();
+        processor->getImpl()->setTransform(*this, context, transform, direction);
+        processor->getImpl()->computeMetadata();
+        return processor;
+    });
+}
+
+void Config::setProcessorCacheEnabled(bool enabled)
+{
+    getImpl()->m_processorCache.setEnabled(enabled);
+}
+
+bool Config::isProcessorCacheEnabled() const
+{
+    return getImpl()->m_processorCache.isEnabled();
+}
+
+void Config::setProcessorCacheSize(size_t maxNumProcessors)
+{
+    getImpl()->m_processorCache.setMaxNumEntries(maxNumProcessors);
+}
+
+size_t Config::getProcessorCacheSize() const
+{
+    return getImpl()->m_processorCache.getMaxNumEntries();
+}
+
+void Config::clearProcessorCache() const
+{
+    getImpl()->m_processorCache.clear();
+}
+
+size_t Config::getProcessorCacheNumHits() const
+{
+    return getImpl()->m_processorCache.getNumHits();
+}
+
+size_t Config::getProcessorCacheNumMisses() const
+{
+    return getImpl()->m_processorCache.getNumMisses();
+}
+
+void Config::setProcessorCacheDirectory(const char * dirname)
+{
+    getImpl()->m_processorCacheDirectory = dirname ? dirname : "";
+}
+
+const char * Config::getProcessorCacheDirectory() const
+{
+    return getImpl()->m_processorCacheDirectory.c_str();
+}
+
+std::future<void> Config::prefetchFiles(const ConstContextRcPtr & context) const
+{
+    // The copy protects the background loads from the later edits of the context.
+    ConstContextRcPtr usedContext
+        = (context ? context : getCurrentContext())->createEditableCopy();
+
+    ConstTransformVec allTransforms;
+    getImpl()->getAllInternalTransforms(allTransforms);
+
+    std::set<std::string> references;
+    for (const auto & transform : allTransforms)
+    {
+        GetFileReferences(references, transform);
+    }
+    references.erase("");
+
+    // The task only holds the file references and the context so the loads do not depend
+    // on the config lifetime. The paths are resolved in the background too as searching
+    // the directories could be slow (e.g. on network storage).
+    const std::vector<std::string> files(references.begin(), references.end());
+
+    return std::async(std::launch::async, [files, usedContext]()
+    {
+        // The missing files are skipped, they are reported when building the processors.
+        std::vector<std::string> filepaths(files.size());
+        ParallelFor(GetNumThreads(0), (long)files.size(), 1,
+                    [&files, &usedContext, &filepaths](unsigned, long begin, long end)
+        {
+            for (long idx = begin; idx < end; ++idx)
+            {
+                try
+                {
+                    filepaths[idx] = usedContext->resolveFileLocation(files[idx].c_str());
+                }
+                catch (...)
+                {
+                }
+            }
+        });
+
+        // Several references could resolve to the same file.
+        std::sort(filepaths.begin(), filepaths.end());
+        filepaths.erase(std::unique(filepaths.begin(), filepaths.end()), filepaths.end());
+        if (!filepaths.empty() && filepaths.front().empty())
+        {
+            filepaths.erase(filepaths.begin());
+        }
+
+        ParallelFor(GetNumThreads(0), (long)filepaths.size(), 1,
+                    [&filepaths](unsigned, long begin, long end)
+        {
+            for (long idx = begin; idx < end; ++idx)
+            {
+                try
+                {
+                    FileFormat * format = nullptr;
+                    CachedFileRcPtr cachedFile;
+                    GetCachedFileAndFormat(format, cachedFile, filepaths[idx]);
+                }
+                catch (...)
+                {
+                    // The failure is cached and reported when building the processors.
+                }
+            }
+        });
+    });
 }
 
 ConstProcessorRcPtr Config::GetProcessor(const ConstConfigRcPtr & srcConfig,
@@ -3011,25 +3469,28 @@ const char * Config::getCacheID() const
 
 const char * Config::getCacheID(const ConstContextRcPtr & context) const
 {
-    AutoMutex lock(getImpl()->m_cacheidMutex);
-
     // A null context will use the empty cacheid
     std::string contextcacheid;
     if(context) contextcacheid = context->getCacheID();
 
-    StringMap::const_iterator cacheiditer = getImpl()->m_cacheids.find(contextcacheid);
-    if(cacheiditer != getImpl()->m_cacheids.end())
+    // Readers never block i.e. an already computed cache ID is only a lookup in the
+    // current snapshot.
+    ConstCacheIDsRcPtr cacheids = std::atomic_load(&getImpl()->m_cacheids);
+
+    auto cacheiditer = cacheids->m_cacheIDs.find(contextcacheid);
+    if(cacheiditer != cacheids->m_cacheIDs.end())
     {
-        return cacheiditer->second.c_str();
+        return cacheiditer->second->c_str();
     }
 
     // Include the hash of the yaml config serialization
-    if(getImpl()->m_cacheidnocontext.empty())
+    std::string cacheidnocontext = cacheids->m_cacheIDNoContext;
+    if(cacheidnocontext.empty())
     {
         std::ostringstream cacheid;
         serialize(cacheid);
         const std::string fullstr = cacheid.str();
-        getImpl()->m_cacheidnocontext = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+        cacheidnocontext = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
     }
 
     // Also include all file references, using the context (if specified)
@@ -3047,30 +3508,35 @@ const char * Config::getCacheID(const ConstContextRcPtr & context) const
             GetFileReferences(files, allTransforms[i]);
         }
 
-        for(std::set<std::string>::iterator iter = files.begin();
-            iter != files.end(); ++iter)
-        {
-            if(iter->empty()) continue;
-            filehash << *iter << "=";
-
-            try
-            {
-                const std::string resolvedLocation = context->resolveFileLocation(iter->c_str());
-                filehash << GetFastFileHash(resolvedLocation) << " ";
-            }
-            catch(...)
-            {
-                filehash << "? ";
-                continue;
-            }
-        }
+        WriteFileHashes(filehash, files, context);
 
         const std::string fullstr = filehash.str();
         fileReferencesFashHash = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
     }
 
-    getImpl()->m_cacheids[contextcacheid] = getImpl()->m_cacheidnocontext + ":" + fileReferencesFashHash;
-    return getImpl()->m_cacheids[contextcacheid].c_str();
+    auto newcacheid
+        = std::make_shared<const std::string>(cacheidnocontext + ":" + fileReferencesFashHash);
+
+    // Publish a new snapshot with the new entry. If another thread published a snapshot
+    // in the meantime, retry with it unless it already has the entry.
+    while(true)
+    {
+        auto newcacheids = std::make_shared<CacheIDs>(*cacheids);
+        newcacheids->m_cacheIDNoContext = cacheidnocontext;
+        newcacheids->m_cacheIDs[contextcacheid] = newcacheid;
+
+        ConstCacheIDsRcPtr published = newcacheids;
+        if(std::atomic_compare_exchange_strong(&getImpl()->m_cacheids, &cacheids, published))
+        {
+            return newcacheid->c_str();
+        }
+
+        cacheiditer = cacheids->m_cacheIDs.find(contextcacheid);
+        if(cacheiditer != cacheids->m_cacheIDs.end())
+        {
+            return cacheiditer->second->c_str();
+        }
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -3150,14 +3616,112 @@ void Config::Impl::refreshActiveColorSpaces()
             m_activeColorSpaceNames.push_back(cs->getName());
         }
     }
+
+    m_activeColorSpaceIndices.clear();
+    for (size_t i = 0; i < m_activeColorSpaceNames.size(); ++i)
+    {
+        m_activeColorSpaceIndices[StringUtils::Lower(m_activeColorSpaceNames[i])] = (int)i;
+    }
+
+    std::atomic_store(&m_colorSpaceNameMatcher, ConstColorSpaceNameMatcherRcPtr());
 }
 
 void Config::Impl::resetCacheIDs()
 {
-    m_cacheids.clear();
-    m_cacheidnocontext = "";
+    std::atomic_store(&m_cacheids, ConstCacheIDsRcPtr(std::make_shared<CacheIDs>()));
+    std::atomic_store(&m_colorSpaceNameMatcher, ConstColorSpaceNameMatcherRcPtr());
     m_sanity = SANITY_UNKNOWN;
     m_sanitytext = "";
+
+    // The config cache ID is part of the processor cache keys so all the cached
+    // processors are now unreachable.
+    m_processorCache.clear();
+}
+
+ConstProcessorRcPtr Config::Impl::getProcessor(const Config & config,
+                                               const ConstContextRcPtr & context,
+                                               const std::string & request,
+                                               const std::set<std::string> & requestFiles,
+                                               const std::function<ProcessorRcPtr()> & build) const
+{
+    const bool useMemoryCache = m_processorCache.isEnabled();
+    const bool useDiskCache   = !m_processorCacheDirectory.empty();
+
+    if (request.empty() || (!useMemoryCache && !useDiskCache))
+    {
+        return build();
+    }
+
+    // Note: The config cache ID without context (i.e. a hash of the serialization) is enough
+    // as the file references are resolved using the context which is part of the key. The
+    // ClearAllCaches() count makes processors built from since-edited files unreachable.
+    std::string key;
+    if (useMemoryCache)
+    {
+        std::ostringstream oss;
+        oss << GetClearAllCachesCount()
+            << " " << config.getCacheID(ConstContextRcPtr())
+            << " " << (context ? context->getCacheID() : "")
+            << " " << request;
+        const std::string fullstr = oss.str();
+        key = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+
+        ConstProcessorRcPtr processor;
+        if (m_processorCache.get(key, processor))
+        {
+            return processor;
+        }
+    }
+
+    // The disk cache outlives the process so its key relies on the config cache ID with
+    // the context, which includes the hashes of the files referenced by the config, on the
+    // hashes of the files only referenced by the request, and on the format version of the
+    // binary serialization.
+    std::string filepath;
+    if (useDiskCache)
+    {
+        const ConstContextRcPtr resolveContext = context ? context : config.getCurrentContext();
+
+        std::ostringstream oss;
+        oss << BINARY_OPS_VERSION
+            << " " << GetVersion()
+            << " " << config.getCacheID(resolveContext)
+            << " " << (context ? context->getCacheID() : "")
+            << " " << request << " ";
+        WriteFileHashes(oss, requestFiles, resolveContext);
+        const std::string fullstr = oss.str();
+        // Skip the leading '$' of the printable hash.
+        const std::string diskKey = CacheIDHash(fullstr.c_str(), (int)fullstr.size()).substr(1);
+        filepath = pystring::os::path::join(m_processorCacheDirectory, diskKey + ".ocioproc");
+
+        ConstProcessorRcPtr processor = ReadCachedProcessor(filepath);
+        if (processor)
+        {
+            if (useMemoryCache)
+            {
+                m_processorCache.add(key, processor);
+            }
+            return processor;
+        }
+    }
+
+    ProcessorRcPtr newProcessor = build();
+
+    // Dynamic properties are shared by all the users of a processor so a processor with
+    // dynamic properties must stay private to its caller.
+    if (!newProcessor->getImpl()->isDynamic())
+    {
+        if (useMemoryCache)
+        {
+            m_processorCache.add(key, newProcessor);
+        }
+        if (useDiskCache)
+        {
+            WriteCachedProcessor(filepath, newProcessor);
+        }
+    }
+
+    return newProcessor;
 }
 
 void Config::Impl::getAllInternalTransforms(ConstTransformVec & transformVec) const
@@ -4,8 +4,10 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -26,8 +28,40 @@ void GetAbsoluteSearchPaths(StringUtils::StringVec & searchpaths,
                             const StringUtils::StringVec & pathStrings,
                             const std::string & configRootDir,
                             const EnvMap & map);
+
+// The default file systems of Windows and macOS are case-insensitive so the directory
+// indexes hold the lower-case entry names there.
+#if defined(_WIN32) || defined(__APPLE__)
+constexpr bool CASE_INSENSITIVE_INDEX = true;
+#else
+constexpr bool CASE_INSENSITIVE_INDEX = false;
+#endif
+
+inline std::string GetIndexName(const std::string & name)
+{
+    return CASE_INSENSITIVE_INDEX ? StringUtils::Lower(name) : name;
+}
 }
 
+// What the file resolution needs from the context, so that the file system is accessed
+// without holding the context mutex.
+struct ResolveState
+{
+    EnvMap m_envMap;
+    StringUtils::StringVec m_searchPaths; // Refer to GetAbsoluteSearchPaths().
+};
+
+typedef std::shared_ptr<const ResolveState> ConstResolveStateRcPtr;
+
+// Entry names of a search path directory (refer to GetIndexName()).
+struct DirectoryIndex
+{
+    std::string m_stamp; // Refer to GetDirectoryStamp().
+    std::unordered_set<std::string> m_names;
+};
+
+typedef std::shared_ptr<const DirectoryIndex> ConstDirectoryIndexRcPtr;
+
 class Context::Impl
 {
 public:
@@ -40,10 +74,20 @@ public:
     EnvironmentMode m_envmode;
     EnvMap m_envMap;
 
-    mutable std::string m_cacheID;
+    // Only accessed using the atomic shared_ptr functions so that reading the cache ID
+    // does not lock the mutex. Null means it needs to be recomputed.
+    mutable std::shared_ptr<const std::string> m_cacheID;
     mutable StringMap m_resultsCache;
     mutable Mutex m_resultsCacheMutex;
 
+    // Null means it needs to be recomputed. Protected by m_resultsCacheMutex.
+    mutable ConstResolveStateRcPtr m_resolveState;
+
+    // The search path directories are listed once and listed again only when their stamps
+    // change. The mutex is never held while accessing the file system.
+    mutable std::map<std::string, ConstDirectoryIndexRcPtr> m_directoryIndexes;
+    mutable Mutex m_directoryIndexesMutex;
+
     Impl() :
         m_envmode(ENV_ENVIRONMENT_LOAD_PREDEFINED)
     {
@@ -54,6 +98,38 @@ public:
 
     }
 
+    void resetCacheID()
+    {
+        std::atomic_store(&m_cacheID, std::shared_ptr<const std::string>());
+    }
+
+    // Note that m_resultsCacheMutex must be locked.
+    void resetResults()
+    {
+        m_resultsCache.clear();
+        m_resolveState.reset();
+        resetCacheID();
+    }
+
+    // Note that m_resultsCacheMutex must be locked.
+    ConstResolveStateRcPtr getResolveState() const
+    {
+        if (!m_resolveState)
+        {
+            auto state = std::make_shared<ResolveState>();
+            state->m_envMap = m_envMap;
+            GetAbsoluteSearchPaths(state->m_searchPaths, m_searchPaths, m_workingDir, m_envMap);
+            m_resolveState = state;
+        }
+        return m_resolveState;
+    }
+
+    // Return null if the directory can't be listed.
+    ConstDirectoryIndexRcPtr getDirectoryIndex(const std::string & dirname) const;
+
+    // Throw if the file is not found.
+    std::string findFile(const std::string & filename, const ResolveState & state) const;
+
     Impl& operator= (const Impl & rhs)
     {
         if(this!=&rhs)
@@ -67,7 +143,8 @@ public:
             m_envMap = rhs.m_envMap;
 
             m_resultsCache = rhs.m_resultsCache;
-            m_cacheID = rhs.m_cacheID;
+            m_resolveState = rhs.m_resolveState;
+            std::atomic_store(&m_cacheID, std::atomic_load(&rhs.m_cacheID));
         }
         return *this;
     }
@@ -107,9 +184,16 @@ ContextRcPtr Context::createEditableCopy() const
 
 const char * Context::getCacheID() const
 {
+    std::shared_ptr<const std::string> cacheID = std::atomic_load(&getImpl()->m_cacheID);
+    if(cacheID)
+    {
+        return cacheID->c_str();
+    }
+
     AutoMutex lock(getImpl()->m_resultsCacheMutex);
 
-    if(getImpl()->m_cacheID.empty())
+    cacheID = std::atomic_load(&getImpl()->m_cacheID);
+    if(!cacheID)
     {
         std::ostringstream cacheid;
         if (!getImpl()->m_searchPaths.empty())
@@ -131,10 +215,12 @@ const char * Context::getCacheID() const
         }
 
         std::string fullstr = cacheid.str();
-        getImpl()->m_cacheID = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+        cacheID = std::make_shared<const std::string>(CacheIDHash(fullstr.c_str(),
+                                                                  (int)fullstr.size()));
+        std::atomic_store(&getImpl()->m_cacheID, cacheID);
     }
 
-    return getImpl()->m_cacheID.c_str();
+    return cacheID->c_str();
 }
 
 void Context::setSearchPath(const char * path)
@@ -143,8 +229,7 @@ void Context::setSearchPath(const char * path)
 
     getImpl()->m_searchPaths = StringUtils::Split(path, ':');
     getImpl()->m_searchPath  = path;
-    getImpl()->m_resultsCache.clear();
-    getImpl()->m_cacheID = "";
+    getImpl()->resetResults();
 }
 
 const char * Context::getSearchPath() const
@@ -169,8 +254,7 @@ void Context::clearSearchPaths()
 
     getImpl()->m_searchPath = "";
     getImpl()->m_searchPaths.clear();
-    getImpl()->m_resultsCache.clear();
-    getImpl()->m_cacheID = "";
+    getImpl()->resetResults();
 }
 
 void Context::addSearchPath(const char * path)
@@ -180,8 +264,7 @@ void Context::addSearchPath(const char * path)
     if (strlen(path) != 0)
     {
         getImpl()->m_searchPaths.emplace_back(path);
-        getImpl()->m_resultsCache.clear();
-        getImpl()->m_cacheID = "";
+        getImpl()->resetResults();
 
         if (getImpl()->m_searchPath.size() != 0)
         {
@@ -196,8 +279,7 @@ void Context::setWorkingDir(const char * dirname)
     AutoMutex lock(getImpl()->m_resultsCacheMutex);
 
     getImpl()->m_workingDir = dirname;
-    getImpl()->m_resultsCache.clear();
-    getImpl()->m_cacheID = "";
+    getImpl()->resetResults();
 }
 
 const char * Context::getWorkingDir() const
@@ -211,8 +293,7 @@ void Context::setEnvironmentMode(EnvironmentMode mode)
 
     getImpl()->m_envmode = mode;
 
-    getImpl()->m_resultsCache.clear();
-    getImpl()->m_cacheID = "";
+    getImpl()->resetResults();
 }
 
 EnvironmentMode Context::getEnvironmentMode() const
@@ -226,8 +307,7 @@ void Context::loadEnvironment()
     LoadEnvironment(getImpl()->m_envMap, update);
 
     AutoMutex lock(getImpl()->m_resultsCacheMutex);
-    getImpl()->m_resultsCache.clear();
-    getImpl()->m_cacheID = "";
+    getImpl()->resetResults();
 }
 
 void Context::setStringVar(const char * name, const char * value)
@@ -251,8 +331,7 @@ void Context::setStringVar(const char * name, const char * value)
         }
     }
 
-    getImpl()->m_resultsCache.clear();
-    getImpl()->m_cacheID = "";
+    getImpl()->resetResults();
 }
 
 const char * Context::getStringVar(const char * name) const
@@ -286,7 +365,10 @@ const char * Context::getStringVarNameByIndex(int index) const
 
 void Context::clearStringVars()
 {
+    AutoMutex lock(getImpl()->m_resultsCacheMutex);
+
     getImpl()->m_envMap.clear();
+    getImpl()->resetResults();
 }
 
 const char * Context::resolveStringVar(const char * val) const
@@ -312,60 +394,152 @@ const char * Context::resolveStringVar(const char * val) const
 
 const char * Context::resolveFileLocation(const char * filename) const
 {
-    AutoMutex lock(getImpl()->m_resultsCacheMutex);
-
     if(!filename || !*filename)
     {
         return "";
     }
 
-    StringMap::const_iterator iter = getImpl()->m_resultsCache.find(filename);
-    if(iter != getImpl()->m_resultsCache.end())
+    while (true)
     {
-        return iter->second.c_str();
+        ConstResolveStateRcPtr state;
+        {
+            AutoMutex lock(getImpl()->m_resultsCacheMutex);
+
+            StringMap::const_iterator iter = getImpl()->m_resultsCache.find(filename);
+            if(iter != getImpl()->m_resultsCache.end())
+            {
+                return iter->second.c_str();
+            }
+
+            state = getImpl()->getResolveState();
+        }
+
+        // The file system is accessed without holding the mutex, so other threads are
+        // not blocked by slow (e.g. network) file systems.
+        const std::string fullpath = getImpl()->findFile(filename, *state);
+
+        AutoMutex lock(getImpl()->m_resultsCacheMutex);
+
+        // Only keep the result if the context did not change meanwhile, otherwise resolve
+        // the file again.
+        if (getImpl()->m_resolveState == state)
+        {
+            const auto result = getImpl()->m_resultsCache.emplace(filename, fullpath);
+            return result.first->second.c_str();
+        }
     }
+}
 
-    // Attempt to load an absolute file reference
+ConstDirectoryIndexRcPtr Context::Impl::getDirectoryIndex(const std::string & dirname) const
+{
+    // Read the stamp before listing the directory so that a change happening during the
+    // listing invalidates it.
+    const std::string stamp = GetDirectoryStamp(dirname);
+    if (stamp.empty())
     {
-    std::string expandedfullpath = EnvExpand(filename, getImpl()->m_envMap);
-    if(pystring::os::path::isabs(expandedfullpath))
+        return ConstDirectoryIndexRcPtr();
+    }
+
     {
-        if(FileExists(expandedfullpath))
+        AutoMutex lock(m_directoryIndexesMutex);
+
+        const auto iter = m_directoryIndexes.find(dirname);
+        if (iter != m_directoryIndexes.end() && iter->second->m_stamp == stamp)
+        {
+            return iter->second;
+        }
+    }
+
+    auto index = std::make_shared<DirectoryIndex>();
+    index->m_stamp = stamp;
+    if (!GetDirectoryEntries(dirname, index->m_names))
+    {
+        return ConstDirectoryIndexRcPtr();
+    }
+
+    if (CASE_INSENSITIVE_INDEX)
+    {
+        std::unordered_set<std::string> names;
+        for (const auto & name : index->m_names)
         {
-            getImpl()->m_resultsCache[filename] = pystring::os::path::normpath(expandedfullpath);
-            return getImpl()->m_resultsCache[filename].c_str();
+            names.insert(GetIndexName(name));
+        }
+        index->m_names.swap(names);
+    }
+
+    AutoMutex lock(m_directoryIndexesMutex);
+    m_directoryIndexes[dirname] = index;
+    return index;
+}
+
+std::string Context::Impl::findFile(const std::string & filename, const ResolveState & state) const
+{
+    // Attempt to load an absolute file reference
+    const std::string expandedfilename = EnvExpand(filename, state.m_envMap);
+    if(pystring::os::path::isabs(expandedfilename))
+    {
+        if(FileExists(expandedfilename))
+        {
+            return pystring::os::path::normpath(expandedfilename);
         }
         std::ostringstream errortext;
         errortext << "The specified absolute file reference ";
-        errortext << "'" << expandedfullpath << "' could not be located.";
+        errortext << "'" << expandedfilename << "' could not be located.";
         throw Exception(errortext.str().c_str());
     }
-    }
 
     // Load a relative file reference
-    // Prep the search path vector
-    // TODO: Cache this prepped vector?
-    StringUtils::StringVec searchpaths;
-    GetAbsoluteSearchPaths(searchpaths,
-                           getImpl()->m_searchPaths,
-                           getImpl()->m_workingDir,
-                           getImpl()->m_envMap);
-
-    // Loop over each path, and try to find the file
+
+    // Look for the first component of the file reference in the search path directory
+    // listings. A search path directory that can't be listed is checked as before.
+#ifdef _WIN32
+    const size_t pos = expandedfilename.find_first_of("/\\");
+#else
+    const size_t pos = expandedfilename.find_first_of('/');
+#endif
+    const std::string name = expandedfilename.substr(0, pos);
+    const std::string indexName = GetIndexName(name);
+    if (!name.empty() && name != "." && name != "..")
+    {
+        for (const auto & searchpath : state.m_searchPaths)
+        {
+            const std::string fullpath = pystring::os::path::join(searchpath, expandedfilename);
+
+            ConstDirectoryIndexRcPtr index = getDirectoryIndex(searchpath);
+            if (index)
+            {
+                // Like the file system, the case-insensitive index could match a file name
+                // differing in case, so the search path order is preserved. The file check
+                // then confirms the match as the volume could still be case-sensitive.
+                if (index->m_names.count(indexName) != 0
+                    && ((pos == std::string::npos && !CASE_INSENSITIVE_INDEX)
+                        || FileExists(fullpath)))
+                {
+                    return pystring::os::path::normpath(fullpath);
+                }
+            }
+            else if (FileExists(fullpath))
+            {
+                return pystring::os::path::normpath(fullpath);
+            }
+        }
+    }
+
+    // Loop over each path, and try to find the file. That also covers the file systems
+    // whose case sensitivity differs from the platform default.
     std::ostringstream errortext;
     errortext << "The specified file reference ";
     errortext << "'" << filename << "' could not be located. ";
     errortext << "The following attempts were made: ";
 
-    for (unsigned int i = 0; i < searchpaths.size(); ++i)
+    for (unsigned int i = 0; i < state.m_searchPaths.size(); ++i)
     {
         // Make an attempt to find the LUT in one of the search paths
-        std::string fullpath = pystring::os::path::join(searchpaths[i], filename);
-        std::string expandedfullpath = EnvExpand(fullpath, getImpl()->m_envMap);
+        std::string fullpath = pystring::os::path::join(state.m_searchPaths[i], filename);
+        std::string expandedfullpath = EnvExpand(fullpath, state.m_envMap);
         if(FileExists(expandedfullpath))
         {
-            getImpl()->m_resultsCache[filename] = pystring::os::path::normpath(expandedfullpath);
-            return getImpl()->m_resultsCache[filename].c_str();
+            return pystring::os::path::normpath(expandedfullpath);
         }
         if(i!=0) errortext << " : ";
         errortext << "'" << expandedfullpath << "'";
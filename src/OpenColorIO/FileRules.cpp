@@ -2,8 +2,12 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <bitset>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <regex>
 #include <sstream>
 
@@ -264,6 +268,449 @@ void ValidateRegularExpression(const char * filePathPattern, const char * fileNa
     ValidateRegularExpression(exp.c_str());
 }
 
+} // anon.
+
+// Automaton matching a file path against several regular expressions in a single pass.
+// Only the simple expressions are supported i.e. the ones only made of literals, '.',
+// bracket expressions and the '*', '+' & '?' quantifiers, which covers all the
+// expressions built from the glob patterns (see BuildRegularExpression()). The
+// expressions are first turned into a NFA (one position per character to match) which is
+// then converted into a DFA, unless the DFA becomes too large in which case the NFA is
+// directly simulated.
+class PathAutomaton
+{
+public:
+    PathAutomaton() = default;
+    PathAutomaton(const PathAutomaton &) = delete;
+    PathAutomaton & operator=(const PathAutomaton &) = delete;
+
+    // Add the expression of a rule, rules must be added in increasing index order.
+    // Returns false if the expression is not supported.
+    bool add(const std::string & expression, int ruleIndex);
+
+    // Build the DFA once all the expressions are added.
+    void finalize();
+
+    bool empty() const noexcept { return m_positions.empty(); }
+
+    // Returns the lowest index of the rules whose expression matches the whole path, or -1.
+    int match(const char * path) const;
+
+private:
+    typedef std::bitset<256> CharSet;
+    typedef std::vector<uint64_t> StateSet;
+
+    enum PositionType
+    {
+        POSITION_ONE = 0, // Exactly one character of the set.
+        POSITION_OPTIONAL, // Zero or one character of the set.
+        POSITION_STAR,     // Any number of characters of the set.
+        POSITION_ACCEPT    // End of the expression of m_ruleIndex.
+    };
+
+    struct Position
+    {
+        CharSet m_chars;
+        PositionType m_type = POSITION_ONE;
+        int m_ruleIndex = -1;
+    };
+
+    static bool ParseExpression(const std::string & exp, std::vector<Position> & positions);
+    static bool ParseBracket(const std::string & exp, size_t & idx, CharSet & chars);
+    static bool ParseBracketChar(const std::string & exp, size_t & idx, unsigned char & c);
+
+    void closure(StateSet & states) const;
+    void step(const StateSet & states, unsigned char c, StateSet & next) const;
+    int acceptedRule(const StateSet & states) const;
+
+    std::vector<Position> m_positions;
+    StateSet m_start;
+
+    bool m_useDfa = false;
+    unsigned char m_charClasses[256];
+    size_t m_numCharClasses = 0;
+    // The DFA state 0 is the dead state and the state 1 the start state.
+    std::vector<int> m_transitions;
+    std::vector<int> m_acceptedRules;
+};
+
+namespace
+{
+// Above that, the NFA is simulated instead.
+constexpr size_t MaxDfaStates = 4096;
+
+std::bitset<256> AnyChar()
+{
+    // The ECMAScript '.' matches all the characters except the line terminators.
+    std::bitset<256> chars;
+    chars.set();
+    chars.reset('\n');
+    chars.reset('\r');
+    return chars;
+}
+} // anon.
+
+bool PathAutomaton::ParseBracketChar(const std::string & exp, size_t & idx, unsigned char & c)
+{
+    if (exp[idx] == '[')
+    {
+        // Could be a character class like '[:alpha:]'.
+        return false;
+    }
+    if (exp[idx] == '\\')
+    {
+        // Escaped letters & digits are character classes or control characters.
+        if (idx + 1 >= exp.size() || isalnum((unsigned char)exp[idx + 1]))
+        {
+            return false;
+        }
+        ++idx;
+    }
+    c = (unsigned char)exp[idx];
+    ++idx;
+    return true;
+}
+
+bool PathAutomaton::ParseBracket(const std::string & exp, size_t & idx, CharSet & chars)
+{
+    const size_t size = exp.size();
+
+    size_t i = idx + 1; // Bypass the '['.
+    bool negate = false;
+    if (i < size && exp[i] == '^')
+    {
+        negate = true;
+        ++i;
+    }
+    if (i >= size || exp[i] == ']')
+    {
+        return false;
+    }
+
+    while (i < size && exp[i] != ']')
+    {
+        unsigned char first = 0;
+        if (!ParseBracketChar(exp, i, first))
+        {
+            return false;
+        }
+
+        if (i + 1 < size && exp[i] == '-' && exp[i + 1] != ']')
+        {
+            ++i;
+            unsigned char last = 0;
+            if (!ParseBracketChar(exp, i, last) || last < first || last >= 0x80)
+            {
+                return false;
+            }
+            for (unsigned c = first; c <= last; ++c)
+            {
+                chars.set(c);
+            }
+        }
+        else
+        {
+            chars.set(first);
+        }
+    }
+
+    if (i >= size)
+    {
+        return false;
+    }
+
+    if (negate)
+    {
+        chars.flip();
+    }
+
+    idx = i; // The ']'.
+    return true;
+}
+
+bool PathAutomaton::ParseExpression(const std::string & exp, std::vector<Position> & positions)
+{
+    const size_t size = exp.size();
+    size_t idx = 0;
+    int groupDepth = 0;
+
+    if (idx < size && exp[idx] == '^')
+    {
+        ++idx;
+    }
+
+    while (idx < size)
+    {
+        const char c = exp[idx];
+
+        // Groups without alternatives and quantifiers do not change what is matched.
+        if (c == '(')
+        {
+            if (idx + 1 < size && exp[idx + 1] == '?')
+            {
+                return false;
+            }
+            ++groupDepth;
+            ++idx;
+            continue;
+        }
+        if (c == ')')
+        {
+            ++idx;
+            if (--groupDepth < 0 || (idx < size && strchr("*+?{", exp[idx])))
+            {
+                return false;
+            }
+            continue;
+        }
+        if (c == '$' && idx + 1 == size)
+        {
+            break;
+        }
+
+        Position pos;
+        if (c == '.')
+        {
+            pos.m_chars = AnyChar();
+        }
+        else if (c == '[')
+        {
+            if (!ParseBracket(exp, idx, pos.m_chars))
+            {
+                return false;
+            }
+        }
+        else if (c == '\\')
+        {
+            // Escaped letters & digits are character classes, assertions or back references.
+            if (idx + 1 >= size || isalnum((unsigned char)exp[idx + 1]))
+            {
+                return false;
+            }
+            ++idx;
+            pos.m_chars.set((unsigned char)exp[idx]);
+        }
+        else if (strchr("|^$*+?{}]", c))
+        {
+            return false;
+        }
+        else
+        {
+            pos.m_chars.set((unsigned char)c);
+        }
+        ++idx;
+
+        if (idx < size && strchr("*+?", exp[idx]))
+        {
+            if (exp[idx] == '*')
+            {
+                pos.m_type = POSITION_STAR;
+            }
+            else if (exp[idx] == '?')
+            {
+                pos.m_type = POSITION_OPTIONAL;
+            }
+            else
+            {
+                // 'x+' is 'xx*'.
+                positions.push_back(pos);
+                pos.m_type = POSITION_STAR;
+            }
+            ++idx;
+
+            // Reject the lazy quantifiers & the invalid repetitions.
+            if (idx < size && strchr("*+?{", exp[idx]))
+            {
+                return false;
+            }
+        }
+        else if (idx < size && exp[idx] == '{')
+        {
+            return false;
+        }
+
+        positions.push_back(pos);
+    }
+
+    return groupDepth == 0;
+}
+
+bool PathAutomaton::add(const std::string & expression, int ruleIndex)
+{
+    std::vector<Position> positions;
+    if (!ParseExpression(expression, positions))
+    {
+        return false;
+    }
+
+    Position accept;
+    accept.m_type = POSITION_ACCEPT;
+    accept.m_ruleIndex = ruleIndex;
+    positions.push_back(accept);
+
+    m_positions.insert(m_positions.end(), positions.begin(), positions.end());
+    m_start.resize((m_positions.size() + 63) / 64, 0);
+
+    // The expression starts at its first position.
+    const size_t first = m_positions.size() - positions.size();
+    m_start[first / 64] |= uint64_t(1) << (first % 64);
+
+    return true;
+}
+
+void PathAutomaton::closure(StateSet & states) const
+{
+    // The optional positions could be skipped so the next ones are also active. As the
+    // skip only goes forward, one pass in the increasing order is enough.
+    const size_t numPositions = m_positions.size();
+    for (size_t p = 0; p + 1 < numPositions; ++p)
+    {
+        if ((states[p / 64] >> (p % 64)) & 1)
+        {
+            const PositionType type = m_positions[p].m_type;
+            if (type == POSITION_OPTIONAL || type == POSITION_STAR)
+            {
+                states[(p + 1) / 64] |= uint64_t(1) << ((p + 1) % 64);
+            }
+        }
+    }
+}
+
+void PathAutomaton::step(const StateSet & states, unsigned char c, StateSet & next) const
+{
+    std::fill(next.begin(), next.end(), 0);
+
+    const size_t numPositions = m_positions.size();
+    for (size_t p = 0; p < numPositions; ++p)
+    {
+        const Position & pos = m_positions[p];
+        if (((states[p / 64] >> (p % 64)) & 1) && pos.m_type != POSITION_ACCEPT && pos.m_chars[c])
+        {
+            const size_t n = (pos.m_type == POSITION_STAR) ? p : p + 1;
+            next[n / 64] |= uint64_t(1) << (n % 64);
+        }
+    }
+
+    closure(next);
+}
+
+int PathAutomaton::acceptedRule(const StateSet & states) const
+{
+    // The rules are added in increasing index order so the first accepting position
+    // is the one of the lowest rule index.
+    const size_t numPositions = m_positions.size();
+    for (size_t p = 0; p < numPositions; ++p)
+    {
+        if (((states[p / 64] >> (p % 64)) & 1) && m_positions[p].m_type == POSITION_ACCEPT)
+        {
+            return m_positions[p].m_ruleIndex;
+        }
+    }
+    return -1;
+}
+
+void PathAutomaton::finalize()
+{
+    if (m_positions.empty())
+    {
+        return;
+    }
+
+    closure(m_start);
+
+    // Group the characters which all the positions handle the same way to reduce the
+    // size of the transition table.
+    std::map<std::vector<bool>, unsigned char> signatures;
+    for (unsigned c = 0; c < 256; ++c)
+    {
+        std::vector<bool> signature(m_positions.size());
+        for (size_t p = 0; p < m_positions.size(); ++p)
+        {
+            signature[p] = m_positions[p].m_chars[c];
+        }
+        auto it = signatures.insert(std::make_pair(signature, (unsigned char)signatures.size()));
+        m_charClasses[c] = it.first->second;
+    }
+    m_numCharClasses = signatures.size();
+
+    unsigned char representatives[256];
+    for (int c = 255; c >= 0; --c)
+    {
+        representatives[m_charClasses[c]] = (unsigned char)c;
+    }
+
+    // Subset construction.
+    std::map<StateSet, int> dfaStates;
+    std::vector<StateSet> pending;
+
+    // The start state is never the dead state as it holds the first position of the
+    // expressions.
+    dfaStates[StateSet(m_start.size(), 0)] = 0;
+    dfaStates[m_start] = 1;
+    m_acceptedRules.push_back(-1);
+    m_acceptedRules.push_back(acceptedRule(m_start));
+    m_transitions.resize(2 * m_numCharClasses, 0);
+    pending.push_back(m_start);
+
+    StateSet next(m_start.size(), 0);
+    while (!pending.empty())
+    {
+        const StateSet states = pending.back();
+        pending.pop_back();
+        const int from = dfaStates[states];
+
+        for (size_t cls = 0; cls < m_numCharClasses; ++cls)
+        {
+            step(states, representatives[cls], next);
+
+            auto it = dfaStates.find(next);
+            if (it == dfaStates.end())
+            {
+                if (dfaStates.size() >= MaxDfaStates)
+                {
+                    m_transitions.clear();
+                    m_acceptedRules.clear();
+                    return;
+                }
+
+                it = dfaStates.insert(std::make_pair(next, (int)dfaStates.size())).first;
+                m_acceptedRules.push_back(acceptedRule(next));
+                m_transitions.resize(dfaStates.size() * m_numCharClasses, 0);
+                pending.push_back(next);
+            }
+
+            m_transitions[from * m_numCharClasses + cls] = it->second;
+        }
+    }
+
+    m_useDfa = true;
+}
+
+int PathAutomaton::match(const char * path) const
+{
+    if (m_positions.empty())
+    {
+        return -1;
+    }
+
+    if (m_useDfa)
+    {
+        int state = 1;
+        for (const unsigned char * c = (const unsigned char *)path; *c && state; ++c)
+        {
+            state = m_transitions[state * m_numCharClasses + m_charClasses[*c]];
+        }
+        return m_acceptedRules[state];
+    }
+
+    StateSet states = m_start;
+    StateSet next(states.size(), 0);
+    for (const unsigned char * c = (const unsigned char *)path; *c; ++c)
+    {
+        step(states, *c, next);
+        states.swap(next);
+    }
+    return acceptedRule(states);
 }
 
 class FileRule
@@ -425,36 +872,19 @@ public:
         }
     }
 
-    bool matches(const Config & config, const char * path) const
+    RuleType getType() const noexcept
     {
-        switch (m_type)
-        {
-        case FILE_RULE_DEFAULT:
-            return true;
-        case FILE_RULE_PARSE_FILEPATH:
-        {
-            const int rightMostColorSpaceIndex = ParseColorSpaceFromString(config, path);
-            if (rightMostColorSpaceIndex >= 0)
-            {
-                m_colorSpace = config.getColorSpaceNameByIndex(rightMostColorSpaceIndex);
-                return true;
-            }
-            return false;
-        }
-        case FILE_RULE_REGEX:
-        {
-            const std::regex reg(m_regex.c_str());
-            return regex_match(path, reg);
-        }
-        case FILE_RULE_GLOB:
+        return m_type;
+    }
+
+    // The regular expression a glob or regex rule matches the whole file path with.
+    std::string getExpression() const
+    {
+        if (m_type == FILE_RULE_GLOB)
         {
-            const std::string exp = BuildRegularExpression(m_pattern.c_str(),
-                                                           m_extension.c_str());
-            const std::regex reg(exp.c_str());
-            return regex_match(path, reg);
+            return BuildRegularExpression(m_pattern.c_str(), m_extension.c_str());
         }
-        }
-        return false;
+        return m_regex;
     }
 
     void sanityCheck(std::function<ConstColorSpaceRcPtr(const char *)> colorSpaceAccesssor) const
@@ -478,13 +908,123 @@ public:
 private:
 
     std::string m_name;
-    mutable std::string m_colorSpace;
+    std::string m_colorSpace;
     std::string m_pattern;
     std::string m_extension;
     std::string m_regex;
     RuleType m_type{ FILE_RULE_GLOB };
 };
 
+// All the rules compiled for the file path classification: the glob rules & the simple
+// regex rules share one automaton, the other regex rules keep their own std::regex.
+class CompiledFileRules
+{
+public:
+    CompiledFileRules() = delete;
+    CompiledFileRules(const CompiledFileRules &) = delete;
+    CompiledFileRules & operator=(const CompiledFileRules &) = delete;
+
+    explicit CompiledFileRules(const std::vector<FileRuleRcPtr> & rules)
+        : m_rules(rules.size())
+    {
+        for (size_t idx = 0; idx < rules.size(); ++idx)
+        {
+            switch (rules[idx]->getType())
+            {
+            case FileRule::FILE_RULE_DEFAULT:
+                m_rules[idx].m_type = RULE_ANY;
+                break;
+            case FileRule::FILE_RULE_PARSE_FILEPATH:
+                m_rules[idx].m_type = RULE_COLORSPACE_NAME;
+                break;
+            case FileRule::FILE_RULE_REGEX:
+            case FileRule::FILE_RULE_GLOB:
+            {
+                const std::string exp = rules[idx]->getExpression();
+                if (m_automaton.add(exp, (int)idx))
+                {
+                    m_rules[idx].m_type = RULE_AUTOMATON;
+                }
+                else
+                {
+                    m_rules[idx].m_type = RULE_REGEX;
+                    m_rules[idx].m_regex = std::make_shared<const std::regex>(exp);
+                }
+                break;
+            }
+            }
+        }
+
+        m_automaton.finalize();
+    }
+
+    // Returns the index of the first rule matching the file path. The colorSpaceIndex is
+    // the index of the color space name found by the ColorSpaceNamePathSearch rule, or -1.
+    size_t findRule(const ColorSpaceNameMatcher & matcher,
+                    const char * filePath,
+                    int & colorSpaceIndex) const
+    {
+        colorSpaceIndex = -1;
+
+        const char * path = filePath ? filePath : "";
+
+        // The rules before the first one matched by the automaton are either not handled by
+        // the automaton or do not match.
+        const int automatonRule = m_automaton.match(path);
+
+        const size_t numRules = m_rules.size();
+        for (size_t idx = 0; idx < numRules; ++idx)
+        {
+            if ((int)idx == automatonRule)
+            {
+                return idx;
+            }
+
+            switch (m_rules[idx].m_type)
+            {
+            case RULE_ANY:
+                return idx;
+            case RULE_COLORSPACE_NAME:
+                colorSpaceIndex = matcher.findRightMost(path);
+                if (colorSpaceIndex >= 0)
+                {
+                    return idx;
+                }
+                break;
+            case RULE_REGEX:
+                if (std::regex_match(path, *m_rules[idx].m_regex))
+                {
+                    return idx;
+                }
+                break;
+            case RULE_AUTOMATON:
+                break;
+            }
+        }
+
+        // Should not be reached since the default rule always matches.
+        return numRules - 1;
+    }
+
+private:
+    enum RuleType
+    {
+        RULE_ANY = 0,
+        RULE_COLORSPACE_NAME,
+        RULE_AUTOMATON,
+        RULE_REGEX
+    };
+
+    struct Rule
+    {
+        RuleType m_type = RULE_ANY;
+        std::shared_ptr<const std::regex> m_regex;
+    };
+
+    std::vector<Rule> m_rules;
+    PathAutomaton m_automaton;
+};
+
 FileRules::FileRules()
     : m_impl(new FileRules::Impl())
 {
@@ -530,6 +1070,9 @@ FileRules::Impl & FileRules::Impl::operator=(const FileRules::Impl & rhs)
         {
             m_rules.push_back(rule->clone());
         }
+
+        // The compiled rules only depend on the rule definitions.
+        std::atomic_store(&m_compiledRules, std::atomic_load(&rhs.m_compiledRules));
     }
 
     return *this;
@@ -580,20 +1123,42 @@ void FileRules::Impl::validateNewRule(size_t ruleIndex, const char * name) const
     }
 }
 
-const char * FileRules::Impl::getRuleFromFilepath(const Config & config, const char * filePath,
+const char * FileRules::Impl::getRuleFromFilepath(const ColorSpaceNameMatcher & matcher,
+                                                  const char * filePath,
                                                   size_t & ruleIndex) const
 {
-    const auto numRules = m_rules.size();
-    for (size_t i = 0; i < numRules; ++i)
+    return getRuleFromFilepath(*getCompiledRules(), matcher, filePath, ruleIndex);
+}
+
+const char * FileRules::Impl::getRuleFromFilepath(const CompiledFileRules & compiledRules,
+                                                  const ColorSpaceNameMatcher & matcher,
+                                                  const char * filePath,
+                                                  size_t & ruleIndex) const
+{
+    int colorSpaceIndex = -1;
+    ruleIndex = compiledRules.findRule(matcher, filePath, colorSpaceIndex);
+    if (colorSpaceIndex >= 0)
     {
-        if (m_rules[i]->matches(config, filePath))
-        {
-            ruleIndex = i;
-            return m_rules[i]->getColorSpace();
-        }
+        return matcher.getName(colorSpaceIndex);
     }
-    // Should not be reached since the default rule always matches.
-    return m_rules.back()->getColorSpace();
+    return m_rules[ruleIndex]->getColorSpace();
+}
+
+ConstCompiledFileRulesRcPtr FileRules::Impl::getCompiledRules() const
+{
+    ConstCompiledFileRulesRcPtr compiledRules = std::atomic_load(&m_compiledRules);
+    if (!compiledRules)
+    {
+        // Concurrent builds give the same result so any of them could be kept.
+        compiledRules = std::make_shared<const CompiledFileRules>(m_rules);
+        std::atomic_store(&m_compiledRules, compiledRules);
+    }
+    return compiledRules;
+}
+
+void FileRules::Impl::resetCompiledRules()
+{
+    std::atomic_store(&m_compiledRules, ConstCompiledFileRulesRcPtr());
 }
 
 void FileRules::Impl::moveRule(size_t ruleIndex, int offset)
@@ -610,6 +1175,7 @@ void FileRules::Impl::moveRule(size_t ruleIndex, int offset)
     auto rule = m_rules[ruleIndex];
     m_rules.erase(m_rules.begin() + ruleIndex);
     m_rules.insert(m_rules.begin() + newIndex, rule);
+    resetCompiledRules();
 }
 
 
@@ -658,6 +1224,7 @@ void FileRules::setPattern(size_t ruleIndex, const char * pattern)
 {
     m_impl->validatePosition(ruleIndex, Impl::DEFAULT_NOT_ALLOWED);
     m_impl->m_rules[ruleIndex]->setPattern(pattern);
+    m_impl->resetCompiledRules();
 }
 
 const char * FileRules::getExtension(size_t ruleIndex) const
@@ -670,6 +1237,7 @@ void FileRules::setExtension(size_t ruleIndex, const char * extension)
 {
     m_impl->validatePosition(ruleIndex, Impl::DEFAULT_NOT_ALLOWED);
     m_impl->m_rules[ruleIndex]->setExtension(extension);
+    m_impl->resetCompiledRules();
 }
 
 const char * FileRules::getRegex(size_t ruleIndex) const
@@ -682,6 +1250,7 @@ void FileRules::setRegex(size_t ruleIndex, const char * regex)
 {
     m_impl->validatePosition(ruleIndex, Impl::DEFAULT_NOT_ALLOWED);
     m_impl->m_rules[ruleIndex]->setRegex(regex);
+    m_impl->resetCompiledRules();
 }
 
 // Color space or role.
@@ -765,6 +1334,7 @@ void FileRules::insertRule(size_t ruleIndex, const char * name, const char * col
     newRule->setPattern(pattern);
     newRule->setExtension(extension);
     m_impl->m_rules.insert(m_impl->m_rules.begin() + ruleIndex, newRule);
+    m_impl->resetCompiledRules();
 }
 
 void FileRules::insertRule(size_t ruleIndex, const char * name, const char * colorSpace,
@@ -778,6 +1348,7 @@ void FileRules::insertRule(size_t ruleIndex, const char * name, const char * col
     newRule->setColorSpace(colorSpace);
     newRule->setRegex(regex);
     m_impl->m_rules.insert(m_impl->m_rules.begin() + ruleIndex, newRule);
+    m_impl->resetCompiledRules();
 }
 
 void FileRules::insertPathSearchRule(size_t ruleIndex)
@@ -794,6 +1365,7 @@ void FileRules::removeRule(size_t ruleIndex)
 {
     m_impl->validatePosition(ruleIndex, Impl::DEFAULT_NOT_ALLOWED);
     m_impl->m_rules.erase(m_impl->m_rules.begin() + ruleIndex);
+    m_impl->resetCompiledRules();
 }
 
 void FileRules::increaseRulePriority(size_t ruleIndex)
@@ -806,26 +1378,47 @@ void FileRules::decreaseRulePriority(size_t ruleIndex)
     m_impl->moveRule(ruleIndex, 1);
 }
 
-const char * FileRules::Impl::getColorSpaceFromFilepath(const Config & config,
+const char * FileRules::Impl::getColorSpaceFromFilepath(const ColorSpaceNameMatcher & matcher,
                                                         const char * filePath) const
 {
     size_t ruleIndex = 0;
-    return getColorSpaceFromFilepath(config, filePath, ruleIndex);
+    return getColorSpaceFromFilepath(matcher, filePath, ruleIndex);
 }
 
-const char * FileRules::Impl::getColorSpaceFromFilepath(const Config & config, const char * filePath,
+const char * FileRules::Impl::getColorSpaceFromFilepath(const ColorSpaceNameMatcher & matcher,
+                                                        const char * filePath,
                                                         size_t & ruleIndex) const
 {
-    return getRuleFromFilepath(config, filePath, ruleIndex);
+    return getRuleFromFilepath(matcher, filePath, ruleIndex);
 }
 
-bool FileRules::Impl::filepathOnlyMatchesDefaultRule(const Config & config, const char * filePath) const
+bool FileRules::Impl::filepathOnlyMatchesDefaultRule(const ColorSpaceNameMatcher & matcher,
+                                                     const char * filePath) const
 {
     size_t rulePos = 0;
-    getColorSpaceFromFilepath(config, filePath, rulePos);
+    getColorSpaceFromFilepath(matcher, filePath, rulePos);
     return (rulePos + 1) == m_rules.size();
 }
 
+void FileRules::Impl::getColorSpacesFromFilepaths(const ColorSpaceNameMatcher & matcher,
+                                                  const char * const * filePaths,
+                                                  size_t numFilePaths,
+                                                  const char ** colorSpaces,
+                                                  size_t * ruleIndices) const
+{
+    const ConstCompiledFileRulesRcPtr compiledRules = getCompiledRules();
+
+    for (size_t idx = 0; idx < numFilePaths; ++idx)
+    {
+        size_t ruleIndex = 0;
+        colorSpaces[idx] = getRuleFromFilepath(*compiledRules, matcher, filePaths[idx], ruleIndex);
+        if (ruleIndices)
+        {
+            ruleIndices[idx] = ruleIndex;
+        }
+    }
+}
+
 std::ostream & operator<< (std::ostream & os, const FileRules & fr)
 {
     const size_t numRules = fr.getNumEntries();
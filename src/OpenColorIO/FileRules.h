@@ -6,9 +6,12 @@
 #define INCLUDED_OCIO_FILERULES_H
 
 #include <functional>
+#include <memory>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "PathUtils.h"
+
 
 namespace OCIO_NAMESPACE
 {
@@ -32,6 +35,9 @@ constexpr char CustomKey[]  { "custom" };
 class FileRule;
 using FileRuleRcPtr = OCIO_SHARED_PTR<FileRule>;
 
+class CompiledFileRules;
+using ConstCompiledFileRulesRcPtr = OCIO_SHARED_PTR<const CompiledFileRules>;
+
 class FileRules::Impl
 {
 public:
@@ -46,7 +52,8 @@ public:
     Impl & operator=(const Impl & rhs);
     ~Impl() = default;
 
-    const char * getRuleFromFilepath(const Config & config, const char * filePath,
+    const char * getRuleFromFilepath(const ColorSpaceNameMatcher & matcher,
+                                     const char * filePath,
                                      size_t & ruleIndex) const;
 
     void validatePosition(size_t ruleIndex, DefaultAllowed allowDefault) const;
@@ -56,12 +63,22 @@ public:
 
     void moveRule(size_t ruleIndex, int offset);
 
-    const char * getColorSpaceFromFilepath(const Config & config, const char * filePath) const;
+    const char * getColorSpaceFromFilepath(const ColorSpaceNameMatcher & matcher,
+                                           const char * filePath) const;
 
-    const char * getColorSpaceFromFilepath(const Config & config, const char * filePath,
+    const char * getColorSpaceFromFilepath(const ColorSpaceNameMatcher & matcher,
+                                           const char * filePath,
                                            size_t & ruleIndex) const;
 
-    bool filepathOnlyMatchesDefaultRule(const Config & config, const char * filePath) const;
+    bool filepathOnlyMatchesDefaultRule(const ColorSpaceNameMatcher & matcher,
+                                        const char * filePath) const;
+
+    // The colorSpaces array and the ruleIndices one (if not null) hold numFilePaths entries.
+    void getColorSpacesFromFilepaths(const ColorSpaceNameMatcher & matcher,
+                                     const char * const * filePaths,
+                                     size_t numFilePaths,
+                                     const char ** colorSpaces,
+                                     size_t * ruleIndices) const;
 
     void sanityCheck(std::function<ConstColorSpaceRcPtr(const char *)> colorSpaceAccessor) const;
 
@@ -69,8 +86,20 @@ private:
 
     friend class FileRules;
 
+    const char * getRuleFromFilepath(const CompiledFileRules & compiledRules,
+                                     const ColorSpaceNameMatcher & matcher,
+                                     const char * filePath,
+                                     size_t & ruleIndex) const;
+
+    // The rules compiled into a single matcher. It is built on the first request and
+    // any rule change drops it.
+    ConstCompiledFileRulesRcPtr getCompiledRules() const;
+    void resetCompiledRules();
+
     // All rules, default rule always at the end.
     std::vector<FileRuleRcPtr> m_rules;
+
+    mutable ConstCompiledFileRulesRcPtr m_compiledRules;
 };
 
 } // namespace OCIO_NAMESPACE
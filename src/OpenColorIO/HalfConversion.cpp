@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "CPUInfo.h"
+#include "HalfConversion.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Defined in a translation unit compiled with the F16C instruction set, so they must
+// only be used once the CPU support is checked.
+#ifdef USE_F16C
+void ConvertHalfToFloatF16C(const half * in, float * out, long numValues);
+void ConvertFloatToHalfF16C(const float * in, half * out, long numValues);
+#endif
+
+namespace
+{
+
+void ConvertHalfToFloatScalar(const half * in, float * out, long numValues)
+{
+    for (long idx = 0; idx < numValues; ++idx)
+    {
+        out[idx] = float(in[idx]);
+    }
+}
+
+void ConvertFloatToHalfScalar(const float * in, half * out, long numValues)
+{
+    for (long idx = 0; idx < numValues; ++idx)
+    {
+        out[idx] = half(in[idx]);
+    }
+}
+
+typedef void (*HalfToFloatFunc)(const half *, float *, long);
+typedef void (*FloatToHalfFunc)(const float *, half *, long);
+
+struct HalfConverters
+{
+    HalfToFloatFunc m_toFloat = ConvertHalfToFloatScalar;
+    FloatToHalfFunc m_toHalf  = ConvertFloatToHalfScalar;
+    bool m_f16c = false;
+
+    HalfConverters()
+    {
+#ifdef USE_F16C
+        if (CPUInfo::Instance().m_hasF16C)
+        {
+            m_toFloat = ConvertHalfToFloatF16C;
+            m_toHalf  = ConvertFloatToHalfF16C;
+            m_f16c    = true;
+        }
+#endif
+    }
+};
+
+const HalfConverters & GetHalfConverters()
+{
+    static const HalfConverters converters;
+    return converters;
+}
+
+} // anon.
+
+void ConvertHalfToFloat(const half * in, float * out, long numValues)
+{
+    GetHalfConverters().m_toFloat(in, out, numValues);
+}
+
+void ConvertFloatToHalf(const float * in, half * out, long numValues)
+{
+    GetHalfConverters().m_toHalf(in, out, numValues);
+}
+
+bool HasF16CHalfConversion()
+{
+    return GetHalfConverters().m_f16c;
+}
+
+} // namespace OCIO_NAMESPACE
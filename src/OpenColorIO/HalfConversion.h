@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_HALFCONVERSION_H
+#define INCLUDED_OCIO_HALFCONVERSION_H
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "OpenEXR/half.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Bulk conversions between half floats and floats. The F16C instructions are used when
+// the build and the running CPU support them, otherwise the conversions go through the
+// OpenEXR half type. Both paths round to the nearest even value and give the same
+// results, except for the signaling NaNs which F16C quiets.
+//
+// Note that the 'in' and 'out' buffers must not overlap.
+
+void ConvertHalfToFloat(const half * in, float * out, long numValues);
+void ConvertFloatToHalf(const float * in, half * out, long numValues);
+
+// Return true if the conversions use the F16C instructions.
+bool HasF16CHalfConversion();
+
+} // namespace OCIO_NAMESPACE
+
+#endif
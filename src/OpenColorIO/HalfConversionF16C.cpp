@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+// This translation unit is compiled with the F16C instruction set enabled, so nothing
+// from it may be called before checking the CPU support (see HalfConversion.cpp).
+
+#include <cstring>
+
+#include <immintrin.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "HalfConversion.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+static_assert(sizeof(half) == 2, "The half type is expected to only hold its 16 bits.");
+
+void ConvertHalfToFloatF16C(const half * in, float * out, long numValues)
+{
+    long idx = 0;
+    for (; idx + 8 <= numValues; idx += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + idx));
+        _mm256_storeu_ps(out + idx, _mm256_cvtph_ps(h));
+    }
+
+    const long remaining = numValues - idx;
+    if (remaining > 0)
+    {
+        // Convert the last values through a full vector.
+        half inBuf[8];
+        float outBuf[8];
+        memcpy(reinterpret_cast<void *>(inBuf), in + idx, remaining * sizeof(half));
+        memset(reinterpret_cast<void *>(inBuf + remaining), 0, (8 - remaining) * sizeof(half));
+
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inBuf));
+        _mm256_storeu_ps(outBuf, _mm256_cvtph_ps(h));
+        memcpy(out + idx, outBuf, remaining * sizeof(float));
+    }
+}
+
+void ConvertFloatToHalfF16C(const float * in, half * out, long numValues)
+{
+    long idx = 0;
+    for (; idx + 8 <= numValues; idx += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + idx), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + idx), h);
+    }
+
+    const long remaining = numValues - idx;
+    if (remaining > 0)
+    {
+        // Convert the last values through a full vector.
+        float inBuf[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+        half outBuf[8];
+        memcpy(inBuf, in + idx, remaining * sizeof(float));
+
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(inBuf), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(outBuf), h);
+        memcpy(reinterpret_cast<void *>(out + idx), outBuf, remaining * sizeof(half));
+    }
+}
+
+} // namespace OCIO_NAMESPACE
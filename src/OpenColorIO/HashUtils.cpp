@@ -6,6 +6,8 @@
 #include "HashUtils.h"
 #include "md5/md5.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <iostream>
 
@@ -43,4 +45,162 @@ std::string GetPrintableHash(const md5_byte_t * digest)
     return std::string(printableResult);
 }
 
+namespace
+{
+
+inline uint64_t Rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t FMix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+constexpr uint64_t C1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t C2 = 0x4cf5ad432745937fULL;
+
+inline uint64_t MixK1(uint64_t k1)
+{
+    k1 *= C1;
+    k1 = Rotl64(k1, 31);
+    return k1 * C2;
+}
+
+inline uint64_t MixK2(uint64_t k2)
+{
+    k2 *= C2;
+    k2 = Rotl64(k2, 33);
+    return k2 * C1;
+}
+
+}
+
+void FastHash128(const void * data, size_t size, uint64_t & low, uint64_t & high)
+{
+    const uint8_t * bytes = static_cast<const uint8_t *>(data);
+    const size_t numBlocks = size / 16;
+
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+
+    for (size_t idx = 0; idx < numBlocks; ++idx)
+    {
+        uint64_t k1, k2;
+        // Unaligned and strict aliasing safe reads (little endian only).
+        std::memcpy(&k1, bytes + idx * 16, sizeof(uint64_t));
+        std::memcpy(&k2, bytes + idx * 16 + 8, sizeof(uint64_t));
+
+        h1 ^= MixK1(k1);
+        h1 = Rotl64(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        h2 ^= MixK2(k2);
+        h2 = Rotl64(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // Process the remaining bytes.
+    const uint8_t * tail = bytes + numBlocks * 16;
+    const size_t tailSize = size & 15;
+
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    for (size_t idx = tailSize; idx > 8; --idx)
+    {
+        k2 ^= uint64_t(tail[idx - 1]) << ((idx - 9) * 8);
+    }
+    if (tailSize > 8)
+    {
+        h2 ^= MixK2(k2);
+    }
+
+    for (size_t idx = std::min<size_t>(tailSize, 8); idx > 0; --idx)
+    {
+        k1 ^= uint64_t(tail[idx - 1]) << ((idx - 1) * 8);
+    }
+    if (tailSize > 0)
+    {
+        h1 ^= MixK1(k1);
+    }
+
+    // Finalization.
+    h1 ^= uint64_t(size);
+    h2 ^= uint64_t(size);
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = FMix64(h1);
+    h2 = FMix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    low  = h1;
+    high = h2;
+}
+
+std::string FastCacheIDHash(const void * data, size_t size)
+{
+    uint64_t hash[2];
+    FastHash128(data, size, hash[0], hash[1]);
+
+    md5_byte_t digest[16];
+    std::memcpy(digest, hash, sizeof(digest));
+
+    return GetPrintableHash(digest);
+}
+
+MemoizedHash::MemoizedHash(const MemoizedHash & rhs)
+{
+    *this = rhs;
+}
+
+MemoizedHash & MemoizedHash::operator=(const MemoizedHash & rhs)
+{
+    if (this != &rhs)
+    {
+        std::string hash;
+        bool valid = false;
+        {
+            AutoMutex lock(rhs.m_mutex);
+            valid = rhs.m_valid;
+            hash  = rhs.m_hash;
+        }
+
+        AutoMutex lock(m_mutex);
+        m_hash  = hash;
+        m_valid = valid;
+    }
+    return *this;
+}
+
+std::string MemoizedHash::get(const void * data, size_t size) const
+{
+    // The hash is only written before m_valid is set, so no lock is needed to read it.
+    if (m_valid.load(std::memory_order_acquire))
+    {
+        return m_hash;
+    }
+
+    AutoMutex lock(m_mutex);
+    if (!m_valid.load(std::memory_order_relaxed))
+    {
+        m_hash = FastCacheIDHash(data, size);
+        m_valid.store(true, std::memory_order_release);
+    }
+
+    return m_hash;
+}
+
 } // namespace OCIO_NAMESPACE
@@ -8,6 +8,10 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "md5/md5.h"
+#include "Mutex.h"
+
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 namespace OCIO_NAMESPACE
@@ -17,6 +21,34 @@ std::string CacheIDHash(const char * array, int size);
 // TODO: get rid of md5.h include, make this a generic byte array
 std::string GetPrintableHash(const md5_byte_t * digest);
 
+// Fast non-cryptographic 128-bit hash (i.e. MurmurHash3 x64 128-bit variant) intended
+// for the large data blocks like the LUT arrays. The printable form is the same as the
+// md5 one.
+void FastHash128(const void * data, size_t size, uint64_t & low, uint64_t & high);
+std::string FastCacheIDHash(const void * data, size_t size);
+
+// Thread-safe memoization of the FastCacheIDHash of a data block. Once computed, reading
+// the hash does not lock anything. The owner must call invalidate() when the data changes.
+class MemoizedHash
+{
+public:
+    MemoizedHash() = default;
+    MemoizedHash(const MemoizedHash & rhs);
+    MemoizedHash & operator=(const MemoizedHash & rhs);
+    ~MemoizedHash() = default;
+
+    // Return the memoized hash, or compute it from the data.
+    std::string get(const void * data, size_t size) const;
+
+    void invalidate() noexcept { m_valid = false; }
+    bool isValid() const noexcept { return m_valid; }
+
+private:
+    mutable Mutex m_mutex;
+    mutable std::atomic<bool> m_valid{ false };
+    mutable std::string m_hash;
+};
+
 } // namespace OCIO_NAMESPACE
 
 #endif
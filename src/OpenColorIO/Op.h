@@ -271,6 +271,18 @@ private:
 
 std::ostream& operator<< (std::ostream&, const Op&);
 
+// Accuracy of the half-domain 1D LUT built by the OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32
+// optimization against the separable ops it replaces.
+struct HalfDomainLutAccuracy
+{
+    bool     m_evaluated     = false; // False if there were no costly separable ops to replace.
+    bool     m_replaced      = false; // True if the LUT replaced the ops.
+    unsigned m_numOps        = 0;     // Number of separable ops evaluated by the LUT.
+    float    m_maxError      = 0.f;   // Absolute error below 1 and relative error above.
+    float    m_maxErrorInput = 0.f;   // Input value where the maximum error happens.
+    long     m_numSamples    = 0;
+};
+
 // The class handles a list of ops.
 //
 // Note: The class follows the std::vector API so it can be used
@@ -366,10 +378,12 @@ public:
     // OpVec when reaching the optimization step).
     void finalize(OptimizationFlags oFlags);
 
-    // Only OptimizationFlags related to bitdepth optimization are used.
+    // Only OptimizationFlags related to bitdepth optimization are used. The optional accuracy
+    // reports how the OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32 optimization went.
     void optimizeForBitdepth(const BitDepth & inBitDepth,
                              const BitDepth & outBitDepth,
-                             OptimizationFlags oFlags);
+                             OptimizationFlags oFlags,
+                             HalfDomainLutAccuracy * accuracy = nullptr);
 
 };
 
@@ -2,14 +2,19 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
 #include "Logging.h"
 #include "Op.h"
+#include "OpenEXR/half.h"
+#include "ops/OpTools.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut3d/Lut3DOp.h"
 #include "ops/range/RangeOpData.h"
@@ -20,6 +25,9 @@ namespace OCIO_NAMESPACE
 namespace
 {
 
+// Unused bit only set by OPTIMIZATION_ALL and the values derived from it.
+constexpr OptimizationFlags OPTIMIZATION_ALL_MARKER = static_cast<OptimizationFlags>(0x80000000);
+
 bool HasFlag(OptimizationFlags flags, OptimizationFlags queryFlag)
 {
     return (flags & queryFlag) == queryFlag;
@@ -461,6 +469,39 @@ unsigned FindSeparablePrefix(const OpRcPtrVec & ops)
     return prefixLen;
 }
 
+// Use functional composition to build a single 1D LUT from the first prefixLen ops.  The
+// LUT domain is built for the input bit-depth (i.e. a half-domain for 16f and 32f).
+Lut1DOpDataRcPtr ComposeSeparablePrefix(const OpRcPtrVec & ops, unsigned prefixLen, BitDepth in)
+{
+    OpRcPtrVec prefixOps;
+    for (unsigned i = 0; i < prefixLen; ++i)
+    {
+        prefixOps.push_back(ops[i]->clone());
+    }
+
+    // Make a domain for the LUT.  (Will be half-domain for target == 16f.)
+    Lut1DOpDataRcPtr newDomain = Lut1DOpData::MakeLookupDomain(in);
+
+    // Send the domain through the prefix ops.
+    // Note: This sets the outBitDepth of newDomain to match prefixOps.
+    Lut1DOpData::ComposeVec(newDomain, prefixOps);
+
+    return newDomain;
+}
+
+// Replace the first prefixLen ops by the LUT.
+void ReplaceSeparablePrefix(OpRcPtrVec & ops, unsigned prefixLen, Lut1DOpDataRcPtr & lut)
+{
+    // Remove the prefix ops.
+    ops.erase(ops.begin(), ops.begin() + prefixLen);
+
+    // Insert the new LUT to replace the prefix ops.
+    OpRcPtrVec lutOps;
+    CreateLut1DOp(lutOps, lut, TRANSFORM_DIR_FORWARD);
+
+    ops.insert(ops.begin(), lutOps.begin(), lutOps.end());
+}
+
 // Use functional composition to replace a string of separable ops at the head of
 // the op list with a single 1D LUT that is built to do a look-up for the input bit-depth.
 void OptimizeSeparablePrefix(OpRcPtrVec & ops, BitDepth in)
@@ -470,8 +511,7 @@ void OptimizeSeparablePrefix(OpRcPtrVec & ops, BitDepth in)
         return;
     }
 
-    // TODO: Investigate whether even the F32 case could be sped up via interpolating 
-    //       in a half-domain Lut1D (e.g. replacing a string of exponent, log, etc.).
+    // Refer to OptimizeSeparablePrefixF32() for the F32 case.
     if (in == BIT_DEPTH_F32 || in == BIT_DEPTH_UINT32)
     {
         return;
@@ -483,27 +523,155 @@ void OptimizeSeparablePrefix(OpRcPtrVec & ops, BitDepth in)
         return; // Nothing to do.
     }
 
+    Lut1DOpDataRcPtr newDomain = ComposeSeparablePrefix(ops, prefixLen, in);
+
+    ReplaceSeparablePrefix(ops, prefixLen, newDomain);
+}
+
+// Maximum error allowed between a half-domain LUT and the ops it replaces for F32 pixels.
+// Note that the error is absolute for values below 1 and relative above.
+constexpr float HALF_DOMAIN_LUT_MAX_ERROR = 1e-4f;
+
+// Compare the interpolated LUT against the exact ops for F32 inputs.  The samples are the
+// midpoints between the consecutive normal half values (i.e. where the interpolation error
+// is the largest), for both signs.  The values below the smallest normal half are spread
+// linearly in the half-domain, so a log curve is not expected to be accurate there.
+HalfDomainLutAccuracy MeasureHalfDomainLutAccuracy(OpRcPtrVec & exactOps,
+                                                   Lut1DOpDataRcPtr & lut)
+{
+    // Normal half values excluding the largest one (i.e. 0x7BFF).
+    static constexpr unsigned short FIRST_NORMAL_HALF = 0x0400;
+    static constexpr unsigned short LAST_NORMAL_HALF  = 0x7BFF;
+
+    std::vector<float> inValues;
+    inValues.reserve(2 * 3 * (LAST_NORMAL_HALF - FIRST_NORMAL_HALF));
+
+    for (unsigned short bits = FIRST_NORMAL_HALF; bits < LAST_NORMAL_HALF; ++bits)
+    {
+        half h0, h1;
+        h0.setBits(bits);
+        h1.setBits(bits + 1);
+        const float midPoint = (float(h0) + float(h1)) * 0.5f;
+
+        inValues.insert(inValues.end(), { midPoint, midPoint, midPoint,
+                                          -midPoint, -midPoint, -midPoint });
+    }
+
+    const long numPixels = (long)inValues.size() / 3;
+
+    std::vector<float> exactValues(inValues.size());
+    EvalTransform(inValues.data(), exactValues.data(), numPixels, exactOps);
+
+    OpRcPtrVec lutOps;
+    CreateLut1DOp(lutOps, lut, TRANSFORM_DIR_FORWARD);
+
+    std::vector<float> lutValues(inValues.size());
+    EvalTransform(inValues.data(), lutValues.data(), numPixels, lutOps);
+
+    HalfDomainLutAccuracy accuracy;
+    accuracy.m_numSamples = numPixels;
+
+    for (size_t idx = 0; idx < inValues.size(); ++idx)
+    {
+        // The LUT could not represent them anyway.
+        if (!std::isfinite(exactValues[idx]))
+        {
+            continue;
+        }
+
+        const float error = std::fabs(lutValues[idx] - exactValues[idx])
+                            / std::max(1.0f, std::fabs(exactValues[idx]));
+
+        // Note that a NaN from the LUT is reported as an infinite error.
+        if (std::isnan(error) || error > accuracy.m_maxError)
+        {
+            accuracy.m_maxError      = std::isnan(error) ? std::numeric_limits<float>::infinity()
+                                                         : error;
+            accuracy.m_maxErrorInput = inValues[idx];
+        }
+    }
+
+    return accuracy;
+}
+
+// Return true if one of the ops is worth replacing by a LUT look-up with interpolation.
+bool HasCostlySeparableOp(const OpRcPtrVec & ops, unsigned prefixLen)
+{
+    for (unsigned i = 0; i < prefixLen; ++i)
+    {
+        ConstOpRcPtr constOp = ops[i];
+        switch (constOp->data()->getType())
+        {
+            case OpData::CDLType:
+            case OpData::ExponentType:
+            case OpData::GammaType:
+            case OpData::LogType:
+                return true;
+
+            case OpData::ExposureContrastType:
+            case OpData::FixedFunctionType:
+            case OpData::Lut1DType:
+            case OpData::Lut3DType:
+            case OpData::MatrixType:
+            case OpData::RangeType:
+            case OpData::ReferenceType:
+            case OpData::NoOpType:
+                break;
+        }
+    }
+    return false;
+}
+
+// Replace a string of separable ops at the head of the op list that includes some costly
+// functions (i.e. pow, log) by a half-domain 1D LUT, interpolated for the F32 pixels.  The
+// LUT is only kept if its accuracy against the original ops is good enough.
+void OptimizeSeparablePrefixF32(OpRcPtrVec & ops, HalfDomainLutAccuracy * report)
+{
+    if (ops.empty())
+    {
+        return;
+    }
+
+    const unsigned prefixLen = FindSeparablePrefix(ops);
+    if (prefixLen == 0 || !HasCostlySeparableOp(ops, prefixLen))
+    {
+        return; // Nothing to do.
+    }
+
+    Lut1DOpDataRcPtr newDomain = ComposeSeparablePrefix(ops, prefixLen, BIT_DEPTH_F32);
+
     OpRcPtrVec prefixOps;
     for (unsigned i = 0; i < prefixLen; ++i)
     {
         prefixOps.push_back(ops[i]->clone());
     }
 
-    // Make a domain for the LUT.  (Will be half-domain for target == 16f.)
-    Lut1DOpDataRcPtr newDomain = Lut1DOpData::MakeLookupDomain(in);
+    HalfDomainLutAccuracy accuracy = MeasureHalfDomainLutAccuracy(prefixOps, newDomain);
+    const bool accurate = accuracy.m_maxError <= HALF_DOMAIN_LUT_MAX_ERROR;
 
-    // Send the domain through the prefix ops.
-    // Note: This sets the outBitDepth of newDomain to match prefixOps.
-    Lut1DOpData::ComposeVec(newDomain, prefixOps);
-
-    // Remove the prefix ops.
-    ops.erase(ops.begin(), ops.begin() + prefixLen);
+    accuracy.m_evaluated = true;
+    accuracy.m_replaced  = accurate;
+    accuracy.m_numOps    = prefixLen;
+    if (report)
+    {
+        *report = accuracy;
+    }
 
-    // Insert the new LUT to replace the prefix ops.
-    OpRcPtrVec lutOps;
-    CreateLut1DOp(lutOps, newDomain, TRANSFORM_DIR_FORWARD);
+    if (IsDebugLoggingEnabled())
+    {
+        std::ostringstream os;
+        os << "Half-domain LUT for " << prefixLen << " separable ops: ";
+        os << "max error " << accuracy.m_maxError;
+        os << " at " << accuracy.m_maxErrorInput;
+        os << " (" << accuracy.m_numSamples << " samples), ";
+        os << (accurate ? "ops replaced." : "ops kept.");
+        LogDebug(os.str());
+    }
 
-    ops.insert(ops.begin(), lutOps.begin(), lutOps.end());
+    if (accurate)
+    {
+        ReplaceSeparablePrefix(ops, prefixLen, newDomain);
+    }
 }
 } // namespace
 
@@ -617,8 +785,14 @@ void OpRcPtrVec::finalize(OptimizationFlags oFlags)
 
 void OpRcPtrVec::optimizeForBitdepth(const BitDepth & inBitDepth,
                                      const BitDepth & outBitDepth,
-                                     OptimizationFlags oFlags)
+                                     OptimizationFlags oFlags,
+                                     HalfDomainLutAccuracy * accuracy)
 {
+    if (accuracy)
+    {
+        *accuracy = HalfDomainLutAccuracy();
+    }
+
     if (!empty())
     {
         if (!IsFloatBitDepth(inBitDepth))
@@ -629,7 +803,17 @@ void OpRcPtrVec::optimizeForBitdepth(const BitDepth & inBitDepth,
         {
             RemoveTrailingClampIdentity(*this);
         }
-        if (HasFlag(oFlags, OPTIMIZATION_COMP_SEPARABLE_PREFIX))
+        if (inBitDepth == BIT_DEPTH_F32)
+        {
+            // The flag is ignored when coming from OPTIMIZATION_ALL (refer to the
+            // OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32 documentation).
+            if (HasFlag(oFlags, OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32)
+                && !HasFlag(oFlags, OPTIMIZATION_ALL_MARKER))
+            {
+                OptimizeSeparablePrefixF32(*this, accuracy);
+            }
+        }
+        else if (HasFlag(oFlags, OPTIMIZATION_COMP_SEPARABLE_PREFIX))
         {
             OptimizeSeparablePrefix(*this, inBitDepth);
         }
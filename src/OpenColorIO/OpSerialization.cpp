@@ -0,0 +1,607 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "fileformats/FormatMetadata.h"
+#include "ops/cdl/CDLOpData.h"
+#include "ops/exponent/ExponentOp.h"
+#include "ops/exposurecontrast/ExposureContrastOpData.h"
+#include "ops/fixedfunction/FixedFunctionOpData.h"
+#include "ops/gamma/GammaOpData.h"
+#include "ops/log/LogOpData.h"
+#include "ops/lut1d/Lut1DOpData.h"
+#include "ops/lut3d/Lut3DOpData.h"
+#include "ops/matrix/MatrixOpData.h"
+#include "ops/range/RangeOpData.h"
+#include "OpSerialization.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+namespace
+{
+
+constexpr char BINARY_OPS_MAGIC[8] = { 'O', 'C', 'I', 'O', 'B', 'O', 'P', 'S' };
+
+// Written in the native byte order, so a reader with another endianness sees it swapped.
+constexpr uint32_t BINARY_OPS_BYTE_ORDER = 0x01020304;
+
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(std::ostream & os)
+        : m_os(os)
+    {
+    }
+
+    template<typename T>
+    void write(T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic values are written as is.");
+        m_os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void writeBool(bool value)
+    {
+        write<uint8_t>(value ? 1 : 0);
+    }
+
+    template<typename E>
+    void writeEnum(E value)
+    {
+        write<int32_t>(static_cast<int32_t>(value));
+    }
+
+    void writeString(const std::string & str)
+    {
+        write<uint64_t>(str.size());
+        m_os.write(str.data(), str.size());
+    }
+
+    template<typename T>
+    void writeValues(const std::vector<T> & values)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic values are written as is.");
+        write<uint64_t>(values.size());
+        m_os.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+
+    void writeMetadata(const FormatMetadataImpl & metadata)
+    {
+        writeString(metadata.getName());
+        writeString(metadata.getValue());
+
+        const auto & attributes = metadata.getAttributes();
+        write<uint64_t>(attributes.size());
+        for (const auto & attribute : attributes)
+        {
+            writeString(attribute.first);
+            writeString(attribute.second);
+        }
+
+        const auto & children = metadata.getChildrenElements();
+        write<uint64_t>(children.size());
+        for (const auto & child : children)
+        {
+            writeMetadata(child);
+        }
+    }
+
+private:
+    std::ostream & m_os;
+};
+
+class BinaryReader
+{
+public:
+    explicit BinaryReader(std::istream & is)
+        : m_is(is)
+    {
+        // When the stream is seekable, bound all the sizes read from the stream by the
+        // number of remaining bytes so that corrupted data cannot trigger huge allocations.
+        const std::streampos start = m_is.tellg();
+        if (start != std::streampos(-1))
+        {
+            m_is.seekg(0, std::ios_base::end);
+            const std::streampos end = m_is.tellg();
+            m_is.seekg(start);
+            if (end != std::streampos(-1) && end >= start)
+            {
+                m_remaining = static_cast<uint64_t>(end - start);
+            }
+        }
+        m_is.clear();
+    }
+
+    template<typename T>
+    T read()
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic values are read as is.");
+        T value;
+        readBytes(reinterpret_cast<char *>(&value), sizeof(T));
+        return value;
+    }
+
+    bool readBool()
+    {
+        return read<uint8_t>() != 0;
+    }
+
+    // All the serialized enums start at 0. The value is checked so that corrupted data
+    // never produces an out-of-range enum value.
+    template<typename E>
+    E readEnum(E last)
+    {
+        const int32_t value = read<int32_t>();
+        if (value < 0 || value > static_cast<int32_t>(last))
+        {
+            throw Exception("Binary ops: corrupted data.");
+        }
+        return static_cast<E>(value);
+    }
+
+    Interpolation readInterpolation()
+    {
+        const Interpolation interp = readEnum(INTERP_BEST);
+        if (interp > INTERP_CUBIC && interp != INTERP_DEFAULT && interp != INTERP_BEST)
+        {
+            throw Exception("Binary ops: corrupted data.");
+        }
+        return interp;
+    }
+
+    std::string readString()
+    {
+        const uint64_t size = readSize(1);
+        std::string str(static_cast<size_t>(size), '\0');
+        readBytes(&str[0], str.size());
+        return str;
+    }
+
+    template<typename T>
+    void readValues(std::vector<T> & values)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic values are read as is.");
+        const uint64_t size = readSize(sizeof(T));
+        values.resize(static_cast<size_t>(size));
+        readBytes(reinterpret_cast<char *>(values.data()), values.size() * sizeof(T));
+    }
+
+    uint64_t readSize(size_t elementSize)
+    {
+        const uint64_t size = read<uint64_t>();
+        if (size > m_remaining / elementSize)
+        {
+            throw Exception("Binary ops: corrupted data.");
+        }
+        return size;
+    }
+
+    void readMetadata(FormatMetadataImpl & metadata)
+    {
+        metadata.setName(readString());
+        metadata.setValue(readString());
+
+        const uint64_t numAttributes = readSize(2 * sizeof(uint64_t));
+        for (uint64_t idx = 0; idx < numAttributes; ++idx)
+        {
+            const std::string name  = readString();
+            const std::string value = readString();
+            metadata.addAttribute(name.c_str(), value.c_str());
+        }
+
+        const uint64_t numChildren = readSize(4 * sizeof(uint64_t));
+        auto & children = metadata.getChildrenElements();
+        for (uint64_t idx = 0; idx < numChildren; ++idx)
+        {
+            children.emplace_back();
+            readMetadata(children.back());
+        }
+    }
+
+    void readBytes(char * data, size_t size)
+    {
+        if (size > m_remaining || !m_is.read(data, size))
+        {
+            throw Exception("Binary ops: truncated data.");
+        }
+        m_remaining -= size;
+    }
+
+private:
+    std::istream & m_is;
+    uint64_t m_remaining = std::numeric_limits<uint64_t>::max();
+};
+
+// Helpers for the RGBA parameters.
+
+void WriteParams(BinaryWriter & writer, const double * params)
+{
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        writer.write<double>(params[idx]);
+    }
+}
+
+void ReadParams(BinaryReader & reader, double * params)
+{
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        params[idx] = reader.read<double>();
+    }
+}
+
+void WriteOpData(BinaryWriter & writer, const ConstOpDataRcPtr & opData)
+{
+    switch (opData->getType())
+    {
+    case OpData::CDLType:
+    {
+        auto cdl = OCIO_DYNAMIC_POINTER_CAST<const CDLOpData>(opData);
+        writer.writeEnum(cdl->getStyle());
+        WriteParams(writer, cdl->getSlopeParams().data());
+        WriteParams(writer, cdl->getOffsetParams().data());
+        WriteParams(writer, cdl->getPowerParams().data());
+        writer.write<double>(cdl->getSaturation());
+        break;
+    }
+    case OpData::ExponentType:
+    {
+        auto exp = OCIO_DYNAMIC_POINTER_CAST<const ExponentOpData>(opData);
+        WriteParams(writer, exp->m_exp4);
+        break;
+    }
+    case OpData::ExposureContrastType:
+    {
+        auto ec = OCIO_DYNAMIC_POINTER_CAST<const ExposureContrastOpData>(opData);
+        writer.writeEnum(ec->getStyle());
+        writer.write<double>(ec->getExposure());
+        writer.writeBool(ec->getExposureProperty()->isDynamic());
+        writer.write<double>(ec->getContrast());
+        writer.writeBool(ec->getContrastProperty()->isDynamic());
+        writer.write<double>(ec->getGamma());
+        writer.writeBool(ec->getGammaProperty()->isDynamic());
+        writer.write<double>(ec->getPivot());
+        writer.write<double>(ec->getLogExposureStep());
+        writer.write<double>(ec->getLogMidGray());
+        break;
+    }
+    case OpData::FixedFunctionType:
+    {
+        auto ff = OCIO_DYNAMIC_POINTER_CAST<const FixedFunctionOpData>(opData);
+        writer.writeEnum(ff->getStyle());
+        writer.writeValues(ff->getParams());
+        break;
+    }
+    case OpData::GammaType:
+    {
+        auto gamma = OCIO_DYNAMIC_POINTER_CAST<const GammaOpData>(opData);
+        writer.writeEnum(gamma->getStyle());
+        writer.writeValues(gamma->getRedParams());
+        writer.writeValues(gamma->getGreenParams());
+        writer.writeValues(gamma->getBlueParams());
+        writer.writeValues(gamma->getAlphaParams());
+        break;
+    }
+    case OpData::LogType:
+    {
+        auto log = OCIO_DYNAMIC_POINTER_CAST<const LogOpData>(opData);
+        writer.write<double>(log->getBase());
+        writer.writeEnum(log->getDirection());
+        writer.writeValues(log->getRedParams());
+        writer.writeValues(log->getGreenParams());
+        writer.writeValues(log->getBlueParams());
+        break;
+    }
+    case OpData::Lut1DType:
+    {
+        auto lut = OCIO_DYNAMIC_POINTER_CAST<const Lut1DOpData>(opData);
+        writer.writeEnum(lut->getHalfFlags());
+        writer.writeEnum(lut->getInterpolation());
+        writer.writeEnum(lut->getHueAdjust());
+        writer.writeEnum(lut->getDirection());
+        writer.writeEnum(lut->getFileOutputBitDepth());
+        const auto & array = lut->getArray();
+        writer.write<uint32_t>(array.getLength());
+        writer.write<uint32_t>(array.getNumColorComponents());
+        writer.writeValues(array.getValues());
+        break;
+    }
+    case OpData::Lut3DType:
+    {
+        auto lut = OCIO_DYNAMIC_POINTER_CAST<const Lut3DOpData>(opData);
+        writer.writeEnum(lut->getInterpolation());
+        writer.writeEnum(lut->getDirection());
+        writer.writeEnum(lut->getFileOutputBitDepth());
+        writer.write<uint32_t>(lut->getArray().getLength());
+        writer.writeValues(lut->getArray().getValues());
+        break;
+    }
+    case OpData::MatrixType:
+    {
+        auto matrix = OCIO_DYNAMIC_POINTER_CAST<const MatrixOpData>(opData);
+        writer.writeEnum(matrix->getDirection());
+        writer.writeEnum(matrix->getFileInputBitDepth());
+        writer.writeEnum(matrix->getFileOutputBitDepth());
+        writer.writeValues(matrix->getArray().getValues());
+        WriteParams(writer, matrix->getOffsets().getValues());
+        break;
+    }
+    case OpData::RangeType:
+    {
+        auto range = OCIO_DYNAMIC_POINTER_CAST<const RangeOpData>(opData);
+        writer.writeEnum(range->getDirection());
+        writer.writeEnum(range->getFileInputBitDepth());
+        writer.writeEnum(range->getFileOutputBitDepth());
+        writer.write<double>(range->getMinInValue());
+        writer.write<double>(range->getMaxInValue());
+        writer.write<double>(range->getMinOutValue());
+        writer.write<double>(range->getMaxOutValue());
+        break;
+    }
+    case OpData::ReferenceType:
+    case OpData::NoOpType:
+    {
+        std::ostringstream oss;
+        oss << "Binary ops: the op '" << opData->getCacheID() << "' can't be serialized.";
+        throw Exception(oss.str().c_str());
+    }
+    }
+}
+
+OpDataRcPtr ReadOpData(BinaryReader & reader, OpData::Type type)
+{
+    switch (type)
+    {
+    case OpData::CDLType:
+    {
+        auto cdl = std::make_shared<CDLOpData>();
+        cdl->setStyle(reader.readEnum(CDLOpData::CDL_NO_CLAMP_REV));
+
+        CDLOpData::ChannelParams params;
+        ReadParams(reader, params.data());
+        cdl->setSlopeParams(params);
+        ReadParams(reader, params.data());
+        cdl->setOffsetParams(params);
+        ReadParams(reader, params.data());
+        cdl->setPowerParams(params);
+        cdl->setSaturation(reader.read<double>());
+        return cdl;
+    }
+    case OpData::ExponentType:
+    {
+        auto exp = std::make_shared<ExponentOpData>();
+        ReadParams(reader, exp->m_exp4);
+        return exp;
+    }
+    case OpData::ExposureContrastType:
+    {
+        auto ec = std::make_shared<ExposureContrastOpData>(
+            reader.readEnum(ExposureContrastOpData::STYLE_LOGARITHMIC_REV));
+
+        ec->setExposure(reader.read<double>());
+        if (reader.readBool()) ec->getExposureProperty()->makeDynamic();
+        ec->setContrast(reader.read<double>());
+        if (reader.readBool()) ec->getContrastProperty()->makeDynamic();
+        ec->setGamma(reader.read<double>());
+        if (reader.readBool()) ec->getGammaProperty()->makeDynamic();
+        ec->setPivot(reader.read<double>());
+        ec->setLogExposureStep(reader.read<double>());
+        ec->setLogMidGray(reader.read<double>());
+        return ec;
+    }
+    case OpData::FixedFunctionType:
+    {
+        const auto style = reader.readEnum(FixedFunctionOpData::LUV_TO_XYZ);
+        FixedFunctionOpData::Params params;
+        reader.readValues(params);
+        return std::make_shared<FixedFunctionOpData>(params, style);
+    }
+    case OpData::GammaType:
+    {
+        const auto style = reader.readEnum(GammaOpData::MONCURVE_MIRROR_REV);
+        GammaOpData::Params red, green, blue, alpha;
+        reader.readValues(red);
+        reader.readValues(green);
+        reader.readValues(blue);
+        reader.readValues(alpha);
+        return std::make_shared<GammaOpData>(style, red, green, blue, alpha);
+    }
+    case OpData::LogType:
+    {
+        const double base = reader.read<double>();
+        auto log = std::make_shared<LogOpData>(base, reader.readEnum(TRANSFORM_DIR_INVERSE));
+
+        LogOpData::Params params;
+        reader.readValues(params);
+        log->setRedParams(params);
+        reader.readValues(params);
+        log->setGreenParams(params);
+        reader.readValues(params);
+        log->setBlueParams(params);
+        return log;
+    }
+    case OpData::Lut1DType:
+    {
+        const auto halfFlags = reader.readEnum(Lut1DOpData::LUT_INPUT_OUTPUT_HALF_CODE);
+        const auto interpolation = reader.readInterpolation();
+        const auto hueAdjust = reader.readEnum(HUE_DW3);
+        const auto direction = reader.readEnum(TRANSFORM_DIR_INVERSE);
+        const auto fileOutBitDepth = reader.readEnum(BIT_DEPTH_F32);
+        const unsigned long length = reader.read<uint32_t>();
+        const unsigned long numComponents = reader.read<uint32_t>();
+
+        auto lut = std::make_shared<Lut1DOpData>(halfFlags, length);
+        lut->setInterpolation(interpolation);
+        lut->setHueAdjust(hueAdjust);
+        lut->setDirection(direction);
+        lut->setFileOutputBitDepth(fileOutBitDepth);
+
+        auto & array = lut->getArray();
+        array.resize(length, numComponents);
+        reader.readValues(array.getValues());
+        array.validate();
+        return lut;
+    }
+    case OpData::Lut3DType:
+    {
+        const auto interpolation = reader.readInterpolation();
+        const auto direction = reader.readEnum(TRANSFORM_DIR_INVERSE);
+        const auto fileOutBitDepth = reader.readEnum(BIT_DEPTH_F32);
+        const unsigned long gridSize = reader.read<uint32_t>();
+
+        auto lut = std::make_shared<Lut3DOpData>(interpolation, gridSize);
+        lut->setDirection(direction);
+        lut->setFileOutputBitDepth(fileOutBitDepth);
+
+        auto & array = lut->getArray();
+        reader.readValues(array.getValues());
+        array.validate();
+        return lut;
+    }
+    case OpData::MatrixType:
+    {
+        auto matrix = std::make_shared<MatrixOpData>(reader.readEnum(TRANSFORM_DIR_INVERSE));
+        matrix->setFileInputBitDepth(reader.readEnum(BIT_DEPTH_F32));
+        matrix->setFileOutputBitDepth(reader.readEnum(BIT_DEPTH_F32));
+
+        auto & array = matrix->getArray();
+        reader.readValues(array.getValues());
+        array.validate();
+
+        double offsets[4];
+        ReadParams(reader, offsets);
+        matrix->setRGBAOffsets(offsets);
+        return matrix;
+    }
+    case OpData::RangeType:
+    {
+        const auto direction = reader.readEnum(TRANSFORM_DIR_INVERSE);
+        const auto fileInBitDepth = reader.readEnum(BIT_DEPTH_F32);
+        const auto fileOutBitDepth = reader.readEnum(BIT_DEPTH_F32);
+        const double minIn  = reader.read<double>();
+        const double maxIn  = reader.read<double>();
+        const double minOut = reader.read<double>();
+        const double maxOut = reader.read<double>();
+
+        auto range = std::make_shared<RangeOpData>(minIn, maxIn, minOut, maxOut, direction);
+        range->setFileInputBitDepth(fileInBitDepth);
+        range->setFileOutputBitDepth(fileOutBitDepth);
+        return range;
+    }
+    case OpData::ReferenceType:
+    case OpData::NoOpType:
+        break;
+    }
+
+    throw Exception("Binary ops: corrupted data.");
+}
+
+} // anon.
+
+void WriteBinaryOps(std::ostream & os,
+                    const OpRcPtrVec & ops,
+                    const ProcessorMetadata & metadata)
+{
+    BinaryWriter writer(os);
+
+    os.write(BINARY_OPS_MAGIC, sizeof(BINARY_OPS_MAGIC));
+    writer.write<uint32_t>(BINARY_OPS_BYTE_ORDER);
+    writer.write<uint32_t>(BINARY_OPS_VERSION);
+    writer.write<uint32_t>(GetVersionHex());
+
+    writer.write<uint64_t>(metadata.getNumFiles());
+    for (int idx = 0; idx < metadata.getNumFiles(); ++idx)
+    {
+        writer.writeString(metadata.getFile(idx));
+    }
+    writer.write<uint64_t>(metadata.getNumLooks());
+    for (int idx = 0; idx < metadata.getNumLooks(); ++idx)
+    {
+        writer.writeString(metadata.getLook(idx));
+    }
+
+    writer.writeMetadata(ops.getFormatMetadata());
+
+    writer.write<uint64_t>(ops.size());
+    for (ConstOpRcPtr op : ops)
+    {
+        ConstOpDataRcPtr opData = op->data();
+        writer.writeEnum(opData->getType());
+        writer.writeMetadata(opData->getFormatMetadata());
+        WriteOpData(writer, opData);
+    }
+
+    if (!os)
+    {
+        throw Exception("Binary ops: writing to the stream failed.");
+    }
+}
+
+void ReadBinaryOps(std::istream & is,
+                   OpRcPtrVec & ops,
+                   ProcessorMetadata & metadata)
+{
+    BinaryReader reader(is);
+
+    char magic[sizeof(BINARY_OPS_MAGIC)];
+    reader.readBytes(magic, sizeof(magic));
+    if (0 != memcmp(magic, BINARY_OPS_MAGIC, sizeof(magic)))
+    {
+        throw Exception("Binary ops: the data is not a binary op list.");
+    }
+
+    if (reader.read<uint32_t>() != BINARY_OPS_BYTE_ORDER)
+    {
+        throw Exception("Binary ops: the data was written with another byte order.");
+    }
+
+    const uint32_t version = reader.read<uint32_t>();
+    const uint32_t libVersion = reader.read<uint32_t>();
+    if (version != BINARY_OPS_VERSION || libVersion != (uint32_t)GetVersionHex())
+    {
+        std::ostringstream oss;
+        oss << "Binary ops: the data was written by another library version ("
+            << std::hex << libVersion << " instead of " << GetVersionHex() << ").";
+        throw Exception(oss.str().c_str());
+    }
+
+    const uint64_t numFiles = reader.readSize(sizeof(uint64_t));
+    for (uint64_t idx = 0; idx < numFiles; ++idx)
+    {
+        metadata.addFile(reader.readString().c_str());
+    }
+    const uint64_t numLooks = reader.readSize(sizeof(uint64_t));
+    for (uint64_t idx = 0; idx < numLooks; ++idx)
+    {
+        metadata.addLook(reader.readString().c_str());
+    }
+
+    FormatMetadataImpl & opsMetadata = ops.getFormatMetadata();
+    opsMetadata.clear();
+    reader.readMetadata(opsMetadata);
+
+    const uint64_t numOps = reader.readSize(sizeof(int32_t));
+    for (uint64_t idx = 0; idx < numOps; ++idx)
+    {
+        const auto type = reader.readEnum(OpData::NoOpType);
+
+        FormatMetadataImpl opMetadata;
+        reader.readMetadata(opMetadata);
+
+        OpDataRcPtr opData = ReadOpData(reader, type);
+        opData->getFormatMetadata() = opMetadata;
+
+        CreateOpVecFromOpData(ops, opData, TRANSFORM_DIR_FORWARD);
+    }
+}
+
+} // namespace OCIO_NAMESPACE
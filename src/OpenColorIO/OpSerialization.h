@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_OPSERIALIZATION_H
+#define INCLUDED_OCIO_OPSERIALIZATION_H
+
+#include <istream>
+#include <ostream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Op.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Compact binary serialization of a finalized op list, i.e. the op parameters and LUT
+// arrays, the format metadata of the list and of each op, and the processor metadata.
+// The layout is only meant to be read back by the same library version on a machine
+// with the same endianness, the reader throws when that is not the case or when the
+// data is truncated or corrupted. Reference and no-op ops are not supported as a
+// finalized op list never contains them.
+
+// Version of the binary layout, to be incremented for any change of the layout.
+constexpr unsigned BINARY_OPS_VERSION = 1;
+
+void WriteBinaryOps(std::ostream & os,
+                    const OpRcPtrVec & ops,
+                    const ProcessorMetadata & metadata);
+
+// Append the ops read from the stream, in the forward direction and not yet finalized.
+void ReadBinaryOps(std::istream & is,
+                   OpRcPtrVec & ops,
+                   ProcessorMetadata & metadata);
+
+} // namespace OCIO_NAMESPACE
+
+#endif
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Mutex.h"
+#include "ParallelUtils.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+namespace
+{
+// Maximum number of threads of the internal parallel steps run from the current thread
+// where 0 means no limit (refer to ThreadLimitGuard).
+thread_local unsigned t_maxInternalThreads = 0;
+
+// Number of threads reserved by the internal parallel steps in addition to their calling
+// threads (refer to ThreadReservation).
+std::atomic<unsigned> g_numReservedThreads(0);
+}
+
+unsigned GetNumThreads(unsigned requestedNumThreads)
+{
+    if (requestedNumThreads == 0)
+    {
+        // Note: hardware_concurrency() could return 0 if the value is not computable. It is
+        // only queried once as it is called for each apply and may read the system files.
+        static const unsigned numHardwareThreads
+            = std::max(1U, std::thread::hardware_concurrency());
+        requestedNumThreads = numHardwareThreads;
+    }
+
+    return requestedNumThreads;
+}
+
+void ParallelRun(unsigned numThreads, const std::function<void(unsigned)> & func)
+{
+    numThreads = std::max(1U, numThreads);
+
+    if (numThreads == 1)
+    {
+        func(0);
+        return;
+    }
+
+    Mutex exceptionMutex;
+    std::exception_ptr firstException;
+
+    auto worker = [&](unsigned threadIdx)
+    {
+        try
+        {
+            // The nested internal parallel steps run on the worker thread.
+            ThreadLimitGuard guard(1);
+            func(threadIdx);
+        }
+        catch (...)
+        {
+            AutoMutex guard(exceptionMutex);
+            if (!firstException)
+            {
+                firstException = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (unsigned idx = 1; idx < numThreads; ++idx)
+    {
+        threads.emplace_back(worker, idx);
+    }
+
+    // The calling thread does its share of the work.
+    worker(0);
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    if (firstException)
+    {
+        std::rethrow_exception(firstException);
+    }
+}
+
+void ParallelFor(unsigned numThreads, long numItems, long chunkSize,
+                 const std::function<void(unsigned, long, long)> & func)
+{
+    if (numItems <= 0)
+    {
+        return;
+    }
+
+    chunkSize = std::max(1L, chunkSize);
+
+    const long numChunks = (numItems + chunkSize - 1) / chunkSize;
+    numThreads = (unsigned)std::min<long>(std::max(1U, numThreads), numChunks);
+
+    std::atomic<long> nextChunk(0);
+
+    ParallelRun(numThreads, [&](unsigned threadIdx)
+    {
+        while (true)
+        {
+            const long chunk = nextChunk.fetch_add(1);
+            if (chunk >= numChunks)
+            {
+                break;
+            }
+
+            const long begin = chunk * chunkSize;
+            const long end   = std::min(numItems, begin + chunkSize);
+            func(threadIdx, begin, end);
+        }
+    });
+}
+
+ThreadReservation::ThreadReservation(unsigned maxNumThreads)
+{
+    const unsigned numHardwareThreads = GetNumThreads(0);
+    maxNumThreads = std::min(GetNumThreads(maxNumThreads), numHardwareThreads);
+    if (t_maxInternalThreads != 0)
+    {
+        maxNumThreads = std::min(maxNumThreads, t_maxInternalThreads);
+    }
+
+    // The calling thread is always used so only the additional threads are reserved.
+    const unsigned maxReserved = numHardwareThreads - 1;
+
+    unsigned reserved = g_numReservedThreads.load();
+    unsigned numExtraThreads = 0;
+    do
+    {
+        numExtraThreads = reserved < maxReserved
+                        ? std::min(maxNumThreads - 1, maxReserved - reserved) : 0;
+        if (numExtraThreads == 0)
+        {
+            break;
+        }
+    }
+    while (!g_numReservedThreads.compare_exchange_weak(reserved, reserved + numExtraThreads));
+
+    m_numThreads = 1 + numExtraThreads;
+}
+
+ThreadReservation::~ThreadReservation()
+{
+    if (m_numThreads > 1)
+    {
+        g_numReservedThreads.fetch_sub(m_numThreads - 1);
+    }
+}
+
+ThreadLimitGuard::ThreadLimitGuard(unsigned maxNumThreads)
+    :   m_previousLimit(t_maxInternalThreads)
+{
+    maxNumThreads = GetNumThreads(maxNumThreads);
+    t_maxInternalThreads = m_previousLimit == 0 ? maxNumThreads
+                                                : std::min(m_previousLimit, maxNumThreads);
+}
+
+ThreadLimitGuard::~ThreadLimitGuard()
+{
+    t_maxInternalThreads = m_previousLimit;
+}
+
+void ParallelFor(long numItems, long chunkSize,
+                 const std::function<void(unsigned, long, long)> & func)
+{
+    if (numItems <= 0)
+    {
+        return;
+    }
+
+    // Do not reserve more threads than chunks.
+    chunkSize = std::max(1L, chunkSize);
+    const long numChunks = (numItems + chunkSize - 1) / chunkSize;
+
+    const ThreadReservation threads((unsigned)std::min<long>(numChunks, GetNumThreads(0)));
+    ParallelFor(threads.getNumThreads(), numItems, chunkSize, func);
+}
+
+} // namespace OCIO_NAMESPACE
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_PARALLELUTILS_H
+#define INCLUDED_OCIO_PARALLELUTILS_H
+
+#include <functional>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Return the number of threads to use for a requested thread count where 0 means
+// one thread per hardware thread.
+unsigned GetNumThreads(unsigned requestedNumThreads);
+
+// Call the function once per thread with the thread index in [0, numThreads). The calling
+// thread is used as one of the worker threads and the method only returns when all the
+// threads are done. If any of the calls throws, the first exception is rethrown.
+void ParallelRun(unsigned numThreads, const std::function<void(unsigned)> & func);
+
+// Split [0, numItems) into chunks of chunkSize items and process them from numThreads
+// threads. The function is called with the thread index and the [begin, end) chunk range.
+// Chunks are handed out dynamically so uneven chunk costs are balanced across the threads.
+void ParallelFor(unsigned numThreads, long numItems, long chunkSize,
+                 const std::function<void(unsigned, long, long)> & func);
+
+// Threads of an internal parallel step i.e. a step without a thread count from the caller
+// (e.g. the Lut3D inversion while building a processor). All the concurrent steps share
+// the hardware threads: in addition to their calling threads, they use at most one thread
+// per hardware thread. The step runs on the calling thread when it is already a worker
+// thread of ParallelRun() or ParallelFor() (i.e. the outer loop already uses the threads),
+// and it is also bounded by the ThreadLimitGuard of the calling thread. A maxNumThreads of
+// 0 means no other limit.
+class ThreadReservation
+{
+public:
+    explicit ThreadReservation(unsigned maxNumThreads = 0);
+    ThreadReservation(const ThreadReservation &) = delete;
+    ThreadReservation & operator=(const ThreadReservation &) = delete;
+    ~ThreadReservation();
+
+    unsigned getNumThreads() const noexcept { return m_numThreads; }
+
+private:
+    unsigned m_numThreads = 1;
+};
+
+// Limit the number of threads of the internal parallel steps run from the calling thread
+// until the guard is destroyed. A limit of 0 means one thread per hardware thread, and an
+// enclosing lower limit is kept.
+class ThreadLimitGuard
+{
+public:
+    explicit ThreadLimitGuard(unsigned maxNumThreads);
+    ThreadLimitGuard(const ThreadLimitGuard &) = delete;
+    ThreadLimitGuard & operator=(const ThreadLimitGuard &) = delete;
+    ~ThreadLimitGuard();
+
+private:
+    unsigned m_previousLimit;
+};
+
+// Same as above for an internal parallel step i.e. the threads are only reserved during
+// the loop (refer to ThreadReservation).
+void ParallelFor(long numItems, long chunkSize,
+                 const std::function<void(unsigned, long, long)> & func);
+
+} // namespace OCIO_NAMESPACE
+
+#endif
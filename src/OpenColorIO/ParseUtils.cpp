@@ -1,13 +1,21 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <locale>
 #include <set>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "ParallelUtils.h"
 #include "ParseUtils.h"
 #include "Platform.h"
 #include "utils/StringUtils.h"
@@ -495,13 +503,457 @@ std::string FloatVecToString(const float * fval, unsigned int size)
     return pretty.str();
 }
 
+namespace
+{
+
+inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Note: Do not use the std::isspace which is slow and locale dependent.
+inline bool IsSpaceChar(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char * SkipSpaces(const char * first, const char * last)
+{
+    while (first != last && IsSpaceChar(*first))
+    {
+        ++first;
+    }
+    return first;
+}
+
+// All the powers of ten exactly representable by a double.
+constexpr double Pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                             1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                             1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+// Convert a correctly rounded double to the requested type. Return false if the result
+// could be wrong because of the double rounding.
+inline bool FromRoundedDouble(double val, double & value)
+{
+    value = val;
+    return true;
+}
+
+inline bool FromRoundedDouble(double val, float & value)
+{
+    const float f = static_cast<float>(val);
+    if (static_cast<double>(f) != val)
+    {
+        // The rounding to float is only ambiguous when the double value is exactly halfway
+        // between two floats (i.e. the 29 extra mantissa bits are 100...0).
+        uint64_t bits = 0;
+        std::memcpy(&bits, &val, sizeof(val));
+        if ((bits & 0x1FFFFFFFULL) == 0x10000000ULL)
+        {
+            return false;
+        }
+    }
+    value = f;
+    return true;
+}
+
+// Return the pointer past the given lower case word if the characters match it (ignoring
+// the case), or nullptr otherwise.
+inline const char * MatchWordNoCase(const char * first, const char * last, const char * word)
+{
+    for (; *word; ++word, ++first)
+    {
+        if (first == last || (*first | 0x20) != *word)
+        {
+            return nullptr;
+        }
+    }
+    return first;
+}
+
+// Read the non-finite values accepted by strtod() & strtof() i.e. "inf", "infinity", "nan"
+// and "nan(chars)", ignoring the case.
+template<typename T>
+const char * ScanNonFinite(const char * first, const char * last, bool negative, T & value)
+{
+    if (const char * ptr = MatchWordNoCase(first, last, "inf"))
+    {
+        if (const char * longPtr = MatchWordNoCase(ptr, last, "inity"))
+        {
+            ptr = longPtr;
+        }
+        value = negative ? -std::numeric_limits<T>::infinity()
+                         : std::numeric_limits<T>::infinity();
+        return ptr;
+    }
+
+    if (const char * ptr = MatchWordNoCase(first, last, "nan"))
+    {
+        if (ptr != last && *ptr == '(')
+        {
+            const char * endPtr = ptr + 1;
+            while (endPtr != last && (IsDigit(*endPtr) || *endPtr == '_'
+                                      || ((*endPtr | 0x20) >= 'a' && (*endPtr | 0x20) <= 'z')))
+            {
+                ++endPtr;
+            }
+            if (endPtr != last && *endPtr == ')')
+            {
+                ptr = endPtr + 1;
+            }
+        }
+        value = negative ? -std::numeric_limits<T>::quiet_NaN()
+                         : std::numeric_limits<T>::quiet_NaN();
+        return ptr;
+    }
+
+    return nullptr;
+}
+
+// Slow but always correctly rounded path for the numbers the fast one cannot handle
+// (i.e. too many significant digits or large exponents).
+template<typename T>
+bool ParseWithClassicLocale(const char * first, const char * last, T & value)
+{
+    std::istringstream iss(std::string(first, last));
+    iss.imbue(std::locale::classic());
+
+    T x;
+    if (!(iss >> x))
+    {
+        return false;
+    }
+
+    value = x;
+    return true;
+}
+
+template<typename T>
+const char * ScanFloatingPoint(const char * first, const char * last, T & value)
+{
+    const char * ptr = first;
+
+    bool negative = false;
+    if (ptr != last && (*ptr == '-' || *ptr == '+'))
+    {
+        negative = (*ptr == '-');
+        ++ptr;
+    }
+
+    // The non-finite values directly follow the sign.
+    const char * const digits = ptr;
+
+    // Up to 19 significant digits always fit in a 64-bit integer, the remaining ones
+    // only change the exponent.
+    static constexpr int MaxDigits = 19;
+
+    uint64_t mantissa = 0;
+    int numDigits     = 0;
+    int exponent      = 0;
+    bool hasDigits    = false;
+    bool truncated    = false;
+
+    for (; ptr != last && IsDigit(*ptr); ++ptr)
+    {
+        hasDigits = true;
+        if (numDigits < MaxDigits)
+        {
+            mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+            if (mantissa != 0) ++numDigits;
+        }
+        else
+        {
+            ++exponent;
+            truncated = truncated || *ptr != '0';
+        }
+    }
+
+    if (ptr != last && *ptr == '.')
+    {
+        for (++ptr; ptr != last && IsDigit(*ptr); ++ptr)
+        {
+            hasDigits = true;
+            if (numDigits < MaxDigits)
+            {
+                mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+                if (mantissa != 0) ++numDigits;
+                --exponent;
+            }
+            else
+            {
+                truncated = truncated || *ptr != '0';
+            }
+        }
+    }
+
+    if (!hasDigits)
+    {
+        const char * end = ScanNonFinite(digits, last, negative, value);
+        return end ? end : first;
+    }
+
+    // The exponent is only part of the number when followed by at least one digit.
+    if (ptr != last && (*ptr == 'e' || *ptr == 'E'))
+    {
+        const char * expPtr = ptr + 1;
+
+        bool negativeExp = false;
+        if (expPtr != last && (*expPtr == '-' || *expPtr == '+'))
+        {
+            negativeExp = (*expPtr == '-');
+            ++expPtr;
+        }
+
+        if (expPtr != last && IsDigit(*expPtr))
+        {
+            int exp = 0;
+            for (; expPtr != last && IsDigit(*expPtr); ++expPtr)
+            {
+                // Saturate far beyond the double range to avoid any overflow.
+                if (exp < 100000) exp = exp * 10 + (*expPtr - '0');
+            }
+
+            exponent += negativeExp ? -exp : exp;
+            ptr = expPtr;
+        }
+    }
+
+    if (mantissa == 0)
+    {
+        value = negative ? -T(0) : T(0);
+        return ptr;
+    }
+
+    // When both the mantissa and the power of ten are exact doubles, a single operation
+    // gives the correctly rounded result (i.e. Clinger's fast path).
+    if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double val = static_cast<double>(mantissa);
+        val = exponent < 0 ? val / Pow10[-exponent] : val * Pow10[exponent];
+
+        T x;
+        if (FromRoundedDouble(val, x))
+        {
+            value = negative ? -x : x;
+            return ptr;
+        }
+    }
+
+    T x;
+    if (!ParseWithClassicLocale(first, ptr, x))
+    {
+        // The syntax is valid so the value is out of range: like strtod() & strtof(),
+        // overflow to infinity and underflow to zero.
+        const bool overflow = exponent + numDigits > 0;
+        x = overflow ? std::numeric_limits<T>::infinity() : T(0);
+        value = negative ? -x : x;
+        return ptr;
+    }
+
+    value = x;
+    return ptr;
+}
+
+template<typename T>
+const char * ScanNumbersImpl(const char * first, const char * last, T * values, size_t numValues)
+{
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        first = SkipSpaces(first, last);
+
+        const char * next = ScanNumber(first, last, values[idx]);
+        if (next == first || (next != last && !IsSpaceChar(*next)))
+        {
+            return nullptr;
+        }
+        first = next;
+    }
+
+    return first;
+}
+
+template<typename T>
+bool ScanAllNumbers(const char * first, const char * last, std::vector<T> & values)
+{
+    values.clear();
+
+    first = SkipSpaces(first, last);
+    while (first != last)
+    {
+        T val;
+        const char * next = ScanNumber(first, last, val);
+        if (next == first || (next != last && !IsSpaceChar(*next)))
+        {
+            return false;
+        }
+
+        values.push_back(val);
+        first = SkipSpaces(next, last);
+    }
+
+    return true;
+}
+
+} // anon.
+
+const char * ScanNumber(const char * first, const char * last, float & value)
+{
+    return ScanFloatingPoint(first, last, value);
+}
+
+const char * ScanNumber(const char * first, const char * last, double & value)
+{
+    return ScanFloatingPoint(first, last, value);
+}
+
+const char * ScanNumber(const char * first, const char * last, int & value)
+{
+    const char * ptr = first;
+
+    bool negative = false;
+    if (ptr != last && (*ptr == '-' || *ptr == '+'))
+    {
+        negative = (*ptr == '-');
+        ++ptr;
+    }
+
+    if (ptr == last || !IsDigit(*ptr))
+    {
+        return first;
+    }
+
+    static constexpr int64_t MaxValue = int64_t(std::numeric_limits<int>::max()) + 1;
+
+    int64_t val = 0;
+    for (; ptr != last && IsDigit(*ptr); ++ptr)
+    {
+        val = val * 10 + (*ptr - '0');
+        if (val > MaxValue)
+        {
+            return first;
+        }
+    }
+
+    val = negative ? -val : val;
+    if (val > std::numeric_limits<int>::max())
+    {
+        return first;
+    }
+
+    value = static_cast<int>(val);
+    return ptr;
+}
+
+const char * ScanNumbers(const char * first, const char * last, float * values, size_t numValues)
+{
+    return ScanNumbersImpl(first, last, values, numValues);
+}
+
+const char * ScanNumbers(const char * first, const char * last, int * values, size_t numValues)
+{
+    return ScanNumbersImpl(first, last, values, numValues);
+}
+
+char * FormatFixed(char * buffer, float value, int precision)
+{
+    static const uint64_t Powers10[10] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL,
+                                           100000ULL, 1000000ULL, 10000000ULL,
+                                           100000000ULL, 1000000000ULL };
+
+    precision = std::min(std::max(precision, 0), 9);
+
+    // A float has 24 significant bits and 10^9 = 2^9 * 5^9 only needs 21 more bits, so the
+    // scaled value is exact in double precision. Rounding it to an integer in the current
+    // rounding mode then gives the same digits as printf().
+    const double scaled = std::fabs(double(value) * double(Powers10[precision]));
+    if (!(scaled < 1e18))
+    {
+        // NaN, infinity and very large values.
+        const int len = snprintf(buffer, FIXED_NUMBER_MAX_CHARS, "%.*f", precision, value);
+        return buffer + std::min(std::max(len, 0), int(FIXED_NUMBER_MAX_CHARS) - 1);
+    }
+
+    uint64_t digits = static_cast<uint64_t>(std::nearbyint(scaled));
+
+    if (std::signbit(value))
+    {
+        *buffer++ = '-';
+    }
+
+    // Write the digits backwards, with at least one digit before the decimal point.
+    char tmp[32];
+    char * ptr = tmp + sizeof(tmp);
+    for (int idx = 0; idx < precision; ++idx)
+    {
+        *--ptr = char('0' + digits % 10);
+        digits /= 10;
+    }
+    if (precision > 0)
+    {
+        *--ptr = '.';
+    }
+    do
+    {
+        *--ptr = char('0' + digits % 10);
+        digits /= 10;
+    }
+    while (digits != 0);
+
+    const size_t len = size_t(tmp + sizeof(tmp) - ptr);
+    memcpy(buffer, ptr, len);
+    return buffer + len;
+}
+
+void WriteFixedTriplets(std::ostream & os, const float * values, long numLines,
+                        int precision, unsigned numThreads)
+{
+    static constexpr long CHUNK_LINES = 4096;
+
+    // Only a few chunks per thread are kept in memory at once.
+    numThreads = GetNumThreads(numThreads);
+    const long numChunks = 2 * long(numThreads);
+    std::vector<std::string> chunks(numChunks);
+
+    for (long batchBegin = 0; batchBegin < numLines; batchBegin += numChunks * CHUNK_LINES)
+    {
+        const long batchLines = std::min(numLines - batchBegin, numChunks * CHUNK_LINES);
+
+        ParallelFor(numThreads, batchLines, CHUNK_LINES,
+                    [&](unsigned, long begin, long end)
+        {
+            std::string & chunk = chunks[begin / CHUNK_LINES];
+            chunk.resize(size_t(end - begin) * 3 * FIXED_NUMBER_MAX_CHARS);
+
+            char * ptr = &chunk[0];
+            for (long line = batchBegin + begin; line < batchBegin + end; ++line)
+            {
+                ptr = FormatFixed(ptr, values[3 * line + 0], precision);
+                *ptr++ = ' ';
+                ptr = FormatFixed(ptr, values[3 * line + 1], precision);
+                *ptr++ = ' ';
+                ptr = FormatFixed(ptr, values[3 * line + 2], precision);
+                *ptr++ = '\n';
+            }
+            chunk.resize(size_t(ptr - &chunk[0]));
+        });
+
+        const long numBatchChunks = (batchLines + CHUNK_LINES - 1) / CHUNK_LINES;
+        for (long idx = 0; idx < numBatchChunks; ++idx)
+        {
+            os.write(chunks[idx].data(), chunks[idx].size());
+        }
+    }
+}
+
 bool StringToFloat(float * fval, const char * str)
 {
     if(!str) return false;
 
-    std::istringstream inputStringstream(str);
+    const char * last  = str + strlen(str);
+    const char * first = SkipSpaces(str, last);
+
     float x;
-    if(!(inputStringstream >> x))
+    if (ScanNumber(first, last, x) == first)
     {
         return false;
     }
@@ -515,9 +967,14 @@ bool StringToInt(int * ival, const char * str, bool failIfLeftoverChars)
     if(!str) return false;
     if(!ival) return false;
 
-    std::istringstream i(str);
-    char c=0;
-    if (!(i >> *ival) || (failIfLeftoverChars && i.get(c))) return false;
+    const char * last  = str + strlen(str);
+    const char * first = SkipSpaces(str, last);
+
+    int x;
+    const char * end = ScanNumber(first, last, x);
+    if (end == first || (failIfLeftoverChars && end != last)) return false;
+
+    *ival = x;
     return true;
 }
 
@@ -551,9 +1008,8 @@ bool StringVecToFloatVec(std::vector<float> &floatArray,
 
     for(unsigned int i=0; i<lineParts.size(); i++)
     {
-        std::istringstream inputStringstream(lineParts[i]);
         float x;
-        if(!(inputStringstream >> x))
+        if(!StringToFloat(&x, lineParts[i].c_str()))
         {
             return false;
         }
@@ -611,6 +1067,86 @@ bool nextline(std::istream &istream, std::string &line)
     return false;
 }
 
+LineTokenizer::LineTokenizer(const char * begin, const char * end)
+    :   m_cur(begin)
+    ,   m_end(end)
+{
+}
+
+bool LineTokenizer::nextLine()
+{
+    if (m_cur == m_end)
+    {
+        m_lineBegin = m_lineEnd = m_end;
+        return false;
+    }
+
+    const char * lineFeed
+        = static_cast<const char *>(std::memchr(m_cur, '\n', size_t(m_end - m_cur)));
+    if (!lineFeed)
+    {
+        lineFeed = m_end;
+    }
+
+    // Trimming the line also removes the '\r' of the windows line feeds.
+    m_lineBegin = SkipSpaces(m_cur, lineFeed);
+    m_lineEnd   = lineFeed;
+    while (m_lineEnd != m_lineBegin && IsSpaceChar(*(m_lineEnd - 1)))
+    {
+        --m_lineEnd;
+    }
+
+    m_cur = (lineFeed == m_end) ? m_end : lineFeed + 1;
+    return true;
+}
+
+bool LineTokenizer::getNumbers(float * values, size_t numValues) const
+{
+    const char * end = ScanNumbers(m_lineBegin, m_lineEnd, values, numValues);
+    return end && SkipSpaces(end, m_lineEnd) == m_lineEnd;
+}
+
+bool LineTokenizer::getNumbers(int * values, size_t numValues) const
+{
+    const char * end = ScanNumbers(m_lineBegin, m_lineEnd, values, numValues);
+    return end && SkipSpaces(end, m_lineEnd) == m_lineEnd;
+}
+
+bool LineTokenizer::getNumbers(std::vector<float> & values) const
+{
+    return ScanAllNumbers(m_lineBegin, m_lineEnd, values);
+}
+
+bool LineTokenizer::getNumbers(std::vector<int> & values) const
+{
+    return ScanAllNumbers(m_lineBegin, m_lineEnd, values);
+}
+
+void ReadStream(std::istream & istream, std::string & buffer)
+{
+    buffer.clear();
+
+    // Read everything at once when the stream size is known.
+    const std::streampos start = istream.tellg();
+    if (start != std::streampos(-1) && istream.seekg(0, std::ios::end))
+    {
+        const std::streamoff size = istream.tellg() - start;
+        istream.seekg(start);
+
+        if (size > 0)
+        {
+            buffer.resize(static_cast<size_t>(size));
+            istream.read(&buffer[0], size);
+            // Text mode streams could return fewer characters.
+            buffer.resize(static_cast<size_t>(istream.gcount()));
+        }
+        return;
+    }
+
+    istream.clear();
+    buffer.assign(std::istreambuf_iterator<char>(istream), std::istreambuf_iterator<char>());
+}
+
 bool StrEqualsCaseIgnore(const std::string & a, const std::string & b)
 {
     return 0 == Platform::Strcasecmp(a.c_str(), b.c_str());
@@ -39,6 +39,72 @@ bool StringVecToFloatVec(std::vector<float> & floatArray,
 bool StringVecToIntVec(std::vector<int> & intArray,
                        const StringUtils::StringVec & lineParts);
 
+// Locale independent and allocation free number scanners in the spirit of the C++17
+// std::from_chars(). The number must start at 'first' (i.e. leading spaces are not skipped)
+// and the pointer past its last character is returned, or 'first' when no number could be
+// read (e.g. invalid characters, or an integer overflow).
+// Note: The floating-point values are correctly rounded i.e. identical to strtod() & strtof()
+//       results in the "C" locale, including the "inf" & "nan" values and the overflows
+//       to infinity.
+const char * ScanNumber(const char * first, const char * last, float & value);
+const char * ScanNumber(const char * first, const char * last, double & value);
+const char * ScanNumber(const char * first, const char * last, int & value);
+
+// Scan 'numValues' numbers separated by spaces, and return the pointer past the last one or
+// nullptr if they could not all be read. Each number must be followed by a space or 'last'
+// but the remaining characters are not checked.
+const char * ScanNumbers(const char * first, const char * last, float * values, size_t numValues);
+const char * ScanNumbers(const char * first, const char * last, int * values, size_t numValues);
+
+// Size of the buffer needed by FormatFixed().
+constexpr size_t FIXED_NUMBER_MAX_CHARS = 64;
+
+// Locale independent formatting of a value with 'precision' decimals (at most 9), identical
+// to the output of a stream using std::fixed (i.e. printf "%.*f"). The characters are not
+// null terminated and the pointer past the last one is returned.
+char * FormatFixed(char * buffer, float value, int precision);
+
+// Write 'numLines' lines of RGB values i.e. "r g b\n", formatted by FormatFixed(). The lines
+// are formatted by chunks from 'numThreads' threads (refer to GetNumThreads()) and the chunks
+// are written in order, so the output does not depend on the number of threads.
+void WriteFixedTriplets(std::ostream & os, const float * values, long numLines,
+                        int precision, unsigned numThreads);
+
+// Iterate over the lines of a text buffer without any copy. Unix & windows line feeds are
+// supported, and the lines are trimmed from their leading and trailing spaces.
+class LineTokenizer
+{
+public:
+    LineTokenizer(const char * begin, const char * end);
+
+    // Move to the next line (possibly empty). Return false at the end of the buffer.
+    bool nextLine();
+
+    const char * lineBegin() const noexcept { return m_lineBegin; }
+    const char * lineEnd() const noexcept { return m_lineEnd; }
+    bool lineEmpty() const noexcept { return m_lineBegin == m_lineEnd; }
+
+    // Copy of the current line, mainly for error messages.
+    std::string line() const { return std::string(m_lineBegin, m_lineEnd); }
+
+    // Scan exactly 'numValues' numbers i.e. the line must not contain anything else.
+    bool getNumbers(float * values, size_t numValues) const;
+    bool getNumbers(int * values, size_t numValues) const;
+
+    // Scan all the numbers of the line. Return false if a token is not a number.
+    bool getNumbers(std::vector<float> & values) const;
+    bool getNumbers(std::vector<int> & values) const;
+
+private:
+    const char * m_cur       = nullptr;
+    const char * m_end       = nullptr;
+    const char * m_lineBegin = nullptr;
+    const char * m_lineEnd   = nullptr;
+};
+
+// Read the remaining content of the stream in one buffer.
+void ReadStream(std::istream & istream, std::string & buffer);
+
 //////////////////////////////////////////////////////////////////////////
 
 // read the next non-empty line, and store it in 'line'
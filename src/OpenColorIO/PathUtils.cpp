@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <cstdlib>
+#include <deque>
 #include <errno.h>
 #include <fstream>
 #include <iostream>
@@ -18,6 +19,7 @@
 #include "utils/StringUtils.h"
 
 #if !defined(_WIN32)
+#include <dirent.h>
 #include <sys/param.h>
 #else
 #include <direct.h>
@@ -118,6 +120,68 @@ void ClearPathCaches()
     g_fastFileHashCache.clear();
 }
 
+std::string GetDirectoryStamp(const std::string & dirname)
+{
+    struct stat results;
+    if (stat(dirname.c_str(), &results) == 0)
+    {
+        std::ostringstream stamp;
+        stamp << results.st_ino << ":";
+        stamp << results.st_mtime;
+#if defined(__APPLE__)
+        stamp << "." << results.st_mtimespec.tv_nsec;
+#elif !defined(_WIN32)
+        stamp << "." << results.st_mtim.tv_nsec;
+#endif
+        return stamp.str();
+    }
+
+    return "";
+}
+
+bool GetDirectoryEntries(const std::string & dirname, std::unordered_set<std::string> & names)
+{
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE handle = FindFirstFileA((dirname + "\\*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    do
+    {
+        const std::string name(data.cFileName);
+        if (name != "." && name != "..")
+        {
+            names.insert(name);
+        }
+    }
+    while (FindNextFileA(handle, &data));
+
+    FindClose(handle);
+    return true;
+#else
+    DIR * dir = opendir(dirname.c_str());
+    if (!dir)
+    {
+        return false;
+    }
+
+    while (const dirent * entry = readdir(dir))
+    {
+        const std::string name(entry->d_name);
+        if (name != "." && name != "..")
+        {
+            names.insert(name);
+        }
+    }
+
+    closedir(dir);
+    return true;
+#endif
+}
+
 namespace
 {
 std::string GetCwd()
@@ -222,46 +286,123 @@ std::string EnvExpand(const std::string & str, const EnvMap & map)
     return orig;
 }
 
-int ParseColorSpaceFromString(const Config & config, const char * str)
+ColorSpaceNameMatcher::ColorSpaceNameMatcher(const std::vector<std::string> & names)
+    :   m_names(names)
 {
-    if (!str) return -1;
+    // Build the trie of the lower-case names.
 
-    // Search the entire filePath, including directory name (if provided)
-    // convert the filename to lowercase.
-    const std::string fullstr = StringUtils::Lower(std::string(str));
+    m_nodes.emplace_back();
 
-    // See if it matches a LUT name.
-    // This is the position of the RIGHT end of the colorspace substring,
-    // not the left
-    int rightMostColorPos = -1;
-    std::string rightMostColorspace = "";
-    int rightMostColorSpaceIndex = -1;
+    for (size_t idx = 0; idx < m_names.size(); ++idx)
+    {
+        const std::string name = StringUtils::Lower(m_names[idx]);
+        if (name.empty()) continue;
 
-    // Find the right-most occcurance within the string for each colorspace.
-    for (int i = 0; i < config.getNumColorSpaces(SEARCH_REFERENCE_SPACE_ALL, COLORSPACE_ALL); ++i)
+        int node = 0;
+        for (const char c : name)
+        {
+            const auto it = m_nodes[node].m_next.find(c);
+            if (it != m_nodes[node].m_next.end())
+            {
+                node = it->second;
+            }
+            else
+            {
+                const int newNode = static_cast<int>(m_nodes.size());
+                m_nodes[node].m_next[c] = newNode;
+                m_nodes.emplace_back();
+                node = newNode;
+            }
+        }
+        m_nodes[node].m_match = static_cast<int>(idx);
+    }
+
+    // Compute the failure links in breadth-first order, so the ones of the shorter
+    // prefixes are always available. A node without its own name inherits the longest
+    // name ending at its failure node.
+
+    std::deque<int> queue;
+    for (const auto & next : m_nodes[0].m_next)
     {
-        const std::string csname = StringUtils::Lower(config.getColorSpaceNameByIndex(i));
+        queue.push_back(next.second);
+    }
+
+    while (!queue.empty())
+    {
+        const int node = queue.front();
+        queue.pop_front();
+
+        for (const auto & next : m_nodes[node].m_next)
+        {
+            const char c   = next.first;
+            const int child = next.second;
 
-        // find right-most extension matched in filename
-        int colorspacePos = (int)StringUtils::ReverseFind(fullstr, csname);
-        if (colorspacePos < 0)
-            continue;
+            int fail = m_nodes[node].m_fail;
+            while (fail != 0 && m_nodes[fail].m_next.find(c) == m_nodes[fail].m_next.end())
+            {
+                fail = m_nodes[fail].m_fail;
+            }
+
+            const auto it = m_nodes[fail].m_next.find(c);
+            m_nodes[child].m_fail = (it != m_nodes[fail].m_next.end()) ? it->second : 0;
+
+            if (m_nodes[child].m_match == -1)
+            {
+                m_nodes[child].m_match = m_nodes[m_nodes[child].m_fail].m_match;
+            }
+
+            queue.push_back(child);
+        }
+    }
+}
+
+int ColorSpaceNameMatcher::findRightMost(const char * str) const
+{
+    if (!str) return -1;
 
-        // If we have found a match, move the pointer over to the right end
-        // of the substring.  This will allow us to find the longest name
-        // that matches the rightmost colorspace
-        colorspacePos += (int)csname.size();
+    int rightMostIndex = -1;
 
-        if ((colorspacePos > rightMostColorPos) ||
-            ((colorspacePos == rightMostColorPos) && (csname.size() > rightMostColorspace.size()))
-            )
+    int node = 0;
+    for (const char * ptr = str; *ptr; ++ptr)
+    {
+        const char c = static_cast<char>(StringUtils::Lower(static_cast<unsigned char>(*ptr)));
+
+        auto it = m_nodes[node].m_next.find(c);
+        while (node != 0 && it == m_nodes[node].m_next.end())
+        {
+            node = m_nodes[node].m_fail;
+            it = m_nodes[node].m_next.find(c);
+        }
+        node = (it != m_nodes[node].m_next.end()) ? it->second : 0;
+
+        // The last name found is the right-most one and, as the node is the longest
+        // suffix in the trie, also the longest one ending there.
+        if (m_nodes[node].m_match != -1)
         {
-            rightMostColorPos = colorspacePos;
-            rightMostColorspace = csname;
-            rightMostColorSpaceIndex = i;
+            rightMostIndex = m_nodes[node].m_match;
         }
     }
-    return rightMostColorSpaceIndex;
+
+    return rightMostIndex;
+}
+
+ConstColorSpaceNameMatcherRcPtr CreateColorSpaceNameMatcher(const Config & config)
+{
+    std::vector<std::string> names;
+
+    const int numColorSpaces = config.getNumColorSpaces();
+    names.reserve(numColorSpaces);
+    for (int idx = 0; idx < numColorSpaces; ++idx)
+    {
+        names.push_back(config.getColorSpaceNameByIndex(idx));
+    }
+
+    return std::make_shared<ColorSpaceNameMatcher>(names);
+}
+
+int ParseColorSpaceFromString(const Config & config, const char * str)
+{
+    return CreateColorSpaceNameMatcher(config)->findRightMost(str);
 }
 
 } // namespace OCIO_NAMESPACE
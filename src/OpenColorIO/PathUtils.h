@@ -8,6 +8,10 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace OCIO_NAMESPACE
 {
@@ -56,6 +60,54 @@ std::string GetFastFileHash(const std::string & filename);
 
 void ClearPathCaches();
 
+// Get a stamp changing whenever entries are added to or removed from a directory (i.e. the
+// inode number and the mtime, with the sub-second part when available). It is empty if the
+// directory does not exist. Note that, unlike GetFastFileHash(), the result is not cached.
+std::string GetDirectoryStamp(const std::string & dirname);
+
+// Get the names of all the entries of a directory, except '.' and '..'. Return false if the
+// directory can't be read.
+bool GetDirectoryEntries(const std::string & dirname, std::unordered_set<std::string> & names);
+
+// Find color space names in a string (e.g. a file path) ignoring the case. All the names
+// are searched at once using an Aho-Corasick automaton so the search cost does not depend
+// on the number of names.
+class ColorSpaceNameMatcher
+{
+public:
+    ColorSpaceNameMatcher() = delete;
+    ColorSpaceNameMatcher(const ColorSpaceNameMatcher &) = delete;
+    ColorSpaceNameMatcher & operator=(const ColorSpaceNameMatcher &) = delete;
+
+    // Empty names are ignored.
+    explicit ColorSpaceNameMatcher(const std::vector<std::string> & names);
+    ~ColorSpaceNameMatcher() = default;
+
+    // Return the index of the name ending the right-most in the string or -1 if there is
+    // none. When several names end at the same position, the longest one wins.
+    int findRightMost(const char * str) const;
+
+    const char * getName(int index) const { return m_names[index].c_str(); }
+
+private:
+    struct Node
+    {
+        std::map<char, int> m_next; // Transitions on the lower-case characters.
+        int m_fail  = 0;            // Longest proper suffix which is also in the trie.
+        int m_match = -1;           // Longest name ending at this node (i.e. a suffix).
+    };
+
+    std::vector<std::string> m_names;
+    std::vector<Node> m_nodes;
+};
+
+typedef std::shared_ptr<const ColorSpaceNameMatcher> ConstColorSpaceNameMatcherRcPtr;
+
+// Create the matcher for all the active color spaces of the config i.e. the found index is
+// the one of Config::getColorSpaceNameByIndex().
+ConstColorSpaceNameMatcherRcPtr CreateColorSpaceNameMatcher(const Config & config);
+
+// Note that the config caches its matcher, refer to Config::parseColorSpaceFromString().
 int ParseColorSpaceFromString(const Config & config, const char * str);
 
 } // namespace OCIO_NAMESPACE
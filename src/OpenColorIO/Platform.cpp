@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <fstream>
+#include <iterator>
 #include <random>
 #include <sstream>
 #include <vector>
@@ -10,7 +12,11 @@
 #include "Platform.h"
 
 #ifndef _WIN32
+#include <fcntl.h>
 #include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 
@@ -181,6 +187,107 @@ std::string CreateTempFilename(const std::string & filenameExt)
     return filename;
 }
 
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string & filepath)
+{
+    close();
+
+#ifdef _WIN32
+
+    HANDLE file = ::CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER fileSize;
+        if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping)
+            {
+                void * view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                // The view keeps a reference on the mapping.
+                ::CloseHandle(mapping);
+
+                if (view)
+                {
+                    m_data   = static_cast<const char *>(view);
+                    m_size   = static_cast<size_t>(fileSize.QuadPart);
+                    m_mapped = true;
+                }
+            }
+        }
+        ::CloseHandle(file);
+
+        if (m_mapped)
+        {
+            return true;
+        }
+    }
+
+#else
+
+    const int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+        struct stat fileStat;
+        if (::fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0)
+        {
+            void * addr = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size),
+                                 PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                m_data   = static_cast<const char *>(addr);
+                m_size   = static_cast<size_t>(fileStat.st_size);
+                m_mapped = true;
+            }
+        }
+        // The mapping stays valid once the file descriptor is closed.
+        ::close(fd);
+
+        if (m_mapped)
+        {
+            return true;
+        }
+    }
+
+#endif
+
+    // Fallback for the empty files, the special files or any mapping failure.
+    std::ifstream filestream(filepath.c_str(), std::ios_base::binary);
+    if (!filestream.good())
+    {
+        return false;
+    }
+
+    m_buffer.assign(std::istreambuf_iterator<char>(filestream),
+                    std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_mapped)
+    {
+#ifdef _WIN32
+        ::UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+    }
+
+    m_data   = nullptr;
+    m_size   = 0;
+    m_mapped = false;
+    m_buffer.clear();
+}
+
 
 
 } // Platform
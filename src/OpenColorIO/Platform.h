@@ -70,6 +70,33 @@ void AlignedFree(void * memBlock);
 //       the file if created.
 std::string CreateTempFilename(const std::string & filenameExt);
 
+// Read-only view of a whole file content. The file is memory mapped when possible,
+// otherwise it is read in memory.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    // Return false if the file could not be opened.
+    bool open(const std::string & filepath);
+    void close();
+
+    // Note: The content is not null terminated.
+    const char * data() const noexcept { return m_data; }
+    size_t size() const noexcept { return m_size; }
+
+    bool isMapped() const noexcept { return m_mapped; }
+
+private:
+    const char * m_data = nullptr;
+    size_t m_size       = 0;
+    bool m_mapped       = false;
+    std::string m_buffer; // Only used when the file is not mapped.
+};
+
 }
 
 } // namespace OCIO_NAMESPACE
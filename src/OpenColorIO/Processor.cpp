@@ -12,6 +12,7 @@
 #include "GPUProcessor.h"
 #include "HashUtils.h"
 #include "OpBuilders.h"
+#include "OpSerialization.h"
 #include "Processor.h"
 #include "TransformBuilder.h"
 #include "transforms/FileTransform.h"
@@ -175,6 +176,18 @@ const char * Processor::getFormatExtensionByIndex(int index)
     return FormatRegistry::GetInstance().getFormatExtensionByIndex(FORMAT_CAPABILITY_WRITE, index);
 }
 
+void Processor::serialize(std::ostream & os) const
+{
+    getImpl()->serialize(os);
+}
+
+ConstProcessorRcPtr Processor::CreateFromStream(std::istream & is)
+{
+    ProcessorRcPtr processor = Create();
+    processor->getImpl()->setFromStream(is);
+    return processor;
+}
+
 bool Processor::hasDynamicProperty(DynamicPropertyType type) const
 {
     return getImpl()->hasDynamicProperty(type);
@@ -228,8 +241,22 @@ ConstCPUProcessorRcPtr Processor::getOptimizedCPUProcessor(BitDepth inBitDepth,
     return getImpl()->getOptimizedCPUProcessor(inBitDepth, outBitDepth, oFlags);
 }
 
+ConstCPUProcessorRcPtr Processor::getTimedCPUProcessor(BitDepth inBitDepth,
+                                                       BitDepth outBitDepth,
+                                                       OptimizationFlags oFlags) const
+{
+    return getImpl()->getTimedCPUProcessor(inBitDepth, outBitDepth, oFlags);
+}
+
+namespace
+{
+// Only few bit-depth and optimization flag combinations are used for a given processor.
+constexpr size_t DEFAULT_CPU_PROCESSOR_CACHE_SIZE = 8;
+}
+
 Processor::Impl::Impl():
-    m_metadata(ProcessorMetadata::Create())
+    m_metadata(ProcessorMetadata::Create()),
+    m_cpuProcessorCache(DEFAULT_CPU_PROCESSOR_CACHE_SIZE)
 {
 }
 
@@ -321,6 +348,23 @@ void Processor::Impl::write(const char * formatName, std::ostream & os) const
     }
 }
 
+void Processor::Impl::serialize(std::ostream & os) const
+{
+    WriteBinaryOps(os, m_ops, *m_metadata);
+}
+
+bool Processor::Impl::isDynamic() const
+{
+    for (const auto & op : m_ops)
+    {
+        if (op->isDynamic())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool Processor::Impl::hasDynamicProperty(DynamicPropertyType type) const
 {
     return m_ops.hasDynamicProperty(type);
@@ -428,9 +472,42 @@ ConstCPUProcessorRcPtr Processor::Impl::getOptimizedCPUProcessor(BitDepth inBitD
                                                                  BitDepth outBitDepth,
                                                                  OptimizationFlags oFlags) const
 {
+    oFlags = EnvironmentOverride(oFlags);
+
+    // The CPU processor dynamic properties are decoupled from the processor ones so each
+    // request must then return a different instance when dynamic properties are present.
+    const bool cacheable = !isDynamic();
+
+    const unsigned long long key = (static_cast<unsigned long long>(oFlags) << 16)
+                                 | (static_cast<unsigned long long>(inBitDepth) << 8)
+                                 | static_cast<unsigned long long>(outBitDepth);
+
+    ConstCPUProcessorRcPtr cachedCpu;
+    if (cacheable && m_cpuProcessorCache.get(key, cachedCpu))
+    {
+        return cachedCpu;
+    }
+
     CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
+    cpu->getImpl()->finalize(m_ops, inBitDepth, outBitDepth, oFlags);
 
+    if (cacheable)
+    {
+        m_cpuProcessorCache.add(key, cpu);
+    }
+
+    return cpu;
+}
+
+ConstCPUProcessorRcPtr Processor::Impl::getTimedCPUProcessor(BitDepth inBitDepth,
+                                                             BitDepth outBitDepth,
+                                                             OptimizationFlags oFlags) const
+{
     oFlags = EnvironmentOverride(oFlags);
+
+    // The accumulated timings are part of the instance so it is never shared.
+    CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
+    cpu->getImpl()->setOpTimingEnabled(true);
     cpu->getImpl()->finalize(m_ops, inBitDepth, outBitDepth, oFlags);
 
     return cpu;
@@ -478,6 +555,21 @@ void Processor::Impl::setTransform(const Config & config,
     m_ops.unifyDynamicProperties();
 }
 
+void Processor::Impl::setFromStream(std::istream & is)
+{
+    if (!m_ops.empty())
+    {
+        throw Exception("Internal error: Processor should be empty");
+    }
+
+    ReadBinaryOps(is, m_ops, *m_metadata);
+
+    // The ops were finalized before being written, this only prepares them again for the
+    // processing (e.g. the inverse LUT 1D properties).
+    m_ops.finalize(OPTIMIZATION_NONE);
+    m_ops.unifyDynamicProperties();
+}
+
 void Processor::Impl::concatenate(ConstProcessorRcPtr & p1, ConstProcessorRcPtr & p2)
 {
     m_ops = p1->getImpl()->m_ops;
@@ -7,6 +7,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Caching.h"
 #include "Mutex.h"
 #include "Op.h"
 #include "PrivateTypes.h"
@@ -25,6 +26,9 @@ private:
 
     mutable Mutex m_resultsCacheMutex;
 
+    // Optimized CPU processors keyed on the bit-depths and optimization flags.
+    mutable GenericCache<unsigned long long, ConstCPUProcessorRcPtr> m_cpuProcessorCache;
+
 public:
     Impl();
     ~Impl();
@@ -41,6 +45,9 @@ public:
     int getNumTransforms() const;
     const FormatMetadata & getTransformFormatMetadata(int index) const;
 
+    // Is there at least one op having a dynamic property?
+    bool isDynamic() const;
+
     bool hasDynamicProperty(DynamicPropertyType type) const;
     DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
 
@@ -50,6 +57,8 @@ public:
 
     void write(const char * formatName, std::ostream & os) const;
 
+    void serialize(std::ostream & os) const;
+
     void apply(ImageDesc& img) const;
 
     ConstProcessorRcPtr getOptimizedProcessor(OptimizationFlags oFlags) const;
@@ -74,6 +83,11 @@ public:
                                                     BitDepth outBitDepth,
                                                     OptimizationFlags oFlags) const;
 
+    // Get a new (i.e. never cached) CPU processor instance with the op timing enabled.
+    ConstCPUProcessorRcPtr getTimedCPUProcessor(BitDepth inBitDepth,
+                                                BitDepth outBitDepth,
+                                                OptimizationFlags oFlags) const;
+
     ////////////////////////////////////////////
     //
     // Builder functions, Not exposed
@@ -88,6 +102,9 @@ public:
                       const ConstTransformRcPtr& transform,
                       TransformDirection direction);
 
+    // Rebuild the ops and the metadata from the binary serialization.
+    void setFromStream(std::istream & is);
+
     void concatenate(ConstProcessorRcPtr & p1, ConstProcessorRcPtr & p2);
 
     void computeMetadata();
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "CPUInfo.h"
+#include "SIMDKernels.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Defined in translation units compiled with the matching instruction set flags, so they
+// must only be used once the CPU support is checked.
+#ifdef USE_AVX2
+extern const SIMDKernels AVX2Kernels;
+#endif
+#ifdef USE_AVX512
+extern const SIMDKernels AVX512Kernels;
+#endif
+
+const SIMDKernels * GetSIMDKernels(SIMDTier tier)
+{
+    const CPUInfo & cpu = CPUInfo::Instance();
+
+    switch (tier)
+    {
+        case SIMD_TIER_DEFAULT:
+            break;
+
+        case SIMD_TIER_AVX2:
+#ifdef USE_AVX2
+            if (cpu.m_hasAVX2)
+            {
+                return &AVX2Kernels;
+            }
+#endif
+            break;
+
+        case SIMD_TIER_AVX512:
+#ifdef USE_AVX512
+            if (cpu.m_hasAVX512F)
+            {
+                return &AVX512Kernels;
+            }
+#endif
+            break;
+    }
+
+    (void)cpu;
+    return nullptr;
+}
+
+const SIMDKernels * GetSIMDKernels()
+{
+    static const SIMDKernels * kernels = []() -> const SIMDKernels *
+    {
+        const SIMDKernels * best = GetSIMDKernels(SIMD_TIER_AVX512);
+        return best ? best : GetSIMDKernels(SIMD_TIER_AVX2);
+    }();
+
+    return kernels;
+}
+
+} // namespace OCIO_NAMESPACE
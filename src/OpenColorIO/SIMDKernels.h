@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_SIMDKERNELS_H
+#define INCLUDED_OCIO_SIMDKERNELS_H
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+namespace OCIO_NAMESPACE
+{
+
+// The CPU renderers are written for SSE2 (i.e. one RGBA pixel per register). The kernels
+// below process several packed RGBA F32 pixels per register using wider instruction sets
+// (i.e. AVX2 or AVX-512) and are selected at runtime based on the running CPU. They use
+// the same approximations as the SSE2 code so the results do not depend on the CPU.
+//
+// All the per-channel parameters are in RGBA order, and the 'in' and 'out' buffers may
+// be the same buffer.
+
+enum SIMDTier
+{
+    SIMD_TIER_DEFAULT = 0, // The renderers use their own SSE2 or scalar code.
+    SIMD_TIER_AVX2,        // 8 lanes i.e. 2 pixels per register.
+    SIMD_TIER_AVX512       // 16 lanes i.e. 4 pixels per register.
+};
+
+// out = in * scale + offset
+struct ScaleKernelParams
+{
+    float m_scale[4]  = { 1.f, 1.f, 1.f, 1.f };
+    float m_offset[4] = { 0.f, 0.f, 0.f, 0.f };
+};
+
+// out[i] = m[i][0] * in[0] + m[i][1] * in[1] + m[i][2] * in[2] + m[i][3] * in[3] + offset[i]
+//
+// The additions are done in the same order as the SSE2 renderer so that all the
+// tiers produce the same values.
+struct MatrixKernelParams
+{
+    float m_column[4][4] = { { 1.f, 0.f, 0.f, 0.f },
+                             { 0.f, 1.f, 0.f, 0.f },
+                             { 0.f, 0.f, 1.f, 0.f },
+                             { 0.f, 0.f, 0.f, 1.f } };
+    float m_offset[4] = { 0.f, 0.f, 0.f, 0.f };
+};
+
+// out = pow(max(0, in * preScale + preOffset), exponent) * postScale + postOffset
+//
+// When m_linearSegment is true, the values smaller or equal to m_breakPnt use
+// out = in * slope instead. When m_mirror is true, the computation uses abs(in) and the
+// input sign is then restored. When m_keepAlpha is true, the alpha is passed through.
+struct PowerKernelParams
+{
+    float m_preScale[4]   = { 1.f, 1.f, 1.f, 1.f };
+    float m_preOffset[4]  = { 0.f, 0.f, 0.f, 0.f };
+    float m_exponent[4]   = { 1.f, 1.f, 1.f, 1.f };
+    float m_postScale[4]  = { 1.f, 1.f, 1.f, 1.f };
+    float m_postOffset[4] = { 0.f, 0.f, 0.f, 0.f };
+    float m_breakPnt[4]   = { 0.f, 0.f, 0.f, 0.f };
+    float m_slope[4]      = { 1.f, 1.f, 1.f, 1.f };
+
+    bool m_linearSegment = false;
+    bool m_mirror        = false;
+    bool m_keepAlpha     = false;
+};
+
+// The log kernel computes
+//   out = log2(max(FLT_MIN, in * preScale + preOffset)) * postScale + postOffset
+// and the anti-log kernel computes
+//   out = (exp2((in + preOffset) * preScale) + postOffset) * postScale
+//
+// When m_linearSegment is true, the values smaller or equal to m_breakPnt respectively use
+//   out = in * linScale + linOffset  and  out = (in + linOffset) * linScale
+// instead. The alpha is always passed through.
+struct LogKernelParams
+{
+    float m_preScale[4]   = { 1.f, 1.f, 1.f, 1.f };
+    float m_preOffset[4]  = { 0.f, 0.f, 0.f, 0.f };
+    float m_postScale[4]  = { 1.f, 1.f, 1.f, 1.f };
+    float m_postOffset[4] = { 0.f, 0.f, 0.f, 0.f };
+    float m_breakPnt[4]   = { 0.f, 0.f, 0.f, 0.f };
+    float m_linScale[4]   = { 1.f, 1.f, 1.f, 1.f };
+    float m_linOffset[4]  = { 0.f, 0.f, 0.f, 0.f };
+
+    bool m_linearSegment = false;
+};
+
+// ASC CDL using the render parameters of the CDL renderers (i.e. already inverted for
+// the reverse styles). The alpha is passed through.
+struct CDLKernelParams
+{
+    float m_slope[4]  = { 1.f, 1.f, 1.f, 1.f };
+    float m_offset[4] = { 0.f, 0.f, 0.f, 0.f };
+    float m_power[4]  = { 1.f, 1.f, 1.f, 1.f };
+    float m_saturation = 1.f;
+
+    bool m_reverse = false;
+    bool m_clamp   = true;
+};
+
+struct SIMDKernels
+{
+    const char * m_name;
+
+    void (*m_scale)(const float * in, float * out, long numPixels,
+                    const ScaleKernelParams & params);
+    void (*m_matrix)(const float * in, float * out, long numPixels,
+                     const MatrixKernelParams & params);
+    void (*m_power)(const float * in, float * out, long numPixels,
+                    const PowerKernelParams & params);
+    void (*m_log)(const float * in, float * out, long numPixels,
+                  const LogKernelParams & params);
+    void (*m_antiLog)(const float * in, float * out, long numPixels,
+                      const LogKernelParams & params);
+    void (*m_cdl)(const float * in, float * out, long numPixels,
+                  const CDLKernelParams & params);
+};
+
+// Return the kernels of the requested tier, or null if the tier is not built or not
+// supported by the running CPU.
+const SIMDKernels * GetSIMDKernels(SIMDTier tier);
+
+// Return the kernels of the widest tier supported by the build and the running CPU, or
+// null if the renderers have to use their own code.
+const SIMDKernels * GetSIMDKernels();
+
+} // namespace OCIO_NAMESPACE
+
+#endif
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+// This translation unit is compiled with the AVX2 instruction set enabled, so nothing
+// from it may be called before checking the CPU support (see SIMDKernels.cpp).
+
+#include <immintrin.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "SIMDKernels.h"
+
+
+namespace OCIO_NAMESPACE
+{
+namespace
+{
+
+struct AVX2
+{
+    typedef __m256  F;
+    typedef __m256i I;
+    typedef __m256  M;
+
+    static constexpr long NumPixels = 2;
+
+    static F load(const float * p) { return _mm256_loadu_ps(p); }
+    static void store(float * p, F v) { _mm256_storeu_ps(p, v); }
+
+    static F set1(float v) { return _mm256_set1_ps(v); }
+    static F setRGBA(const float * rgba)
+    {
+        const __m128 v = _mm_loadu_ps(rgba);
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(v), v, 1);
+    }
+
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F min(F a, F b) { return _mm256_min_ps(a, b); }
+    static F max(F a, F b) { return _mm256_max_ps(a, b); }
+
+    static F bitAnd(F a, F b) { return _mm256_and_ps(a, b); }
+    static F bitOr(F a, F b) { return _mm256_or_ps(a, b); }
+    static F bitAndNot(F a, F b) { return _mm256_andnot_ps(a, b); }
+
+    static M cmpgt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static M cmplt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static F select(M mask, F t, F f) { return _mm256_blendv_ps(f, t, mask); }
+
+    static I set1i(int v) { return _mm256_set1_epi32(v); }
+    static I castToInt(F a) { return _mm256_castps_si256(a); }
+    static F castToFloat(I a) { return _mm256_castsi256_ps(a); }
+    static F cvtToFloat(I a) { return _mm256_cvtepi32_ps(a); }
+    static I addi(I a, I b) { return _mm256_add_epi32(a, b); }
+    static I subi(I a, I b) { return _mm256_sub_epi32(a, b); }
+    static I andi(I a, I b) { return _mm256_and_si256(a, b); }
+    template<int N> static I slli(I a) { return _mm256_slli_epi32(a, N); }
+    template<int N> static I srli(I a) { return _mm256_srli_epi32(a, N); }
+
+    static I floorToInt(F a)
+    {
+        const F notPositive = _mm256_cmp_ps(_mm256_setzero_ps(), a, _CMP_NLE_UQ);
+        return _mm256_add_epi32(_mm256_cvttps_epi32(a), castToInt(notPositive));
+    }
+
+    template<int IMM> static F permute(F a) { return _mm256_permute_ps(a, IMM); }
+
+    static F keepAlpha(F res, F in) { return _mm256_blend_ps(res, in, 0x88); }
+};
+
+} // anon.
+} // namespace OCIO_NAMESPACE
+
+#include "SIMDKernelsImpl.h"
+
+namespace OCIO_NAMESPACE
+{
+
+extern const SIMDKernels AVX2Kernels;
+const SIMDKernels AVX2Kernels = MakeSIMDKernels<AVX2>("AVX2");
+
+} // namespace OCIO_NAMESPACE
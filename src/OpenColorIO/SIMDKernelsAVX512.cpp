@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+// This translation unit is compiled with the AVX-512 foundation instruction set enabled,
+// so nothing from it may be called before checking the CPU support (see SIMDKernels.cpp).
+
+#include <immintrin.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "SIMDKernels.h"
+
+
+namespace OCIO_NAMESPACE
+{
+namespace
+{
+
+// Some AVX-512 intrinsics pass an _mm512_undefined_*() source to their builtin, which some
+// GCC versions report as used uninitialized once inlined. Their zero-masked forms with a
+// full mask compile to the same instructions and are used instead.
+struct AVX512
+{
+    typedef __m512    F;
+    typedef __m512i   I;
+    typedef __mmask16 M;
+
+    static constexpr M FullMask = 0xFFFF;
+
+    static constexpr long NumPixels = 4;
+
+    static F load(const float * p) { return _mm512_loadu_ps(p); }
+    static void store(float * p, F v) { _mm512_storeu_ps(p, v); }
+
+    static F set1(float v) { return _mm512_set1_ps(v); }
+    static F setRGBA(const float * rgba)
+    {
+        return _mm512_set4_ps(rgba[3], rgba[2], rgba[1], rgba[0]);
+    }
+
+    static F add(F a, F b) { return _mm512_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm512_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm512_mul_ps(a, b); }
+    static F min(F a, F b) { return _mm512_maskz_min_ps(FullMask, a, b); }
+    static F max(F a, F b) { return _mm512_maskz_max_ps(FullMask, a, b); }
+
+    // The floating-point bitwise operations need AVX-512DQ so use the integer ones.
+    static F bitAnd(F a, F b)
+    {
+        return castToFloat(_mm512_and_si512(castToInt(a), castToInt(b)));
+    }
+    static F bitOr(F a, F b)
+    {
+        return castToFloat(_mm512_or_si512(castToInt(a), castToInt(b)));
+    }
+    static F bitAndNot(F a, F b)
+    {
+        return castToFloat(_mm512_maskz_andnot_epi32(FullMask, castToInt(a), castToInt(b)));
+    }
+
+    static M cmpgt(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static M cmplt(F a, F b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static F select(M mask, F t, F f) { return _mm512_mask_blend_ps(mask, f, t); }
+
+    static I set1i(int v) { return _mm512_set1_epi32(v); }
+    static I castToInt(F a) { return _mm512_castps_si512(a); }
+    static F castToFloat(I a) { return _mm512_castsi512_ps(a); }
+    static F cvtToFloat(I a) { return _mm512_maskz_cvtepi32_ps(FullMask, a); }
+    static I addi(I a, I b) { return _mm512_add_epi32(a, b); }
+    static I subi(I a, I b) { return _mm512_sub_epi32(a, b); }
+    static I andi(I a, I b) { return _mm512_and_si512(a, b); }
+    template<int N> static I slli(I a) { return _mm512_maskz_slli_epi32(FullMask, a, N); }
+    template<int N> static I srli(I a) { return _mm512_maskz_srli_epi32(FullMask, a, N); }
+
+    static I floorToInt(F a)
+    {
+        const M notPositive = _mm512_cmp_ps_mask(_mm512_setzero_ps(), a, _CMP_NLE_UQ);
+        const I truncated = _mm512_maskz_cvttps_epi32(FullMask, a);
+        return _mm512_mask_sub_epi32(truncated, notPositive, truncated, set1i(1));
+    }
+
+    template<int IMM> static F permute(F a) { return _mm512_maskz_permute_ps(FullMask, a, IMM); }
+
+    static F keepAlpha(F res, F in) { return _mm512_mask_blend_ps(0x8888, res, in); }
+};
+
+} // anon.
+} // namespace OCIO_NAMESPACE
+
+#include "SIMDKernelsImpl.h"
+
+namespace OCIO_NAMESPACE
+{
+
+extern const SIMDKernels AVX512Kernels;
+const SIMDKernels AVX512Kernels = MakeSIMDKernels<AVX512>("AVX512");
+
+} // namespace OCIO_NAMESPACE
@@ -0,0 +1,446 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_SIMDKERNELSIMPL_H
+#define INCLUDED_OCIO_SIMDKERNELSIMPL_H
+
+#include <cstring>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "SIMDKernels.h"
+
+
+// Implementation of the kernels declared in SIMDKernels.h for a given register type V.
+//
+// This header must only be included by the translation units compiled with the
+// instruction set flags of a tier (e.g. SIMDKernelsAVX2.cpp). Everything is in an
+// anonymous namespace and only instantiated with types from an anonymous namespace so
+// that the linker can never pick one of these functions for code running on a CPU
+// without the matching instruction set.
+//
+// V provides the following static members:
+//   - F, I and M: the float, integer and comparison mask types,
+//   - NumPixels: the number of RGBA pixels in one register,
+//   - load, store, set1, setRGBA, add, sub, mul, min, max,
+//   - bitAnd, bitOr, bitAndNot, cmpgt, cmplt, select,
+//   - set1i, castToInt, castToFloat, cvtToFloat, addi, subi, andi, slli, srli,
+//   - floorToInt: the integer part computed like sseExp2() i.e. the truncation minus one
+//     when x is not greater or equal to zero,
+//   - permute<IMM>: shuffle each pixel (i.e. each 128-bit lane) like _mm_shuffle_ps(x, x, IMM),
+//   - keepAlpha(res, in): res with the alpha channel of in.
+
+namespace OCIO_NAMESPACE
+{
+namespace
+{
+
+// Same coefficients and the same sequence of operations as the SSE2 approximations from
+// SSE.h so that the results are identical (i.e. including the special values) whatever
+// the instruction set used by the CPU renderers.
+constexpr float PNLOG5 = (float)+4.487361286440374006195e-2;
+constexpr float PNLOG4 = (float)-4.165637071209677112635e-1;
+constexpr float PNLOG3 = (float)+1.631148826119436277100;
+constexpr float PNLOG2 = (float)-3.550793018041176193407;
+constexpr float PNLOG1 = (float)+5.091710879305474367557;
+constexpr float PNLOG0 = (float)-2.800364054395965731506;
+
+constexpr float PNEXP4 = (float)1.353416792833547468620e-2;
+constexpr float PNEXP3 = (float)5.201146058412685018921e-2;
+constexpr float PNEXP2 = (float)2.414427569091865207710e-1;
+constexpr float PNEXP1 = (float)6.930038344665415134202e-1;
+constexpr float PNEXP0 = (float)1.000002593370603213644;
+
+constexpr int EXPONENT_MASK = 0x7F800000;
+constexpr int EXPONENT_BIAS = 127;
+constexpr int SIGN_MASK     = (int)0x80000000;
+constexpr int ABS_MASK      = 0x7FFFFFFF;
+
+// Smallest normalized float i.e. FLT_MIN.
+constexpr float MIN_NORMALIZED = 1.17549435e-38f;
+
+template<typename V>
+inline typename V::F Log2(typename V::F x)
+{
+    // log2(x) = exponent + log2(mantissa) where the mantissa is in [1, 2[.
+    const typename V::F mantissa
+        = V::bitOr(V::bitAndNot(V::castToFloat(V::set1i(EXPONENT_MASK)), x), V::set1(1.0f));
+
+    typename V::F log2 = V::add(V::mul(V::set1(PNLOG5), mantissa), V::set1(PNLOG4));
+    log2 = V::add(V::mul(log2, mantissa), V::set1(PNLOG3));
+    log2 = V::add(V::mul(log2, mantissa), V::set1(PNLOG2));
+    log2 = V::add(V::mul(log2, mantissa), V::set1(PNLOG1));
+    log2 = V::add(V::mul(log2, mantissa), V::set1(PNLOG0));
+
+    const typename V::I exponent
+        = V::subi(V::template srli<23>(V::andi(V::castToInt(x), V::set1i(EXPONENT_MASK))),
+                  V::set1i(EXPONENT_BIAS));
+
+    return V::add(log2, V::cvtToFloat(exponent));
+}
+
+template<typename V>
+inline typename V::F Exp2(typename V::F x)
+{
+    // exp2(x) = exp2(integer) * exp2(fraction) where the fraction is in [0, 1[.
+    const typename V::I floor_x = V::floorToInt(x);
+
+    const typename V::F zf
+        = V::castToFloat(V::template slli<23>(V::addi(floor_x, V::set1i(EXPONENT_BIAS))));
+
+    const typename V::F iexp = V::cvtToFloat(floor_x);
+    const typename V::F fraction = V::sub(x, iexp);
+
+    typename V::F mexp = V::add(V::mul(V::set1(PNEXP4), fraction), V::set1(PNEXP3));
+    mexp = V::add(V::mul(mexp, fraction), V::set1(PNEXP2));
+    mexp = V::add(V::mul(mexp, fraction), V::set1(PNEXP1));
+    mexp = V::add(V::mul(mexp, fraction), V::set1(PNEXP0));
+
+    typename V::F exp2 = V::mul(zf, mexp);
+
+    // Handle the underflow and the overflow like sseExp2().
+    exp2 = V::select(V::cmplt(iexp, V::set1(-126.0f)), V::set1(0.0f), exp2);
+    exp2 = V::select(V::cmpgt(iexp, V::set1(127.0f)),
+                     V::castToFloat(V::set1i(EXPONENT_MASK)), exp2);
+
+    return exp2;
+}
+
+// pow(x, exp) = exp2(exp * log2(x)) where bases smaller or equal to zero map to zero.
+template<typename V>
+inline typename V::F Power(typename V::F x, typename V::F exp)
+{
+    const typename V::F values = Exp2<V>(V::mul(exp, Log2<V>(x)));
+    return V::select(V::cmpgt(x, V::set1(0.0f)), values, V::set1(0.0f));
+}
+
+// Apply the function to all the pixels, V::NumPixels at a time. The remaining pixels are
+// processed through a temporary buffer.
+template<typename V, typename Func>
+inline void ApplyToPixels(const float * in, float * out, long numPixels, const Func & func)
+{
+    constexpr long numFloats = 4 * V::NumPixels;
+
+    long idx = 0;
+    for (; idx + V::NumPixels <= numPixels; idx += V::NumPixels)
+    {
+        V::store(out, func(V::load(in)));
+
+        in  += numFloats;
+        out += numFloats;
+    }
+
+    const long remaining = numPixels - idx;
+    if (remaining > 0)
+    {
+        float buffer[numFloats] = { 0.0f };
+        std::memcpy(buffer, in, remaining * 4 * sizeof(float));
+
+        V::store(buffer, func(V::load(buffer)));
+
+        std::memcpy(out, buffer, remaining * 4 * sizeof(float));
+    }
+}
+
+template<typename V>
+void ApplyScale(const float * in, float * out, long numPixels, const ScaleKernelParams & params)
+{
+    const typename V::F scale  = V::setRGBA(params.m_scale);
+    const typename V::F offset = V::setRGBA(params.m_offset);
+
+    ApplyToPixels<V>(in, out, numPixels, [&](typename V::F pix)
+    {
+        return V::add(V::mul(pix, scale), offset);
+    });
+}
+
+template<typename V>
+void ApplyMatrix(const float * in, float * out, long numPixels, const MatrixKernelParams & params)
+{
+    const typename V::F m0 = V::setRGBA(params.m_column[0]);
+    const typename V::F m1 = V::setRGBA(params.m_column[1]);
+    const typename V::F m2 = V::setRGBA(params.m_column[2]);
+    const typename V::F m3 = V::setRGBA(params.m_column[3]);
+    const typename V::F offset = V::setRGBA(params.m_offset);
+
+    ApplyToPixels<V>(in, out, numPixels, [&](typename V::F pix)
+    {
+        const typename V::F rm0 = V::mul(m0, V::template permute<0x00>(pix));
+        const typename V::F gm1 = V::mul(m1, V::template permute<0x55>(pix));
+        const typename V::F bm2 = V::mul(m2, V::template permute<0xAA>(pix));
+        const typename V::F am3 = V::mul(m3, V::template permute<0xFF>(pix));
+
+        return V::add(V::add(V::add(rm0, gm1), V::add(bm2, am3)), offset);
+    });
+}
+
+template<typename V, bool LINEAR_SEGMENT, bool MIRROR, bool KEEP_ALPHA>
+void ApplyPower(const float * in, float * out, long numPixels, const PowerKernelParams & params)
+{
+    const typename V::F preScale   = V::setRGBA(params.m_preScale);
+    const typename V::F preOffset  = V::setRGBA(params.m_preOffset);
+    const typename V::F exponent   = V::setRGBA(params.m_exponent);
+    const typename V::F postScale  = V::setRGBA(params.m_postScale);
+    const typename V::F postOffset = V::setRGBA(params.m_postOffset);
+    const typename V::F breakPnt   = V::setRGBA(params.m_breakPnt);
+    const typename V::F slope      = V::setRGBA(params.m_slope);
+
+    ApplyToPixels<V>(in, out, numPixels, [&](typename V::F pix)
+    {
+        typename V::F x = pix;
+        if (MIRROR)
+        {
+            x = V::bitAnd(pix, V::castToFloat(V::set1i(ABS_MASK)));
+        }
+
+        typename V::F data = V::add(V::mul(x, preScale), preOffset);
+        data = Power<V>(data, exponent);
+        data = V::add(V::mul(data, postScale), postOffset);
+
+        if (LINEAR_SEGMENT)
+        {
+            data = V::select(V::cmpgt(x, breakPnt), data, V::mul(x, slope));
+        }
+        if (MIRROR)
+        {
+            data = V::bitOr(data, V::bitAnd(pix, V::castToFloat(V::set1i(SIGN_MASK))));
+        }
+        if (KEEP_ALPHA)
+        {
+            data = V::keepAlpha(data, pix);
+        }
+
+        return data;
+    });
+}
+
+template<typename V, bool LINEAR_SEGMENT, bool MIRROR>
+void ApplyPower(const float * in, float * out, long numPixels, const PowerKernelParams & params)
+{
+    if (params.m_keepAlpha)
+    {
+        ApplyPower<V, LINEAR_SEGMENT, MIRROR, true>(in, out, numPixels, params);
+    }
+    else
+    {
+        ApplyPower<V, LINEAR_SEGMENT, MIRROR, false>(in, out, numPixels, params);
+    }
+}
+
+template<typename V, bool LINEAR_SEGMENT>
+void ApplyPower(const float * in, float * out, long numPixels, const PowerKernelParams & params)
+{
+    if (params.m_mirror)
+    {
+        ApplyPower<V, LINEAR_SEGMENT, true>(in, out, numPixels, params);
+    }
+    else
+    {
+        ApplyPower<V, LINEAR_SEGMENT, false>(in, out, numPixels, params);
+    }
+}
+
+template<typename V>
+void ApplyPower(const float * in, float * out, long numPixels, const PowerKernelParams & params)
+{
+    if (params.m_linearSegment)
+    {
+        ApplyPower<V, true>(in, out, numPixels, params);
+    }
+    else
+    {
+        ApplyPower<V, false>(in, out, numPixels, params);
+    }
+}
+
+template<typename V, bool LINEAR_SEGMENT>
+void ApplyLog(const float * in, float * out, long numPixels, const LogKernelParams & params)
+{
+    const typename V::F preScale   = V::setRGBA(params.m_preScale);
+    const typename V::F preOffset  = V::setRGBA(params.m_preOffset);
+    const typename V::F postScale  = V::setRGBA(params.m_postScale);
+    const typename V::F postOffset = V::setRGBA(params.m_postOffset);
+    const typename V::F breakPnt   = V::setRGBA(params.m_breakPnt);
+    const typename V::F linScale   = V::setRGBA(params.m_linScale);
+    const typename V::F linOffset  = V::setRGBA(params.m_linOffset);
+    const typename V::F minValue   = V::set1(MIN_NORMALIZED);
+
+    ApplyToPixels<V>(in, out, numPixels, [&](typename V::F pix)
+    {
+        typename V::F data = V::add(V::mul(pix, preScale), preOffset);
+        data = Log2<V>(V::max(data, minValue));
+        data = V::add(V::mul(data, postScale), postOffset);
+
+        if (LINEAR_SEGMENT)
+        {
+            const typename V::F lin = V::add(V::mul(pix, linScale), linOffset);
+            data = V::select(V::cmpgt(pix, breakPnt), data, lin);
+        }
+
+        return V::keepAlpha(data, pix);
+    });
+}
+
+template<typename V>
+void ApplyLog(const float * in, float * out, long numPixels, const LogKernelParams & params)
+{
+    if (params.m_linearSegment)
+    {
+        ApplyLog<V, true>(in, out, numPixels, params);
+    }
+    else
+    {
+        ApplyLog<V, false>(in, out, numPixels, params);
+    }
+}
+
+template<typename V, bool LINEAR_SEGMENT>
+void ApplyAntiLog(const float * in, float * out, long numPixels, const LogKernelParams & params)
+{
+    const typename V::F preScale   = V::setRGBA(params.m_preScale);
+    const typename V::F preOffset  = V::setRGBA(params.m_preOffset);
+    const typename V::F postScale  = V::setRGBA(params.m_postScale);
+    const typename V::F postOffset = V::setRGBA(params.m_postOffset);
+    const typename V::F breakPnt   = V::setRGBA(params.m_breakPnt);
+    const typename V::F linScale   = V::setRGBA(params.m_linScale);
+    const typename V::F linOffset  = V::setRGBA(params.m_linOffset);
+
+    ApplyToPixels<V>(in, out, numPixels, [&](typename V::F pix)
+    {
+        typename V::F data = V::mul(V::add(pix, preOffset), preScale);
+        data = Exp2<V>(data);
+        data = V::mul(V::add(data, postOffset), postScale);
+
+        if (LINEAR_SEGMENT)
+        {
+            const typename V::F lin = V::mul(V::add(pix, linOffset), linScale);
+            data = V::select(V::cmpgt(pix, breakPnt), data, lin);
+        }
+
+        return V::keepAlpha(data, pix);
+    });
+}
+
+template<typename V>
+void ApplyAntiLog(const float * in, float * out, long numPixels, const LogKernelParams & params)
+{
+    if (params.m_linearSegment)
+    {
+        ApplyAntiLog<V, true>(in, out, numPixels, params);
+    }
+    else
+    {
+        ApplyAntiLog<V, false>(in, out, numPixels, params);
+    }
+}
+
+template<typename V, bool CLAMP>
+inline typename V::F CDLClamp(typename V::F pix)
+{
+    return CLAMP ? V::min(V::max(pix, V::set1(0.0f)), V::set1(1.0f)) : pix;
+}
+
+// When clamping, the values are clamped to [0, 1] before the power. Otherwise the negative
+// values are passed through.
+template<typename V, bool CLAMP>
+inline typename V::F CDLPower(typename V::F pix, typename V::F power)
+{
+    if (CLAMP)
+    {
+        return Power<V>(CDLClamp<V, true>(pix), power);
+    }
+
+    return V::select(V::cmplt(pix, V::set1(0.0f)), pix, Power<V>(pix, power));
+}
+
+template<typename V>
+inline typename V::F CDLSaturation(typename V::F pix, typename V::F lumaWeights,
+                                   typename V::F saturation)
+{
+    // Compute the luma of each pixel and broadcast it to all its channels.
+    typename V::F luma = V::mul(pix, lumaWeights);
+    luma = V::add(luma, V::template permute<0xB1>(luma)); // _MM_SHUFFLE(2,3,0,1)
+    luma = V::add(luma, V::template permute<0x4E>(luma)); // _MM_SHUFFLE(1,0,3,2)
+
+    return V::add(luma, V::mul(saturation, V::sub(pix, luma)));
+}
+
+template<typename V, bool REVERSE, bool CLAMP>
+void ApplyCDL(const float * in, float * out, long numPixels, const CDLKernelParams & params)
+{
+    static constexpr float lumaWeights[4] = { 0.2126f, 0.7152f, 0.0722f, 0.0f };
+
+    const typename V::F slope      = V::setRGBA(params.m_slope);
+    const typename V::F offset     = V::setRGBA(params.m_offset);
+    const typename V::F power      = V::setRGBA(params.m_power);
+    const typename V::F saturation = V::set1(params.m_saturation);
+    const typename V::F luma       = V::setRGBA(lumaWeights);
+
+    ApplyToPixels<V>(in, out, numPixels, [&](typename V::F pix)
+    {
+        typename V::F data = pix;
+
+        if (REVERSE)
+        {
+            data = CDLClamp<V, CLAMP>(data);
+            data = CDLSaturation<V>(data, luma, saturation);
+            data = CDLPower<V, CLAMP>(data, power);
+            data = V::mul(V::add(data, offset), slope);
+            data = CDLClamp<V, CLAMP>(data);
+        }
+        else
+        {
+            data = V::add(V::mul(data, slope), offset);
+            data = CDLPower<V, CLAMP>(data, power);
+            data = CDLSaturation<V>(data, luma, saturation);
+            data = CDLClamp<V, CLAMP>(data);
+        }
+
+        return V::keepAlpha(data, pix);
+    });
+}
+
+template<typename V>
+void ApplyCDL(const float * in, float * out, long numPixels, const CDLKernelParams & params)
+{
+    if (params.m_reverse)
+    {
+        if (params.m_clamp)
+        {
+            ApplyCDL<V, true, true>(in, out, numPixels, params);
+        }
+        else
+        {
+            ApplyCDL<V, true, false>(in, out, numPixels, params);
+        }
+    }
+    else
+    {
+        if (params.m_clamp)
+        {
+            ApplyCDL<V, false, true>(in, out, numPixels, params);
+        }
+        else
+        {
+            ApplyCDL<V, false, false>(in, out, numPixels, params);
+        }
+    }
+}
+
+template<typename V>
+constexpr SIMDKernels MakeSIMDKernels(const char * name)
+{
+    return SIMDKernels{ name,
+                        &ApplyScale<V>,
+                        &ApplyMatrix<V>,
+                        &ApplyPower<V>,
+                        &ApplyLog<V>,
+                        &ApplyAntiLog<V>,
+                        &ApplyCDL<V> };
+}
+
+} // anon.
+} // namespace OCIO_NAMESPACE
+
+#endif
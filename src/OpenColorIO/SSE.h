@@ -590,6 +590,207 @@ inline void sseSinCos(const float x, float& sin_x, float& cos_x)
     sin_x = buf[1];
 }
 
+// The following functions are more accurate (i.e. about 2 ulp) versions of the natural
+// logarithm, exponential, power and arc tangent functions. They are slower than the
+// approximations above but their results stay close to the ones of the C library so they
+// could be used where the scalar and the SSE paths must agree (e.g. the ACES fixed
+// functions). They are based on the Cephes single precision implementations.
+
+// Natural logarithm of x, for x > 0.
+inline __m128 sseLogPrecise(__m128 x)
+{
+    static const __m128 SQRT_HALF = _mm_set1_ps( (float) 0.707106781186547524 );
+    static const __m128 MIN_NORM  = _mm_castsi128_ps(_mm_set1_epi32(0x00800000));
+    static const __m128 EHALF     = _mm_set1_ps(0.5f);
+    static const __m128 DENORM_SCALE     = _mm_set1_ps(33554432.0f); // 2^25
+    static const __m128 DENORM_SCALE_EXP = _mm_set1_ps(25.0f);
+
+    static const __m128 PN_LOG_P0 = _mm_set1_ps( 7.0376836292e-2f);
+    static const __m128 PN_LOG_P1 = _mm_set1_ps(-1.1514610310e-1f);
+    static const __m128 PN_LOG_P2 = _mm_set1_ps( 1.1676998740e-1f);
+    static const __m128 PN_LOG_P3 = _mm_set1_ps(-1.2420140846e-1f);
+    static const __m128 PN_LOG_P4 = _mm_set1_ps( 1.4249322787e-1f);
+    static const __m128 PN_LOG_P5 = _mm_set1_ps(-1.6668057665e-1f);
+    static const __m128 PN_LOG_P6 = _mm_set1_ps( 2.0000714765e-1f);
+    static const __m128 PN_LOG_P7 = _mm_set1_ps(-2.4999993993e-1f);
+    static const __m128 PN_LOG_P8 = _mm_set1_ps( 3.3333331174e-1f);
+
+    static const __m128 LN2_HI = _mm_set1_ps( 0.693359375f);
+    static const __m128 LN2_LO = _mm_set1_ps(-2.12194440e-4f);
+
+    // The denormalized values are scaled to normalized ones.
+    const __m128 denorm_mask = _mm_cmplt_ps(x, MIN_NORM);
+    x = sseSelect(denorm_mask, _mm_mul_ps(x, DENORM_SCALE), x);
+
+    // x = mantissa * 2^exponent with the mantissa in [0.5, 1[.
+    __m128i exponent
+        = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), EXP_SHIFT), _mm_set1_epi32(126));
+    __m128 mantissa
+        = _mm_or_ps(_mm_andnot_ps(_mm_castsi128_ps(EMASK), x), EHALF);
+    __m128 e = _mm_sub_ps(_mm_cvtepi32_ps(exponent), _mm_and_ps(denorm_mask, DENORM_SCALE_EXP));
+
+    // Use [sqrt(0.5), sqrt(2)[ as the mantissa range.
+    const __m128 small_mask = _mm_cmplt_ps(mantissa, SQRT_HALF);
+    e = _mm_sub_ps(e, _mm_and_ps(EONE, small_mask));
+    mantissa = _mm_add_ps(_mm_sub_ps(mantissa, EONE), _mm_and_ps(mantissa, small_mask));
+
+    const __m128 z = _mm_mul_ps(mantissa, mantissa);
+
+    __m128 y = _mm_add_ps(_mm_mul_ps(PN_LOG_P0, mantissa), PN_LOG_P1);
+    y = _mm_add_ps(_mm_mul_ps(y, mantissa), PN_LOG_P2);
+    y = _mm_add_ps(_mm_mul_ps(y, mantissa), PN_LOG_P3);
+    y = _mm_add_ps(_mm_mul_ps(y, mantissa), PN_LOG_P4);
+    y = _mm_add_ps(_mm_mul_ps(y, mantissa), PN_LOG_P5);
+    y = _mm_add_ps(_mm_mul_ps(y, mantissa), PN_LOG_P6);
+    y = _mm_add_ps(_mm_mul_ps(y, mantissa), PN_LOG_P7);
+    y = _mm_add_ps(_mm_mul_ps(y, mantissa), PN_LOG_P8);
+    y = _mm_mul_ps(_mm_mul_ps(y, mantissa), z);
+
+    y = _mm_add_ps(y, _mm_mul_ps(e, LN2_LO));
+    y = _mm_sub_ps(y, _mm_mul_ps(z, EHALF));
+
+    return _mm_add_ps(_mm_add_ps(mantissa, y), _mm_mul_ps(e, LN2_HI));
+}
+
+// Exponential of x. The results overflow to infinity and underflow to zero.
+inline __m128 sseExpPrecise(__m128 x)
+{
+    static const __m128 EXP_HI = _mm_set1_ps( 88.7228391f);
+    static const __m128 EXP_LO = _mm_set1_ps(-87.3365447f);
+    static const __m128 LOG2E  = _mm_set1_ps( (float) 1.44269504088896341 );
+    static const __m128 EHALF  = _mm_set1_ps(0.5f);
+
+    static const __m128 LN2_HI = _mm_set1_ps( 0.693359375f);
+    static const __m128 LN2_LO = _mm_set1_ps(-2.12194440e-4f);
+
+    static const __m128 PN_EXP_P0 = _mm_set1_ps(1.9875691500e-4f);
+    static const __m128 PN_EXP_P1 = _mm_set1_ps(1.3981999507e-3f);
+    static const __m128 PN_EXP_P2 = _mm_set1_ps(8.3334519073e-3f);
+    static const __m128 PN_EXP_P3 = _mm_set1_ps(4.1665795894e-2f);
+    static const __m128 PN_EXP_P4 = _mm_set1_ps(1.6666665459e-1f);
+    static const __m128 PN_EXP_P5 = _mm_set1_ps(5.0000001201e-1f);
+
+    const __m128 overflow  = _mm_cmpgt_ps(x, EXP_HI);
+    const __m128 underflow = _mm_cmplt_ps(x, EXP_LO);
+    x = _mm_min_ps(_mm_max_ps(x, EXP_LO), EXP_HI);
+
+    // x = n * ln(2) + r with n = round(x / ln(2)).
+    __m128 fx = _mm_add_ps(_mm_mul_ps(x, LOG2E), EHALF);
+    __m128i n = _mm_cvttps_epi32(fx);
+    n = _mm_add_epi32(n, _mm_castps_si128(_mm_cmplt_ps(fx, _mm_cvtepi32_ps(n))));
+    fx = _mm_cvtepi32_ps(n);
+
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, LN2_HI));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, LN2_LO));
+
+    const __m128 z = _mm_mul_ps(x, x);
+
+    __m128 y = _mm_add_ps(_mm_mul_ps(PN_EXP_P0, x), PN_EXP_P1);
+    y = _mm_add_ps(_mm_mul_ps(y, x), PN_EXP_P2);
+    y = _mm_add_ps(_mm_mul_ps(y, x), PN_EXP_P3);
+    y = _mm_add_ps(_mm_mul_ps(y, x), PN_EXP_P4);
+    y = _mm_add_ps(_mm_mul_ps(y, x), PN_EXP_P5);
+    y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), EONE);
+
+    // Multiply by 2^n in two steps so that 2^n never overflows (i.e. n is at most 128).
+    const __m128i n1 = _mm_srai_epi32(n, 1);
+    const __m128i n2 = _mm_sub_epi32(n, n1);
+    y = _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n1, EBIAS), EXP_SHIFT)));
+    y = _mm_mul_ps(y, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n2, EBIAS), EXP_SHIFT)));
+
+    y = sseSelect(overflow, EPOSINF, y);
+    return _mm_andnot_ps(underflow, y);
+}
+
+// Power function computed as exp(exp * log(|x|)). The zero, negative, infinite and NaN
+// arguments give the same results as powf().
+inline __m128 ssePowerPrecise(__m128 x, __m128 exp)
+{
+    // All the floats from 2^24 are even integers.
+    static const __m128 MIN_EVEN = _mm_set1_ps(16777216.0f);
+    static const __m128 QNAN     = _mm_set1_ps(std::numeric_limits<float>::quiet_NaN());
+
+    const __m128 abs_x = _mm_and_ps(x, EABS_MASK);
+
+    __m128 res = sseExpPrecise(_mm_mul_ps(exp, sseLogPrecise(abs_x)));
+
+    // 0^exp and inf^exp (i.e. the sign of x is handled below).
+    res = sseSelect(_mm_cmpeq_ps(abs_x, EZERO),
+                    _mm_and_ps(_mm_cmplt_ps(exp, EZERO), EPOSINF), res);
+    res = sseSelect(_mm_cmpeq_ps(abs_x, EPOSINF),
+                    _mm_and_ps(_mm_cmpgt_ps(exp, EZERO), EPOSINF), res);
+
+    // (+/-1)^(+/-inf) is 1.
+    res = sseSelect(_mm_cmpeq_ps(abs_x, EONE), EONE, res);
+
+    // A negative x only has a real power for an integer exponent, the odd ones keeping
+    // the sign of x.
+    const __m128 abs_exp   = _mm_and_ps(exp, EABS_MASK);
+    const __m128 is_even   = _mm_cmpge_ps(abs_exp, MIN_EVEN);
+    const __m128i exp_int  = _mm_cvttps_epi32(exp);
+    const __m128 is_int    = _mm_or_ps(is_even, _mm_cmpeq_ps(_mm_cvtepi32_ps(exp_int), exp));
+    const __m128 is_odd
+        = _mm_andnot_ps(is_even,
+                        _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(exp_int, _mm_set1_epi32(1)),
+                                                         _mm_set1_epi32(1))));
+
+    res = _mm_or_ps(res, _mm_and_ps(_mm_and_ps(x, ESIGN_MASK), _mm_and_ps(is_int, is_odd)));
+
+    const __m128 is_negative_finite = _mm_and_ps(_mm_cmplt_ps(x, EZERO),
+                                                 _mm_cmpneq_ps(abs_x, EPOSINF));
+    res = sseSelect(_mm_andnot_ps(is_int, is_negative_finite), QNAN, res);
+
+    // The NaNs propagate except for 1^exp and x^0 which are always 1.
+    res = sseSelect(_mm_cmpunord_ps(x, exp), _mm_add_ps(x, exp), res);
+    return sseSelect(_mm_or_ps(_mm_cmpeq_ps(x, EONE), _mm_cmpeq_ps(exp, EZERO)), EONE, res);
+}
+
+// Arc tangent of y / x in [-pi, pi] using the signs of both arguments to determine the
+// quadrant like atan2f(), including for the infinite and NaN arguments.
+inline __m128 sseAtan2Precise(__m128 y, __m128 x)
+{
+    static const __m128 TAN_PI_8  = _mm_set1_ps( (float) 0.414213562373095048802 );
+    static const __m128 E_PI_4    = _mm_set1_ps( (float) 0.785398163397448309616 );
+
+    static const __m128 PN_ATAN_P0 = _mm_set1_ps( 8.05374449538e-2f);
+    static const __m128 PN_ATAN_P1 = _mm_set1_ps(-1.38776856032e-1f);
+    static const __m128 PN_ATAN_P2 = _mm_set1_ps( 1.99777106478e-1f);
+    static const __m128 PN_ATAN_P3 = _mm_set1_ps(-3.33329491539e-1f);
+
+    const __m128 abs_x = _mm_and_ps(x, EABS_MASK);
+    const __m128 abs_y = _mm_and_ps(y, EABS_MASK);
+
+    // Reduce the domain to [0, 1] using atan(t) = pi/2 - atan(1/t).
+    const __m128 swap_mask = _mm_cmpgt_ps(abs_y, abs_x);
+    const __m128 num = sseSelect(swap_mask, abs_x, abs_y);
+    const __m128 den = sseSelect(swap_mask, abs_y, abs_x);
+
+    // Note: atan2(0, 0) is 0 and atan2(inf, inf) is pi/4 (i.e. before the quadrant
+    //       adjustments).
+    __m128 t = _mm_and_ps(_mm_div_ps(num, den), _mm_cmpneq_ps(den, EZERO));
+    t = sseSelect(_mm_and_ps(_mm_cmpeq_ps(abs_x, EPOSINF), _mm_cmpeq_ps(abs_y, EPOSINF)),
+                  EONE, t);
+
+    // Further reduce the domain to [0, tan(pi/8)] using atan(t) = pi/4 + atan((t-1)/(t+1)).
+    const __m128 shift_mask = _mm_cmpgt_ps(t, TAN_PI_8);
+    t = sseSelect(shift_mask, _mm_div_ps(_mm_sub_ps(t, EONE), _mm_add_ps(t, EONE)), t);
+
+    const __m128 z = _mm_mul_ps(t, t);
+
+    __m128 res = _mm_add_ps(_mm_mul_ps(PN_ATAN_P0, z), PN_ATAN_P1);
+    res = _mm_add_ps(_mm_mul_ps(res, z), PN_ATAN_P2);
+    res = _mm_add_ps(_mm_mul_ps(res, z), PN_ATAN_P3);
+    res = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(res, z), t), t);
+    res = _mm_add_ps(res, _mm_and_ps(E_PI_4, shift_mask));
+
+    // Undo the domain reductions and adjust the result to the quadrant.
+    res = sseSelect(swap_mask, _mm_sub_ps(E_PI_2, res), res);
+    res = sseSelect(isNegativeSpecial(x), _mm_sub_ps(E_PI, res), res);
+    res = _mm_or_ps(res, _mm_and_ps(y, ESIGN_MASK));
+
+    return sseSelect(_mm_cmpunord_ps(x, y), _mm_add_ps(x, y), res);
+}
+
 } // namespace OCIO_NAMESPACE
 
 
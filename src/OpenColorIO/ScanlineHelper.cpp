@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -43,6 +44,7 @@ GenericScanlineHelper<InType, OutType>::GenericScanlineHelper(BitDepth inputBitD
     ,   m_inOptimizedMode(NO_OPTIMIZATION)
     ,   m_outOptimizedMode(NO_OPTIMIZATION)
     ,   m_yIndex(0)
+    ,   m_yEnd(0)
     ,   m_useDstBuffer(false)
 {
 }
@@ -60,6 +62,8 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & srcImg, cons
         throw Exception("Dimension inconsistency between source and destination image buffers.");
     }
 
+    m_yEnd = m_dstImg.m_height;
+
     m_inOptimizedMode  = GetOptimizationMode(m_srcImg);
     m_outOptimizedMode = GetOptimizationMode(m_dstImg);
 
@@ -70,14 +74,14 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & srcImg, cons
     if( (m_inOptimizedMode & PACKED_OPTIMIZATION) != PACKED_OPTIMIZATION)
     {
         const long bufferSize = 4 * m_dstImg.m_width;
-        m_inBitDepthBuffer.resize(bufferSize);
+        m_inBitDepthBuffer.reserve(bufferSize);
     }
 
     if(!m_useDstBuffer)
     {
         const long bufferSize = 4 * m_dstImg.m_width;
-        m_rgbaFloatBuffer.resize(bufferSize);
-        m_outBitDepthBuffer.resize(bufferSize);
+        m_rgbaFloatBuffer.reserve(bufferSize);
+        m_outBitDepthBuffer.reserve(bufferSize);
     }
 }
 
@@ -89,6 +93,8 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & img)
     m_srcImg.init(img, m_inputBitDepth, m_inBitDepthOp);
     m_dstImg.init(img, m_outputBitDepth, m_outBitDepthOp);
 
+    m_yEnd = m_dstImg.m_height;
+
     m_inOptimizedMode  = GetOptimizationMode(m_srcImg);
     m_outOptimizedMode = m_inOptimizedMode;
 
@@ -98,17 +104,47 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & img)
 
     if(!m_useDstBuffer)
     {
-        // TODO: Re-use memory from thread-safe memory pool, rather
-        // than doing a new allocation each time.
+        // Note: The buffers only grow, and the CPUProcessor reuses its helpers, so there is
+        // no allocation once an image of the same width was processed.
 
         const long bufferSize = 4 * m_dstImg.m_width;
 
-        m_rgbaFloatBuffer.resize(bufferSize);
-        m_inBitDepthBuffer.resize(bufferSize);
-        m_outBitDepthBuffer.resize(bufferSize);
+        m_rgbaFloatBuffer.reserve(bufferSize);
+        m_inBitDepthBuffer.reserve(bufferSize);
+        m_outBitDepthBuffer.reserve(bufferSize);
     }
 }
 
+template<typename InType, typename OutType>
+void GenericScanlineHelper<InType, OutType>::reserve(long width)
+{
+    if (width < 0)
+    {
+        throw Exception("Invalid image width for the scanline buffers.");
+    }
+
+    const size_t bufferSize = 4 * size_t(width);
+
+    m_rgbaFloatBuffer.reserve(bufferSize);
+    m_inBitDepthBuffer.reserve(bufferSize);
+    m_outBitDepthBuffer.reserve(bufferSize);
+}
+
+template<typename InType, typename OutType>
+void GenericScanlineHelper<InType, OutType>::setRowRange(long yBegin, long yEnd)
+{
+    if (yBegin < 0 || yEnd > m_dstImg.m_height || yBegin > yEnd)
+    {
+        std::ostringstream oss;
+        oss << "Invalid scanline range [" << yBegin << ", " << yEnd
+            << ") for an image of height " << m_dstImg.m_height << ".";
+        throw Exception(oss.str().c_str());
+    }
+
+    m_yIndex = yBegin;
+    m_yEnd   = yEnd;
+}
+
 template<typename InType, typename OutType>
 GenericScanlineHelper<InType, OutType>::~GenericScanlineHelper()
 {
@@ -120,14 +156,14 @@ void GenericScanlineHelper<InType, OutType>::prepRGBAScanline(float** buffer, lo
 {
     // Note that only a line-by-line processing is done on the image buffer.
 
-    if(m_yIndex >= m_dstImg.m_height)
+    if(m_yIndex >= m_yEnd)
     {
         numPixels = 0;
         return;
     }
 
     *buffer = m_useDstBuffer ? (float*)(m_dstImg.m_rData + m_dstImg.m_yStrideBytes * m_yIndex)
-                             : &m_rgbaFloatBuffer[0];
+                             : m_rgbaFloatBuffer.data();
 
     if((m_inOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION)
     {
@@ -140,7 +176,7 @@ void GenericScanlineHelper<InType, OutType>::prepRGBAScanline(float** buffer, lo
         // Pack from any channel ordering & bit-depth to a packed RGBA F32 buffer.
 
         Generic<InType>::PackRGBAFromImageDesc(m_srcImg,
-                                               &m_inBitDepthBuffer[0],
+                                               m_inBitDepthBuffer.data(),
                                                *buffer,
                                                m_dstImg.m_width,
                                                m_yIndex * m_dstImg.m_width);
@@ -159,7 +195,7 @@ void GenericScanlineHelper<InType, OutType>::finishRGBAScanline()
     {
         void * out = (void*)(m_dstImg.m_rData + m_dstImg.m_yStrideBytes * m_yIndex);
 
-        const void * in  = m_useDstBuffer ? out : (void*)&m_rgbaFloatBuffer[0];
+        const void * in  = m_useDstBuffer ? out : (void*)m_rgbaFloatBuffer.data();
 
         m_dstImg.m_bitDepthOp->apply(in, out, m_dstImg.m_width);
     }
@@ -167,8 +203,8 @@ void GenericScanlineHelper<InType, OutType>::finishRGBAScanline()
     {
         // Unpack from packed RGBA F32 to any channel ordering & bit-depth.
         Generic<OutType>::UnpackRGBAToImageDesc(m_dstImg,
-                                                &m_rgbaFloatBuffer[0],
-                                                &m_outBitDepthBuffer[0],
+                                                m_rgbaFloatBuffer.data(),
+                                                m_outBitDepthBuffer.data(),
                                                 m_dstImg.m_width,
                                                 m_yIndex * m_dstImg.m_width);
     }
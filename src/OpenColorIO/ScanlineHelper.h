@@ -8,6 +8,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "ImagePacking.h"
+#include "Platform.h"
 
 namespace OCIO_NAMESPACE
 {
@@ -25,6 +26,45 @@ enum Optimizations
 Optimizations GetOptimizationMode(const GenericImageDesc & imgDesc);
 
 
+// Intermediate buffer aligned on a cache line. It only grows so a helper reused for several
+// images does not allocate again once it has processed the widest one.
+template<typename T>
+class ScanlineBuffer
+{
+public:
+    ScanlineBuffer() = default;
+    ScanlineBuffer(const ScanlineBuffer &) = delete;
+    ScanlineBuffer& operator=(const ScanlineBuffer &) = delete;
+
+    ~ScanlineBuffer() { Platform::AlignedFree(m_data); }
+
+    // Make room for at least numElements elements. The content is not preserved.
+    void reserve(size_t numElements)
+    {
+        if (numElements > m_size)
+        {
+            Platform::AlignedFree(m_data);
+            m_data = nullptr;
+            m_size = 0;
+
+            m_data = static_cast<T *>(Platform::AlignedMalloc(numElements * sizeof(T), 64));
+            if (!m_data)
+            {
+                throw Exception("Memory allocation failed for the scanline buffer.");
+            }
+            m_size = numElements;
+        }
+    }
+
+    T * data() noexcept { return m_data; }
+    size_t size() const noexcept { return m_size; }
+
+private:
+    T * m_data = nullptr;
+    size_t m_size = 0;
+};
+
+
 class ScanlineHelper
 {
 public:
@@ -37,6 +77,14 @@ public:
     virtual void init(const ImageDesc & srcImg, const ImageDesc & dstImg) = 0;
     virtual void init(const ImageDesc & img) = 0;
 
+    // Pre-allocate all the intermediate buffers for images up to width pixels wide.
+    virtual void reserve(long width) = 0;
+
+    // Restrict the processing to the scanlines [yBegin, yEnd) of the image. It must be called
+    // after init() and could be called several times to process different row bands with the
+    // same helper (and so the same internal buffers).
+    virtual void setRowRange(long yBegin, long yEnd) = 0;
+
     virtual void prepRGBAScanline(float** buffer, long & numPixels) = 0;
 
     virtual void finishRGBAScanline() = 0;
@@ -56,6 +104,10 @@ public:
     void init(const ImageDesc & srcImg, const ImageDesc & dstImg) override;
     void init(const ImageDesc & img) override;
 
+    void reserve(long width) override;
+
+    void setRowRange(long yBegin, long yEnd) override;
+
     ~GenericScanlineHelper() override;
 
     // Copy from the src image to our scanline, in our preferred
@@ -81,15 +133,17 @@ private:
     Optimizations m_outOptimizedMode; // Optimization applicable to the output buffer.
 
     // Processing needs an intermediate buffer as CPU Ops only process packed RGBA F32.
-    std::vector<float> m_rgbaFloatBuffer;
+    ScanlineBuffer<float> m_rgbaFloatBuffer;
 
     // Processing needs additional buffers of the same pixel type as the input/output
     // in order to convert arbitrary channel order from/to RGBA.
-    std::vector<InType> m_inBitDepthBuffer;
-    std::vector<OutType> m_outBitDepthBuffer;
+    ScanlineBuffer<InType> m_inBitDepthBuffer;
+    ScanlineBuffer<OutType> m_outBitDepthBuffer;
 
     // The index of the current line to process.
-    int m_yIndex;
+    long m_yIndex;
+    // The index of the line following the last one to process.
+    long m_yEnd;
 
     // If the destination buffer is packed RGBA F32 it could then be used
     // as the internal processing buffer (i.e. instead of m_rgbaFloatBuffer
@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "BitDepthUtils.h"
 #include "MathUtils.h"
 #include "ops/lut1d/Lut1DOp.h"
@@ -103,9 +104,15 @@ public:
         std::istream & istream,
         const std::string & fileName) const override;
 
+    CachedFileRcPtr readBuffer(
+        const char * data,
+        size_t size,
+        const std::string & fileName) const override;
+
     void bake(const Baker & baker,
                 const std::string & formatName,
-                std::ostream & ostream) const override;
+                std::ostream & ostream,
+                BakingCache & cache) const override;
 
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
@@ -232,6 +239,16 @@ bool IsIdentity(const std::vector<int> & rawshaper, BitDepth outBitDepth)
 
 CachedFileRcPtr LocalFileFormat::read(
     std::istream & istream,
+    const std::string & fileName) const
+{
+    std::string buffer;
+    ReadStream(istream, buffer);
+    return readBuffer(buffer.data(), buffer.size(), fileName);
+}
+
+CachedFileRcPtr LocalFileFormat::readBuffer(
+    const char * data,
+    size_t size,
     const std::string & /* fileName unused */) const
 {
     std::vector<int> rawshaper;
@@ -241,44 +258,38 @@ CachedFileRcPtr LocalFileFormat::read(
 
     // Parse the file 3D LUT data to an int array.
     {
-        const int MAX_LINE_SIZE = 4096;
-        char lineBuffer[MAX_LINE_SIZE];
+        // Tokenize the file content in place, the per line copies and string streams
+        // are far too slow for the large LUTs.
+        LineTokenizer lines(data, data + size);
 
-        StringUtils::StringVec lineParts;
         std::vector<int> tmpData;
 
         int lineNumber = 0;
 
-        while(istream.good())
+        while(lines.nextLine())
         {
-            istream.getline(lineBuffer, MAX_LINE_SIZE);
             ++lineNumber;
 
-            // Strip and split the line.
-            lineParts = StringUtils::SplitByWhiteSpaces(StringUtils::Trim(lineBuffer));
+            if(lines.lineEmpty()) continue;
 
-            if(lineParts.empty()) continue;
-            if (lineParts.size() > 0)
+            if (*lines.lineBegin() == '#')
             {
-                if (StringUtils::StartsWith(lineParts[0], "#"))
-                {
-                    continue;
-                }
-                if (StringUtils::StartsWith(lineParts[0], "<"))
-                {
-                    // Format error: reject files that could be
-                    // formatted as xml.
-                    std::ostringstream os;
-                    os << "Error parsing .3dl file. ";
-                    os << "Not expecting a line starting with \"<\".";
-                    os << "Line (" << lineNumber << "): '";
-                    os << lineBuffer << "'.";
-                    throw Exception(os.str().c_str());
-                }
+                continue;
+            }
+            if (*lines.lineBegin() == '<')
+            {
+                // Format error: reject files that could be
+                // formatted as xml.
+                std::ostringstream os;
+                os << "Error parsing .3dl file. ";
+                os << "Not expecting a line starting with \"<\".";
+                os << "Line (" << lineNumber << "): '";
+                os << lines.line() << "'.";
+                throw Exception(os.str().c_str());
             }
 
             // If we haven't found a list of ints, continue.
-            if (!StringVecToIntVec(tmpData, lineParts))
+            if (!lines.getNumbers(tmpData))
             {
                 // Some keywords are valid (3DMESH, mesh, gamma, LUT*)
                 // but others could be format error.
@@ -304,7 +315,7 @@ CachedFileRcPtr LocalFileFormat::read(
                     os << "Error parsing .3dl file. ";
                     os << "Appears to contain more than 1 shaper LUT.";
                     os << "Line (" << lineNumber << "): '";
-                    os << lineBuffer << "'.";
+                    os << lines.line() << "'.";
                     throw Exception(os.str().c_str());
                 }
             }
@@ -326,7 +337,7 @@ CachedFileRcPtr LocalFileFormat::read(
                 os << "Error parsing .3dl file. ";
                 os << "Invalid line with less than 3 values.";
                 os << "Line (" << lineNumber << "): '";
-                os << lineBuffer << "'.";
+                os << lines.line() << "'.";
                 throw Exception(os.str().c_str());
             }
         }
@@ -478,7 +489,8 @@ int CubeDimensionLenToLustreBitDepth(int size)
 
 void LocalFileFormat::bake(const Baker & baker,
                             const std::string & formatName,
-                            std::ostream & ostream) const
+                            std::ostream & ostream,
+                            BakingCache & cache) const
 {
     int DEFAULT_CUBE_SIZE = 0;
     int SHAPER_BIT_DEPTH = 10;
@@ -513,11 +525,6 @@ void LocalFileFormat::bake(const Baker & baker,
     int shaperSize = baker.getShaperSize();
     if(shaperSize==-1) shaperSize = cubeSize;
 
-    std::vector<float> cubeData;
-    cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-    GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_BLUE);
-    PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
     // Apply our conversion from the input space to the output space.
     ConstProcessorRcPtr inputToTarget;
     std::string looks = baker.getLooks();
@@ -536,7 +543,9 @@ void LocalFileFormat::bake(const Baker & baker,
             baker.getTargetSpace());
     }
     ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-    cpu->apply(cubeImg);
+    const ConstLutValuesRcPtr cubeValues
+        = cache.getLut3D(cubeSize, LUT3DORDER_FAST_BLUE, { cpu }, baker.getNumThreads());
+    const std::vector<float> & cubeData = *cubeValues;
 
     // Write out the file.
     // For for maximum compatibility with other apps, we will
@@ -13,6 +13,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "MathUtils.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut3d/Lut3DOp.h"
@@ -325,7 +326,8 @@ public:
 
     void bake(const Baker & baker,
                 const std::string & formatName,
-                std::ostream & ostream) const override;
+                std::ostream & ostream,
+                BakingCache & cache) const override;
 
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
@@ -682,7 +684,8 @@ CachedFileRcPtr LocalFileFormat::read(
 
 void LocalFileFormat::bake(const Baker & baker,
                             const std::string & /*formatName*/,
-                            std::ostream & ostream) const
+                            std::ostream & ostream,
+                            BakingCache & cache) const
 {
     const int DEFAULT_CUBE_SIZE = 32;
     const int DEFAULT_SHAPER_SIZE = 1024;
@@ -693,15 +696,12 @@ void LocalFileFormat::bake(const Baker & baker,
     int cubeSize = baker.getCubeSize();
     if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
     cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
-    std::vector<float> cubeData;
-    cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-    GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-    PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
+    ConstLutValuesRcPtr cubeValues;
 
     std::string looks = baker.getLooks();
 
-    std::vector<float> shaperInData;
-    std::vector<float> shaperOutData;
+    ConstLutValuesRcPtr shaperInValues;
+    ConstLutValuesRcPtr shaperOutValues;
 
     // Use an explicitly shaper space.
     // TODO: Use the optional allocation for the shaper space,
@@ -719,11 +719,6 @@ void LocalFileFormat::bake(const Baker & baker,
             throw Exception(os.str().c_str());
         }
 
-        shaperOutData.resize(shaperSize*3);
-        shaperInData.resize(shaperSize*3);
-        GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-        GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
-
         ConstCPUProcessorRcPtr shaperToInput 
             = config->getProcessor(baker.getShaperSpace(), 
                                     baker.getInputSpace())->getDefaultCPUProcessor();
@@ -736,8 +731,8 @@ void LocalFileFormat::bake(const Baker & baker,
             os << "Please select an alternate shaper space or omit this option.";
             throw Exception(os.str().c_str());
         }
-        PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-        shaperToInput->apply(shaperInImg);
+        shaperOutValues = cache.getLut1D(shaperSize, {}, baker.getNumThreads());
+        shaperInValues = cache.getLut1D(shaperSize, { shaperToInput }, baker.getNumThreads());
 
         ConstCPUProcessorRcPtr shaperToTarget;
         if (!looks.empty())
@@ -756,7 +751,8 @@ void LocalFileFormat::bake(const Baker & baker,
                 = config->getProcessor(baker.getShaperSpace(), 
                                         baker.getTargetSpace())->getDefaultCPUProcessor();
         }
-        shaperToTarget->apply(cubeImg);
+        cubeValues = cache.getLut3D(cubeSize, LUT3DORDER_FAST_RED, { shaperToTarget },
+                                    baker.getNumThreads());
     }
     else
     {
@@ -799,18 +795,12 @@ void LocalFileFormat::bake(const Baker & baker,
             // If we know it's a uniform scaling, only 2 points will suffice!
             shaperSize = 2;
         }
-        shaperOutData.resize(shaperSize*3);
-        shaperInData.resize(shaperSize*3);
-        GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-        GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
-
         // Apply the forward to the allocation to the output shaper y axis, and the cube
         ConstCPUProcessorRcPtr shaperToInput
             = config->getProcessor(allocationTransform, TRANSFORM_DIR_INVERSE)->getDefaultCPUProcessor();
 
-        PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-        shaperToInput->apply(shaperInImg);
-        shaperToInput->apply(cubeImg);
+        shaperOutValues = cache.getLut1D(shaperSize, {}, baker.getNumThreads());
+        shaperInValues = cache.getLut1D(shaperSize, { shaperToInput }, baker.getNumThreads());
 
         // Apply the 3D LUT to the remainder (from the input to the output).
         ConstProcessorRcPtr inputToTarget;
@@ -828,9 +818,14 @@ void LocalFileFormat::bake(const Baker & baker,
             inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
         }
         ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-        cpu->apply(cubeImg);
+        cubeValues = cache.getLut3D(cubeSize, LUT3DORDER_FAST_RED, { shaperToInput, cpu },
+                                    baker.getNumThreads());
     }
 
+    const std::vector<float> & cubeData = *cubeValues;
+    const std::vector<float> & shaperInData = *shaperInValues;
+    const std::vector<float> & shaperOutData = *shaperOutValues;
+
     // Write out the file.
     ostream << "CSPLUTV100\n";
     ostream << "3D\n";
@@ -883,10 +878,8 @@ void LocalFileFormat::bake(const Baker & baker,
         throw Exception("Internal cube size exception.");
     }
     ostream << cubeSize << " " << cubeSize << " " << cubeSize << "\n";
-    for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
-    {
-        ostream << cubeData[3*i+0] << " " << cubeData[3*i+1] << " " << cubeData[3*i+2] << "\n";
-    }
+    WriteFixedTriplets(ostream, cubeData.data(), cubeSize*cubeSize*cubeSize, 6,
+                       baker.getNumThreads());
     ostream << "\n";
 }
 
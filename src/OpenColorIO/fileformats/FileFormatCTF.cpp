@@ -1,13 +1,17 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "expat.h"
 #include "fileformats/ctf/CTFTransform.h"
 #include "fileformats/ctf/CTFReaderHelper.h"
@@ -121,6 +125,10 @@ public:
     CachedFileRcPtr read(std::istream & istream,
                          const std::string & fileName) const override;
 
+    CachedFileRcPtr readBuffer(const char * data,
+                               size_t size,
+                               const std::string & fileName) const override;
+
     void buildFileOps(OpRcPtrVec & ops,
                       const Config & config,
                       const ConstContextRcPtr & context,
@@ -130,7 +138,8 @@ public:
 
     void bake(const Baker & baker,
               const std::string & formatName,
-              std::ostream & ostream) const override;
+              std::ostream & ostream,
+              BakingCache & cache) const override;
 
     void write(const OpRcPtrVec & ops,
                const FormatMetadataImpl & metadata,
@@ -183,22 +192,79 @@ public:
 
     void Parse(std::istream & istream)
     {
-        std::string line;
-        m_lineNumber = 0;
+        // The file content is given to the parser by large blocks. Each block ends with a
+        // newline character because the parsing callbacks receive pointers into the block
+        // and the number parsing relies on a delimiter after the last character (i.e. the
+        // code uses strtod). Only the incomplete last line is kept for the next block.
+        std::vector<char> buffer(BlockSize);
+        size_t used = 0;
         while (istream.good())
         {
-            std::getline(istream, line);
-            // Add back the newline character. Parsing will copy the line in a
-            // buffer up to the length of the line without the null termination.
-            // Our code will be called back to parse the buffer into a number.
-            // Code uses strtod. The buffer has to be delimited so that strtod
-            // does not access it after its length.
-            line.push_back('\n');
-            ++m_lineNumber;
-
-            Parse(line, !istream.good());
+            if (used == buffer.size())
+            {
+                // A single line is longer than the buffer.
+                buffer.resize(buffer.size() * 2);
+            }
+
+            istream.read(buffer.data() + used, std::streamsize(buffer.size() - used));
+            used += size_t(istream.gcount());
+
+            const char * lastLineFeed = LastLineFeed(buffer.data(), used);
+            if (lastLineFeed)
+            {
+                const size_t blockSize = size_t(lastLineFeed + 1 - buffer.data());
+                Parse(buffer.data(), blockSize, false);
+
+                used -= blockSize;
+                memmove(buffer.data(), buffer.data() + blockSize, used);
+            }
+        }
+
+        // As above, the newline character delimits the buffer.
+        buffer.resize(used);
+        buffer.push_back('\n');
+        Parse(buffer.data(), buffer.size(), true);
+
+        validate();
+    }
+
+    // Parse a file content already in memory (e.g. a memory mapped file) by blocks as
+    // the istream version, but without any copy except for the last line.
+    void Parse(const char * data, size_t size)
+    {
+        const char * end = data + size;
+        while (data != end)
+        {
+            const size_t available = size_t(end - data);
+            const char * lastLineFeed
+                = LastLineFeed(data, available < BlockSize ? available : BlockSize);
+            if (!lastLineFeed && available > BlockSize)
+            {
+                // A single line is longer than a block.
+                lastLineFeed = static_cast<const char *>(memchr(data, '\n', available));
+            }
+
+            if (!lastLineFeed)
+            {
+                // As above, the newline character delimits the buffer so the last line
+                // needs to be copied.
+                std::string lastLine(data, end);
+                lastLine.push_back('\n');
+                Parse(lastLine.c_str(), lastLine.size(), false);
+                break;
+            }
+
+            Parse(data, size_t(lastLineFeed + 1 - data), false);
+            data = lastLineFeed + 1;
         }
 
+        Parse("", 0, true);
+
+        validate();
+    }
+
+    void validate()
+    {
         if (!m_elms.empty())
         {
             std::string error("CTF/CLF parsing error (no closing tag for '");
@@ -223,13 +289,13 @@ public:
         }
     }
 
-    void Parse(const std::string & buffer, bool lastLine)
+    void Parse(const char * buffer, size_t len, bool lastLine)
     {
         const int done = lastLine?1:0;
 
         if (XML_STATUS_ERROR == XML_Parse(m_parser,
-                                          buffer.c_str(),
-                                          (int)buffer.size(), done))
+                                          buffer,
+                                          (int)len, done))
         {
             XML_Error eXpatErrorCode = XML_GetErrorCode(m_parser);
             if (eXpatErrorCode == XML_ERROR_TAG_MISMATCH)
@@ -268,6 +334,21 @@ public:
 
 private:
 
+    // Size of the blocks given to the parser.
+    static constexpr size_t BlockSize = 1024 * 1024;
+
+    static const char * LastLineFeed(const char * data, size_t size)
+    {
+        for (const char * ptr = data + size; ptr != data; --ptr)
+        {
+            if (*(ptr - 1) == '\n')
+            {
+                return ptr - 1;
+            }
+        }
+        return nullptr;
+    }
+
     void AddOpReader(CTFReaderOpElt::Type type, const char * xmlTag)
     {
         if (m_elms.size() != 1)
@@ -316,7 +397,7 @@ private:
         os << "Error parsing CTF/CLF file (";
         os << m_fileName.c_str() << "). ";
         os << "Error is: " << error.c_str();
-        os << ". At line (" << m_lineNumber << ")";
+        os << ". At line (" << getXmLineNumber() << ")";
         throw Exception(os.str().c_str());
     }
 
@@ -424,7 +505,7 @@ private:
                     std::make_shared<CTFReaderMetadataElt>(
                         name,
                         pMD,
-                        pImpl->m_lineNumber,
+                        pImpl->getXmLineNumber(),
                         pImpl->m_fileName));
 
                 pImpl->m_elms.back()->start(atts);
@@ -988,7 +1069,22 @@ private:
 
     unsigned int getXmLineNumber() const
     {
-        return m_lineNumber;
+        // Line of the element or of the character data being processed, or of the
+        // parsing error.
+        unsigned int line = (unsigned int)XML_GetCurrentLineNumber(m_parser);
+
+        // Report the line where the current event ends, e.g. the last line of a
+        // multi-line start tag.
+        int offset = 0;
+        int size = 0;
+        const char * context = XML_GetInputContext(m_parser, &offset, &size);
+        const int count = XML_GetCurrentByteCount(m_parser);
+        if (context && count > 0 && offset + count <= size)
+        {
+            line += (unsigned int)std::count(context + offset, context + offset + count, '\n');
+        }
+
+        return line;
     }
 
     const std::string & getXmlFilename() const
@@ -1002,7 +1098,6 @@ private:
     }
 
     XML_Parser m_parser;
-    unsigned int m_lineNumber;
     std::string m_fileName;
     bool m_isCLF;
     XmlReaderElementStack m_elms; // Parsing stack
@@ -1037,6 +1132,16 @@ bool isLoadableCTF(std::istream & istream)
     return foundPattern;
 }
 
+bool isLoadableCTF(const char * data, size_t size)
+{
+    // Find ProcessList tag at beginning of file.
+    const size_t limit(5 * 1024); // 5 kilobytes.
+    const std::string pattern("<ProcessList");
+
+    const char * end = data + std::min(size, limit + pattern.size());
+    return std::search(data, end, pattern.begin(), pattern.end()) != end;
+}
+
 // Try and load the format.
 // Raise an exception if it can't be loaded.
 CachedFileRcPtr LocalFileFormat::read(
@@ -1063,6 +1168,31 @@ CachedFileRcPtr LocalFileFormat::read(
     return cachedFile;
 }
 
+CachedFileRcPtr LocalFileFormat::readBuffer(
+    const char * data,
+    size_t size,
+    const std::string & filePath) const
+{
+    if (!isLoadableCTF(data, size))
+    {
+        std::ostringstream oss;
+        oss << "Parsing error: '" << filePath << "' is not a CTF/CLF file.";
+        throw Exception(oss.str().c_str());
+    }
+
+    XMLParserHelper parser(filePath);
+    parser.Parse(data, size);
+
+    LocalCachedFileRcPtr cachedFile =
+        LocalCachedFileRcPtr(new LocalCachedFile());
+
+    // Keep transform.
+    cachedFile->m_transform = parser.getTransform();
+    cachedFile->m_filePath = filePath;
+
+    return cachedFile;
+}
+
 // Helper called by LocalFileFormat::buildFileOps
 void BuildOp(OpRcPtrVec & ops,
              const Config& config,
@@ -1147,28 +1277,68 @@ LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
     }
 }
 
+void LocalFileFormat::bake(const Baker & baker,
+                           const std::string & formatName,
+                           std::ostream & ostream,
+                           BakingCache & cache) const
+{
+    if (formatName != FILEFORMAT_CTF && formatName != FILEFORMAT_CLF)
+    {
+        std::ostringstream os;
+        os << "Unknown CLF/CTF file format name, '";
+        os << formatName << "'.";
+        throw Exception(os.str().c_str());
+    }
+
+    OpRcPtrVec ops;
+    CreateBakedLutOps(ops, baker, cache);
+
+    write(ops, baker.getFormatMetadata(), formatName, ostream);
+}
+
+void LocalFileFormat::write(const OpRcPtrVec & ops,
+                            const FormatMetadataImpl & metadata,
+                            const std::string & formatName,
+                            std::ostream & ostream) const
+{
+    bool isCLF = false;
+    if (Platform::Strcasecmp(formatName.c_str(), FILEFORMAT_CLF) == 0)
+    {
+        isCLF = true;
+    }
+    else if (Platform::Strcasecmp(formatName.c_str(), FILEFORMAT_CTF) != 0)
+    {
+        // Neither a clf nor a ctf.
+        std::ostringstream os;
+        os << "Error: CLF/CTF writer does not also write format " << formatName << ".";
+        throw Exception(os.str().c_str());
+    }
+
+    CTFReaderTransformPtr transform = std::make_shared<CTFReaderTransform>(ops, metadata);
+
+    // Write XML Header.
+    ostream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+    XmlFormatter fmt(ostream);
+
+    TransformWriter writer(fmt, transform, isCLF);
+    writer.write();
+}
+
+} // end of anonymous namespace.
+
 // This baker is based on what was done for ResolveCube and HDL.  We enhanced
 // it to use a half-domain Lut1D for the shaper to better represent transforms
 // expecting linear inputs.
 // TODO: The CLF format is more powerful than those older formats and there is
 // no need to be limited to a Lut1D + Lut3D structure -- more ops could be used
 // when necessary for a more accurate bake.
-void LocalFileFormat::bake(const Baker & baker,
-                           const std::string & formatName,
-                           std::ostream & ostream) const
+void CreateBakedLutOps(OpRcPtrVec & ops, const Baker & baker, BakingCache & cache)
 {
     static constexpr int DEFAULT_1D_SIZE = 4096;
     static constexpr int DEFAULT_3D_SIZE = 64;
 
     // NB: By default, the shaper uses a half-domain LUT1D, which is always 65536 entries.
     // If the user requests some other size, a typical (non-half-domain) LUT1D will be used.
-    if (formatName != FILEFORMAT_CTF && formatName != FILEFORMAT_CLF)
-    {
-        std::ostringstream os;
-        os << "Unknown CLF/CTF file format name, '";
-        os << formatName << "'.";
-        throw Exception(os.str().c_str());
-    }
 
     //
     // Initialize config and data.
@@ -1329,13 +1499,9 @@ void LocalFileFormat::bake(const Baker & baker,
     // Generate 3DLUT.
     //
 
-    std::vector<float> cubeData;
+    ConstLutValuesRcPtr cubeData;
     if (required_lut == CTF_3D || required_lut == CTF_1D_3D)
     {
-        cubeData.resize(cubeSize*cubeSize*cubeSize * 3);
-        GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_BLUE);
-        PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
         ConstProcessorRcPtr cubeProc;
         if (required_lut == CTF_1D_3D)
         {
@@ -1361,35 +1527,29 @@ void LocalFileFormat::bake(const Baker & baker,
         }
 
         ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-        cpu->apply(cubeImg);
+        cubeData = cache.getLut3D(cubeSize, LUT3DORDER_FAST_BLUE, { cpu }, baker.getNumThreads());
     }
 
     //
     // Generate 1DLUT
     //
 
-    std::vector<float> onedData;
+    ConstLutValuesRcPtr onedData;
     if (required_lut == CTF_1D)
     {
-        onedData.resize(onedSize * 3);
-        GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-        PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
-
         ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-        cpu->apply(onedImg);
+        onedData = cache.getLut1D(onedSize, { cpu }, baker.getNumThreads());
     }
 
     //
-    // Write.
+    // Create the ops.
     //
 
-    OpRcPtrVec ops;
-
     // 1D data.
     if (required_lut == CTF_1D)
     {
         Lut1DOpDataRcPtr lut1D = std::make_shared<Lut1DOpData>((unsigned long)onedSize);
-        lut1D->getArray().getValues() = onedData;
+        lut1D->getArray().getValues() = *onedData;
         CreateLut1DOp(ops, lut1D, TRANSFORM_DIR_FORWARD);
     }
     else if (required_lut == CTF_1D_3D)
@@ -1405,43 +1565,12 @@ void LocalFileFormat::bake(const Baker & baker,
     if (required_lut == CTF_3D || required_lut == CTF_1D_3D)
     {
         Lut3DOpDataRcPtr lut3D = std::make_shared<Lut3DOpData>((unsigned long)cubeSize);
-        lut3D->getArray().getValues() = cubeData;
+        lut3D->getArray().getValues() = *cubeData;
         CreateLut3DOp(ops, lut3D, TRANSFORM_DIR_FORWARD);
     }
 
-    write(ops, baker.getFormatMetadata(), formatName, ostream);
 }
 
-void LocalFileFormat::write(const OpRcPtrVec & ops,
-                            const FormatMetadataImpl & metadata,
-                            const std::string & formatName,
-                            std::ostream & ostream) const
-{
-    bool isCLF = false;
-    if (Platform::Strcasecmp(formatName.c_str(), FILEFORMAT_CLF) == 0)
-    {
-        isCLF = true;
-    }
-    else if (Platform::Strcasecmp(formatName.c_str(), FILEFORMAT_CTF) != 0)
-    {
-        // Neither a clf nor a ctf.
-        std::ostringstream os;
-        os << "Error: CLF/CTF writer does not also write format " << formatName << ".";
-        throw Exception(os.str().c_str());
-    }
-
-    CTFReaderTransformPtr transform = std::make_shared<CTFReaderTransform>(ops, metadata);
-
-    // Write XML Header.
-    ostream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
-    XmlFormatter fmt(ostream);
-
-    TransformWriter writer(fmt, transform, isCLF);
-    writer.write();
-}
-
-} // end of anonymous namespace.
-
 FileFormat * CreateFileFormatCLF()
 {
     return new LocalFileFormat();
@@ -29,6 +29,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "MathUtils.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut3d/Lut3DOp.h"
@@ -273,7 +274,8 @@ public:
 
     void bake(const Baker & baker,
                 const std::string & formatName,
-                std::ostream & ostream) const override;
+                std::ostream & ostream,
+                BakingCache & cache) const override;
 
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
@@ -554,7 +556,8 @@ LocalFileFormat::read(
 
 void LocalFileFormat::bake(const Baker & baker,
                             const std::string & formatName,
-                            std::ostream & ostream) const
+                            std::ostream & ostream,
+                            BakingCache & cache) const
 {
 
     if(formatName != "houdini")
@@ -744,14 +747,9 @@ void LocalFileFormat::bake(const Baker & baker,
     // TODO: Do same "auto prelut" input-space allocation as FileFormatCSP?
 
     // Make 3D LUT
-    std::vector<float> cubeData;
+    ConstLutValuesRcPtr cubeData;
     if(required_lut == HDL_3D || required_lut == HDL_3D1D)
     {
-        cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-
-        GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-        PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
         ConstProcessorRcPtr cubeProc;
         if(required_lut == HDL_3D1D)
         {
@@ -778,20 +776,16 @@ void LocalFileFormat::bake(const Baker & baker,
         }
 
         ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-        cpu->apply(cubeImg);
+        cubeData = cache.getLut3D(cubeSize, LUT3DORDER_FAST_RED, { cpu }, baker.getNumThreads());
     }
 
 
     // Make 1D LUT
-    std::vector<float> onedData;
+    ConstLutValuesRcPtr onedData;
     if(required_lut == HDL_1D)
     {
-        onedData.resize(onedSize * 3);
-
-        GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-        PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
         ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-        cpu->apply(onedImg);
+        onedData = cache.getLut1D(onedSize, { cpu }, baker.getNumThreads());
     }
 
 
@@ -854,9 +848,9 @@ void LocalFileFormat::bake(const Baker & baker,
             // TODO: Original baker code clamped values to
             // 1.0, was this necessary/desirable?
 
-            ostream << "\t" << cubeData[3*i+0];
-            ostream << " "  << cubeData[3*i+1];
-            ostream << " "  << cubeData[3*i+2] << "\n";
+            ostream << "\t" << (*cubeData)[3*i+0];
+            ostream << " "  << (*cubeData)[3*i+1];
+            ostream << " "  << (*cubeData)[3*i+2] << "\n";
         }
 
         // Write closing "}"
@@ -868,17 +862,17 @@ void LocalFileFormat::bake(const Baker & baker,
     {
         ostream << "R {\n";
         for(int i=0; i < onedSize; ++i)
-            ostream << "\t" << onedData[i*3+0] << "\n";
+            ostream << "\t" << (*onedData)[i*3+0] << "\n";
         ostream << "}\n";
 
         ostream << "G {\n";
         for(int i=0; i < onedSize; ++i)
-            ostream << "\t" << onedData[i*3+1] << "\n";
+            ostream << "\t" << (*onedData)[i*3+1] << "\n";
         ostream << "}\n";
 
         ostream << "B {\n";
         for(int i=0; i < onedSize; ++i)
-            ostream << "\t" << onedData[i*3+2] << "\n";
+            ostream << "\t" << (*onedData)[i*3+2] << "\n";
         ostream << "}\n";
     }
 }
@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut3d/Lut3DOp.h"
 #include "ops/matrix/MatrixOp.h"
@@ -97,9 +98,15 @@ public:
         std::istream & istream,
         const std::string & fileName) const override;
 
+    CachedFileRcPtr readBuffer(
+        const char * data,
+        size_t size,
+        const std::string & fileName) const override;
+
     void bake(const Baker & baker,
                 const std::string & formatName,
-                std::ostream & ostream) const override;
+                std::ostream & ostream,
+                BakingCache & cache) const override;
 
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
@@ -154,6 +161,18 @@ LocalFileFormat::read(
         throw Exception ("File stream empty when trying to read Iridas .cube LUT");
     }
 
+    std::string buffer;
+    ReadStream(istream, buffer);
+    return readBuffer(buffer.data(), buffer.size(), fileName);
+}
+
+CachedFileRcPtr
+LocalFileFormat::readBuffer(
+    const char * data,
+    size_t size,
+    const std::string & fileName) const
+{
+
     // Parse the file
     std::vector<float> raw;
 
@@ -167,16 +186,32 @@ LocalFileFormat::read(
     float domain_max[] = { 1.0f, 1.0f, 1.0f };
 
     {
+        // Tokenize the file content in place, the per line copies and string streams
+        // are far too slow for the large LUTs.
+        LineTokenizer lines(data, data + size);
+
         std::string line;
         StringUtils::StringVec parts;
         std::vector<float> tmpfloats;
         int lineNumber = 0;
 
-        while(nextline(istream, line))
+        while(lines.nextLine())
         {
+            if(lines.lineEmpty()) continue;
+
             ++lineNumber;
             // All lines starting with '#' are comments
-            if(StringUtils::StartsWith(line,"#")) continue;
+            if(*lines.lineBegin() == '#') continue;
+
+            // The color triples are by far the most frequent lines.
+            float rgb[3];
+            if(lines.getNumbers(rgb, 3))
+            {
+                raw.insert(raw.end(), rgb, rgb + 3);
+                continue;
+            }
+
+            line = lines.line();
 
             // Strip, lowercase, and split the line
             parts = StringUtils::SplitByWhiteSpaces(StringUtils::Lower(StringUtils::Trim(line)));
@@ -346,7 +381,8 @@ LocalFileFormat::read(
 
 void LocalFileFormat::bake(const Baker & baker,
                             const std::string & formatName,
-                            std::ostream & ostream) const
+                            std::ostream & ostream,
+                            BakingCache & cache) const
 {
 
     static const int DEFAULT_CUBE_SIZE = 32;
@@ -365,11 +401,6 @@ void LocalFileFormat::bake(const Baker & baker,
     if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
     cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-    std::vector<float> cubeData;
-    cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-    GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-    PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
     // Apply our conversion from the input space to the output space.
     ConstProcessorRcPtr inputToTarget;
     std::string looks = baker.getLooks();
@@ -386,7 +417,9 @@ void LocalFileFormat::bake(const Baker & baker,
         inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
     }
     ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-    cpu->apply(cubeImg);
+    const ConstLutValuesRcPtr cubeValues
+        = cache.getLut3D(cubeSize, LUT3DORDER_FAST_RED, { cpu }, baker.getNumThreads());
+    const std::vector<float> & cubeData = *cubeValues;
 
     const auto & metadata = baker.getFormatMetadata();
     const auto nb = metadata.getNumChildrenElements();
@@ -409,12 +442,8 @@ void LocalFileFormat::bake(const Baker & baker,
     // Set to a fixed 6 decimal precision
     ostream.setf(std::ios::fixed, std::ios::floatfield);
     ostream.precision(6);
-    for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
-    {
-        ostream << cubeData[3*i+0] << " "
-                << cubeData[3*i+1] << " "
-                << cubeData[3*i+2] << "\n";
-    }
+    WriteFixedTriplets(ostream, cubeData.data(), cubeSize*cubeSize*cubeSize, 6,
+                       baker.getNumThreads());
 }
 
 void
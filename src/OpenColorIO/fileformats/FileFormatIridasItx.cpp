@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut3d/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -73,7 +74,8 @@ public:
 
     void bake(const Baker & baker,
                 const std::string & formatName,
-                std::ostream & ostream) const override;
+                std::ostream & ostream,
+                BakingCache & cache) const override;
 
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
@@ -225,7 +227,8 @@ LocalFileFormat::read(
 
 void LocalFileFormat::bake(const Baker & baker,
                             const std::string & formatName,
-                            std::ostream & ostream) const
+                            std::ostream & ostream,
+                            BakingCache & cache) const
 {
     int DEFAULT_CUBE_SIZE = 64;
 
@@ -243,11 +246,6 @@ void LocalFileFormat::bake(const Baker & baker,
     if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
     cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-    std::vector<float> cubeData;
-    cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-    GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-    PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
     // Apply our conversion from the input space to the output space.
     ConstProcessorRcPtr inputToTarget;
     std::string looks = baker.getLooks();
@@ -266,7 +264,9 @@ void LocalFileFormat::bake(const Baker & baker,
             baker.getTargetSpace());
     }
     ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-    cpu->apply(cubeImg);
+    const ConstLutValuesRcPtr cubeValues
+        = cache.getLut3D(cubeSize, LUT3DORDER_FAST_RED, { cpu }, baker.getNumThreads());
+    const std::vector<float> & cubeData = *cubeValues;
 
     // Write out the file.
     // For for maximum compatibility with other apps, we will
@@ -281,13 +281,8 @@ void LocalFileFormat::bake(const Baker & baker,
     // Set to a fixed 6 decimal precision
     ostream.setf(std::ios::fixed, std::ios::floatfield);
     ostream.precision(6);
-    for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
-    {
-        float r = cubeData[3*i+0];
-        float g = cubeData[3*i+1];
-        float b = cubeData[3*i+2];
-        ostream << r << " " << g << " " << b << "\n";
-    }
+    WriteFixedTriplets(ostream, cubeData.data(), cubeSize*cubeSize*cubeSize, 6,
+                       baker.getNumThreads());
     ostream << "\n";
 }
 
@@ -0,0 +1,722 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "BakingUtils.h"
+#include "HalfConversion.h"
+#include "ops/lut1d/Lut1DOpData.h"
+#include "ops/lut3d/Lut3DOpData.h"
+#include "ops/matrix/MatrixOpData.h"
+#include "ops/range/RangeOpData.h"
+#include "ParseUtils.h"
+#include "transforms/FileTransform.h"
+
+
+/*
+
+Compact binary container for a list of LUT ops, meant to avoid any text parsing when
+loading large LUTs. The file is the result of a bake or of a processor write (e.g. to
+convert any other LUT file once).
+
+All the values are little-endian. The header is:
+
+    char[8]  "OCIOBLUT"
+    uint32   version of the layout (i.e. 1)
+    uint32   number of ops
+
+followed by the ops, each starting with an uint32 op type:
+
+    1 - Lut1D:  uint8 value type (0 = float, 1 = half), uint8 interpolation,
+                uint8 direction (0 = forward, 1 = inverse), uint8 hue adjust,
+                uint8 half flags, uint8 number of color components, uint16 reserved,
+                uint32 length, then the length * 3 values.
+    2 - Lut3D:  uint8 value type, uint8 interpolation, uint8 direction, uint8 reserved,
+                uint32 grid size, then the grid size^3 * 3 values (blue changing fastest).
+    3 - Matrix: uint8 direction, uint8[3] reserved, then 16 doubles for the matrix and
+                4 doubles for the offsets.
+    4 - Range:  uint8 direction, uint8[3] reserved, then 4 doubles for the min in,
+                max in, min out & max out values (NaN when not set).
+
+The LUT values start at an offset which is a multiple of 16 bytes (the padding bytes are
+zeros) so the values of a memory mapped file are aligned, and are read with a single copy
+into the LUT storage.
+
+*/
+
+
+namespace OCIO_NAMESPACE
+{
+
+namespace
+{
+
+constexpr char BINARY_LUT_MAGIC[8] = { 'O', 'C', 'I', 'O', 'B', 'L', 'U', 'T' };
+constexpr uint32_t BINARY_LUT_VERSION = 1;
+constexpr size_t BINARY_LUT_ALIGNMENT = 16;
+
+constexpr char FILEFORMAT_BINARY_LUT[] = "ocio_binary_lut";
+constexpr char FILEFORMAT_BINARY_LUT_HALF[] = "ocio_binary_lut_half";
+
+enum BinaryOpType : uint32_t
+{
+    BINARY_OP_LUT1D  = 1,
+    BINARY_OP_LUT3D  = 2,
+    BINARY_OP_MATRIX = 3,
+    BINARY_OP_RANGE  = 4
+};
+
+enum BinaryValueType : uint8_t
+{
+    BINARY_VALUE_FLOAT = 0,
+    BINARY_VALUE_HALF  = 1
+};
+
+bool IsLittleEndian()
+{
+    const uint16_t value = 1;
+    uint8_t firstByte = 0;
+    memcpy(&firstByte, &value, 1);
+    return firstByte == 1;
+}
+
+template<typename T>
+void SwapBytes(T & value)
+{
+    char * bytes = reinterpret_cast<char *>(&value);
+    for (size_t idx = 0; idx < sizeof(T) / 2; ++idx)
+    {
+        std::swap(bytes[idx], bytes[sizeof(T) - 1 - idx]);
+    }
+}
+
+uint8_t DirectionToByte(TransformDirection dir)
+{
+    return dir == TRANSFORM_DIR_INVERSE ? 1 : 0;
+}
+
+class BinaryLutWriter
+{
+public:
+    explicit BinaryLutWriter(std::ostream & ostream)
+        : m_ostream(ostream)
+        , m_littleEndian(IsLittleEndian())
+    {
+    }
+
+    template<typename T>
+    void write(T value)
+    {
+        if (!m_littleEndian)
+        {
+            SwapBytes(value);
+        }
+        writeBytes(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void writeValues(const std::vector<float> & values, BinaryValueType valueType)
+    {
+        align();
+
+        if (valueType == BINARY_VALUE_HALF)
+        {
+            std::vector<half> halfValues(values.size());
+            ConvertFloatToHalf(values.data(), halfValues.data(), (long)values.size());
+            writeArray(halfValues.data(), halfValues.size());
+        }
+        else
+        {
+            writeArray(values.data(), values.size());
+        }
+    }
+
+    void writeBytes(const char * bytes, size_t size)
+    {
+        m_ostream.write(bytes, (std::streamsize)size);
+        m_offset += size;
+    }
+
+private:
+
+    template<typename T>
+    void writeArray(const T * values, size_t numValues)
+    {
+        if (m_littleEndian)
+        {
+            writeBytes(reinterpret_cast<const char *>(values), numValues * sizeof(T));
+        }
+        else
+        {
+            for (size_t idx = 0; idx < numValues; ++idx)
+            {
+                T value = values[idx];
+                SwapBytes(value);
+                writeBytes(reinterpret_cast<const char *>(&value), sizeof(T));
+            }
+        }
+    }
+
+    void align()
+    {
+        static const char padding[BINARY_LUT_ALIGNMENT] = { 0 };
+        const size_t remainder = m_offset % BINARY_LUT_ALIGNMENT;
+        if (remainder != 0)
+        {
+            writeBytes(padding, BINARY_LUT_ALIGNMENT - remainder);
+        }
+    }
+
+    std::ostream & m_ostream;
+    size_t m_offset = 0;
+    const bool m_littleEndian;
+};
+
+class BinaryLutReader
+{
+public:
+    BinaryLutReader(const char * data, size_t size, const std::string & fileName)
+        : m_data(data)
+        , m_size(size)
+        , m_fileName(fileName)
+        , m_littleEndian(IsLittleEndian())
+    {
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value;
+        memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+        if (!m_littleEndian)
+        {
+            SwapBytes(value);
+        }
+        return value;
+    }
+
+    void readValues(std::vector<float> & values, BinaryValueType valueType)
+    {
+        align();
+
+        const size_t numValues = values.size();
+        if (valueType == BINARY_VALUE_HALF)
+        {
+            std::vector<half> halfValues(numValues);
+            readArray(halfValues.data(), numValues);
+            ConvertHalfToFloat(halfValues.data(), values.data(), (long)numValues);
+        }
+        else
+        {
+            readArray(values.data(), numValues);
+        }
+    }
+
+    // Throw if the remaining data cannot hold the number of values.
+    void checkValues(uint64_t numValues, BinaryValueType valueType) const
+    {
+        const uint64_t valueSize = valueType == BINARY_VALUE_HALF ? sizeof(half) : sizeof(float);
+        if (numValues > (m_size - m_offset) / valueSize)
+        {
+            throwError("The file is truncated.");
+        }
+    }
+
+    void readHeader(uint32_t & numOps)
+    {
+        if (m_size < sizeof(BINARY_LUT_MAGIC)
+            || 0 != memcmp(m_data, BINARY_LUT_MAGIC, sizeof(BINARY_LUT_MAGIC)))
+        {
+            throwError("The file is not a binary LUT.");
+        }
+        m_offset = sizeof(BINARY_LUT_MAGIC);
+
+        const uint32_t version = read<uint32_t>();
+        if (version != BINARY_LUT_VERSION)
+        {
+            std::ostringstream os;
+            os << "Unsupported version " << version << ".";
+            throwError(os.str());
+        }
+
+        numOps = read<uint32_t>();
+    }
+
+    TransformDirection readDirection()
+    {
+        const uint8_t dir = read<uint8_t>();
+        if (dir > 1)
+        {
+            throwError("Invalid direction.");
+        }
+        return dir == 1 ? TRANSFORM_DIR_INVERSE : TRANSFORM_DIR_FORWARD;
+    }
+
+    BinaryValueType readValueType()
+    {
+        const uint8_t valueType = read<uint8_t>();
+        if (valueType != BINARY_VALUE_FLOAT && valueType != BINARY_VALUE_HALF)
+        {
+            throwError("Invalid value type.");
+        }
+        return BinaryValueType(valueType);
+    }
+
+    void skip(size_t size)
+    {
+        readBytes(size);
+    }
+
+    bool atEnd() const
+    {
+        return m_offset == m_size;
+    }
+
+    void throwError(const std::string & error) const
+    {
+        std::ostringstream os;
+        os << "Error parsing binary LUT file (" << m_fileName << "). " << error;
+        throw Exception(os.str().c_str());
+    }
+
+private:
+    const char * readBytes(size_t size)
+    {
+        if (size > m_size - m_offset)
+        {
+            throwError("The file is truncated.");
+        }
+        const char * bytes = m_data + m_offset;
+        m_offset += size;
+        return bytes;
+    }
+
+    template<typename T>
+    void readArray(T * values, size_t numValues)
+    {
+        const char * bytes = readBytes(numValues * sizeof(T));
+        memcpy(values, bytes, numValues * sizeof(T));
+        if (!m_littleEndian)
+        {
+            for (size_t idx = 0; idx < numValues; ++idx)
+            {
+                SwapBytes(values[idx]);
+            }
+        }
+    }
+
+    void align()
+    {
+        const size_t remainder = m_offset % BINARY_LUT_ALIGNMENT;
+        if (remainder != 0)
+        {
+            readBytes(BINARY_LUT_ALIGNMENT - remainder);
+        }
+    }
+
+    const char * m_data;
+    const size_t m_size;
+    size_t m_offset = 0;
+    const std::string & m_fileName;
+    const bool m_littleEndian;
+};
+
+class LocalCachedFile : public CachedFile
+{
+public:
+    LocalCachedFile() = default;
+    ~LocalCachedFile() = default;
+
+    ConstOpDataVec m_ops;
+};
+
+typedef OCIO_SHARED_PTR<LocalCachedFile> LocalCachedFileRcPtr;
+
+class LocalFileFormat : public FileFormat
+{
+public:
+    LocalFileFormat() = default;
+    ~LocalFileFormat() = default;
+
+    void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+    CachedFileRcPtr read(
+        std::istream & istream,
+        const std::string & fileName) const override;
+
+    CachedFileRcPtr readBuffer(
+        const char * data,
+        size_t size,
+        const std::string & fileName) const override;
+
+    void bake(const Baker & baker,
+              const std::string & formatName,
+              std::ostream & ostream,
+              BakingCache & cache) const override;
+
+    void write(const OpRcPtrVec & ops,
+               const FormatMetadataImpl & metadata,
+               const std::string & formatName,
+               std::ostream & ostream) const override;
+
+    void buildFileOps(OpRcPtrVec & ops,
+                      const Config & config,
+                      const ConstContextRcPtr & context,
+                      CachedFileRcPtr untypedCachedFile,
+                      const FileTransform & fileTransform,
+                      TransformDirection dir) const override;
+
+    bool isBinary() const override
+    {
+        return true;
+    }
+};
+
+void LocalFileFormat::getFormatInfo(FormatInfoVec & formatInfoVec) const
+{
+    FormatInfo info;
+    info.name = FILEFORMAT_BINARY_LUT;
+    info.extension = "oblut";
+    info.capabilities = FORMAT_CAPABILITY_READ |
+                        FORMAT_CAPABILITY_BAKE |
+                        FORMAT_CAPABILITY_WRITE;
+    formatInfoVec.push_back(info);
+
+    // Same format with the LUT values stored as half floats, read by the reader above.
+    FormatInfo info2;
+    info2.name = FILEFORMAT_BINARY_LUT_HALF;
+    info2.extension = "oblut";
+    info2.capabilities = FORMAT_CAPABILITY_BAKE |
+                         FORMAT_CAPABILITY_WRITE;
+    formatInfoVec.push_back(info2);
+}
+
+CachedFileRcPtr LocalFileFormat::read(
+    std::istream & istream,
+    const std::string & fileName) const
+{
+    std::string buffer;
+    ReadStream(istream, buffer);
+    return readBuffer(buffer.data(), buffer.size(), fileName);
+}
+
+CachedFileRcPtr LocalFileFormat::readBuffer(
+    const char * data,
+    size_t size,
+    const std::string & fileName) const
+{
+    BinaryLutReader reader(data, size, fileName);
+
+    uint32_t numOps = 0;
+    reader.readHeader(numOps);
+
+    LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+    for (uint32_t opIdx = 0; opIdx < numOps; ++opIdx)
+    {
+        const uint32_t type = reader.read<uint32_t>();
+        switch (type)
+        {
+        case BINARY_OP_LUT1D:
+        {
+            const BinaryValueType valueType = reader.readValueType();
+            const uint8_t interpolation = reader.read<uint8_t>();
+            const TransformDirection direction = reader.readDirection();
+            const uint8_t hueAdjust = reader.read<uint8_t>();
+            const uint8_t halfFlags = reader.read<uint8_t>();
+            const uint8_t numComponents = reader.read<uint8_t>();
+            reader.skip(2);
+            const uint32_t length = reader.read<uint32_t>();
+
+            if (halfFlags > Lut1DOpData::LUT_INPUT_OUTPUT_HALF_CODE
+                || hueAdjust > HUE_DW3
+                || (numComponents != 1 && numComponents != 3))
+            {
+                reader.throwError("Invalid 1D LUT parameters.");
+            }
+            reader.checkValues(uint64_t(length) * 3, valueType);
+
+            auto lut = std::make_shared<Lut1DOpData>(Lut1DOpData::HalfFlags(halfFlags),
+                                                     length);
+            lut->setInterpolation(Interpolation(interpolation));
+            lut->setDirection(direction);
+            lut->setHueAdjust(Lut1DHueAdjust(hueAdjust));
+            lut->setFileOutputBitDepth(BIT_DEPTH_F32);
+
+            auto & array = lut->getArray();
+            array.resize(length, numComponents);
+            reader.readValues(array.getValues(), valueType);
+
+            cachedFile->m_ops.push_back(lut);
+            break;
+        }
+        case BINARY_OP_LUT3D:
+        {
+            const BinaryValueType valueType = reader.readValueType();
+            const uint8_t interpolation = reader.read<uint8_t>();
+            const TransformDirection direction = reader.readDirection();
+            reader.skip(1);
+            const uint32_t gridSize = reader.read<uint32_t>();
+
+            if (gridSize > Lut3DOpData::maxSupportedLength)
+            {
+                reader.throwError("Invalid 3D LUT grid size.");
+            }
+            reader.checkValues(uint64_t(gridSize) * gridSize * gridSize * 3, valueType);
+
+            auto lut = std::make_shared<Lut3DOpData>(Interpolation(interpolation),
+                                                     gridSize);
+            lut->setDirection(direction);
+            lut->setFileOutputBitDepth(BIT_DEPTH_F32);
+
+            reader.readValues(lut->getArray().getValues(), valueType);
+
+            cachedFile->m_ops.push_back(lut);
+            break;
+        }
+        case BINARY_OP_MATRIX:
+        {
+            auto matrix = std::make_shared<MatrixOpData>(reader.readDirection());
+            reader.skip(3);
+
+            for (unsigned long idx = 0; idx < 16; ++idx)
+            {
+                matrix->setArrayValue(idx, reader.read<double>());
+            }
+
+            double offsets[4];
+            for (double & offset : offsets)
+            {
+                offset = reader.read<double>();
+            }
+            matrix->setRGBAOffsets(offsets);
+
+            cachedFile->m_ops.push_back(matrix);
+            break;
+        }
+        case BINARY_OP_RANGE:
+        {
+            const TransformDirection direction = reader.readDirection();
+            reader.skip(3);
+            const double minIn  = reader.read<double>();
+            const double maxIn  = reader.read<double>();
+            const double minOut = reader.read<double>();
+            const double maxOut = reader.read<double>();
+
+            cachedFile->m_ops.push_back(
+                std::make_shared<RangeOpData>(minIn, maxIn, minOut, maxOut, direction));
+            break;
+        }
+        default:
+        {
+            std::ostringstream os;
+            os << "Unknown op type " << type << ".";
+            reader.throwError(os.str());
+        }
+        }
+
+        try
+        {
+            cachedFile->m_ops.back()->validate();
+        }
+        catch (Exception & e)
+        {
+            reader.throwError(e.what());
+        }
+    }
+
+    if (!reader.atEnd())
+    {
+        reader.throwError("Unexpected data after the last op.");
+    }
+
+    return cachedFile;
+}
+
+void LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
+                                   const Config & /*config*/,
+                                   const ConstContextRcPtr & /*context*/,
+                                   CachedFileRcPtr untypedCachedFile,
+                                   const FileTransform & fileTransform,
+                                   TransformDirection dir) const
+{
+    LocalCachedFileRcPtr cachedFile = DynamicPtrCast<LocalCachedFile>(untypedCachedFile);
+
+    // This should never happen.
+    if (!cachedFile)
+    {
+        std::ostringstream os;
+        os << "Cannot build binary LUT ops. Invalid cache type.";
+        throw Exception(os.str().c_str());
+    }
+
+    const TransformDirection newDir
+        = CombineTransformDirections(dir, fileTransform.getDirection());
+
+    if (newDir == TRANSFORM_DIR_UNKNOWN)
+    {
+        std::ostringstream os;
+        os << "Cannot build file format transform,";
+        os << " unspecified transform direction.";
+        throw Exception(os.str().c_str());
+    }
+
+    const ConstOpDataVec & opDataVec = cachedFile->m_ops;
+    if (newDir == TRANSFORM_DIR_FORWARD)
+    {
+        for (const auto & opData : opDataVec)
+        {
+            CreateOpVecFromOpData(ops, opData, newDir);
+        }
+    }
+    else
+    {
+        for (auto it = opDataVec.rbegin(); it != opDataVec.rend(); ++it)
+        {
+            CreateOpVecFromOpData(ops, *it, newDir);
+        }
+    }
+}
+
+void LocalFileFormat::bake(const Baker & baker,
+                           const std::string & formatName,
+                           std::ostream & ostream,
+                           BakingCache & cache) const
+{
+    OpRcPtrVec ops;
+    CreateBakedLutOps(ops, baker, cache);
+
+    write(ops, baker.getFormatMetadata(), formatName, ostream);
+}
+
+void LocalFileFormat::write(const OpRcPtrVec & ops,
+                            const FormatMetadataImpl & /*metadata*/,
+                            const std::string & formatName,
+                            std::ostream & ostream) const
+{
+    BinaryValueType valueType = BINARY_VALUE_FLOAT;
+    if (formatName == FILEFORMAT_BINARY_LUT_HALF)
+    {
+        valueType = BINARY_VALUE_HALF;
+    }
+    else if (formatName != FILEFORMAT_BINARY_LUT)
+    {
+        std::ostringstream os;
+        os << "Unknown binary LUT file format name, '";
+        os << formatName << "'.";
+        throw Exception(os.str().c_str());
+    }
+
+    // Check the ops before writing anything.
+    for (ConstOpRcPtr op : ops)
+    {
+        const OpData::Type type = op->data()->getType();
+        if (type != OpData::Lut1DType && type != OpData::Lut3DType
+            && type != OpData::MatrixType && type != OpData::RangeType)
+        {
+            std::ostringstream os;
+            os << "The binary LUT file format does not support the op '";
+            os << op->getInfo() << "'.";
+            throw Exception(os.str().c_str());
+        }
+    }
+
+    BinaryLutWriter writer(ostream);
+
+    writer.writeBytes(BINARY_LUT_MAGIC, sizeof(BINARY_LUT_MAGIC));
+    writer.write<uint32_t>(BINARY_LUT_VERSION);
+    writer.write<uint32_t>((uint32_t)ops.size());
+
+    for (ConstOpRcPtr op : ops)
+    {
+        ConstOpDataRcPtr opData = op->data();
+        switch (opData->getType())
+        {
+        case OpData::Lut1DType:
+        {
+            auto lut = OCIO_DYNAMIC_POINTER_CAST<const Lut1DOpData>(opData);
+            const auto & array = lut->getArray();
+
+            writer.write<uint32_t>(BINARY_OP_LUT1D);
+            writer.write<uint8_t>(valueType);
+            writer.write<uint8_t>((uint8_t)lut->getInterpolation());
+            writer.write<uint8_t>(DirectionToByte(lut->getDirection()));
+            writer.write<uint8_t>((uint8_t)lut->getHueAdjust());
+            writer.write<uint8_t>((uint8_t)lut->getHalfFlags());
+            writer.write<uint8_t>((uint8_t)array.getNumColorComponents());
+            writer.write<uint16_t>(0);
+            writer.write<uint32_t>((uint32_t)array.getLength());
+            writer.writeValues(array.getValues(), valueType);
+            break;
+        }
+        case OpData::Lut3DType:
+        {
+            auto lut = OCIO_DYNAMIC_POINTER_CAST<const Lut3DOpData>(opData);
+
+            writer.write<uint32_t>(BINARY_OP_LUT3D);
+            writer.write<uint8_t>(valueType);
+            writer.write<uint8_t>((uint8_t)lut->getInterpolation());
+            writer.write<uint8_t>(DirectionToByte(lut->getDirection()));
+            writer.write<uint8_t>(0);
+            writer.write<uint32_t>((uint32_t)lut->getArray().getLength());
+            writer.writeValues(lut->getArray().getValues(), valueType);
+            break;
+        }
+        case OpData::MatrixType:
+        {
+            auto matrix = OCIO_DYNAMIC_POINTER_CAST<const MatrixOpData>(opData);
+
+            writer.write<uint32_t>(BINARY_OP_MATRIX);
+            writer.write<uint8_t>(DirectionToByte(matrix->getDirection()));
+            writer.write<uint8_t>(0);
+            writer.write<uint16_t>(0);
+            for (double value : matrix->getArray().getValues())
+            {
+                writer.write<double>(value);
+            }
+            for (unsigned long idx = 0; idx < 4; ++idx)
+            {
+                writer.write<double>(matrix->getOffsets()[idx]);
+            }
+            break;
+        }
+        case OpData::RangeType:
+        {
+            auto range = OCIO_DYNAMIC_POINTER_CAST<const RangeOpData>(opData);
+
+            writer.write<uint32_t>(BINARY_OP_RANGE);
+            writer.write<uint8_t>(DirectionToByte(range->getDirection()));
+            writer.write<uint8_t>(0);
+            writer.write<uint16_t>(0);
+            writer.write<double>(range->getMinInValue());
+            writer.write<double>(range->getMaxInValue());
+            writer.write<double>(range->getMinOutValue());
+            writer.write<double>(range->getMaxOutValue());
+            break;
+        }
+        case OpData::CDLType:
+        case OpData::ExponentType:
+        case OpData::ExposureContrastType:
+        case OpData::FixedFunctionType:
+        case OpData::GammaType:
+        case OpData::LogType:
+        case OpData::ReferenceType:
+        case OpData::NoOpType:
+            // Already checked above.
+            break;
+        }
+    }
+}
+
+} // anon.
+
+FileFormat * CreateFileFormatOCIOBinaryLut()
+{
+    return new LocalFileFormat();
+}
+
+} // namespace OCIO_NAMESPACE
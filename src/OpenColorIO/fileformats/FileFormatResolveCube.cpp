@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut3d/Lut3DOp.h"
 #include "ops/matrix/MatrixOp.h"
@@ -206,9 +207,15 @@ public:
         std::istream & istream,
         const std::string & fileName) const override;
 
+    CachedFileRcPtr readBuffer(
+        const char * data,
+        size_t size,
+        const std::string & fileName) const override;
+
     void bake(const Baker & baker,
                 const std::string & formatName,
-                std::ostream & ostream) const override;
+                std::ostream & ostream,
+                BakingCache & cache) const override;
 
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
@@ -262,6 +269,17 @@ CachedFileRcPtr LocalFileFormat::read(
         throw Exception ("File stream empty when trying to read Resolve .cube lut");
     }
 
+    std::string buffer;
+    ReadStream(istream, buffer);
+    return readBuffer(buffer.data(), buffer.size(), fileName);
+}
+
+CachedFileRcPtr LocalFileFormat::readBuffer(
+    const char * data,
+    size_t size,
+    const std::string & fileName) const
+{
+
     // Parse the file
     std::vector<float> raw1d;
     std::vector<float> raw3d;
@@ -279,6 +297,10 @@ CachedFileRcPtr LocalFileFormat::read(
     float range3d_max = 1.0f;
 
     {
+        // Tokenize the file content in place, the per line copies and string streams
+        // are far too slow for the large LUTs.
+        LineTokenizer lines(data, data + size);
+
         std::string line;
         StringUtils::StringVec parts;
         std::vector<float> tmpfloats;
@@ -286,10 +308,27 @@ CachedFileRcPtr LocalFileFormat::read(
         bool headerComplete = false;
         int tripletNumber = 0;
 
-        while(nextline(istream, line))
+        while(lines.nextLine())
         {
+            if(lines.lineEmpty()) continue;
+
             ++lineNumber;
 
+            // The color triples are by far the most frequent lines.
+            float rgb[3];
+            if(lines.getNumbers(rgb, 3))
+            {
+                headerComplete = true;
+
+                std::vector<float> & raw = (has1d && tripletNumber < size1d) ? raw1d : raw3d;
+                raw.insert(raw.end(), rgb, rgb + 3);
+
+                ++tripletNumber;
+                continue;
+            }
+
+            line = lines.line();
+
             // All lines starting with '#' are comments
             if(StringUtils::StartsWith(line,"#"))
             {
@@ -483,7 +522,8 @@ CachedFileRcPtr LocalFileFormat::read(
 
 void LocalFileFormat::bake(const Baker & baker,
                             const std::string & formatName,
-                            std::ostream & ostream) const
+                            std::ostream & ostream,
+                            BakingCache & cache) const
 {
 
     const int DEFAULT_1D_SIZE = 4096;
@@ -660,13 +700,9 @@ void LocalFileFormat::bake(const Baker & baker,
     // Generate 3DLUT
     //
 
-    std::vector<float> cubeData;
+    ConstLutValuesRcPtr cubeData;
     if(required_lut == CUBE_3D || required_lut == CUBE_1D_3D)
     {
-        cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-        GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-        PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
         ConstProcessorRcPtr cubeProc;
         if(required_lut == CUBE_1D_3D)
         {
@@ -693,22 +729,18 @@ void LocalFileFormat::bake(const Baker & baker,
         }
 
         ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-        cpu->apply(cubeImg);
+        cubeData = cache.getLut3D(cubeSize, LUT3DORDER_FAST_RED, { cpu }, baker.getNumThreads());
     }
 
     //
     // Generate 1DLUT
     //
 
-    std::vector<float> onedData;
+    ConstLutValuesRcPtr onedData;
     if(required_lut == CUBE_1D)
     {
-        onedData.resize(onedSize * 3);
-        GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-        PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
-
         ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-        cpu->apply(onedImg);
+        onedData = cache.getLut1D(onedSize, { cpu }, baker.getNumThreads());
     }
 
     //
@@ -756,32 +788,18 @@ void LocalFileFormat::bake(const Baker & baker,
     // Write 1D data
     if(required_lut == CUBE_1D)
     {
-        for(int i=0; i<onedSize; ++i)
-        {
-            ostream << onedData[3*i+0] << " "
-                    << onedData[3*i+1] << " "
-                    << onedData[3*i+2] << "\n";
-        }
+        WriteFixedTriplets(ostream, onedData->data(), onedSize, 6, baker.getNumThreads());
     }
     else if(required_lut == CUBE_1D_3D)
     {
-        for(int i=0; i<shaperSize; ++i)
-        {
-            ostream << shaperData[3*i+0] << " "
-                    << shaperData[3*i+1] << " "
-                    << shaperData[3*i+2] << "\n";
-        }
+        WriteFixedTriplets(ostream, shaperData.data(), shaperSize, 6, baker.getNumThreads());
     }
 
     // Write 3D data
     if(required_lut == CUBE_3D || required_lut == CUBE_1D_3D)
     {
-        for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
-        {
-            ostream << cubeData[3*i+0] << " "
-                    << cubeData[3*i+1] << " "
-                    << cubeData[3*i+2] << "\n";
-        }
+        WriteFixedTriplets(ostream, cubeData->data(), cubeSize*cubeSize*cubeSize, 6,
+                           baker.getNumThreads());
     }
 }
 
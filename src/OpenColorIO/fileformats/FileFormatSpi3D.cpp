@@ -1,13 +1,13 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
-#include <cstdio>
 #include <sstream>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "ops/lut3d/Lut3DOp.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 #include "transforms/FileTransform.h"
 #include "utils/StringUtils.h"
@@ -54,6 +54,11 @@ public:
         std::istream & istream,
         const std::string & fileName) const override;
 
+    CachedFileRcPtr readBuffer(
+        const char * data,
+        size_t size,
+        const std::string & fileName) const override;
+
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
                         const ConstContextRcPtr & context,
@@ -75,11 +80,25 @@ CachedFileRcPtr LocalFileFormat::read(
     std::istream & istream,
     const std::string & fileName) const
 {
-    const int MAX_LINE_SIZE = 4096;
-    char lineBuffer[MAX_LINE_SIZE];
+    std::string buffer;
+    ReadStream(istream, buffer);
+    return readBuffer(buffer.data(), buffer.size(), fileName);
+}
+
+CachedFileRcPtr LocalFileFormat::readBuffer(
+    const char * data,
+    size_t size,
+    const std::string & fileName) const
+{
+    // Tokenize the file content in place, sscanf() is far too slow (and locale
+    // dependent) for the large LUTs.
+    LineTokenizer lines(data, data + size);
+
+    std::string lineBuffer;
 
     // Read header information
-    istream.getline(lineBuffer, MAX_LINE_SIZE);
+    lines.nextLine();
+    lineBuffer = lines.line();
     if(!StringUtils::StartsWith(StringUtils::Lower(lineBuffer), "spilut"))
     {
         std::ostringstream os;
@@ -92,12 +111,13 @@ CachedFileRcPtr LocalFileFormat::read(
     }
 
     // TODO: Assert 2nd line is 3 3
-    istream.getline(lineBuffer, MAX_LINE_SIZE);
+    lines.nextLine();
 
     // Get LUT Size
-    int rSize = 0, gSize = 0, bSize = 0;
-    istream.getline(lineBuffer, MAX_LINE_SIZE);
-    if (3 != sscanf(lineBuffer, "%d %d %d", &rSize, &gSize, &bSize))
+    int sizes[3] = { 0, 0, 0 };
+    lines.nextLine();
+    lineBuffer = lines.line();
+    if (!ScanNumbers(lines.lineBegin(), lines.lineEnd(), sizes, 3))
     {
         std::ostringstream os;
         os << "Error parsing .spi3d file (";
@@ -108,6 +128,8 @@ CachedFileRcPtr LocalFileFormat::read(
         throw Exception(os.str().c_str());
     }
 
+    const int rSize = sizes[0], gSize = sizes[1], bSize = sizes[2];
+
     // TODO: Support nonuniformly sized LUTs.
     if (rSize != gSize || rSize != bSize)
     {
@@ -125,21 +147,21 @@ CachedFileRcPtr LocalFileFormat::read(
 
     // Parse table
     int index = 0;
-    int rIndex, gIndex, bIndex;
-    float redValue, greenValue, blueValue;
 
     int entriesRemaining = rSize * gSize * bSize;
     Array & lutArray = lut3d->getArray();
     unsigned long numVal = lutArray.getNumValues();
     std::vector<bool> indexDefined(numVal, false);
-    while (istream.good() && entriesRemaining > 0)
+    while (lines.nextLine() && entriesRemaining > 0)
     {
-        istream.getline(lineBuffer, MAX_LINE_SIZE);
+        int indices[3];
+        float values[3];
 
-        if (sscanf(lineBuffer, "%d %d %d %f %f %f",
-            &rIndex, &gIndex, &bIndex,
-            &redValue, &greenValue, &blueValue) == 6)
+        const char * ptr = ScanNumbers(lines.lineBegin(), lines.lineEnd(), indices, 3);
+        if (ptr && ScanNumbers(ptr, lines.lineEnd(), values, 3))
         {
+            const int rIndex = indices[0], gIndex = indices[1], bIndex = indices[2];
+
             bool invalidIndex = false;
             if (rIndex < 0 || rIndex >= rSize
                 || gIndex < 0 || gIndex >= gSize
@@ -171,9 +193,9 @@ CachedFileRcPtr LocalFileFormat::read(
                 throw Exception(os.str().c_str());
             }
 
-            lutArray[index+0] = redValue;
-            lutArray[index+1] = greenValue;
-            lutArray[index+2] = blueValue;
+            lutArray[index+0] = values[0];
+            lutArray[index+1] = values[1];
+            lutArray[index+2] = values[2];
             if (! indexDefined[index])
             {
                 entriesRemaining--;
@@ -9,6 +9,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut3d/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -64,7 +65,8 @@ public:
 
     void bake(const Baker & baker,
                 const std::string & formatName,
-                std::ostream & ostream) const override;
+                std::ostream & ostream,
+                BakingCache & cache) const override;
 
     void buildFileOps(OpRcPtrVec & ops,
                         const Config & config,
@@ -266,7 +268,8 @@ LocalFileFormat::read(
 void
 LocalFileFormat::bake(const Baker & baker,
                         const std::string & /*formatName*/,
-                        std::ostream & ostream) const
+                        std::ostream & ostream,
+                        BakingCache & cache) const
 {
     const int DEFAULT_CUBE_SIZE = 32;
     const int DEFAULT_SHAPER_SIZE = 1024;
@@ -277,17 +280,14 @@ LocalFileFormat::bake(const Baker & baker,
     if (cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
     cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-    std::vector<float> cubeData;
-    cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-    GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-    PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
     // Apply processor to LUT data
     ConstCPUProcessorRcPtr inputToTarget;
     inputToTarget
         = config->getProcessor(baker.getInputSpace(), 
                                 baker.getTargetSpace())->getDefaultCPUProcessor();
-    inputToTarget->apply(cubeImg);
+    const ConstLutValuesRcPtr cubeValues
+        = cache.getLut3D(cubeSize, LUT3DORDER_FAST_RED, { inputToTarget }, baker.getNumThreads());
+    const std::vector<float> & cubeData = *cubeValues;
 
     int shaperSize = baker.getShaperSize();
     if (shaperSize==-1) shaperSize = DEFAULT_SHAPER_SIZE;
@@ -319,10 +319,8 @@ LocalFileFormat::bake(const Baker & baker,
 
     // Write the cube
     ostream << "# Cube\n";
-    for (int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
-    {
-        ostream << cubeData[3*i+0] << " " << cubeData[3*i+1] << " " << cubeData[3*i+2] << "\n";
-    }
+    WriteFixedTriplets(ostream, cubeData.data(), cubeSize*cubeSize*cubeSize, 6,
+                       baker.getNumThreads());
 
     ostream << "# end\n";
 }
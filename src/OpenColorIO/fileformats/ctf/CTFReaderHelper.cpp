@@ -8,6 +8,7 @@
 #include "Logging.h"
 #include "MathUtils.h"
 #include "ops/log/LogUtils.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 #include "utils/StringUtils.h"
 
@@ -267,6 +268,7 @@ CTFReaderArrayElt::CTFReaderArrayElt(const std::string & name,
                                      const std::string & xmlFile)
     : XmlReaderPlainElt(name, pParent, xmlLineNumber, xmlFile)
     , m_array(nullptr)
+    , m_floatValues(nullptr)
     , m_position(0)
 {
 }
@@ -274,6 +276,7 @@ CTFReaderArrayElt::CTFReaderArrayElt(const std::string & name,
 CTFReaderArrayElt::~CTFReaderArrayElt()
 {
     m_array = nullptr; // Not owned
+    m_floatValues = nullptr;
 }
 
 void CTFReaderArrayElt::start(const char ** atts)
@@ -339,6 +342,14 @@ void CTFReaderArrayElt::start(const char ** atts)
     }
 
     m_position = 0;
+
+    // The LUT arrays store floats so the values could be directly written.
+    m_floatValues = nullptr;
+    auto * floatArray = dynamic_cast<ArrayT<float> *>(m_array);
+    if (floatArray && floatArray->getValues().size() == floatArray->getNumValues())
+    {
+        m_floatValues = floatArray->getValues().data();
+    }
 }
 
 void CTFReaderArrayElt::end()
@@ -358,13 +369,40 @@ void CTFReaderArrayElt::setRawData(const char * s,
     const unsigned long maxValues = m_array->getNumValues();
     size_t pos(0);
 
+    // This function is the most used when reading in large transforms so the values
+    // of the LUT arrays are directly scanned into the array. The scan stops at the
+    // first value it cannot handle (e.g. an illegal value or too many values) and
+    // the loop below then processes the remaining values and reports the errors.
+    if (m_floatValues)
+    {
+        const char * last = s + len;
+        while (pos != len && m_position < maxValues)
+        {
+            pos = FindNextTokenStart(s, len, pos);
+            if (pos == len)
+            {
+                break;
+            }
+
+            // Scan as double then cast to be identical to the strtod() based path.
+            double data(0.);
+            const char * next = ScanNumber(s + pos, last, data);
+            if (next == s + pos || (next != last && !IsNumberDelimiter(*next)))
+            {
+                break;
+            }
+
+            m_floatValues[m_position++] = (float)data;
+            pos = size_t(next - s);
+        }
+    }
+
     //
     // using GetNextNumber here instead of GetNumbers to leverage the loop
-    // needed here to process each value from the strings.  This function
-    // is the most used when reading in large transforms.
+    // needed here to process each value from the strings.
     //
 
-    pos = FindNextTokenStart(s, len, 0);
+    pos = FindNextTokenStart(s, len, pos);
     while (pos != len)
     {
         double data(0.);
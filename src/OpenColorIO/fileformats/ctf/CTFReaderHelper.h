@@ -208,6 +208,9 @@ private:
     // Array is managed as a member object of an OpData.
     ArrayBase * m_array;
 
+    // Direct access to the values when the array stores floats i.e. the LUT arrays.
+    float * m_floatValues;
+
     // The current position to fill.
     unsigned int m_position;
 };
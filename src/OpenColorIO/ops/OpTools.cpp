@@ -1,47 +1,87 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
 #include "ops/OpTools.h"
+#include "ParallelUtils.h"
 
 namespace OCIO_NAMESPACE
 {
+
+namespace
+{
+// Number of pixels evaluated at once by a thread. The chunk boundaries do not depend
+// on the number of threads so the results are always the same.
+constexpr long EVAL_CHUNK_SIZE = 4096;
+}
+
 void EvalTransform(const float * in,
                     float * out,
                     long numPixels,
                     OpRcPtrVec & ops)
 {
-    std::vector<float> tmp(numPixels * 4);
-
-    // Render the LUT entries (domain) through the ops.
-    const float * values = in;
-    for (long idx = 0; idx<numPixels; ++idx)
-    {
-        tmp[4 * idx + 0] = values[0];
-        tmp[4 * idx + 1] = values[1];
-        tmp[4 * idx + 2] = values[2];
-        tmp[4 * idx + 3] = 1.0f;
-
-        values += 3;
-    }
-
     ops.finalize(OPTIMIZATION_NONE);
 
+    // Create the CPU ops only once as some of them are costly to build (e.g. the exact
+    // inverse of a Lut3D).
+    ConstOpCPURcPtrVec cpuOps;
     for (OpRcPtrVec::size_type i = 0, size = ops.size(); i<size; ++i)
     {
-        ops[i]->apply(&tmp[0], &tmp[0], numPixels);
+        cpuOps.push_back(ops[i]->getCPUOp());
     }
 
-    float * result = out;
-    for (long idx = 0; idx<numPixels; ++idx)
+    // Do not reserve more threads than chunks.
+    const long numChunks = std::max(1L, (numPixels + EVAL_CHUNK_SIZE - 1) / EVAL_CHUNK_SIZE);
+    const ThreadReservation threads((unsigned)std::min<long>(numChunks, GetNumThreads(0)));
+    std::vector<std::vector<float>> buffers(threads.getNumThreads());
+
+    // Render the LUT entries (domain) through the ops.
+    ParallelFor(threads.getNumThreads(), numPixels, EVAL_CHUNK_SIZE,
+                [&](unsigned threadIdx, long begin, long end)
     {
-        result[0] = tmp[4 * idx + 0];
-        result[1] = tmp[4 * idx + 1];
-        result[2] = tmp[4 * idx + 2];
+        const long numChunkPixels = end - begin;
 
-        result += 3;
-    }
+        std::vector<float> & tmp = buffers[threadIdx];
+        tmp.resize(EVAL_CHUNK_SIZE * 4);
+
+        const float * values = in + 3 * begin;
+        for (long idx = 0; idx<numChunkPixels; ++idx)
+        {
+            tmp[4 * idx + 0] = values[0];
+            tmp[4 * idx + 1] = values[1];
+            tmp[4 * idx + 2] = values[2];
+            tmp[4 * idx + 3] = 1.0f;
+
+            values += 3;
+        }
+
+        for (OpRcPtrVec::size_type i = 0, size = ops.size(); i<size; ++i)
+        {
+            // Some ops (e.g. the no-ops) do not have a CPU op.
+            if (cpuOps[i])
+            {
+                cpuOps[i]->apply(&tmp[0], &tmp[0], numChunkPixels);
+            }
+            else
+            {
+                ops[i]->apply(&tmp[0], &tmp[0], numChunkPixels);
+            }
+        }
+
+        float * result = out + 3 * begin;
+        for (long idx = 0; idx<numChunkPixels; ++idx)
+        {
+            result[0] = tmp[4 * idx + 0];
+            result[1] = tmp[4 * idx + 1];
+            result[2] = tmp[4 * idx + 2];
+
+            result += 3;
+        }
+    });
 }
+
 } // namespace OCIO_NAMESPACE
@@ -14,6 +14,8 @@
 namespace OCIO_NAMESPACE
 {
 
+// Evaluate the RGB values (i.e. numPixels triplets) through the ops. The evaluation is
+// spread across all the hardware threads. Note that in and out could be the same buffer.
 void EvalTransform(const float * in, float * out,
                    long numPixels,
                    OpRcPtrVec & ops);
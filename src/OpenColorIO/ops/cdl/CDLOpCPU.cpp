@@ -296,6 +296,13 @@ CDLOpCPU::CDLOpCPU(ConstCDLOpDataRcPtr & cdl)
     :   OpCPU()
 {
     m_renderParams.update(cdl);
+
+    std::copy(m_renderParams.getSlope(), m_renderParams.getSlope() + 4, m_kernelParams.m_slope);
+    std::copy(m_renderParams.getOffset(), m_renderParams.getOffset() + 4, m_kernelParams.m_offset);
+    std::copy(m_renderParams.getPower(), m_renderParams.getPower() + 4, m_kernelParams.m_power);
+    m_kernelParams.m_saturation = m_renderParams.getSaturation();
+    m_kernelParams.m_reverse    = m_renderParams.isReverse();
+    m_kernelParams.m_clamp      = !m_renderParams.isNoClamp();
 }
 
 #ifdef USE_SSE
@@ -325,6 +332,12 @@ void CDLRendererV1_2Fwd::apply(const void * inImg, void * outImg, long numPixels
 template<bool CLAMP>
 void CDLRendererV1_2Fwd::_apply(const float * inImg, float * outImg, long numPixels) const
 {
+    if (m_kernels)
+    {
+        m_kernels->m_cdl(inImg, outImg, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     __m128 slope, offset, power, saturation, pix;
     LoadRenderParams(m_renderParams,
@@ -409,6 +422,12 @@ void CDLRendererV1_2Rev::apply(const void * inImg, void * outImg, long numPixels
 template<bool CLAMP>
 void CDLRendererV1_2Rev::_apply(const float * inImg, float * outImg, long numPixels) const
 {
+    if (m_kernels)
+    {
+        m_kernels->m_cdl(inImg, outImg, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     __m128 slopeRev, offsetRev, powerRev, saturationRev, pix;
     LoadRenderParams(m_renderParams,
@@ -9,6 +9,7 @@
 
 #include "Op.h"
 #include "ops/cdl/CDLOpData.h"
+#include "SIMDKernels.h"
 
 
 namespace OCIO_NAMESPACE
@@ -70,6 +71,9 @@ protected:
 protected:
     RenderParams m_renderParams;
 
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    CDLKernelParams m_kernelParams;
+
 private:
     CDLOpCPU();
 };
@@ -9,6 +9,7 @@
 #include "BitDepthUtils.h"
 #include "DynamicProperty.h"
 #include "ops/exposurecontrast/ExposureContrastOpCPU.h"
+#include "SIMDKernels.h"
 #include "SSE.h"
 
 namespace OCIO_NAMESPACE
@@ -31,12 +32,20 @@ public:
 protected:
     virtual void updateData(ConstExposureContrastOpDataRcPtr & ec) = 0;
 
+    // Compute out = pow(max(0, in * preScale), exponent) * postScale on the RGB channels
+    // using the SIMD kernels. Returns false when they are not available.
+    bool applyPowerKernel(const float * in, float * out, long numPixels,
+                          float preScale, float exponent, float postScale) const;
+
     DynamicPropertyImplRcPtr m_exposure;
     DynamicPropertyImplRcPtr m_contrast;
     DynamicPropertyImplRcPtr m_gamma;
 
     float m_pivot = 0.0f;
     float m_logExposureStep = 0.088f;
+
+private:
+    const SIMDKernels * m_kernels = GetSIMDKernels();
 };
 
 ECRendererBase::ECRendererBase(ConstExposureContrastOpDataRcPtr & ec)
@@ -104,6 +113,24 @@ DynamicPropertyRcPtr ECRendererBase::getDynamicProperty(DynamicPropertyType type
     throw Exception("ExposureContrast property is not dynamic.");
 }
 
+bool ECRendererBase::applyPowerKernel(const float * in, float * out, long numPixels,
+                                      float preScale, float exponent, float postScale) const
+{
+    if (!m_kernels)
+    {
+        return false;
+    }
+
+    PowerKernelParams params;
+    std::fill(params.m_preScale, params.m_preScale + 3, preScale);
+    std::fill(params.m_exponent, params.m_exponent + 3, exponent);
+    std::fill(params.m_postScale, params.m_postScale + 3, postScale);
+    params.m_keepAlpha = true;
+
+    m_kernels->m_power(in, out, numPixels, params);
+    return true;
+}
+
 
 class ECLinearRenderer : public ECRendererBase
 {
@@ -157,6 +184,11 @@ void ECLinearRenderer::apply(const void * inImg, void * outImg, long numPixels)
     }
     else
     {
+        if (applyPowerKernel(in, out, numPixels, exposureVal / m_pivot, contrastVal, m_pivot))
+        {
+            return;
+        }
+
 #ifdef USE_SSE
         __m128 contrast = _mm_set1_ps(contrastVal);
         __m128 exposure_over_pivot = _mm_set1_ps(exposureVal / m_pivot);
@@ -257,6 +289,12 @@ void ECLinearRevRenderer::apply(const void * inImg, void * outImg, long numPixel
     }
     else
     {
+        if (applyPowerKernel(in, out, numPixels,
+                             1.f / m_pivot, invContrastVal, m_pivot * invExposureVal))
+        {
+            return;
+        }
+
 #ifdef USE_SSE
         __m128 inv_contrast = _mm_set1_ps(invContrastVal);
 
@@ -367,6 +405,11 @@ void ECVideoRenderer::apply(const void * inImg, void * outImg, long numPixels) c
     }
     else
     {
+        if (applyPowerKernel(in, out, numPixels, exposureVal / m_pivot, contrastVal, m_pivot))
+        {
+            return;
+        }
+
 #ifdef USE_SSE
         __m128 contrast = _mm_set1_ps(contrastVal);
         __m128 exposure_over_pivot = _mm_set1_ps(exposureVal / m_pivot);
@@ -472,6 +515,11 @@ void ECVideoRevRenderer::apply(const void * inImg, void * outImg, long numPixels
     }
     else
     {
+        if (applyPowerKernel(in, out, numPixels, invPivotVal, invContrastVal, pivotOverExposureVal))
+        {
+            return;
+        }
+
 #ifdef USE_SSE
         __m128 inv_contrast = _mm_set1_ps(invContrastVal);
         __m128 pivot_over_exposure = _mm_set1_ps(pivotOverExposureVal);
@@ -9,6 +9,7 @@
 
 #include "BitDepthUtils.h"
 #include "ops/fixedfunction/FixedFunctionOpCPU.h"
+#include "SSE.h"
 
 
 namespace OCIO_NAMESPACE
@@ -209,6 +210,49 @@ public:
 ///////////////////////////////////////////////////////////////////////////////
 
 
+#ifdef USE_SSE
+
+// The SSE versions of the renderers process four pixels at once with one register per
+// channel. They use the same sequence of operations as the scalar code and masks instead
+// of the branches, so the results are identical except where an approximation of a C
+// library function (i.e. atan2f() and powf()) is used.
+
+namespace
+{
+
+inline void LoadPixels(const float * in, __m128 & red, __m128 & grn, __m128 & blu, __m128 & alpha)
+{
+    red   = _mm_loadu_ps(in);
+    grn   = _mm_loadu_ps(in + 4);
+    blu   = _mm_loadu_ps(in + 8);
+    alpha = _mm_loadu_ps(in + 12);
+    _MM_TRANSPOSE4_PS(red, grn, blu, alpha);
+}
+
+inline void StorePixels(float * out, __m128 red, __m128 grn, __m128 blu, __m128 alpha)
+{
+    _MM_TRANSPOSE4_PS(red, grn, blu, alpha);
+    _mm_storeu_ps(out,      red);
+    _mm_storeu_ps(out + 4,  grn);
+    _mm_storeu_ps(out + 8,  blu);
+    _mm_storeu_ps(out + 12, alpha);
+}
+
+// Same results as std::min() and std::max(), including for the NaN values.
+inline __m128 StdMin(__m128 a, __m128 b) { return _mm_min_ps(b, a); }
+inline __m128 StdMax(__m128 a, __m128 b) { return _mm_max_ps(b, a); }
+
+inline __m128 Negate(__m128 a) { return _mm_xor_ps(a, ESIGN_MASK); }
+
+// Return (d == 0) ? 0 : num / d
+inline __m128 SafeDivide(__m128 num, __m128 d)
+{
+    return _mm_and_ps(_mm_div_ps(num, d), _mm_cmpneq_ps(d, EZERO));
+}
+
+} // anon.
+
+#endif // USE_SSE
 
 
 // Calculate a saturation measure in a safe manner.
@@ -226,6 +270,18 @@ __inline float CalcSatWeight(const float red, const float grn, const float blu,
     return sat;
 }
 
+#ifdef USE_SSE
+__inline __m128 CalcSatWeight(__m128 red, __m128 grn, __m128 blu, __m128 noiseLimit)
+{
+    const __m128 minVal = StdMin( red, StdMin( grn, blu ) );
+    const __m128 maxVal = StdMax( red, StdMax( grn, blu ) );
+
+    const __m128 lowLimit = _mm_set1_ps(1e-10f);
+    return _mm_div_ps(_mm_sub_ps(StdMax(lowLimit, maxVal), StdMax(lowLimit, minVal)),
+                      StdMax(noiseLimit, maxVal));
+}
+#endif
+
 Renderer_ACES_RedMod03_Fwd::Renderer_ACES_RedMod03_Fwd(ConstFixedFunctionOpDataRcPtr & /*data*/)
     :   OpCPU()
 {
@@ -287,12 +343,125 @@ __inline float CalcHueWeight(const float red, const float grn, const float blu,
     return f_H;
 }
 
+#ifdef USE_SSE
+__inline __m128 CalcHueWeight(__m128 red, __m128 grn, __m128 blu, __m128 inv_width)
+{
+    // Convert RGB to Yab (luma/chroma).
+    const __m128 a = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.f), red), _mm_add_ps(grn, blu));
+    const __m128 b = _mm_mul_ps(_mm_set1_ps(1.7320508075688772f), _mm_sub_ps(grn, blu));
+
+    const __m128 hue = sseAtan2Precise(b, a);
+
+    // Determine normalized input coords to B-spline.
+    const __m128 knot_coord = _mm_add_ps(_mm_mul_ps(hue, inv_width), _mm_set1_ps(2.f));
+    const __m128i j = _mm_cvttps_epi32(knot_coord);
+    const __m128 t = _mm_sub_ps(knot_coord, _mm_cvtepi32_ps(j));
+
+    // Select the quadratic B-spline coefficients of each pixel.
+    const __m128 isJ0 = _mm_castsi128_ps(_mm_cmpeq_epi32(j, _mm_set1_epi32(0)));
+    const __m128 isJ1 = _mm_castsi128_ps(_mm_cmpeq_epi32(j, _mm_set1_epi32(1)));
+    const __m128 isJ2 = _mm_castsi128_ps(_mm_cmpeq_epi32(j, _mm_set1_epi32(2)));
+
+    auto coef = [&](float c0, float c1, float c2, float c3) -> __m128
+    {
+        return sseSelect(isJ0, _mm_set1_ps(c0),
+                         sseSelect(isJ1, _mm_set1_ps(c1),
+                                   sseSelect(isJ2, _mm_set1_ps(c2), _mm_set1_ps(c3))));
+    };
+
+    const __m128 coef0 = coef( 0.25f, -0.75f,  0.75f, -0.25f);
+    const __m128 coef1 = coef( 0.00f,  0.75f, -1.50f,  0.75f);
+    const __m128 coef2 = coef( 0.00f,  0.75f,  0.00f, -0.75f);
+    const __m128 coef3 = coef( 0.00f,  0.25f,  1.00f,  0.25f);
+
+    const __m128 f_H
+        = _mm_add_ps(coef3,
+                     _mm_mul_ps(t, _mm_add_ps(coef2,
+                                              _mm_mul_ps(t, _mm_add_ps(coef1,
+                                                                       _mm_mul_ps(t, coef0))))));
+
+    // The weight is only defined for j in [0, 3].
+    const __m128i inWindow = _mm_andnot_si128(_mm_cmplt_epi32(j, _mm_set1_epi32(0)),
+                                              _mm_cmplt_epi32(j, _mm_set1_epi32(4)));
+
+    return _mm_and_ps(f_H, _mm_castsi128_ps(inWindow));
+}
+
+// Restore the hue after the red channel modification.
+__inline void RestoreHue(__m128 modified, __m128 red, __m128 newRed, __m128 & grn, __m128 & blu)
+{
+    const __m128 lowLimit = _mm_set1_ps(1e-10f);
+    const __m128 grnHigher = _mm_cmpge_ps(grn, blu);
+
+    // red >= grn >= blu
+    const __m128 hue_fac_grn = _mm_div_ps(_mm_sub_ps(grn, blu), StdMax(lowLimit, _mm_sub_ps(red, blu)));
+    const __m128 newGrn = _mm_add_ps(_mm_mul_ps(hue_fac_grn, _mm_sub_ps(newRed, blu)), blu);
+
+    // red >= blu >= grn
+    const __m128 hue_fac_blu = _mm_div_ps(_mm_sub_ps(blu, grn), StdMax(lowLimit, _mm_sub_ps(red, grn)));
+    const __m128 newBlu = _mm_add_ps(_mm_mul_ps(hue_fac_blu, _mm_sub_ps(newRed, grn)), grn);
+
+    grn = sseSelect(_mm_and_ps(modified, grnHigher), newGrn, grn);
+    blu = sseSelect(_mm_andnot_ps(grnHigher, modified), newBlu, blu);
+}
+
+// Compute the red value from the inverse of the red modifier.
+__inline __m128 InvRedMod(__m128 red, __m128 grn, __m128 blu, __m128 f_H,
+                          __m128 pivot, __m128 oneMinusScale)
+{
+    const __m128 minChan = sseSelect(_mm_cmplt_ps(grn, blu), grn, blu);
+
+    const __m128 a = _mm_sub_ps(_mm_mul_ps(f_H, oneMinusScale), EONE);
+    const __m128 b = _mm_sub_ps(red, _mm_mul_ps(_mm_mul_ps(f_H, _mm_add_ps(pivot, minChan)),
+                                                oneMinusScale));
+    const __m128 c = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(f_H, pivot), minChan), oneMinusScale);
+
+    const __m128 discriminant
+        = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(4.f), a), c));
+
+    return _mm_div_ps(_mm_sub_ps(Negate(b), _mm_sqrt_ps(discriminant)),
+                      _mm_mul_ps(_mm_set1_ps(2.f), a));
+}
+#endif
+
 void Renderer_ACES_RedMod03_Fwd::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+    const __m128 noiseLimit    = _mm_set1_ps(m_noiseLimit);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        const __m128 f_H = CalcHueWeight(red, grn, blu, inv_width);
+        const __m128 modified = _mm_cmpgt_ps(f_H, EZERO);
+
+        const __m128 f_S = CalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 newRed
+            = _mm_add_ps(red, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(f_H, f_S), _mm_sub_ps(pivot, red)),
+                                         oneMinusScale));
+
+        RestoreHue(modified, red, newRed, grn, blu);
+        red = sseSelect(modified, newRed, red);
+
+        StorePixels(out, red, grn, blu, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         float grn = in[1];
@@ -348,7 +517,34 @@ void Renderer_ACES_RedMod03_Inv::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        const __m128 f_H = CalcHueWeight(red, grn, blu, inv_width);
+        const __m128 modified = _mm_cmpgt_ps(f_H, EZERO);
+
+        const __m128 newRed = InvRedMod(red, grn, blu, f_H, pivot, oneMinusScale);
+
+        RestoreHue(modified, red, newRed, grn, blu);
+        red = sseSelect(modified, newRed, red);
+
+        StorePixels(out, red, grn, blu, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         float grn = in[1];
@@ -408,7 +604,38 @@ void Renderer_ACES_RedMod10_Fwd::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+    const __m128 noiseLimit    = _mm_set1_ps(m_noiseLimit);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        const __m128 f_H = CalcHueWeight(red, grn, blu, inv_width);
+        const __m128 modified = _mm_cmpgt_ps(f_H, EZERO);
+
+        const __m128 f_S = CalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 newRed
+            = _mm_add_ps(red, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(f_H, f_S), _mm_sub_ps(pivot, red)),
+                                         oneMinusScale));
+
+        red = sseSelect(modified, newRed, red);
+
+        StorePixels(out, red, grn, blu, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         const float grn = in[1];
@@ -450,7 +677,33 @@ void Renderer_ACES_RedMod10_Inv::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        const __m128 f_H = CalcHueWeight(red, grn, blu, inv_width);
+        const __m128 modified = _mm_cmpgt_ps(f_H, EZERO);
+
+        const __m128 newRed = InvRedMod(red, grn, blu, f_H, pivot, oneMinusScale);
+
+        red = sseSelect(modified, newRed, red);
+
+        StorePixels(out, red, grn, blu, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         float red = in[0];
         const float grn = in[1];
@@ -506,12 +759,77 @@ __inline float SigmoidShaper(const float sat)
     return s;
 }
 
+#ifdef USE_SSE
+__inline __m128 rgbToYC(__m128 red, __m128 grn, __m128 blu)
+{
+    const __m128 chroma
+        = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(blu, _mm_sub_ps(blu, grn)),
+                                            _mm_mul_ps(grn, _mm_sub_ps(grn, red))),
+                                 _mm_mul_ps(red, _mm_sub_ps(red, blu))));
+
+    return _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(blu, grn), red),
+                                 _mm_mul_ps(_mm_set1_ps(1.75f), chroma)),
+                      _mm_set1_ps(3.f));
+}
+
+__inline __m128 SigmoidShaper(__m128 sat)
+{
+    const __m128 x = _mm_mul_ps(_mm_sub_ps(sat, _mm_set1_ps(0.4f)), _mm_set1_ps(5.f));
+    const __m128 sign = _mm_or_ps(EONE, _mm_and_ps(x, ESIGN_MASK));
+    const __m128 t = StdMax(EZERO, _mm_sub_ps(EONE, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), sign), x)));
+    return _mm_mul_ps(_mm_add_ps(EONE, _mm_mul_ps(sign, _mm_sub_ps(EONE, _mm_mul_ps(t, t)))),
+                      _mm_set1_ps(0.5f));
+}
+#endif
+
 void Renderer_ACES_Glow03_Fwd::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 glowGain   = _mm_set1_ps(m_glowGain);
+    const __m128 GlowMid    = _mm_set1_ps(m_glowMid);
+    const __m128 noiseLimit = _mm_set1_ps(m_noiseLimit);
+    const __m128 highLimit  = _mm_set1_ps(m_glowMid * 2.f);
+    const __m128 lowLimit   = _mm_set1_ps(m_glowMid * 2.f / 3.f);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        // NB: YC is at inScale.
+        const __m128 YC = rgbToYC(red, grn, blu);
+
+        const __m128 sat = CalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 s = SigmoidShaper(sat);
+
+        const __m128 GlowGain = _mm_mul_ps(glowGain, s);
+
+        // Apply FwdGlow.
+        const __m128 glowGainOut
+            = _mm_andnot_ps(_mm_cmpge_ps(YC, highLimit),
+                            sseSelect(_mm_cmple_ps(YC, lowLimit),
+                                      GlowGain,
+                                      _mm_mul_ps(GlowGain, _mm_sub_ps(_mm_div_ps(GlowMid, YC),
+                                                                      _mm_set1_ps(0.5f)))));
+
+        // Calculate glow factor.
+        const __m128 addedGlow = _mm_add_ps(EONE, glowGainOut);
+
+        StorePixels(out, _mm_mul_ps(red, addedGlow), _mm_mul_ps(grn, addedGlow),
+                    _mm_mul_ps(blu, addedGlow), alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -567,7 +885,57 @@ void Renderer_ACES_Glow03_Inv::apply(const void * inImg, void * outImg, long num
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 glowGain   = _mm_set1_ps(m_glowGain);
+    const __m128 GlowMid    = _mm_set1_ps(m_glowMid);
+    const __m128 noiseLimit = _mm_set1_ps(m_noiseLimit);
+    const __m128 highLimit  = _mm_set1_ps(m_glowMid * 2.f);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        // NB: YC is at inScale.
+        const __m128 YC = rgbToYC(red, grn, blu);
+
+        const __m128 sat = CalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 s = SigmoidShaper(sat);
+
+        const __m128 GlowGain = _mm_mul_ps(glowGain, s);
+
+        // Apply InvGlow.
+        const __m128 onePlusGain = _mm_add_ps(EONE, GlowGain);
+        const __m128 lowLimit
+            = _mm_div_ps(_mm_mul_ps(_mm_mul_ps(onePlusGain, GlowMid), _mm_set1_ps(2.f)),
+                         _mm_set1_ps(3.f));
+
+        const __m128 midGain
+            = _mm_div_ps(_mm_mul_ps(GlowGain, _mm_sub_ps(_mm_div_ps(GlowMid, YC),
+                                                         _mm_set1_ps(0.5f))),
+                         _mm_sub_ps(_mm_mul_ps(GlowGain, _mm_set1_ps(0.5f)), EONE));
+
+        const __m128 glowGainOut
+            = _mm_andnot_ps(_mm_cmpge_ps(YC, highLimit),
+                            sseSelect(_mm_cmple_ps(YC, lowLimit),
+                                      _mm_div_ps(Negate(GlowGain), onePlusGain),
+                                      midGain));
+
+        // Calculate glow factor.
+        const __m128 reducedGlow = _mm_add_ps(EONE, glowGainOut);
+
+        StorePixels(out, _mm_mul_ps(red, reducedGlow), _mm_mul_ps(grn, reducedGlow),
+                    _mm_mul_ps(blu, reducedGlow), alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -623,7 +991,33 @@ void Renderer_ACES_DarkToDim10_Fwd::apply(const void * inImg, void * outImg, lon
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 minLum = _mm_set1_ps(1e-10f);
+    const __m128 gamma  = _mm_set1_ps(m_gamma);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        const __m128 Y
+            = StdMax(minLum, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.27222871678091454f), red),
+                                                   _mm_mul_ps(_mm_set1_ps(0.67408176581114831f), grn)),
+                                        _mm_mul_ps(_mm_set1_ps(0.053689517407937051f), blu)));
+
+        const __m128 Ypow_over_Y = ssePowerPrecise(Y, gamma);
+
+        StorePixels(out, _mm_mul_ps(red, Ypow_over_Y), _mm_mul_ps(grn, Ypow_over_Y),
+                    _mm_mul_ps(blu, Ypow_over_Y), alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -667,7 +1061,33 @@ void Renderer_REC2100_Surround::apply(const void * inImg, void * outImg, long nu
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 minLum = _mm_set1_ps(1e-4f);
+    const __m128 gamma  = _mm_set1_ps(m_gamma);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        const __m128 Y
+            = StdMax(minLum, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.2627f), red),
+                                                   _mm_mul_ps(_mm_set1_ps(0.6780f), grn)),
+                                        _mm_mul_ps(_mm_set1_ps(0.0593f), blu)));
+
+        const __m128 Ypow_over_Y = ssePowerPrecise(Y, gamma);
+
+        StorePixels(out, _mm_mul_ps(red, Ypow_over_Y), _mm_mul_ps(grn, Ypow_over_Y),
+                    _mm_mul_ps(blu, Ypow_over_Y), alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -716,7 +1136,52 @@ void Renderer_RGB_TO_HSV::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 two      = _mm_set1_ps(2.f);
+    const __m128 four     = _mm_set1_ps(4.f);
+    const __m128 six      = _mm_set1_ps(6.f);
+    const __m128 oneSixth = _mm_set1_ps(0.16666666666666666f);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 red, grn, blu, alpha;
+        LoadPixels(in, red, grn, blu, alpha);
+
+        const __m128 rgb_min = StdMin( StdMin( red, grn ), blu );
+        const __m128 rgb_max = StdMax( StdMax( red, grn ), blu );
+
+        const __m128 notGray = _mm_cmpneq_ps(rgb_min, rgb_max);
+        const __m128 delta = _mm_sub_ps(rgb_max, rgb_min);
+
+        // Sat
+        __m128 sat = _mm_and_ps(_mm_div_ps(delta, rgb_max),
+                                _mm_and_ps(notGray, _mm_cmpneq_ps(rgb_max, EZERO)));
+
+        // Hue
+        const __m128 hueRed = _mm_div_ps(_mm_sub_ps(grn, blu), delta);
+        const __m128 hueGrn = _mm_add_ps(two, _mm_div_ps(_mm_sub_ps(blu, red), delta));
+        const __m128 hueBlu = _mm_add_ps(four, _mm_div_ps(_mm_sub_ps(red, grn), delta));
+
+        __m128 hue = sseSelect(_mm_cmpeq_ps(red, rgb_max), hueRed,
+                               sseSelect(_mm_cmpeq_ps(grn, rgb_max), hueGrn, hueBlu));
+        hue = sseSelect(_mm_cmplt_ps(hue, EZERO), _mm_add_ps(hue, six), hue);
+        hue = _mm_and_ps(_mm_mul_ps(hue, oneSixth), notGray);
+
+        // Handle extended range inputs.
+        const __m128 val = sseSelect(_mm_cmplt_ps(rgb_min, EZERO), _mm_add_ps(rgb_max, rgb_min), rgb_max);
+        const __m128 neg_min = Negate(rgb_min);
+        sat = sseSelect(_mm_cmpgt_ps(neg_min, rgb_max), _mm_div_ps(delta, neg_min), sat);
+
+        StorePixels(out, hue, sat, val, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         const float red = in[0];
         const float grn = in[1];
@@ -798,7 +1263,61 @@ void Renderer_HSV_TO_RGB::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for (long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    const __m128 two    = _mm_set1_ps(2.f);
+    const __m128 three  = _mm_set1_ps(3.f);
+    const __m128 four   = _mm_set1_ps(4.f);
+    const __m128 six    = _mm_set1_ps(6.f);
+    const __m128 maxSat = _mm_set1_ps(1.999f);
+    const __m128 maxInt = _mm_set1_ps(8388608.f);
+
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 h, s, val, alpha;
+        LoadPixels(in, h, s, val, alpha);
+
+        // floor(h), the values greater than 2^23 being already integers.
+        __m128 floor_h = _mm_cvtepi32_ps(_mm_cvttps_epi32(h));
+        floor_h = _mm_sub_ps(floor_h, _mm_and_ps(EONE, _mm_cmpgt_ps(floor_h, h)));
+        floor_h = sseSelect(_mm_cmpge_ps(_mm_and_ps(h, EABS_MASK), maxInt), h, floor_h);
+
+        const __m128 hue = _mm_mul_ps(_mm_sub_ps(h, floor_h), six);
+        const __m128 sat = StdMin(StdMax(EZERO, s), maxSat);
+
+        const __m128 red = StdMin(StdMax(EZERO, _mm_sub_ps(_mm_and_ps(_mm_sub_ps(hue, three), EABS_MASK), EONE)), EONE);
+        const __m128 grn = StdMin(StdMax(EZERO, _mm_sub_ps(two, _mm_and_ps(_mm_sub_ps(hue, two), EABS_MASK))), EONE);
+        const __m128 blu = StdMin(StdMax(EZERO, _mm_sub_ps(two, _mm_and_ps(_mm_sub_ps(hue, four), EABS_MASK))), EONE);
+
+        __m128 rgb_max = val;
+        __m128 rgb_min = _mm_mul_ps(val, _mm_sub_ps(EONE, sat));
+
+        // Handle extended range inputs.
+        const __m128 twoMinusSat = _mm_sub_ps(two, sat);
+
+        const __m128 highSat = _mm_cmpgt_ps(sat, EONE);
+        rgb_min = sseSelect(highSat, _mm_div_ps(rgb_min, twoMinusSat), rgb_min);
+        rgb_max = sseSelect(highSat, _mm_sub_ps(val, rgb_min), rgb_max);
+
+        const __m128 negVal = _mm_cmplt_ps(val, EZERO);
+        rgb_min = sseSelect(negVal, _mm_div_ps(val, twoMinusSat), rgb_min);
+        rgb_max = sseSelect(negVal, _mm_sub_ps(val, rgb_min), rgb_max);
+
+        const __m128 delta = _mm_sub_ps(rgb_max, rgb_min);
+
+        StorePixels(out,
+                    _mm_add_ps(_mm_mul_ps(red, delta), rgb_min),
+                    _mm_add_ps(_mm_mul_ps(grn, delta), rgb_min),
+                    _mm_add_ps(_mm_mul_ps(blu, delta), rgb_min),
+                    alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for (; idx<numPixels; ++idx)
     {
         constexpr float MAX_SAT = 1.999f;
 
@@ -846,7 +1365,24 @@ void Renderer_XYZ_TO_xyY::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 X, Y, Z, alpha;
+        LoadPixels(in, X, Y, Z, alpha);
+
+        const __m128 d = SafeDivide(EONE, _mm_add_ps(_mm_add_ps(X, Y), Z));
+
+        StorePixels(out, _mm_mul_ps(X, d), _mm_mul_ps(Y, d), Y, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         const float X = in[0];
         const float Y = in[1];
@@ -877,7 +1413,26 @@ void Renderer_xyY_TO_XYZ::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 x, y, Y, alpha;
+        LoadPixels(in, x, y, Y, alpha);
+
+        const __m128 d = SafeDivide(EONE, y);
+        const __m128 X = _mm_mul_ps(_mm_mul_ps(Y, x), d);
+        const __m128 Z = _mm_mul_ps(_mm_mul_ps(Y, _mm_sub_ps(_mm_sub_ps(EONE, x), y)), d);
+
+        StorePixels(out, X, Y, Z, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         const float x = in[0];
         const float y = in[1];
@@ -907,7 +1462,28 @@ void Renderer_XYZ_TO_uvY::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 X, Y, Z, alpha;
+        LoadPixels(in, X, Y, Z, alpha);
+
+        const __m128 d
+            = SafeDivide(EONE, _mm_add_ps(_mm_add_ps(X, _mm_mul_ps(_mm_set1_ps(15.f), Y)),
+                                          _mm_mul_ps(_mm_set1_ps(3.f), Z)));
+        const __m128 u = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(4.f), X), d);
+        const __m128 v = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(9.f), Y), d);
+
+        StorePixels(out, u, v, Y, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         // TODO: Check robustness for arbitrary float inputs.
 
@@ -940,7 +1516,30 @@ void Renderer_uvY_TO_XYZ::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 u, v, Y, alpha;
+        LoadPixels(in, u, v, Y, alpha);
+
+        const __m128 d = SafeDivide(EONE, v);
+        const __m128 X = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(9.f / 4.f), Y), u), d);
+        const __m128 Z
+            = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(3.f / 4.f), Y),
+                                    _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(4.f), u),
+                                               _mm_mul_ps(_mm_set1_ps(6.666666666666667f), v))),
+                         d);
+
+        StorePixels(out, X, Y, Z, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         // TODO: Check robustness for arbitrary float inputs.
 
@@ -972,7 +1571,39 @@ void Renderer_XYZ_TO_LUV::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 X, Y, Z, alpha;
+        LoadPixels(in, X, Y, Z, alpha);
+
+        const __m128 d
+            = SafeDivide(EONE, _mm_add_ps(_mm_add_ps(X, _mm_mul_ps(_mm_set1_ps(15.f), Y)),
+                                          _mm_mul_ps(_mm_set1_ps(3.f), Z)));
+        const __m128 u = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(4.f), X), d);
+        const __m128 v = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(9.f), Y), d);
+
+        const __m128 Lstar
+            = sseSelect(_mm_cmple_ps(Y, _mm_set1_ps(0.008856451679f)),
+                        _mm_mul_ps(_mm_set1_ps(9.0329629629629608f), Y),
+                        _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.16f),
+                                              ssePowerPrecise(Y, _mm_set1_ps(0.333333333f))),
+                                   _mm_set1_ps(0.16f)));
+
+        const __m128 Lstar13 = _mm_mul_ps(_mm_set1_ps(13.f), Lstar);
+        const __m128 ustar = _mm_mul_ps(Lstar13, _mm_sub_ps(u, _mm_set1_ps(0.19783001f)));
+        const __m128 vstar = _mm_mul_ps(Lstar13, _mm_sub_ps(v, _mm_set1_ps(0.46831999f)));
+
+        StorePixels(out, Lstar, ustar, vstar, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         // TODO: Check robustness for arbitrary float inputs.
 
@@ -1010,7 +1641,40 @@ void Renderer_LUV_TO_XYZ::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    for(long idx=0; idx<numPixels; ++idx)
+    long idx = 0;
+
+#ifdef USE_SSE
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        __m128 Lstar, ustar, vstar, alpha;
+        LoadPixels(in, Lstar, ustar, vstar, alpha);
+
+        const __m128 d = SafeDivide(_mm_set1_ps(0.076923076923076927f), Lstar);
+        const __m128 u = _mm_add_ps(_mm_mul_ps(ustar, d), _mm_set1_ps(0.19783001f));
+        const __m128 v = _mm_add_ps(_mm_mul_ps(vstar, d), _mm_set1_ps(0.46831999f));
+
+        const __m128 tmp = _mm_mul_ps(_mm_add_ps(Lstar, _mm_set1_ps(0.16f)),
+                                      _mm_set1_ps(0.86206896551724144f));
+        const __m128 Y = sseSelect(_mm_cmple_ps(Lstar, _mm_set1_ps(0.08f)),
+                                   _mm_mul_ps(_mm_set1_ps(0.11070564598794539f), Lstar),
+                                   _mm_mul_ps(_mm_mul_ps(tmp, tmp), tmp));
+
+        const __m128 dd = SafeDivide(_mm_set1_ps(0.25f), v);
+        const __m128 X = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(9.f), Y), u), dd);
+        const __m128 Z
+            = _mm_mul_ps(_mm_mul_ps(Y, _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(12.f),
+                                                             _mm_mul_ps(_mm_set1_ps(3.f), u)),
+                                                  _mm_mul_ps(_mm_set1_ps(20.f), v))),
+                         dd);
+
+        StorePixels(out, X, Y, Z, alpha);
+
+        in  += 16;
+        out += 16;
+    }
+#endif
+
+    for(; idx<numPixels; ++idx)
     {
         // TODO: Check robustness for arbitrary float inputs.
 
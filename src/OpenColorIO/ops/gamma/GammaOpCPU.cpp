@@ -9,7 +9,7 @@
 #include "BitDepthUtils.h"
 #include "ops/gamma/GammaOpCPU.h"
 #include "ops/gamma/GammaOpUtils.h"
-
+#include "SIMDKernels.h"
 #include "SSE.h"
 
 
@@ -38,6 +38,9 @@ protected:
     float m_grnGamma;
     float m_bluGamma;
     float m_alpGamma;
+
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    PowerKernelParams m_kernelParams;
 };
 
 class GammaBasicMirrorOpCPU : public GammaBasicOpCPU
@@ -65,11 +68,17 @@ class GammaMoncurveOpCPU : public OpCPU
 protected:
     explicit GammaMoncurveOpCPU(ConstGammaOpDataRcPtr &) : OpCPU() {}
 
+    // Fill the kernel parameters once the renderer parameters are computed.
+    void updateKernelParams(bool forward, bool mirror);
+
 protected:
     RendererParams m_red;
     RendererParams m_green;
     RendererParams m_blue;
     RendererParams m_alpha;
+
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    PowerKernelParams m_kernelParams;
 };
 
 class GammaMoncurveOpCPUFwd : public GammaMoncurveOpCPU
@@ -195,6 +204,11 @@ void GammaBasicOpCPU::update(ConstGammaOpDataRcPtr & gamma)
     m_grnGamma = (float)(forward ? gamma->getGreenParams()[0] : 1. / gamma->getGreenParams()[0]);
     m_bluGamma = (float)(forward ? gamma->getBlueParams()[0]  : 1. / gamma->getBlueParams()[0]);
     m_alpGamma = (float)(forward ? gamma->getAlphaParams()[0] : 1. / gamma->getAlphaParams()[0]);
+
+    m_kernelParams.m_exponent[0] = m_redGamma;
+    m_kernelParams.m_exponent[1] = m_grnGamma;
+    m_kernelParams.m_exponent[2] = m_bluGamma;
+    m_kernelParams.m_exponent[3] = m_alpGamma;
 }
 
 void GammaBasicOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
@@ -202,6 +216,12 @@ void GammaBasicOpCPU::apply(const void * inImg, void * outImg, long numPixels) c
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_power(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 gamma = _mm_set_ps(m_alpGamma, m_bluGamma, m_grnGamma, m_redGamma);
 
@@ -238,6 +258,7 @@ void GammaBasicOpCPU::apply(const void * inImg, void * outImg, long numPixels) c
 GammaBasicMirrorOpCPU::GammaBasicMirrorOpCPU(ConstGammaOpDataRcPtr & gamma)
     : GammaBasicOpCPU(gamma)
 {
+    m_kernelParams.m_mirror = true;
 }
 
 void GammaBasicMirrorOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
@@ -245,6 +266,12 @@ void GammaBasicMirrorOpCPU::apply(const void * inImg, void * outImg, long numPix
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_power(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 gamma = _mm_set_ps(m_alpGamma, m_bluGamma, m_grnGamma, m_redGamma);
 
@@ -284,6 +311,8 @@ void GammaBasicMirrorOpCPU::apply(const void * inImg, void * outImg, long numPix
 GammaBasicPassThruOpCPU::GammaBasicPassThruOpCPU(ConstGammaOpDataRcPtr & gamma)
     : GammaBasicOpCPU(gamma)
 {
+    // Values smaller or equal to zero are passed through i.e. out = in * 1.
+    m_kernelParams.m_linearSegment = true;
 }
 
 void GammaBasicPassThruOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
@@ -291,6 +320,12 @@ void GammaBasicPassThruOpCPU::apply(const void * inImg, void * outImg, long numP
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_power(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 gamma = _mm_set_ps(m_alpGamma, m_bluGamma, m_grnGamma, m_redGamma);
     const __m128 breakPnt = _mm_set_ps(0.0, 0.f, 0.f, 0.f);
@@ -328,6 +363,34 @@ void GammaBasicPassThruOpCPU::apply(const void * inImg, void * outImg, long numP
 #endif
 }
 
+void GammaMoncurveOpCPU::updateKernelParams(bool forward, bool mirror)
+{
+    const RendererParams * params[4] = { &m_red, &m_green, &m_blue, &m_alpha };
+
+    for (int c = 0; c < 4; ++c)
+    {
+        if (forward)
+        {
+            // out = pow(in * scale + offset, gamma)
+            m_kernelParams.m_preScale[c]  = params[c]->scale;
+            m_kernelParams.m_preOffset[c] = params[c]->offset;
+        }
+        else
+        {
+            // out = pow(in, gamma) * scale - offset
+            m_kernelParams.m_postScale[c]  = params[c]->scale;
+            m_kernelParams.m_postOffset[c] = -params[c]->offset;
+        }
+
+        m_kernelParams.m_exponent[c] = params[c]->gamma;
+        m_kernelParams.m_breakPnt[c] = params[c]->breakPnt;
+        m_kernelParams.m_slope[c]    = params[c]->slope;
+    }
+
+    m_kernelParams.m_linearSegment = true;
+    m_kernelParams.m_mirror        = mirror;
+}
+
 GammaMoncurveOpCPUFwd::GammaMoncurveOpCPUFwd(ConstGammaOpDataRcPtr & gamma)
     :   GammaMoncurveOpCPU(gamma)
 {
@@ -340,6 +403,8 @@ void GammaMoncurveOpCPUFwd::update(ConstGammaOpDataRcPtr & gamma)
     ComputeParamsFwd(gamma->getGreenParams(), m_green);
     ComputeParamsFwd(gamma->getBlueParams(),  m_blue);
     ComputeParamsFwd(gamma->getAlphaParams(), m_alpha);
+
+    updateKernelParams(true, false);
 }
 
 void GammaMoncurveOpCPUFwd::apply(const void * inImg, void * outImg, long numPixels) const
@@ -347,6 +412,12 @@ void GammaMoncurveOpCPUFwd::apply(const void * inImg, void * outImg, long numPix
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_power(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 scale
       = _mm_set_ps(m_alpha.scale, m_blue.scale,
@@ -432,6 +503,8 @@ void GammaMoncurveOpCPURev::update(ConstGammaOpDataRcPtr & gamma)
     ComputeParamsRev(gamma->getGreenParams(), m_green);
     ComputeParamsRev(gamma->getBlueParams(),  m_blue);
     ComputeParamsRev(gamma->getAlphaParams(), m_alpha);
+
+    updateKernelParams(false, false);
 }
 
 void GammaMoncurveOpCPURev::apply(const void * inImg, void * outImg, long numPixels) const
@@ -439,6 +512,12 @@ void GammaMoncurveOpCPURev::apply(const void * inImg, void * outImg, long numPix
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_power(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 scale
       = _mm_set_ps(m_alpha.scale, m_blue.scale,
@@ -524,6 +603,8 @@ void GammaMoncurveMirrorOpCPUFwd::update(ConstGammaOpDataRcPtr & gamma)
     ComputeParamsFwd(gamma->getGreenParams(), m_green);
     ComputeParamsFwd(gamma->getBlueParams(), m_blue);
     ComputeParamsFwd(gamma->getAlphaParams(), m_alpha);
+
+    updateKernelParams(true, true);
 }
 
 void GammaMoncurveMirrorOpCPUFwd::apply(const void * inImg, void * outImg, long numPixels) const
@@ -531,6 +612,12 @@ void GammaMoncurveMirrorOpCPUFwd::apply(const void * inImg, void * outImg, long
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_power(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 scale = _mm_set_ps(m_alpha.scale, m_blue.scale,
                                     m_green.scale, m_red.scale);
@@ -615,6 +702,8 @@ void GammaMoncurveMirrorOpCPURev::update(ConstGammaOpDataRcPtr & gamma)
     ComputeParamsRev(gamma->getGreenParams(), m_green);
     ComputeParamsRev(gamma->getBlueParams(), m_blue);
     ComputeParamsRev(gamma->getAlphaParams(), m_alpha);
+
+    updateKernelParams(false, true);
 }
 
 void GammaMoncurveMirrorOpCPURev::apply(const void * inImg, void * outImg, long numPixels) const
@@ -622,6 +711,12 @@ void GammaMoncurveMirrorOpCPURev::apply(const void * inImg, void * outImg, long
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_power(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 scale = _mm_set_ps(m_alpha.scale, m_blue.scale,
                                     m_green.scale, m_red.scale);
@@ -12,6 +12,7 @@
 #include "ops/log/LogUtils.h"
 #include "ops/OpTools.h"
 #include "Platform.h"
+#include "SIMDKernels.h"
 #include "SSE.h"
 
 #ifndef USE_SSE
@@ -31,6 +32,10 @@ public:
 protected:
     // Update renderer parameters.
     virtual void updateData(ConstLogOpDataRcPtr & log);
+
+protected:
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    LogKernelParams m_kernelParams;
 };
 
 // Base class for LogToLin and LinToLog renderers.
@@ -243,6 +248,8 @@ LogRenderer::LogRenderer(ConstLogOpDataRcPtr & log, float logScale)
     , m_logScale(logScale)
 {
     LogOpCPU::updateData(log);
+
+    std::fill(m_kernelParams.m_postScale, m_kernelParams.m_postScale + 3, m_logScale);
 }
 
 
@@ -301,6 +308,12 @@ void LogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_log(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 mm_minValue = _mm_set1_ps(minValue);
     const __m128 mm_logScale = _mm_set1_ps(m_logScale);
@@ -348,6 +361,8 @@ AntiLogRenderer::AntiLogRenderer(ConstLogOpDataRcPtr & log, float log2base)
     , m_log2_base(log2base)
 {
     LogOpCPU::updateData(log);
+
+    std::fill(m_kernelParams.m_preScale, m_kernelParams.m_preScale + 3, m_log2_base);
 }
 
 void AntiLogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -363,6 +378,12 @@ void AntiLogRenderer::apply(const void * inImg, void * outImg, long numPixels) c
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_antiLog(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 mm_log2_base = _mm_set1_ps(m_log2_base);
 
@@ -423,6 +444,11 @@ void Log2LinRenderer::updateData(ConstLogOpDataRcPtr & log)
     m_minv[0] = 1.0f / (float)m_paramsR[LIN_SIDE_SLOPE];
     m_minv[1] = 1.0f / (float)m_paramsG[LIN_SIDE_SLOPE];
     m_minv[2] = 1.0f / (float)m_paramsB[LIN_SIDE_SLOPE];
+
+    std::copy(m_minuskb, m_minuskb + 3, m_kernelParams.m_preOffset);
+    std::copy(m_kinv, m_kinv + 3, m_kernelParams.m_preScale);
+    std::copy(m_minusb, m_minusb + 3, m_kernelParams.m_postOffset);
+    std::copy(m_minv, m_minv + 3, m_kernelParams.m_postScale);
 }
 
 void Log2LinRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -440,6 +466,12 @@ void Log2LinRenderer::apply(const void * inImg, void * outImg, long numPixels) c
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_antiLog(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 mm_kinv = _mm_set_ps(0.0f, m_kinv[2], m_kinv[1], m_kinv[0]);
     const __m128 mm_minuskb = _mm_set_ps(0.0f, m_minuskb[2], m_minuskb[1], m_minuskb[0]);
@@ -510,6 +542,11 @@ void Lin2LogRenderer::updateData(ConstLogOpDataRcPtr & log)
     m_kb[0] = (float)m_paramsR[LOG_SIDE_OFFSET];
     m_kb[1] = (float)m_paramsG[LOG_SIDE_OFFSET];
     m_kb[2] = (float)m_paramsB[LOG_SIDE_OFFSET];
+
+    std::copy(m_m, m_m + 3, m_kernelParams.m_preScale);
+    std::copy(m_b, m_b + 3, m_kernelParams.m_preOffset);
+    std::copy(m_klog, m_klog + 3, m_kernelParams.m_postScale);
+    std::copy(m_kb, m_kb + 3, m_kernelParams.m_postOffset);
 }
 
 void Lin2LogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -523,6 +560,12 @@ void Lin2LogRenderer::apply(const void * inImg, void * outImg, long numPixels) c
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_log(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 mm_minValue = _mm_set1_ps(minValue);
 
@@ -623,6 +666,15 @@ void CameraLog2LinRenderer::updateData(ConstLogOpDataRcPtr & log)
     m_minuslino[0] = -m_linearOffset[0];
     m_minuslino[1] = -m_linearOffset[1];
     m_minuslino[2] = -m_linearOffset[2];
+
+    std::copy(m_minuskb, m_minuskb + 3, m_kernelParams.m_preOffset);
+    std::copy(m_kinv, m_kinv + 3, m_kernelParams.m_preScale);
+    std::copy(m_minusb, m_minusb + 3, m_kernelParams.m_postOffset);
+    std::copy(m_minv, m_minv + 3, m_kernelParams.m_postScale);
+    std::copy(m_logSideBreak, m_logSideBreak + 3, m_kernelParams.m_breakPnt);
+    std::copy(m_minuslino, m_minuslino + 3, m_kernelParams.m_linOffset);
+    std::copy(m_linsinv, m_linsinv + 3, m_kernelParams.m_linScale);
+    m_kernelParams.m_linearSegment = true;
 }
 
 void CameraLog2LinRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -638,6 +690,12 @@ void CameraLog2LinRenderer::apply(const void * inImg, void * outImg, long numPix
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_antiLog(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 mm_kinv = _mm_set_ps(0.0f, m_kinv[2], m_kinv[1], m_kinv[0]);
     const __m128 mm_minuskb = _mm_set_ps(0.0f, m_minuskb[2], m_minuskb[1], m_minuskb[0]);
@@ -727,6 +785,15 @@ void CameraLin2LogRenderer::updateData(ConstLogOpDataRcPtr & log)
     m_linb[0] = (float)m_paramsR[LIN_SIDE_BREAK];
     m_linb[1] = (float)m_paramsG[LIN_SIDE_BREAK];
     m_linb[2] = (float)m_paramsB[LIN_SIDE_BREAK];
+
+    std::copy(m_m, m_m + 3, m_kernelParams.m_preScale);
+    std::copy(m_b, m_b + 3, m_kernelParams.m_preOffset);
+    std::copy(m_klog, m_klog + 3, m_kernelParams.m_postScale);
+    std::copy(m_kb, m_kb + 3, m_kernelParams.m_postOffset);
+    std::copy(m_linb, m_linb + 3, m_kernelParams.m_breakPnt);
+    std::copy(m_linearSlope, m_linearSlope + 3, m_kernelParams.m_linScale);
+    std::copy(m_linearOffset, m_linearOffset + 3, m_kernelParams.m_linOffset);
+    m_kernelParams.m_linearSegment = true;
 }
 
 void CameraLin2LogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -743,6 +810,12 @@ void CameraLin2LogRenderer::apply(const void * inImg, void * outImg, long numPix
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_log(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     const __m128 mm_minValue = _mm_set1_ps(minValue);
 
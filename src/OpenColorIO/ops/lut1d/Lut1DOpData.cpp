@@ -9,7 +9,6 @@
 #include "BitDepthUtils.h"
 #include "HashUtils.h"
 #include "MathUtils.h"
-#include "md5/md5.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/lut1d/Lut1DOpData.h"
 #include "ops/matrix/MatrixOp.h"
@@ -526,23 +525,16 @@ const char* GetHueAdjustName(Lut1DHueAdjust algo)
 
 std::string Lut1DOpData::getCacheID() const
 {
-    AutoMutex lock(m_mutex);
-
-    md5_state_t state;
-    md5_byte_t digest[16];
-
-    md5_init(&state);
-    md5_append(&state,
-        (const md5_byte_t *)&(getArray().getValues()[0]),
-        (int)(getArray().getValues().size() * sizeof(float)));
-    md5_finish(&state, digest);
+    // The array hash is memoized (i.e. usually computed by finalize()) so there is no
+    // need to lock anything.
+    const Array::Values & values = m_array.getValues();
 
     std::ostringstream cacheIDStream;
     if (!getID().empty())
     {
         cacheIDStream << getID() << " ";
     }
-    cacheIDStream << GetPrintableHash(digest)                                  << " ";
+    cacheIDStream << m_arrayHash.get(values.data(), values.size() * sizeof(float)) << " ";
     cacheIDStream << TransformDirectionToString(m_direction)                   << " ";
     cacheIDStream << InterpolationToString(m_interpolation)                    << " ";
     cacheIDStream << (isInputHalfDomain() ? "half domain" : "standard domain") << " ";
@@ -818,6 +810,11 @@ void Lut1DOpData::finalize()
         initializeFromForward();
     }
     m_array.adjustColorComponentNumber();
+
+    // Compute the array hash once for all the following getCacheID() calls.
+    m_arrayHash.invalidate();
+    const Array::Values & values = m_array.getValues();
+    m_arrayHash.get(values.data(), values.size() * sizeof(float));
 }
 
 void Lut1DOpData::initializeFromForward()
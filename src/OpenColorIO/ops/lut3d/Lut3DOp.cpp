@@ -174,6 +174,7 @@ public:
     bool canCombineWith(ConstOpRcPtr & op) const override;
     void combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const override;
     bool hasChannelCrosstalk() const override;
+    void finalize() override;
     std::string getCacheID() const override;
 
     ConstOpCPURcPtr getCPUOp() const override;
@@ -265,6 +266,11 @@ bool Lut3DOp::hasChannelCrosstalk() const
     return lut3DData()->hasChannelCrosstalk();
 }
 
+void Lut3DOp::finalize()
+{
+    lut3DData()->finalize();
+}
+
 std::string Lut3DOp::getCacheID() const
 {
     std::ostringstream cacheIDStream;
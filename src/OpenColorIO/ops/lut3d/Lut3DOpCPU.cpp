@@ -12,6 +12,7 @@
 #include "MathUtils.h"
 #include "ops/lut3d/Lut3DOpCPU.h"
 #include "ops/OpTools.h"
+#include "ParallelUtils.h"
 #include "Platform.h"
 #include "SSE.h"
 
@@ -185,6 +186,10 @@ private:
 };
 
 
+// Number of items (i.e. LUT cubes or tree nodes) processed at once by a thread when
+// building the inverse. Small LUTs are then processed by the calling thread only.
+constexpr long TREE_CHUNK_SIZE = 4096;
+
 int GetLut3DIndexBlueFast(int indexR, int indexG, int indexB, long dim)
 {
     return 3 * (indexB + (int)dim * (indexG + (int)dim * indexR));
@@ -1282,38 +1287,43 @@ void InvLut3DRenderer::RangeTree::initRanges(float *grvec)
         throw Exception("Unsupported channel number.");
     }
 
-    float minVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    float maxVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    for (unsigned long i = 0; i < N; i++)
+    // Each LUT cube is independent so process them from several threads.
+    ParallelFor((long)N, TREE_CHUNK_SIZE,
+                [&](unsigned /*threadIdx*/, long begin, long end)
     {
-        const unsigned long baseOffset = m_baseInds[i].inds[0] * ind0scale +
-            m_baseInds[i].inds[1] * ind1scale + m_baseInds[i].inds[2];
-
-        for (unsigned long k = 0; k < m_chans; k++)
+        float minVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float maxVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (unsigned long i = (unsigned long)begin; i < (unsigned long)end; i++)
         {
-            minVal[k] = grvec[baseOffset * m_chans + k];
-            maxVal[k] = minVal[k];
-        }
+            const unsigned long baseOffset = m_baseInds[i].inds[0] * ind0scale +
+                m_baseInds[i].inds[1] * ind1scale + m_baseInds[i].inds[2];
 
-        for (unsigned long j = 1; j < corners; j++)
-        {
-            const unsigned long index = (baseOffset + cornerOffsets[j]) * m_chans;
             for (unsigned long k = 0; k < m_chans; k++)
             {
-                minVal[k] = std::min(minVal[k], grvec[index + k]);
-                maxVal[k] = std::max(maxVal[k], grvec[index + k]);
+                minVal[k] = grvec[baseOffset * m_chans + k];
+                maxVal[k] = minVal[k];
             }
-        }
 
-        // Expand the ranges slightly to allow for error in forward evaluation.
-        const float TOL = 1e-6f;
+            for (unsigned long j = 1; j < corners; j++)
+            {
+                const unsigned long index = (baseOffset + cornerOffsets[j]) * m_chans;
+                for (unsigned long k = 0; k < m_chans; k++)
+                {
+                    minVal[k] = std::min(minVal[k], grvec[index + k]);
+                    maxVal[k] = std::max(maxVal[k], grvec[index + k]);
+                }
+            }
 
-        for (unsigned long k = 0; k < m_chans; k++)
-        {
-            m_levels[depthm1].minVals[i * m_chans + k] = minVal[k] - TOL;
-            m_levels[depthm1].maxVals[i * m_chans + k] = maxVal[k] + TOL;
+            // Expand the ranges slightly to allow for error in forward evaluation.
+            const float TOL = 1e-6f;
+
+            for (unsigned long k = 0; k < m_chans; k++)
+            {
+                m_levels[depthm1].minVals[i * m_chans + k] = minVal[k] - TOL;
+                m_levels[depthm1].maxVals[i * m_chans + k] = maxVal[k] + TOL;
+            }
         }
-    }
+    });
 }
 
 void InvLut3DRenderer::RangeTree::initInds()
@@ -1425,41 +1435,45 @@ void InvLut3DRenderer::RangeTree::updateRanges(const unsigned long level)
     m_levels[level].minVals.resize(levelSize * m_chans);
     m_levels[level].maxVals.resize(levelSize * m_chans);
 
-    for (unsigned long i = 0; i < levelSize; i++)
+    ParallelFor((long)levelSize, TREE_CHUNK_SIZE,
+                [&](unsigned /*threadIdx*/, long begin, long end)
     {
-        const unsigned long index = m_levels[level].child0offsets[i];
-        for (unsigned long k = 0; k < m_chans; k++)
+        for (unsigned long i = (unsigned long)begin; i < (unsigned long)end; i++)
         {
-            m_levels[level].minVals[i * m_chans + k] =
-                m_levels[level + 1].minVals[index * m_chans + k];
-            m_levels[level].maxVals[i * m_chans + k] =
-                m_levels[level + 1].maxVals[index * m_chans + k];
-        }
+            const unsigned long index = m_levels[level].child0offsets[i];
+            for (unsigned long k = 0; k < m_chans; k++)
+            {
+                m_levels[level].minVals[i * m_chans + k] =
+                    m_levels[level + 1].minVals[index * m_chans + k];
+                m_levels[level].maxVals[i * m_chans + k] =
+                    m_levels[level + 1].maxVals[index * m_chans + k];
+            }
 
-        // New min/max combine the min/max for all children from next lower level.
-        for (unsigned long j = 2; j <= maxChildren; j++)
-        {
-            if (m_levels[level].numChildren[i] >= j)
+            // New min/max combine the min/max for all children from next lower level.
+            for (unsigned long j = 2; j <= maxChildren; j++)
             {
-                const unsigned long ind = index + j - 1;
-                for (unsigned long k = 0; k < m_chans; k++)
+                if (m_levels[level].numChildren[i] >= j)
                 {
-                    const float minVal = m_levels[level].minVals[i * m_chans + k];
-                    const float childMinVal = m_levels[level + 1].minVals[ind * m_chans + k];
-                    if (childMinVal < minVal)
-                    {
-                        m_levels[level].minVals[i * m_chans + k] = childMinVal;
-                    }
-                    const float maxVal = m_levels[level].maxVals[i * m_chans + k];
-                    const float childMaxVal = m_levels[level + 1].maxVals[ind * m_chans + k];
-                    if (childMaxVal > maxVal)
+                    const unsigned long ind = index + j - 1;
+                    for (unsigned long k = 0; k < m_chans; k++)
                     {
-                        m_levels[level].maxVals[i * m_chans + k] = childMaxVal;
+                        const float minVal = m_levels[level].minVals[i * m_chans + k];
+                        const float childMinVal = m_levels[level + 1].minVals[ind * m_chans + k];
+                        if (childMinVal < minVal)
+                        {
+                            m_levels[level].minVals[i * m_chans + k] = childMinVal;
+                        }
+                        const float maxVal = m_levels[level].maxVals[i * m_chans + k];
+                        const float childMaxVal = m_levels[level + 1].maxVals[ind * m_chans + k];
+                        if (childMaxVal > maxVal)
+                        {
+                            m_levels[level].maxVals[i * m_chans + k] = childMaxVal;
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
 
 void InvLut3DRenderer::RangeTree::initialize(float *grvec, unsigned long gsz)
@@ -1510,10 +1524,14 @@ void InvLut3DRenderer::RangeTree::initialize(float *grvec, unsigned long gsz)
     // Calculate hash for indices.
 
     const unsigned long cnt = (const unsigned long)m_baseInds.size();
-    for (unsigned long i = 0; i < cnt; i++)
+    ParallelFor((long)cnt, TREE_CHUNK_SIZE,
+                [&](unsigned /*threadIdx*/, long begin, long end)
     {
-        indsToHash(i);
-    }
+        for (unsigned long i = (unsigned long)begin; i < (unsigned long)end; i++)
+        {
+            indsToHash(i);
+        }
+    });
 
     // Sort indices based on hash.
     std::sort(m_baseInds.begin(), m_baseInds.end());
@@ -1627,19 +1645,23 @@ void InvLut3DRenderer::extrapolate3DArray(ConstLut3DOpDataRcPtr & lut)
 
     Lut3DOpData::Lut3DArray newArray(newDim);
 
-    // Copy center values.
-    for (unsigned long idx = 0; idx<dim; idx++)
+    // Copy center values (i.e. one red slice at a time).
+    ParallelFor((long)dim, std::max(1L, TREE_CHUNK_SIZE / long(dim * dim)),
+                [&](unsigned /*threadIdx*/, long begin, long end)
     {
-        for (unsigned long jdx = 0; jdx<dim; jdx++)
+        for (unsigned long idx = (unsigned long)begin; idx<(unsigned long)end; idx++)
         {
-            for (unsigned long kdx = 0; kdx<dim; kdx++)
+            for (unsigned long jdx = 0; jdx<dim; jdx++)
             {
-                float RGB[3];
-                array.getRGB(idx, jdx, kdx, RGB);
-                newArray.setRGB(idx + 1, jdx + 1, kdx + 1, RGB);
+                for (unsigned long kdx = 0; kdx<dim; kdx++)
+                {
+                    float RGB[3];
+                    array.getRGB(idx, jdx, kdx, RGB);
+                    newArray.setRGB(idx + 1, jdx + 1, kdx + 1, RGB);
+                }
             }
         }
-    }
+    });
 
     const float center = 0.5f;
     const float scale = 4.f;
@@ -8,7 +8,6 @@
 #include "BitDepthUtils.h"
 #include "HashUtils.h"
 #include "MathUtils.h"
-#include "md5/md5.h"
 #include "ops/lut3d/Lut3DOp.h"
 #include "ops/lut3d/Lut3DOpData.h"
 #include "ops/OpTools.h"
@@ -460,18 +459,18 @@ Lut3DOpDataRcPtr Lut3DOpData::inverse() const
     return invLut;
 }
 
-std::string Lut3DOpData::getCacheID() const
+void Lut3DOpData::finalize()
 {
-    AutoMutex lock(m_mutex);
+    const Array::Values & values = m_array.getValues();
 
-    md5_state_t state;
-    md5_byte_t digest[16];
+    m_arrayHash.get(values.data(), values.size() * sizeof(float));
+}
 
-    md5_init(&state);
-    md5_append(&state,
-               (const md5_byte_t *)&(getArray().getValues()[0]),
-               (int)(getArray().getValues().size() * sizeof(float)));
-    md5_finish(&state, digest);
+std::string Lut3DOpData::getCacheID() const
+{
+    // The array hash is memoized (i.e. usually computed by finalize()) so there is no
+    // need to lock anything.
+    const Array::Values & values = m_array.getValues();
 
     std::ostringstream cacheIDStream;
     if (!getID().empty())
@@ -479,7 +478,7 @@ std::string Lut3DOpData::getCacheID() const
         cacheIDStream << getID() << " ";
     }
 
-    cacheIDStream << GetPrintableHash(digest)                << " ";
+    cacheIDStream << m_arrayHash.get(values.data(), values.size() * sizeof(float)) << " ";
     cacheIDStream << InterpolationToString(m_interpolation)  << " ";
     cacheIDStream << TransformDirectionToString(m_direction) << " ";
 
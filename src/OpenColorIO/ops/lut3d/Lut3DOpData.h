@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "HashUtils.h"
 #include "Op.h"
 #include "ops/OpArray.h"
 #include "PrivateTypes.h"
@@ -53,7 +54,8 @@ public:
 
     // Note: The Lut3DOpData Array stores the values in blue-fastest order.
     inline const Array & getArray() const { return m_array; }
-    inline Array & getArray() { return m_array; }
+    // Note: Any non-const access invalidates the memoized array hash.
+    inline Array & getArray() { m_arrayHash.invalidate(); return m_array; }
 
     void setArrayFromRedFastestOrder(const std::vector<float> & lut);
 
@@ -88,6 +90,9 @@ public:
 
     void scale(float scale);
 
+    // Compute the array hash once for all the following getCacheID() calls.
+    void finalize();
+
 protected:
     // Test core parts of LUTs for equality.
     bool haveEqualBasics(const Lut3DOpData & other) const;
@@ -127,6 +132,7 @@ private:
 
     Interpolation       m_interpolation;
     Lut3DArray          m_array;
+    MemoizedHash        m_arrayHash;
 
     TransformDirection  m_direction;
 
@@ -1,12 +1,15 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
 #include "MathUtils.h"
 #include "ops/matrix/MatrixOpCPU.h"
 #include "Platform.h"
+#include "SIMDKernels.h"
 #include "SSE.h"
 
 namespace OCIO_NAMESPACE
@@ -25,6 +28,9 @@ public:
 
 private:
     float m_scale[4];
+
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    ScaleKernelParams m_kernelParams;
 };
 
 class ScaleWithOffsetRenderer : public OpCPU
@@ -39,6 +45,9 @@ public:
 private:
     float m_scale[4];
     float m_offset[4];
+
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    ScaleKernelParams m_kernelParams;
 };
 
 class MatrixWithOffsetRenderer : public OpCPU
@@ -58,6 +67,9 @@ private:
     float m_column4[4];
 
     float m_offset[4];
+
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    MatrixKernelParams m_kernelParams;
 };
 
 class MatrixRenderer : public OpCPU
@@ -74,6 +86,9 @@ private:
     float m_column2[4];
     float m_column3[4];
     float m_column4[4];
+
+    const SIMDKernels * m_kernels = GetSIMDKernels();
+    MatrixKernelParams m_kernelParams;
 };
 
 ScaleRenderer::ScaleRenderer(ConstMatrixOpDataRcPtr & mat)
@@ -85,6 +100,8 @@ ScaleRenderer::ScaleRenderer(ConstMatrixOpDataRcPtr & mat)
     m_scale[1] = (float)m[5];
     m_scale[2] = (float)m[10];
     m_scale[3] = (float)m[15];
+
+    std::copy(m_scale, m_scale + 4, m_kernelParams.m_scale);
 }
 
 void ScaleRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -92,6 +109,12 @@ void ScaleRenderer::apply(const void * inImg, void * outImg, long numPixels) con
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_scale(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
     for (long idx = 0; idx < numPixels; ++idx)
     {
         out[0] = in[0] * m_scale[0];
@@ -120,6 +143,9 @@ ScaleWithOffsetRenderer::ScaleWithOffsetRenderer(ConstMatrixOpDataRcPtr & mat)
     m_offset[1] = (float)o[1];
     m_offset[2] = (float)o[2];
     m_offset[3] = (float)o[3];
+
+    std::copy(m_scale, m_scale + 4, m_kernelParams.m_scale);
+    std::copy(m_offset, m_offset + 4, m_kernelParams.m_offset);
 }
 
 void ScaleWithOffsetRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -127,6 +153,12 @@ void ScaleWithOffsetRenderer::apply(const void * inImg, void * outImg, long numP
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_scale(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
     for (long idx = 0; idx < numPixels; ++idx)
     {
         out[0] = in[0] * m_scale[0] + m_offset[0];
@@ -178,6 +210,11 @@ MatrixWithOffsetRenderer::MatrixWithOffsetRenderer(ConstMatrixOpDataRcPtr & mat)
     m_offset[2] = (float)o[2];
     m_offset[3] = (float)o[3];
 
+    std::copy(m_column1, m_column1 + 4, m_kernelParams.m_column[0]);
+    std::copy(m_column2, m_column2 + 4, m_kernelParams.m_column[1]);
+    std::copy(m_column3, m_column3 + 4, m_kernelParams.m_column[2]);
+    std::copy(m_column4, m_column4 + 4, m_kernelParams.m_column[3]);
+    std::copy(m_offset, m_offset + 4, m_kernelParams.m_offset);
 }
 
 // Apply the rendering
@@ -211,6 +248,12 @@ void MatrixWithOffsetRenderer::apply(const void * inImg, void * outImg, long num
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_matrix(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     // Matrix decomposition per _column.
     __m128 m0 = _mm_set_ps(m_column1[3],
@@ -318,6 +361,11 @@ MatrixRenderer::MatrixRenderer(ConstMatrixOpDataRcPtr & mat)
     m_column4[1] = (float)m[dim + 3];
     m_column4[2] = (float)m[twoDim + 3];
     m_column4[3] = (float)m[threeDim + 3];
+
+    std::copy(m_column1, m_column1 + 4, m_kernelParams.m_column[0]);
+    std::copy(m_column2, m_column2 + 4, m_kernelParams.m_column[1]);
+    std::copy(m_column3, m_column3 + 4, m_kernelParams.m_column[2]);
+    std::copy(m_column4, m_column4 + 4, m_kernelParams.m_column[3]);
 }
 
 void MatrixRenderer::apply(const void * inImg, void * outImg, long numPixels) const
@@ -325,6 +373,12 @@ void MatrixRenderer::apply(const void * inImg, void * outImg, long numPixels) co
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+    if (m_kernels)
+    {
+        m_kernels->m_matrix(in, out, numPixels, m_kernelParams);
+        return;
+    }
+
 #ifdef USE_SSE
     // Matrix decomposition per _column.
     __m128 m0 = _mm_set_ps(m_column1[3],
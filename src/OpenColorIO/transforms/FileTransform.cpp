@@ -2,9 +2,13 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
-#include <fstream>
-#include <map>
+#include <atomic>
+#include <functional>
+#include <istream>
+#include <list>
 #include <sstream>
+#include <streambuf>
+#include <unordered_map>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -216,6 +220,7 @@ FormatRegistry::FormatRegistry()
     registerFileFormat(CreateFileFormatIridasCube());
     registerFileFormat(CreateFileFormatIridasItx());
     registerFileFormat(CreateFileFormatIridasLook());
+    registerFileFormat(CreateFileFormatOCIOBinaryLut());
     registerFileFormat(CreateFileFormatPandora());
     registerFileFormat(CreateFileFormatResolveCube());
     registerFileFormat(CreateFileFormatSpi1D());
@@ -282,7 +287,13 @@ void FormatRegistry::registerFileFormat(FileFormat* format)
 
         m_formatsByName[StringUtils::Lower(formatInfoVec[i].name)] = format;
 
-        m_formatsByExtension[formatInfoVec[i].extension].push_back(format);
+        // A format could register several names for the same extension.
+        FileFormatVector & extensionFormats = m_formatsByExtension[formatInfoVec[i].extension];
+        if (std::find(extensionFormats.begin(), extensionFormats.end(), format)
+                == extensionFormats.end())
+        {
+            extensionFormats.push_back(format);
+        }
 
         if(formatInfoVec[i].capabilities & FORMAT_CAPABILITY_READ)
         {
@@ -408,6 +419,65 @@ FileFormat::~FileFormat()
 
 }
 
+namespace
+{
+
+// Read-only stream buffer on top of a memory block i.e. no copy.
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+    MemoryStreamBuf(const char * data, size_t size)
+    {
+        char * begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off,
+                     std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in))
+        {
+            return pos_type(off_type(-1));
+        }
+
+        off_type pos = off;
+        if (dir == std::ios_base::cur)
+        {
+            pos += off_type(gptr() - eback());
+        }
+        else if (dir == std::ios_base::end)
+        {
+            pos += off_type(egptr() - eback());
+        }
+
+        if (pos < 0 || pos > off_type(egptr() - eback()))
+        {
+            return pos_type(off_type(-1));
+        }
+
+        setg(eback(), eback() + pos, egptr());
+        return pos_type(pos);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+} // anon.
+
+CachedFileRcPtr FileFormat::readBuffer(const char * data,
+                                       size_t size,
+                                       const std::string & originalFileName) const
+{
+    MemoryStreamBuf streamBuf(data, size);
+    std::istream istream(&streamBuf);
+    return read(istream, originalFileName);
+}
+
 std::string FileFormat::getName() const
 {
     FormatInfoVec infoVec;
@@ -421,7 +491,8 @@ std::string FileFormat::getName() const
 
 void FileFormat::bake(const Baker & /*baker*/,
                       const std::string & formatName,
-                      std::ostream & /*ostream*/) const
+                      std::ostream & /*ostream*/,
+                      BakingCache & /*cache*/) const
 {
     std::ostringstream os;
     os << "Format '" << formatName << "' does not support baking.";
@@ -443,9 +514,11 @@ namespace
 
 void LoadFileUncached(FileFormat * & returnFormat,
                       CachedFileRcPtr & returnCachedFile,
+                      size_t & returnFileSize,
                       const std::string & filepath)
 {
     returnFormat = NULL;
+    returnFileSize = 0;
 
     {
         std::ostringstream os;
@@ -463,6 +536,20 @@ void LoadFileUncached(FileFormat * & returnFormat,
 
     FormatRegistry & formatRegistry = FormatRegistry::GetInstance();
 
+    // The file is read (i.e. memory mapped) only once for all the format attempts.
+    Platform::MappedFile file;
+    if (!file.open(filepath))
+    {
+        std::ostringstream os;
+        os << "The specified FileTransform srcfile, '";
+        os << filepath << "', could not be opened. ";
+        os << "Please confirm the file exists with ";
+        os << "appropriate read permissions.";
+        throw Exception(os.str().c_str());
+    }
+
+    returnFileSize = file.size();
+
     FileFormatVector possibleFormats;
     formatRegistry.getFileFormatForExtension(extension, possibleFormats);
     FileFormatVector::const_iterator endFormat = possibleFormats.end();
@@ -471,26 +558,11 @@ void LoadFileUncached(FileFormat * & returnFormat,
     {
 
         FileFormat * tryFormat = *itFormat;
-        std::ifstream filestream;
         try
         {
-            // Open the filePath
-            filestream.open(
-                filepath.c_str(),
-                tryFormat->isBinary()
-                    ? std::ios_base::binary : std::ios_base::in);
-            if (!filestream.good())
-            {
-                std::ostringstream os;
-                os << "The specified FileTransform srcfile, '";
-                os << filepath << "', could not be opened. ";
-                os << "Please confirm the file exists with ";
-                os << "appropriate read permissions.";
-                throw Exception(os.str().c_str());
-            }
-
-            CachedFileRcPtr cachedFile = tryFormat->read(
-                filestream,
+            CachedFileRcPtr cachedFile = tryFormat->readBuffer(
+                file.data(),
+                file.size(),
                 filepath);
 
             if(IsDebugLoggingEnabled())
@@ -503,16 +575,10 @@ void LoadFileUncached(FileFormat * & returnFormat,
 
             returnFormat = tryFormat;
             returnCachedFile = cachedFile;
-            filestream.close();
             return;
         }
         catch(std::exception & e)
         {
-            if (filestream.is_open())
-            {
-                filestream.close();
-            }
-
             primaryErrorText += "\t'";
             primaryErrorText += tryFormat->getName();
             primaryErrorText += "' failed with: ";
@@ -546,23 +612,9 @@ void LoadFileUncached(FileFormat * & returnFormat,
         if(itAlt != endFormat)
             continue;
 
-        std::ifstream filestream;
         try
         {
-            filestream.open(filepath.c_str(), altFormat->isBinary()
-                ? std::ios_base::binary : std::ios_base::in);
-            if (!filestream.good())
-            {
-                std::ostringstream os;
-                os << "The specified FileTransform srcfile, '";
-                os << filepath << "', could not be opened. ";
-                os << "Please confirm the file exists with ";
-                os << "appropriate read";
-                os << " permissions.";
-                throw Exception(os.str().c_str());
-            }
-
-            cachedFile = altFormat->read(filestream, filepath);
+            cachedFile = altFormat->readBuffer(file.data(), file.size(), filepath);
 
             if(IsDebugLoggingEnabled())
             {
@@ -574,16 +626,10 @@ void LoadFileUncached(FileFormat * & returnFormat,
 
             returnFormat = altFormat;
             returnCachedFile = cachedFile;
-            filestream.close();
             return;
         }
         catch(std::exception & e)
         {
-            if (filestream.is_open())
-            {
-                filestream.close();
-            }
-
             if(IsDebugLoggingEnabled())
             {
                 std::ostringstream os;
@@ -626,9 +672,12 @@ void LoadFileUncached(FileFormat * & returnFormat,
     throw Exception(os.str().c_str());
 }
 
-// We mutex both the main map and each item individually, so that
-// the potentially slow file access wont block other lookups to already
-// existing items. (Loads of the *same* file will mutually block though)
+// The cache is split into shards, each having its own mutex and least recently used list,
+// so that concurrent lookups of different files rarely wait for each other. The size budget
+// is global though i.e. the least recently used item of all the shards is evicted first.
+// Each item also has its own mutex, so that the potentially slow file access wont block
+// other lookups to already existing items. (Loads of the *same* file will mutually block
+// though)
 
 struct FileCacheResult
 {
@@ -647,33 +696,232 @@ struct FileCacheResult
 };
 
 typedef OCIO_SHARED_PTR<FileCacheResult> FileCacheResultPtr;
-typedef std::map<std::string, FileCacheResultPtr> FileCacheMap;
 
-FileCacheMap g_fileCache;
-Mutex g_fileCacheLock;
+class FileCache
+{
+public:
+    FileCache() = delete;
+    FileCache(const FileCache &) = delete;
+    FileCache & operator=(const FileCache &) = delete;
 
-} // namespace
+    explicit FileCache(size_t numShards)
+        :   m_shards(numShards)
+    {
+    }
 
-void GetCachedFileAndFormat(FileFormat * & format,
-                            CachedFileRcPtr & cachedFile,
-                            const std::string & filepath)
-{
-    // Load the file cache ptr from the global map
-    FileCacheResultPtr result;
+    // Get the item of the file, a new (i.e. not ready) one is added on a miss.
+    FileCacheResultPtr getResult(const std::string & filepath)
     {
-        AutoMutex lock(g_fileCacheLock);
-        FileCacheMap::iterator iter = g_fileCache.find(filepath);
-        if (iter != g_fileCache.end())
+        Shard & shard = getShard(filepath);
+        AutoMutex lock(shard.m_mutex);
+
+        auto it = shard.m_index.find(filepath);
+        if (it != shard.m_index.end())
         {
-            result = iter->second;
+            // The item becomes the most recently used one.
+            shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, it->second);
+            it->second->m_lastUse = ++m_useCount;
+            ++shard.m_numHits;
+            return it->second->m_result;
         }
-        else
+
+        ++shard.m_numMisses;
+
+        Entry entry;
+        entry.m_filepath = filepath;
+        entry.m_result   = std::make_shared<FileCacheResult>();
+        entry.m_lastUse  = ++m_useCount;
+        shard.m_entries.push_front(entry);
+        shard.m_index[filepath] = shard.m_entries.begin();
+
+        return entry.m_result;
+    }
+
+    // Account the size of a loaded item, the least recently used items are then evicted
+    // if the cache is over budget.
+    void setResultSize(const std::string & filepath,
+                       const FileCacheResultPtr & result,
+                       size_t size)
+    {
+        {
+            Shard & shard = getShard(filepath);
+            AutoMutex lock(shard.m_mutex);
+
+            // The item could have been evicted (or the cache cleared) while loading the file.
+            auto it = shard.m_index.find(filepath);
+            if (it == shard.m_index.end() || it->second->m_result != result)
+            {
+                return;
+            }
+
+            shard.m_size -= it->second->m_size;
+            m_size       -= it->second->m_size;
+            it->second->m_size = size;
+            shard.m_size += size;
+            m_size       += size;
+        }
+
+        evict(filepath);
+    }
+
+    size_t getMaxSize() const
+    {
+        return m_maxSize.load();
+    }
+
+    void setMaxSize(size_t maxSize)
+    {
+        m_maxSize.store(maxSize);
+
+        evict(std::string());
+    }
+
+    // Empty the cache and reset the statistics.
+    void clear()
+    {
+        for (Shard & shard : m_shards)
         {
-            result = FileCacheResultPtr(new FileCacheResult);
-            g_fileCache[filepath] = result;
+            AutoMutex lock(shard.m_mutex);
+            shard.m_index.clear();
+            shard.m_entries.clear();
+            m_size              -= shard.m_size;
+            shard.m_size         = 0;
+            shard.m_numHits      = 0;
+            shard.m_numMisses    = 0;
+            shard.m_numEvictions = 0;
         }
     }
 
+    size_t getSize() const        { return m_size.load(); }
+    size_t getNumHits() const     { return sum(&Shard::m_numHits); }
+    size_t getNumMisses() const   { return sum(&Shard::m_numMisses); }
+    size_t getNumEvictions() const { return sum(&Shard::m_numEvictions); }
+
+    size_t getNumEntries() const
+    {
+        size_t numEntries = 0;
+        for (const Shard & shard : m_shards)
+        {
+            AutoMutex lock(shard.m_mutex);
+            numEntries += shard.m_entries.size();
+        }
+        return numEntries;
+    }
+
+private:
+    struct Entry
+    {
+        std::string m_filepath;
+        FileCacheResultPtr m_result;
+        size_t m_size = 0;
+        unsigned long long m_lastUse = 0; // Refer to m_useCount.
+    };
+
+    typedef std::list<Entry> Entries;
+
+    struct Shard
+    {
+        Entries m_entries; // The most recently used item is the first one.
+        std::unordered_map<std::string, Entries::iterator> m_index;
+
+        size_t m_size         = 0;
+        size_t m_numHits      = 0;
+        size_t m_numMisses    = 0;
+        size_t m_numEvictions = 0;
+
+        mutable Mutex m_mutex;
+    };
+
+    Shard & getShard(const std::string & filepath)
+    {
+        return m_shards[std::hash<std::string>()(filepath) % m_shards.size()];
+    }
+
+    // Evict the least recently used items of all the shards until the cache is within its
+    // budget. The item of keepFilepath (i.e. the one just loaded) is always kept so that a
+    // file larger than the budget does not get reloaded on each access.
+    void evict(const std::string & keepFilepath)
+    {
+        const size_t maxSize = m_maxSize.load();
+        if (maxSize == 0)
+        {
+            return;
+        }
+
+        // Only one thread evicts at a time, and no shard mutex is held while taking it.
+        AutoMutex evictLock(m_evictMutex);
+
+        while (m_size.load() > maxSize)
+        {
+            // Find the shard whose least recently used item is the oldest one.
+            Shard * oldestShard = nullptr;
+            unsigned long long oldestUse = 0;
+            for (Shard & shard : m_shards)
+            {
+                AutoMutex lock(shard.m_mutex);
+                if (!shard.m_entries.empty()
+                    && shard.m_entries.back().m_filepath != keepFilepath
+                    && (!oldestShard || shard.m_entries.back().m_lastUse < oldestUse))
+                {
+                    oldestShard = &shard;
+                    oldestUse   = shard.m_entries.back().m_lastUse;
+                }
+            }
+
+            if (!oldestShard)
+            {
+                return; // Only the kept item is left.
+            }
+
+            AutoMutex lock(oldestShard->m_mutex);
+
+            // Look again if the item was used (or removed) in the meantime.
+            if (oldestShard->m_entries.empty()
+                || oldestShard->m_entries.back().m_lastUse != oldestUse)
+            {
+                continue;
+            }
+
+            const Entry & entry = oldestShard->m_entries.back();
+            oldestShard->m_size -= entry.m_size;
+            m_size              -= entry.m_size;
+            oldestShard->m_index.erase(entry.m_filepath);
+            oldestShard->m_entries.pop_back();
+            ++oldestShard->m_numEvictions;
+        }
+    }
+
+    size_t sum(size_t Shard::* member) const
+    {
+        size_t total = 0;
+        for (const Shard & shard : m_shards)
+        {
+            AutoMutex lock(shard.m_mutex);
+            total += shard.*member;
+        }
+        return total;
+    }
+
+    std::vector<Shard> m_shards;
+    std::atomic<size_t> m_maxSize{ 0 }; // No limit.
+    std::atomic<size_t> m_size{ 0 };    // Sum of the shard sizes.
+
+    // Incremented on each access so that the items of different shards can be compared.
+    std::atomic<unsigned long long> m_useCount{ 0 };
+    Mutex m_evictMutex;
+};
+
+FileCache g_fileCache(16);
+
+} // namespace
+
+void GetCachedFileAndFormat(FileFormat * & format,
+                            CachedFileRcPtr & cachedFile,
+                            const std::string & filepath)
+{
+    // Load the file cache ptr from the global cache.
+    FileCacheResultPtr result = g_fileCache.getResult(filepath);
+
     // If this file has already been loaded, return
     // the result immediately
 
@@ -683,10 +931,12 @@ void GetCachedFileAndFormat(FileFormat * & format,
         result->ready = true;
         result->error = false;
 
+        size_t fileSize = 0;
         try
         {
             LoadFileUncached(result->format,
                 result->cachedFile,
+                fileSize,
                 filepath);
         }
         catch (std::exception & e)
@@ -702,6 +952,8 @@ void GetCachedFileAndFormat(FileFormat * & format,
             os << filepath;
             result->exceptionText = os.str();
         }
+
+        g_fileCache.setResultSize(filepath, result, fileSize);
     }
 
     if (result->error)
@@ -735,10 +987,44 @@ void GetCachedFileAndFormat(FileFormat * & format,
 
 void ClearFileTransformCaches()
 {
-    AutoMutex lock(g_fileCacheLock);
     g_fileCache.clear();
 }
 
+void SetFileTransformCacheMaxSize(size_t maxNumBytes)
+{
+    g_fileCache.setMaxSize(maxNumBytes);
+}
+
+size_t GetFileTransformCacheMaxSize()
+{
+    return g_fileCache.getMaxSize();
+}
+
+size_t GetFileTransformCacheSize()
+{
+    return g_fileCache.getSize();
+}
+
+size_t GetFileTransformCacheNumEntries()
+{
+    return g_fileCache.getNumEntries();
+}
+
+size_t GetFileTransformCacheNumHits()
+{
+    return g_fileCache.getNumHits();
+}
+
+size_t GetFileTransformCacheNumMisses()
+{
+    return g_fileCache.getNumMisses();
+}
+
+size_t GetFileTransformCacheNumEvictions()
+{
+    return g_fileCache.getNumEvictions();
+}
+
 void BuildFileTransformOps(OpRcPtrVec & ops,
                            const Config& config,
                            const ConstContextRcPtr & context,
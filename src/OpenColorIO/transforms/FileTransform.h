@@ -19,6 +19,8 @@
 
 namespace OCIO_NAMESPACE
 {
+class BakingCache;
+
 void ClearFileTransformCaches();
 
 class CachedFile
@@ -62,9 +64,20 @@ public:
         std::istream & istream,
         const std::string & originalFileName) const = 0;
 
+    // Read a file content already in memory (e.g. memory mapped) without any copy.
+    // The default implementation wraps the buffer in an istream for the formats only
+    // implementing the istream reader.
+    virtual CachedFileRcPtr readBuffer(
+        const char * data,
+        size_t size,
+        const std::string & originalFileName) const;
+
+    // The evaluated LUT lattices are shared through the cache (e.g. by the jobs of a
+    // BatchBaker).
     virtual void bake(const Baker & baker,
                         const std::string & formatName,
-                        std::ostream & ostream) const;
+                        std::ostream & ostream,
+                        BakingCache & cache) const;
 
     virtual void write(const OpRcPtrVec & ops,
                         const FormatMetadataImpl & metadata,
@@ -144,6 +157,7 @@ FileFormat * CreateFileFormatICC();
 FileFormat * CreateFileFormatIridasCube();
 FileFormat * CreateFileFormatIridasItx();
 FileFormat * CreateFileFormatIridasLook();
+FileFormat * CreateFileFormatOCIOBinaryLut();
 FileFormat * CreateFileFormatPandora();
 FileFormat * CreateFileFormatResolveCube();
 FileFormat * CreateFileFormatSpi1D();
@@ -152,6 +166,17 @@ FileFormat * CreateFileFormatSpiMtx();
 FileFormat * CreateFileFormatTruelight();
 FileFormat * CreateFileFormatVF();
 
+// Get the file from the FileTransform cache, the file is loaded on the first request.
+// Throws if the file could not be read.
+void GetCachedFileAndFormat(FileFormat * & format,
+                            CachedFileRcPtr & cachedFile,
+                            const std::string & filepath);
+
+// Create the ops of a baked LUT i.e. a 1D LUT when the transform has no channel crosstalk,
+// otherwise a 3D LUT with an optional shaper (a range and a half-domain 1D LUT by default).
+// It is used by the formats able to store a list of ops.
+void CreateBakedLutOps(OpRcPtrVec & ops, const Baker & baker, BakingCache & cache);
+
 static constexpr char FILEFORMAT_CLF[] = "Academy/ASC Common LUT Format";
 static constexpr char FILEFORMAT_CTF[] = "Color Transform Format";
 
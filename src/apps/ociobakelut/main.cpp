@@ -36,6 +36,7 @@ int main (int argc, const char* argv[])
     bool help = false;
     int cubesize = -1;
     int shapersize = -1; // cubsize^2
+    int numthreads = 0;
     std::string format;
     std::string inputconfig;
     std::string inputspace;
@@ -96,6 +97,7 @@ int main (int argc, const char* argv[])
                "--format %s", &format, formatstr.c_str(),
                "--shapersize %d", &shapersize, "size of the shaper (default: format specific)",
                "--cubesize %d", &cubesize, "size of the cube (default: format specific)",
+               "--threads %d", &numthreads, "number of threads to bake the LUT (default: 0, i.e. one per hardware thread)",
                "--stdout", &usestdout, "Write to stdout (rather than file)",
                "--v", &verbose, "Verbose",
                "--help", &help, "Print help message\n",
@@ -333,6 +335,7 @@ int main (int argc, const char* argv[])
             baker->setTargetSpace(outputspace.c_str());
             if(shapersize!=-1) baker->setShaperSize(shapersize);
             if(cubesize!=-1) baker->setCubeSize(cubesize);
+            if(numthreads>=0) baker->setNumThreads((unsigned)numthreads);
 
             // output LUT
             std::ostringstream output;
@@ -346,7 +349,11 @@ int main (int argc, const char* argv[])
             }
             else
             {
-                std::ofstream f(outputfile.c_str());
+                // The binary formats must not go through the newline translation.
+                const bool isBinary = format.rfind("ocio_binary_lut", 0) == 0;
+                std::ofstream f(outputfile.c_str(),
+                                isBinary ? std::ios_base::out | std::ios_base::binary
+                                         : std::ios_base::out);
                 if(f.fail())
                 {
                     std::cerr << "ERROR: Non-writable file path " << outputfile << " specified." << std::endl;
@@ -0,0 +1,755 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+namespace OCIO = OCIO_NAMESPACE;
+
+#include "apputils/argparse.h"
+#include "utils/StringUtils.h"
+
+
+namespace
+{
+
+// A benchmark case is a transform that finalizes into a single op, and so measures one
+// CPU renderer class (i.e. the name of the case).
+struct BenchmarkCase
+{
+    std::string m_renderer;
+    std::function<OCIO::ConstProcessorRcPtr()> m_createProcessor;
+};
+
+struct BenchmarkResult
+{
+    std::string m_renderer;
+    OCIO::BitDepth m_inBitDepth;
+    OCIO::BitDepth m_outBitDepth;
+    std::string m_channelOrdering;
+    unsigned m_iterations;
+    double m_medianTimeNs;
+    double m_minTimeNs;
+    double m_cpuTimeNs; // Mean process CPU time per iteration.
+    double m_pixelsPerSecond;
+};
+
+OCIO::ConstProcessorRcPtr GetProcessor(const OCIO::ConstTransformRcPtr & transform)
+{
+    static OCIO::ConstConfigRcPtr config = OCIO::Config::CreateRaw();
+    return config->getProcessor(transform);
+}
+
+OCIO::ConstProcessorRcPtr GetProcessor(const OCIO::ConstTransformRcPtr & transform,
+                                       OCIO::TransformDirection dir)
+{
+    OCIO::TransformRcPtr t = transform->createEditableCopy();
+    t->setDirection(dir);
+    return GetProcessor(t);
+}
+
+// Create a 1D LUT holding a gamma curve.
+OCIO::Lut1DTransformRcPtr CreateLut1D(bool halfDomain, OCIO::Lut1DHueAdjust hueAdjust)
+{
+    const unsigned long length = halfDomain ? 65536 : 4096;
+    OCIO::Lut1DTransformRcPtr lut = OCIO::Lut1DTransform::Create(length, halfDomain);
+    if (!halfDomain)
+    {
+        for (unsigned long idx = 0; idx < length; ++idx)
+        {
+            const float val = std::pow(float(idx) / float(length - 1), 1.f / 2.2f);
+            lut->setValue(idx, val, val * 0.9f, val * 0.8f);
+        }
+    }
+    lut->setHueAdjust(hueAdjust);
+    return lut;
+}
+
+// Create a 3D LUT which is not an identity.
+OCIO::Lut3DTransformRcPtr CreateLut3D(OCIO::Interpolation interp)
+{
+    const unsigned long gridSize = 33;
+    OCIO::Lut3DTransformRcPtr lut = OCIO::Lut3DTransform::Create(gridSize);
+    for (unsigned long r = 0; r < gridSize; ++r)
+    {
+        for (unsigned long g = 0; g < gridSize; ++g)
+        {
+            for (unsigned long b = 0; b < gridSize; ++b)
+            {
+                const float rv = float(r) / float(gridSize - 1);
+                const float gv = float(g) / float(gridSize - 1);
+                const float bv = float(b) / float(gridSize - 1);
+                lut->setValue(r, g, b,
+                              0.8f * rv + 0.1f * gv + 0.1f * bv,
+                              0.1f * rv + 0.8f * gv + 0.1f * bv,
+                              0.1f * rv + 0.1f * gv + 0.8f * bv);
+            }
+        }
+    }
+    lut->setInterpolation(interp);
+    return lut;
+}
+
+std::vector<BenchmarkCase> GetBenchmarkCases()
+{
+    std::vector<BenchmarkCase> cases;
+
+    auto add = [&cases](const std::string & renderer,
+                        std::function<OCIO::ConstProcessorRcPtr()> createProcessor)
+    {
+        cases.push_back({ renderer, createProcessor });
+    };
+
+    // CDL.
+
+    auto cdl = [](OCIO::CDLStyle style)
+    {
+        OCIO::CDLTransformRcPtr cdl = OCIO::CDLTransform::Create();
+        const double slope[3]  = { 1.1, 1.0, 0.9 };
+        const double offset[3] = { 0.01, 0.0, -0.01 };
+        const double power[3]  = { 1.2, 1.1, 1.0 };
+        cdl->setSlope(slope);
+        cdl->setOffset(offset);
+        cdl->setPower(power);
+        cdl->setSat(1.1);
+        cdl->setStyle(style);
+        return cdl;
+    };
+
+    add("CDLRendererV1_2Fwd", [&]() { return GetProcessor(cdl(OCIO::CDL_ASC)); });
+    add("CDLRendererV1_2Rev", [&]() { return GetProcessor(cdl(OCIO::CDL_ASC),
+                                                          OCIO::TRANSFORM_DIR_INVERSE); });
+    add("CDLRendererNoClampFwd", [&]() { return GetProcessor(cdl(OCIO::CDL_NO_CLAMP)); });
+    add("CDLRendererNoClampRev", [&]() { return GetProcessor(cdl(OCIO::CDL_NO_CLAMP),
+                                                             OCIO::TRANSFORM_DIR_INVERSE); });
+
+    // Exponent (i.e. only for the v1 configs).
+
+    add("ExponentOpCPU", []()
+    {
+        OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+        const double value[4] = { 2.2, 2.4, 2.6, 1.0 };
+        exp->setValue(value);
+
+        std::istringstream is("ocio_profile_version: 1\n"
+                              "roles:\n"
+                              "  default: raw\n"
+                              "colorspaces:\n"
+                              "  - !<ColorSpace>\n"
+                              "    name: raw\n");
+        OCIO::ConstConfigRcPtr config = OCIO::Config::CreateFromStream(is);
+        return config->getProcessor(exp);
+    });
+
+    // Exposure & contrast.
+
+    auto ec = [](OCIO::ExposureContrastStyle style)
+    {
+        OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+        ec->setStyle(style);
+        ec->setExposure(0.5);
+        ec->setContrast(1.2);
+        ec->setGamma(1.1);
+        return ec;
+    };
+
+    add("ECLinearRenderer", [&]() { return GetProcessor(ec(OCIO::EXPOSURE_CONTRAST_LINEAR)); });
+    add("ECLinearRevRenderer", [&]() { return GetProcessor(ec(OCIO::EXPOSURE_CONTRAST_LINEAR),
+                                                           OCIO::TRANSFORM_DIR_INVERSE); });
+    add("ECVideoRenderer", [&]() { return GetProcessor(ec(OCIO::EXPOSURE_CONTRAST_VIDEO)); });
+    add("ECVideoRevRenderer", [&]() { return GetProcessor(ec(OCIO::EXPOSURE_CONTRAST_VIDEO),
+                                                          OCIO::TRANSFORM_DIR_INVERSE); });
+    add("ECLogarithmicRenderer", [&]()
+        { return GetProcessor(ec(OCIO::EXPOSURE_CONTRAST_LOGARITHMIC)); });
+    add("ECLogarithmicRevRenderer", [&]()
+        { return GetProcessor(ec(OCIO::EXPOSURE_CONTRAST_LOGARITHMIC),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+
+    // Fixed functions.
+
+    auto ff = [](OCIO::FixedFunctionStyle style)
+    {
+        OCIO::FixedFunctionTransformRcPtr ff = OCIO::FixedFunctionTransform::Create();
+        ff->setStyle(style);
+        if (style == OCIO::FIXED_FUNCTION_REC2100_SURROUND)
+        {
+            const double gamma = 0.78;
+            ff->setParams(&gamma, 1);
+        }
+        return ff;
+    };
+
+    add("Renderer_ACES_RedMod03_Fwd", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_ACES_RED_MOD_03)); });
+    add("Renderer_ACES_RedMod03_Inv", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_ACES_RED_MOD_03),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+    add("Renderer_ACES_RedMod10_Fwd", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_ACES_RED_MOD_10)); });
+    add("Renderer_ACES_RedMod10_Inv", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_ACES_RED_MOD_10),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+    add("Renderer_ACES_Glow03_Fwd", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_ACES_GLOW_03)); });
+    add("Renderer_ACES_Glow03_Inv", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_ACES_GLOW_03),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+    add("Renderer_ACES_DarkToDim10_Fwd", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_ACES_DARK_TO_DIM_10)); });
+    add("Renderer_REC2100_Surround", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_REC2100_SURROUND)); });
+    add("Renderer_RGB_TO_HSV", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_RGB_TO_HSV)); });
+    add("Renderer_HSV_TO_RGB", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_RGB_TO_HSV),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+    add("Renderer_XYZ_TO_xyY", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_XYZ_TO_xyY)); });
+    add("Renderer_xyY_TO_XYZ", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_XYZ_TO_xyY),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+    add("Renderer_XYZ_TO_uvY", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_XYZ_TO_uvY)); });
+    add("Renderer_uvY_TO_XYZ", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_XYZ_TO_uvY),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+    add("Renderer_XYZ_TO_LUV", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_XYZ_TO_LUV)); });
+    add("Renderer_LUV_TO_XYZ", [&]()
+        { return GetProcessor(ff(OCIO::FIXED_FUNCTION_XYZ_TO_LUV),
+                              OCIO::TRANSFORM_DIR_INVERSE); });
+
+    // Gamma.
+
+    auto basicGamma = [](OCIO::NegativeStyle style)
+    {
+        OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+        const double value[4] = { 2.2, 2.4, 2.6, 1.0 };
+        exp->setValue(value);
+        exp->setNegativeStyle(style);
+        return exp;
+    };
+
+    add("GammaBasicOpCPU", [&]() { return GetProcessor(basicGamma(OCIO::NEGATIVE_CLAMP)); });
+    add("GammaBasicMirrorOpCPU", [&]()
+        { return GetProcessor(basicGamma(OCIO::NEGATIVE_MIRROR)); });
+    add("GammaBasicPassThruOpCPU", [&]()
+        { return GetProcessor(basicGamma(OCIO::NEGATIVE_PASS_THRU)); });
+
+    auto moncurve = [](OCIO::NegativeStyle style)
+    {
+        OCIO::ExponentWithLinearTransformRcPtr exp = OCIO::ExponentWithLinearTransform::Create();
+        const double gamma[4]  = { 2.4, 2.4, 2.4, 1.0 };
+        const double offset[4] = { 0.055, 0.055, 0.055, 0.0 };
+        exp->setGamma(gamma);
+        exp->setOffset(offset);
+        exp->setNegativeStyle(style);
+        return exp;
+    };
+
+    add("GammaMoncurveOpCPUFwd", [&]() { return GetProcessor(moncurve(OCIO::NEGATIVE_LINEAR)); });
+    add("GammaMoncurveOpCPURev", [&]() { return GetProcessor(moncurve(OCIO::NEGATIVE_LINEAR),
+                                                             OCIO::TRANSFORM_DIR_INVERSE); });
+    add("GammaMoncurveMirrorOpCPUFwd", [&]()
+        { return GetProcessor(moncurve(OCIO::NEGATIVE_MIRROR)); });
+    add("GammaMoncurveMirrorOpCPURev", [&]()
+        { return GetProcessor(moncurve(OCIO::NEGATIVE_MIRROR), OCIO::TRANSFORM_DIR_INVERSE); });
+
+    // Log.
+
+    auto log = [](double base)
+    {
+        OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+        log->setBase(base);
+        return log;
+    };
+
+    add("LogRenderer", [&]() { return GetProcessor(log(10.)); });
+    add("AntiLogRenderer", [&]() { return GetProcessor(log(10.), OCIO::TRANSFORM_DIR_INVERSE); });
+
+    auto logAffine = []()
+    {
+        OCIO::LogAffineTransformRcPtr log = OCIO::LogAffineTransform::Create();
+        const double logSlope[3] = { 0.18, 0.18, 0.18 };
+        const double linSlope[3] = { 2.0, 2.0, 2.0 };
+        const double linOffset[3] = { 0.1, 0.1, 0.1 };
+        log->setLogSideSlopeValue(logSlope);
+        log->setLinSideSlopeValue(linSlope);
+        log->setLinSideOffsetValue(linOffset);
+        return log;
+    };
+
+    add("Lin2LogRenderer", [&]() { return GetProcessor(logAffine()); });
+    add("Log2LinRenderer", [&]() { return GetProcessor(logAffine(), OCIO::TRANSFORM_DIR_INVERSE); });
+
+    auto logCamera = []()
+    {
+        const double linBreak[3] = { 0.1, 0.1, 0.1 };
+        OCIO::LogCameraTransformRcPtr log = OCIO::LogCameraTransform::Create();
+        log->setLinSideBreakValue(linBreak);
+        const double logSlope[3] = { 0.18, 0.18, 0.18 };
+        log->setLogSideSlopeValue(logSlope);
+        return log;
+    };
+
+    add("CameraLin2LogRenderer", [&]() { return GetProcessor(logCamera()); });
+    add("CameraLog2LinRenderer", [&]()
+        { return GetProcessor(logCamera(), OCIO::TRANSFORM_DIR_INVERSE); });
+
+    // 1D LUT.
+
+    add("Lut1DRenderer", []() { return GetProcessor(CreateLut1D(false, OCIO::HUE_NONE)); });
+    add("Lut1DRendererHueAdjust", []() { return GetProcessor(CreateLut1D(false, OCIO::HUE_DW3)); });
+    add("Lut1DRendererHalfCode", []() { return GetProcessor(CreateLut1D(true, OCIO::HUE_NONE)); });
+    add("Lut1DRendererHalfCodeHueAdjust", []()
+        { return GetProcessor(CreateLut1D(true, OCIO::HUE_DW3)); });
+    add("InvLut1DRenderer", []()
+        { return GetProcessor(CreateLut1D(false, OCIO::HUE_NONE), OCIO::TRANSFORM_DIR_INVERSE); });
+    add("InvLut1DRendererHueAdjust", []()
+        { return GetProcessor(CreateLut1D(false, OCIO::HUE_DW3), OCIO::TRANSFORM_DIR_INVERSE); });
+    add("InvLut1DRendererHalfCode", []()
+        { return GetProcessor(CreateLut1D(true, OCIO::HUE_NONE), OCIO::TRANSFORM_DIR_INVERSE); });
+    add("InvLut1DRendererHalfCodeHueAdjust", []()
+        { return GetProcessor(CreateLut1D(true, OCIO::HUE_DW3), OCIO::TRANSFORM_DIR_INVERSE); });
+
+    // 3D LUT.
+
+    add("Lut3DTetrahedralRenderer", []()
+        { return GetProcessor(CreateLut3D(OCIO::INTERP_TETRAHEDRAL)); });
+    add("Lut3DRenderer", []() { return GetProcessor(CreateLut3D(OCIO::INTERP_LINEAR)); });
+    add("InvLut3DRenderer", []()
+        { return GetProcessor(CreateLut3D(OCIO::INTERP_TETRAHEDRAL), OCIO::TRANSFORM_DIR_INVERSE); });
+
+    // Matrix.
+
+    auto matrix = [](bool diagonal, bool offsets)
+    {
+        OCIO::MatrixTransformRcPtr mat = OCIO::MatrixTransform::Create();
+        const double m44[16] = { 1.1, diagonal ? 0. : 0.1, diagonal ? 0. : 0.05, 0.,
+                                 diagonal ? 0. : 0.2, 0.9, diagonal ? 0. : 0.1, 0.,
+                                 diagonal ? 0. : 0.05, diagonal ? 0. : 0.1, 1.2, 0.,
+                                 0., 0., 0., 1. };
+        const double offset4[4] = { 0.01, 0.02, 0.03, 0. };
+        const double noOffset4[4] = { 0., 0., 0., 0. };
+        mat->setMatrix(m44);
+        mat->setOffset(offsets ? offset4 : noOffset4);
+        return mat;
+    };
+
+    add("ScaleRenderer", [&]() { return GetProcessor(matrix(true, false)); });
+    add("ScaleWithOffsetRenderer", [&]() { return GetProcessor(matrix(true, true)); });
+    add("MatrixRenderer", [&]() { return GetProcessor(matrix(false, false)); });
+    add("MatrixWithOffsetRenderer", [&]() { return GetProcessor(matrix(false, true)); });
+
+    // Range.
+
+    auto range = [](bool hasMin, bool hasMax, bool scales)
+    {
+        OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+        if (hasMin)
+        {
+            range->setMinInValue(0.);
+            range->setMinOutValue(scales ? 0.1 : 0.);
+        }
+        if (hasMax)
+        {
+            range->setMaxInValue(1.);
+            range->setMaxOutValue(scales ? 0.9 : 1.);
+        }
+        return range;
+    };
+
+    add("RangeScaleMinMaxRenderer", [&]() { return GetProcessor(range(true, true, true)); });
+    add("RangeMinMaxRenderer", [&]() { return GetProcessor(range(true, true, false)); });
+    add("RangeMinRenderer", [&]() { return GetProcessor(range(true, false, false)); });
+    add("RangeMaxRenderer", [&]() { return GetProcessor(range(false, true, false)); });
+
+    return cases;
+}
+
+struct ChannelOrderingInfo
+{
+    const char * m_name;
+    OCIO::ChannelOrdering m_ordering;
+    long m_numChannels;
+};
+
+const ChannelOrderingInfo ALL_CHANNEL_ORDERINGS[] = {
+    { "RGBA", OCIO::CHANNEL_ORDERING_RGBA, 4 },
+    { "BGRA", OCIO::CHANNEL_ORDERING_BGRA, 4 },
+    { "ABGR", OCIO::CHANNEL_ORDERING_ABGR, 4 },
+    { "RGB",  OCIO::CHANNEL_ORDERING_RGB,  3 },
+    { "BGR",  OCIO::CHANNEL_ORDERING_BGR,  3 }
+};
+
+const OCIO::BitDepth ALL_BIT_DEPTHS[] = {
+    OCIO::BIT_DEPTH_UINT8,
+    OCIO::BIT_DEPTH_UINT10,
+    OCIO::BIT_DEPTH_UINT12,
+    OCIO::BIT_DEPTH_UINT16,
+    OCIO::BIT_DEPTH_F16,
+    OCIO::BIT_DEPTH_F32
+};
+
+size_t GetChannelSize(OCIO::BitDepth bitDepth)
+{
+    switch (bitDepth)
+    {
+        case OCIO::BIT_DEPTH_UINT8:
+            return 1;
+        case OCIO::BIT_DEPTH_UINT10:
+        case OCIO::BIT_DEPTH_UINT12:
+        case OCIO::BIT_DEPTH_UINT16:
+        case OCIO::BIT_DEPTH_F16:
+            return 2;
+        case OCIO::BIT_DEPTH_F32:
+            return 4;
+        case OCIO::BIT_DEPTH_UINT14:
+        case OCIO::BIT_DEPTH_UINT32:
+        case OCIO::BIT_DEPTH_UNKNOWN:
+            break;
+    }
+
+    std::string err("Unsupported bit-depth: ");
+    err += OCIO::BitDepthToString(bitDepth);
+    throw OCIO::Exception(err.c_str());
+}
+
+// Create an image of the requested bit-depth holding a ramp in [-0.1, 1.1].
+std::vector<char> CreateInputImage(long width, long height, const ChannelOrderingInfo & ordering,
+                                   OCIO::BitDepth bitDepth)
+{
+    const long numValues = width * height * ordering.m_numChannels;
+
+    std::vector<float> ramp(numValues);
+    for (long idx = 0; idx < numValues; ++idx)
+    {
+        ramp[idx] = -0.1f + 1.2f * float(idx % 4093) / 4092.f;
+    }
+
+    std::vector<char> img(numValues * GetChannelSize(bitDepth));
+
+    // Use an identity transform to convert the ramp to the requested bit-depth.
+    OCIO::ConstCPUProcessorRcPtr converter
+        = GetProcessor(OCIO::MatrixTransform::Create())
+            ->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, bitDepth, OCIO::OPTIMIZATION_NONE);
+
+    OCIO::PackedImageDesc src(ramp.data(), width, height, ordering.m_ordering);
+    OCIO::PackedImageDesc dst(img.data(), width, height, ordering.m_ordering, bitDepth,
+                              OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+    converter->apply(src, dst);
+
+    return img;
+}
+
+BenchmarkResult RunBenchmark(const BenchmarkCase & benchmark,
+                             OCIO::BitDepth inBitDepth,
+                             OCIO::BitDepth outBitDepth,
+                             const ChannelOrderingInfo & ordering,
+                             long width, long height,
+                             unsigned iterations)
+{
+    // Keep the op as is so that only its renderer is measured.
+    OCIO::ConstCPUProcessorRcPtr cpu
+        = benchmark.m_createProcessor()->getOptimizedCPUProcessor(inBitDepth, outBitDepth,
+                                                                  OCIO::OPTIMIZATION_NONE);
+
+    std::vector<char> inImg = CreateInputImage(width, height, ordering, inBitDepth);
+    std::vector<char> outImg(width * height * ordering.m_numChannels * GetChannelSize(outBitDepth));
+
+    OCIO::PackedImageDesc src(inImg.data(), width, height, ordering.m_ordering, inBitDepth,
+                              OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc dst(outImg.data(), width, height, ordering.m_ordering, outBitDepth,
+                              OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+
+    // Warm up the caches.
+    cpu->apply(src, dst);
+
+    std::vector<double> timesNs;
+    timesNs.reserve(iterations);
+
+    const std::clock_t cpuStart = std::clock();
+
+    for (unsigned iter = 0; iter < iterations; ++iter)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        cpu->apply(src, dst);
+        const auto end = std::chrono::steady_clock::now();
+
+        timesNs.push_back(double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
+
+    const std::clock_t cpuEnd = std::clock();
+
+    std::sort(timesNs.begin(), timesNs.end());
+
+    BenchmarkResult result;
+    result.m_renderer        = benchmark.m_renderer;
+    result.m_inBitDepth      = inBitDepth;
+    result.m_outBitDepth     = outBitDepth;
+    result.m_channelOrdering = ordering.m_name;
+    result.m_iterations      = iterations;
+    result.m_medianTimeNs    = timesNs[timesNs.size() / 2];
+    result.m_minTimeNs       = timesNs.front();
+    result.m_cpuTimeNs       = double(cpuEnd - cpuStart) * 1e9 / CLOCKS_PER_SEC / iterations;
+    result.m_pixelsPerSecond = double(width * height) * 1e9 / std::max(1.0, result.m_medianTimeNs);
+
+    return result;
+}
+
+std::string GetResultName(const BenchmarkResult & result)
+{
+    std::ostringstream oss;
+    oss << result.m_renderer << "/"
+        << OCIO::BitDepthToString(result.m_inBitDepth) << "_"
+        << OCIO::BitDepthToString(result.m_outBitDepth) << "/"
+        << result.m_channelOrdering;
+    return oss.str();
+}
+
+// Write the results using the same layout as the JSON reports of Google Benchmark.
+void WriteJSON(std::ostream & os, const std::vector<BenchmarkResult> & results,
+               long width, long height)
+{
+    char date[64] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"date\": \"" << date << "\",\n";
+    os << "    \"ocio_version\": \"" << OCIO::GetVersion() << "\",\n";
+    os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    os << "    \"image_width\": " << width << ",\n";
+    os << "    \"image_height\": " << height << "\n";
+    os << "  },\n";
+    os << "  \"benchmarks\": [\n";
+
+    for (size_t idx = 0; idx < results.size(); ++idx)
+    {
+        const BenchmarkResult & result = results[idx];
+
+        os << "    {\n";
+        os << "      \"name\": \"" << GetResultName(result) << "\",\n";
+        os << "      \"renderer\": \"" << result.m_renderer << "\",\n";
+        os << "      \"in_bit_depth\": \"" << OCIO::BitDepthToString(result.m_inBitDepth) << "\",\n";
+        os << "      \"out_bit_depth\": \"" << OCIO::BitDepthToString(result.m_outBitDepth) << "\",\n";
+        os << "      \"channel_ordering\": \"" << result.m_channelOrdering << "\",\n";
+        os << "      \"run_type\": \"iteration\",\n";
+        os << "      \"iterations\": " << result.m_iterations << ",\n";
+        os << "      \"real_time\": " << std::fixed << std::setprecision(0) << result.m_medianTimeNs << ",\n";
+        os << "      \"cpu_time\": " << result.m_cpuTimeNs << ",\n";
+        os << "      \"min_time\": " << result.m_minTimeNs << ",\n";
+        os << "      \"time_unit\": \"ns\",\n";
+        os << "      \"items_per_second\": " << result.m_pixelsPerSecond << "\n";
+        os << "    }" << (idx + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    os << "  ]\n";
+    os << "}\n";
+}
+
+bool ParseBitDepthPairs(const std::string & str,
+                        std::vector<std::pair<OCIO::BitDepth, OCIO::BitDepth>> & pairs)
+{
+    if (StringUtils::Lower(str) == "all")
+    {
+        for (auto in : ALL_BIT_DEPTHS)
+        {
+            for (auto out : ALL_BIT_DEPTHS)
+            {
+                pairs.emplace_back(in, out);
+            }
+        }
+        return true;
+    }
+
+    for (const auto & pair : StringUtils::Split(str, ','))
+    {
+        const StringUtils::StringVec bitDepths = StringUtils::Split(StringUtils::Trim(pair), ':');
+        if (bitDepths.size() != 2)
+        {
+            return false;
+        }
+
+        const OCIO::BitDepth in  = OCIO::BitDepthFromString(bitDepths[0].c_str());
+        const OCIO::BitDepth out = OCIO::BitDepthFromString(bitDepths[1].c_str());
+        if (std::find(std::begin(ALL_BIT_DEPTHS), std::end(ALL_BIT_DEPTHS), in) == std::end(ALL_BIT_DEPTHS)
+            || std::find(std::begin(ALL_BIT_DEPTHS), std::end(ALL_BIT_DEPTHS), out) == std::end(ALL_BIT_DEPTHS))
+        {
+            return false;
+        }
+        pairs.emplace_back(in, out);
+    }
+    return !pairs.empty();
+}
+
+bool ParseChannelOrderings(const std::string & str, std::vector<ChannelOrderingInfo> & orderings)
+{
+    if (StringUtils::Lower(str) == "all")
+    {
+        orderings.assign(std::begin(ALL_CHANNEL_ORDERINGS), std::end(ALL_CHANNEL_ORDERINGS));
+        return true;
+    }
+
+    for (const auto & name : StringUtils::Split(str, ','))
+    {
+        const std::string upperName = StringUtils::Upper(StringUtils::Trim(name));
+
+        auto it = std::find_if(std::begin(ALL_CHANNEL_ORDERINGS), std::end(ALL_CHANNEL_ORDERINGS),
+                               [&upperName](const ChannelOrderingInfo & info)
+                               { return upperName == info.m_name; });
+        if (it == std::end(ALL_CHANNEL_ORDERINGS))
+        {
+            return false;
+        }
+        orderings.push_back(*it);
+    }
+    return !orderings.empty();
+}
+
+} // anon.
+
+
+int main(int argc, const char ** argv)
+{
+    bool help = false;
+    bool list = false;
+    int width = 1920;
+    int height = 270;
+    int iterations = 10;
+    std::string filter;
+    std::string bitDepthsStr("32f:32f,16f:16f,16ui:16ui,10ui:10ui,8ui:8ui,8ui:32f,16f:32f");
+    std::string orderingsStr("RGBA,RGB");
+    std::string jsonFile;
+
+    ArgParse ap;
+    ap.options("ociobench -- measure the throughput of each CPU renderer\n\n"
+               "usage: ociobench [options]\n\n"
+               "Each benchmark processes an image with a transform made of a single op, for\n"
+               "a given pair of bit-depths and a given channel ordering.\n",
+               "--h", &help, "Display the help and exit",
+               "--list", &list, "List the renderers and exit",
+               "--filter %s", &filter, "Only run the renderers whose name contains this string",
+               "--bitdepths %s", &bitDepthsStr, "Comma separated list of in:out bit-depth pairs, "
+                                                "or 'all' (default is "
+                                                "32f:32f,16f:16f,16ui:16ui,10ui:10ui,8ui:8ui,8ui:32f,16f:32f)",
+               "--orderings %s", &orderingsStr, "Comma separated list of channel orderings "
+                                                "(RGBA, BGRA, ABGR, RGB, BGR), or 'all' (default is RGBA,RGB)",
+               "--width %d", &width, "Width of the processed image (default is 1920)",
+               "--height %d", &height, "Height of the processed image (default is 270)",
+               "--iter %d", &iterations, "Number of iterations of each benchmark (default is 10)",
+               "--json %s", &jsonFile, "Write the results in the JSON file",
+               NULL);
+
+    if (ap.parse(argc, argv) < 0)
+    {
+        std::cerr << ap.geterror() << std::endl;
+        ap.usage();
+        return 1;
+    }
+
+    if (help)
+    {
+        ap.usage();
+        return 0;
+    }
+
+    const std::vector<BenchmarkCase> cases = GetBenchmarkCases();
+
+    if (list)
+    {
+        for (const auto & benchmark : cases)
+        {
+            std::cout << benchmark.m_renderer << std::endl;
+        }
+        return 0;
+    }
+
+    std::vector<std::pair<OCIO::BitDepth, OCIO::BitDepth>> bitDepths;
+    if (!ParseBitDepthPairs(bitDepthsStr, bitDepths))
+    {
+        std::cerr << "Invalid list of bit-depth pairs: " << bitDepthsStr << std::endl;
+        return 1;
+    }
+
+    std::vector<ChannelOrderingInfo> orderings;
+    if (!ParseChannelOrderings(orderingsStr, orderings))
+    {
+        std::cerr << "Invalid list of channel orderings: " << orderingsStr << std::endl;
+        return 1;
+    }
+
+    if (width <= 0 || height <= 0 || iterations <= 0)
+    {
+        std::cerr << "The image size and the number of iterations must be positive." << std::endl;
+        return 1;
+    }
+
+    std::vector<BenchmarkResult> results;
+
+    try
+    {
+        std::cout << std::left << std::setw(60) << "Benchmark"
+                  << std::right << std::setw(14) << "Time (ms)"
+                  << std::setw(16) << "Mpixels/s" << std::endl;
+        std::cout << std::string(90, '-') << std::endl;
+
+        for (const auto & benchmark : cases)
+        {
+            if (!filter.empty() && benchmark.m_renderer.find(filter) == std::string::npos)
+            {
+                continue;
+            }
+
+            for (const auto & bitDepth : bitDepths)
+            {
+                for (const auto & ordering : orderings)
+                {
+                    const BenchmarkResult result = RunBenchmark(benchmark,
+                                                                bitDepth.first, bitDepth.second,
+                                                                ordering,
+                                                                width, height,
+                                                                unsigned(iterations));
+                    results.push_back(result);
+
+                    std::cout << std::left << std::setw(60) << GetResultName(result)
+                              << std::right << std::fixed
+                              << std::setw(14) << std::setprecision(3) << result.m_medianTimeNs * 1e-6
+                              << std::setw(16) << std::setprecision(1) << result.m_pixelsPerSecond * 1e-6
+                              << std::endl;
+                }
+            }
+        }
+    }
+    catch (const OCIO::Exception & ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    if (!jsonFile.empty())
+    {
+        std::ofstream ofs(jsonFile.c_str(), std::ios_base::out);
+        if (!ofs.good())
+        {
+            std::cerr << "Could not open the file: " << jsonFile << std::endl;
+            return 1;
+        }
+        WriteJSON(ofs, results, width, height);
+    }
+
+    return 0;
+}
@@ -81,6 +81,8 @@ void bindPyBaker(py::module & m)
         .def("setShaperSize", &Baker::setShaperSize, "shaperSize"_a)
         .def("getCubeSize", &Baker::getCubeSize)
         .def("setCubeSize", &Baker::setCubeSize, "cubeSize"_a)
+        .def("getNumThreads", &Baker::getNumThreads)
+        .def("setNumThreads", &Baker::setNumThreads, "numThreads"_a)
         .def("bake", [](BakerRcPtr & self, const std::string & fileName) 
             {
                 std::ofstream f(fileName.c_str());
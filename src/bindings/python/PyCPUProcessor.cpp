@@ -36,6 +36,57 @@ void bindPyCPUProcessor(py::module & m)
             },
              "srcImgDesc"_a, "dstImgDesc"_a,
              py::call_guard<py::gil_scoped_release>())
+        .def("applyParallel", [](CPUProcessorRcPtr & self, 
+                                 PyImageDesc & imgDesc, 
+                                 unsigned numThreads) 
+            {
+                self->applyParallel((*imgDesc.m_img), numThreads);
+            },
+             "imgDesc"_a, "numThreads"_a = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("applyParallel", [](CPUProcessorRcPtr & self, 
+                                 PyImageDesc & srcImgDesc, 
+                                 PyImageDesc & dstImgDesc,
+                                 unsigned numThreads)
+            {
+                self->applyParallel((*srcImgDesc.m_img), (*dstImgDesc.m_img), numThreads);
+            },
+             "srcImgDesc"_a, "dstImgDesc"_a, "numThreads"_a = 0,
+             py::call_guard<py::gil_scoped_release>())
+        .def("reserveScanlineBuffers", &CPUProcessor::reserveScanlineBuffers,
+             "width"_a, "numThreads"_a = 1)
+        .def("getBlockSize", &CPUProcessor::getBlockSize)
+        .def("setBlockSize", &CPUProcessor::setBlockSize, "numPixels"_a)
+        .def("isOpTimingEnabled", &CPUProcessor::isOpTimingEnabled)
+        .def("resetOpTimings", &CPUProcessor::resetOpTimings)
+        .def("getOpTimings", [](CPUProcessorRcPtr & self)
+            {
+                py::list timings;
+                for (int i = 0; i < self->getNumOpTimings(); i++)
+                {
+                    timings.append(py::make_tuple(self->getOpTimingName(i),
+                                                  self->getOpTimingNumCalls(i),
+                                                  self->getOpTimingNumPixels(i),
+                                                  self->getOpTimingNanoseconds(i)));
+                }
+                return timings;
+            })
+        .def("serializeOpTimings", [](CPUProcessorRcPtr & self)
+            {
+                std::ostringstream os;
+                self->serializeOpTimings(os);
+                return os.str();
+            })
+        .def("getSeparablePrefixF32Accuracy", [](CPUProcessorRcPtr & self) -> py::object
+            {
+                float maxError = 0.f, maxErrorInput = 0.f;
+                bool replaced = false;
+                if (!self->getSeparablePrefixF32Accuracy(maxError, maxErrorInput, replaced))
+                {
+                    return py::none();
+                }
+                return py::make_tuple(maxError, maxErrorInput, replaced);
+            })
         .def("applyRGB", [](CPUProcessorRcPtr & self, py::buffer & pixel) 
             {
                 py::buffer_info info = pixel.request();
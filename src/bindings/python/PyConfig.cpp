@@ -266,6 +266,20 @@ void bindPyConfig(py::module & m)
              "filePath"_a, "ruleIndex"_a)
         .def("filepathOnlyMatchesDefaultRule", &Config::filepathOnlyMatchesDefaultRule, 
              "filePath"_a)
+        .def("getColorSpacesFromFilepaths", 
+             [](ConfigRcPtr & self, const std::vector<std::string> & filePaths)
+            {
+                std::vector<const char *> paths;
+                for (const auto & filePath : filePaths)
+                {
+                    paths.push_back(filePath.c_str());
+                }
+                std::vector<const char *> colorSpaces(paths.size());
+                self->getColorSpacesFromFilepaths(paths.data(), paths.size(),
+                                                  colorSpaces.data(), nullptr);
+                return std::vector<std::string>(colorSpaces.begin(), colorSpaces.end());
+            },
+             "filePaths"_a)
 
         // Processors
         .def("getProcessor", 
@@ -315,6 +329,15 @@ void bindPyConfig(py::module & m)
                                               TransformDirection) const) 
              &Config::getProcessor, 
              "context"_a, "transform"_a, "direction"_a)
+        .def("setProcessorCacheEnabled", &Config::setProcessorCacheEnabled, "enabled"_a)
+        .def("isProcessorCacheEnabled", &Config::isProcessorCacheEnabled)
+        .def("setProcessorCacheSize", &Config::setProcessorCacheSize, "maxNumProcessors"_a)
+        .def("getProcessorCacheSize", &Config::getProcessorCacheSize)
+        .def("clearProcessorCache", &Config::clearProcessorCache)
+        .def("getProcessorCacheNumHits", &Config::getProcessorCacheNumHits)
+        .def("getProcessorCacheNumMisses", &Config::getProcessorCacheNumMisses)
+        .def("setProcessorCacheDirectory", &Config::setProcessorCacheDirectory, "dirname"_a)
+        .def("getProcessorCacheDirectory", &Config::getProcessorCacheDirectory)
 
         .def_static("GetProcessor", [](const ConstConfigRcPtr & srcConfig,
                                        const char * srcColorSpaceName,
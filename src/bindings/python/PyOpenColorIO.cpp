@@ -14,6 +14,13 @@ PYBIND11_MODULE(PyOpenColorIO, m)
 
     // Global
     m.def("ClearAllCaches", &ClearAllCaches);
+    m.def("SetFileTransformCacheMaxSize", &SetFileTransformCacheMaxSize, "maxNumBytes"_a);
+    m.def("GetFileTransformCacheMaxSize", &GetFileTransformCacheMaxSize);
+    m.def("GetFileTransformCacheSize", &GetFileTransformCacheSize);
+    m.def("GetFileTransformCacheNumEntries", &GetFileTransformCacheNumEntries);
+    m.def("GetFileTransformCacheNumHits", &GetFileTransformCacheNumHits);
+    m.def("GetFileTransformCacheNumMisses", &GetFileTransformCacheNumMisses);
+    m.def("GetFileTransformCacheNumEvictions", &GetFileTransformCacheNumEvictions);
     m.def("GetVersion", &GetVersion);
     m.def("GetVersionHex", &GetVersionHex);
     m.def("GetLoggingLevel", &GetLoggingLevel);
@@ -57,6 +57,18 @@ void bindPyProcessor(py::module & m)
                 return os.str();
             }, 
              "formatName"_a)
+        .def("serialize", [](ProcessorRcPtr & self) 
+            {
+                std::ostringstream os;
+                self->serialize(os);
+                return py::bytes(os.str());
+            })
+        .def_static("CreateFromStream", [](const py::bytes & data) 
+            {
+                std::istringstream is(data);
+                return Processor::CreateFromStream(is);
+            }, 
+             "data"_a)
         .def("getDynamicProperty", &Processor::getDynamicProperty, "type"_a)
         .def("hasDynamicProperty", &Processor::hasDynamicProperty, "type"_a)
         .def("getOptimizedProcessor",
@@ -80,6 +92,8 @@ void bindPyProcessor(py::module & m)
         .def("getOptimizedCPUProcessor", 
              (ConstCPUProcessorRcPtr (Processor::*)(BitDepth, BitDepth, OptimizationFlags) const) 
              &Processor::getOptimizedCPUProcessor, 
+             "inBitDepth"_a, "outBitDepth"_a, "oFlags"_a)
+        .def("getTimedCPUProcessor", &Processor::getTimedCPUProcessor,
              "inBitDepth"_a, "outBitDepth"_a, "oFlags"_a);
 
     py::class_<TransformFormatMetadataIterator>(cls, "TransformFormatMetadataIterator")
@@ -176,6 +176,7 @@ void bindPyTypes(py::module & m)
         .value("OPTIMIZATION_COMP_SEPARABLE_PREFIX", OPTIMIZATION_COMP_SEPARABLE_PREFIX)
         .value("OPTIMIZATION_LUT_INV_FAST", OPTIMIZATION_LUT_INV_FAST)
         .value("OPTIMIZATION_NO_DYNAMIC_PROPERTIES", OPTIMIZATION_NO_DYNAMIC_PROPERTIES)
+        .value("OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32", OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32)
         .value("OPTIMIZATION_ALL", OPTIMIZATION_ALL)
         .value("OPTIMIZATION_LOSSLESS", OPTIMIZATION_LOSSLESS)
         .value("OPTIMIZATION_VERY_GOOD", OPTIMIZATION_VERY_GOOD)
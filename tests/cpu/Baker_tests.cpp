@@ -135,11 +135,143 @@ OCIO_ADD_TEST(Baker, bake)
     std::ostringstream os;
     OCIO_CHECK_NO_THROW(bake->bake(os));
     OCIO_CHECK_EQUAL(expectedLut, os.str());
-    OCIO_CHECK_EQUAL(10, bake->getNumFormats());
+    OCIO_CHECK_EQUAL(12, bake->getNumFormats());
     OCIO_CHECK_EQUAL("cinespace", std::string(bake->getFormatNameByIndex(4)));
     OCIO_CHECK_EQUAL("3dl", std::string(bake->getFormatExtensionByIndex(1)));
 }
 
+OCIO_ADD_TEST(Baker, bake_parallel)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    {
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName("target");
+
+        // Use a non-separable transform to make a 3D LUT.
+        OCIO::CDLTransformRcPtr transform = OCIO::CDLTransform::Create();
+        const double slope[3] = { 1.1, 1.0, 0.9 };
+        transform->setSlope(slope);
+        transform->setSat(0.7);
+        cs->setTransform(transform, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+        config->addColorSpace(cs);
+    }
+
+    OCIO::BakerRcPtr baker = OCIO::Baker::Create();
+    baker->setConfig(config);
+    baker->setInputSpace("raw");
+    baker->setTargetSpace("target");
+    baker->setCubeSize(17);
+    OCIO_CHECK_EQUAL(baker->getNumThreads(), 1);
+
+    for (const char * format : { "iridas_cube", "resolve_cube", "cinespace", "truelight",
+                                 "iridas_itx", "lustre", "houdini", "ocio_binary_lut" })
+    {
+        baker->setFormat(format);
+        baker->setNumThreads(1);
+        std::ostringstream serial;
+        OCIO_CHECK_NO_THROW(baker->bake(serial));
+
+        baker->setNumThreads(4);
+        std::ostringstream parallel;
+        OCIO_CHECK_NO_THROW(baker->bake(parallel));
+        OCIO_CHECK_ASSERT(serial.str() == parallel.str());
+    }
+
+    OCIO::BakerRcPtr copy = baker->createEditableCopy();
+    OCIO_CHECK_EQUAL(copy->getNumThreads(), 4);
+}
+
+OCIO_ADD_TEST(Baker, batch_bake)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    for (const char * name : { "target1", "target2" })
+    {
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName(name);
+
+        OCIO::CDLTransformRcPtr transform = OCIO::CDLTransform::Create();
+        transform->setSat(name[6] == '1' ? 0.7 : 1.2);
+        cs->setTransform(transform, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+        config->addColorSpace(cs);
+    }
+    {
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName("shaper");
+
+        OCIO::ExponentTransformRcPtr transform = OCIO::ExponentTransform::Create();
+        const double gamma[4] = { 2.2, 2.2, 2.2, 1.0 };
+        transform->setValue(gamma);
+        cs->setTransform(transform, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+        config->addColorSpace(cs);
+    }
+
+    OCIO::BatchBakerRcPtr batch = OCIO::BatchBaker::Create();
+    OCIO_CHECK_EQUAL(batch->getNumThreads(), 0);
+    batch->setNumThreads(4);
+    batch->getFormatMetadata().addChildElement(OCIO::METADATA_DESCRIPTION, "A batch");
+
+    std::ostringstream unused;
+    OCIO_CHECK_THROW_WHAT(batch->addJob("foo", "raw", "", "", "target1", -1, 17, unused),
+                          OCIO::Exception, "File format foo does not support baking");
+    OCIO_CHECK_EQUAL(batch->getNumJobs(), 0);
+
+    struct Job
+    {
+        const char * m_format;
+        const char * m_shaperSpace;
+        const char * m_targetSpace;
+    };
+    const Job jobs[] = { { "cinespace",   "shaper", "target1" },
+                         { "cinespace",   "shaper", "target2" },
+                         { "cinespace",   "",       "target1" },
+                         { "iridas_cube", "",       "target1" },
+                         { "iridas_cube", "",       "target2" },
+                         { "houdini",     "",       "target2" },
+                         { OCIO::FILEFORMAT_CLF, "", "target1" } };
+    const size_t numJobs = sizeof(jobs) / sizeof(jobs[0]);
+
+    std::ostringstream outputs[numJobs];
+    for (size_t idx = 0; idx < numJobs; ++idx)
+    {
+        OCIO_CHECK_NO_THROW(batch->addJob(jobs[idx].m_format, "raw", jobs[idx].m_shaperSpace,
+                                          "", jobs[idx].m_targetSpace, -1, 17,
+                                          outputs[idx]));
+    }
+    OCIO_CHECK_EQUAL(batch->getNumJobs(), static_cast<int>(numJobs));
+
+    OCIO_CHECK_THROW_WHAT(batch->bake(), OCIO::Exception, "No OCIO config has been set");
+
+    batch->setConfig(config);
+    OCIO_CHECK_NO_THROW(batch->bake());
+
+    // The batch gives the same LUTs as the individual bakes.
+    OCIO::BakerRcPtr baker = OCIO::Baker::Create();
+    baker->setConfig(config);
+    baker->getFormatMetadata().addChildElement(OCIO::METADATA_DESCRIPTION, "A batch");
+    baker->setInputSpace("raw");
+    baker->setCubeSize(17);
+    for (size_t idx = 0; idx < numJobs; ++idx)
+    {
+        baker->setFormat(jobs[idx].m_format);
+        baker->setShaperSpace(jobs[idx].m_shaperSpace);
+        baker->setTargetSpace(jobs[idx].m_targetSpace);
+
+        std::ostringstream expected;
+        OCIO_CHECK_NO_THROW(baker->bake(expected));
+        OCIO_CHECK_ASSERT(!expected.str().empty());
+        OCIO_CHECK_ASSERT(expected.str() == outputs[idx].str());
+    }
+
+    // A failing job reports its index.
+    batch->clearJobs();
+    OCIO_CHECK_EQUAL(batch->getNumJobs(), 0);
+    std::ostringstream good, bad;
+    batch->addJob("iridas_cube", "raw", "", "", "target1", -1, 17, good);
+    batch->addJob("iridas_cube", "raw", "", "", "missing", -1, 17, bad);
+    OCIO_CHECK_THROW_WHAT(batch->bake(), OCIO::Exception, "Error baking the job 1: ");
+    OCIO_CHECK_ASSERT(!good.str().empty());
+}
+
 OCIO_ADD_TEST(Baker, empty_config)
 {
     // Verify that running bake with an empty configuration
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include "BakingUtils.cpp"
+
+#include "testutils/UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+OCIO::ConstCPUProcessorRcPtr GetCPUProcessor(double sat)
+{
+    OCIO::CDLTransformRcPtr transform = OCIO::CDLTransform::Create();
+    transform->setSat(sat);
+    return OCIO::Config::CreateRaw()->getProcessor(transform)->getDefaultCPUProcessor();
+}
+
+}
+
+OCIO_ADD_TEST(BakingUtils, lattices)
+{
+    OCIO::BakingCache cache(8);
+
+    OCIO::ConstCPUProcessorRcPtr cpu1 = GetCPUProcessor(0.5);
+    OCIO::ConstCPUProcessorRcPtr cpu2 = GetCPUProcessor(1.5);
+
+    // The identity lattice is cached, not the processed one (i.e. the complete sequence).
+    OCIO::ConstLutValuesRcPtr lut;
+    OCIO_CHECK_NO_THROW(lut = cache.getLut3D(5, OCIO::LUT3DORDER_FAST_RED, { cpu1 }, 2));
+    OCIO_REQUIRE_ASSERT(lut);
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 1);
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 0);
+
+    std::vector<float> expected(5 * 5 * 5 * 3);
+    OCIO::GenerateIdentityLut3D(expected.data(), 5, 3, OCIO::LUT3DORDER_FAST_RED);
+    OCIO::PackedImageDesc img(expected.data(), 5 * 5 * 5, 1, 3);
+    cpu1->apply(img);
+    OCIO_CHECK_ASSERT(*lut == expected);
+
+    // The same request reuses the identity lattice.
+    OCIO::ConstLutValuesRcPtr lut2;
+    OCIO_CHECK_NO_THROW(lut2 = cache.getLut3D(5, OCIO::LUT3DORDER_FAST_RED, { cpu1 }, 1));
+    OCIO_CHECK_ASSERT(*lut2 == *lut);
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 1);
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 1);
+
+    // The first processor of the sequence is cached and then shared.
+    OCIO::ConstLutValuesRcPtr lut12;
+    OCIO_CHECK_NO_THROW(lut12 = cache.getLut3D(5, OCIO::LUT3DORDER_FAST_RED, { cpu1, cpu2 }, 1));
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 2);
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 2);
+
+    cpu2->apply(img);
+    OCIO_CHECK_ASSERT(*lut12 == expected);
+
+    OCIO_CHECK_NO_THROW(lut12 = cache.getLut3D(5, OCIO::LUT3DORDER_FAST_RED, { cpu1, cpu2 }, 1));
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 2);
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 4);
+    OCIO_CHECK_ASSERT(*lut12 == expected);
+
+    // Another order or size is another lattice.
+    OCIO_CHECK_NO_THROW(cache.getLut3D(5, OCIO::LUT3DORDER_FAST_BLUE, {}, 1));
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 3);
+
+    OCIO::ConstLutValuesRcPtr lut1D;
+    OCIO_CHECK_NO_THROW(lut1D = cache.getLut1D(5, { cpu2 }, 1));
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 4);
+    OCIO_REQUIRE_EQUAL(lut1D->size(), 15);
+    OCIO_CHECK_CLOSE((*lut1D)[12], 1.0f, 1e-4f);
+}
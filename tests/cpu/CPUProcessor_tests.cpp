@@ -818,7 +818,7 @@ OCIO_ADD_TEST(CPUProcessor, with_several_ops)
             const std::string cacheID{ cpuProcessor->getCacheID() };
 
             const std::string expectedID("CPU Processor: from 16ui to 32f oFlags 122879 ops"
-                ": <Lut1D $a57d7444e629d796d2234c18a0539c74 forward default standard domain none>");
+                ": <Lut1D $5fb09c83f2bac37e018cf9f93d2626e7 forward default standard domain none>");
 
             // Test integer optimization. The ops should be optimized into a single LUT
             // when finalizing with an integer input bit-depth.
@@ -2199,3 +2199,431 @@ OCIO_ADD_TEST(CPUProcessor, optimizations)
     }
 }
 
+
+OCIO_ADD_TEST(CPUProcessor, apply_parallel)
+{
+    // The unit test validates that the multi-threaded processing gives the same results
+    // as the single-threaded one for the various image buffer layouts.
+
+    constexpr long width  = 67;
+    constexpr long height = 131;
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExponentTransformRcPtr transform = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.4, 2.6, 1.0 };
+    transform->setValue(exp4);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+
+    std::vector<float> inImg(width * height * 4);
+    for (size_t idx = 0; idx < inImg.size(); ++idx)
+    {
+        inImg[idx] = float(idx) / float(inImg.size());
+    }
+
+    // 1. In-place processing of a packed RGBA F32 image.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+        std::vector<float> refImg(inImg);
+        OCIO::PackedImageDesc refDesc(&refImg[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+        for (unsigned numThreads : { 0U, 1U, 2U, 3U, 8U, 200U })
+        {
+            std::vector<float> outImg(inImg);
+            OCIO::PackedImageDesc outDesc(&outImg[0], width, height, 4);
+            OCIO_CHECK_NO_THROW(cpuProcessor->applyParallel(outDesc, numThreads));
+
+            OCIO_CHECK_ASSERT(outImg == refImg);
+        }
+    }
+
+    // 2. From a packed RGBA F32 image to a planar uint16 image.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32,
+                                                  OCIO::BIT_DEPTH_UINT16,
+                                                  OCIO::OPTIMIZATION_DEFAULT));
+
+        const OCIO::PackedImageDesc srcDesc(&inImg[0], width, height, 4);
+
+        std::vector<uint16_t> refImg(width * height * 4);
+        OCIO::PlanarImageDesc refDesc(&refImg[0],
+                                      &refImg[width * height],
+                                      &refImg[width * height * 2],
+                                      &refImg[width * height * 3],
+                                      width, height,
+                                      OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        std::vector<uint16_t> outImg(width * height * 4);
+        OCIO::PlanarImageDesc outDesc(&outImg[0],
+                                      &outImg[width * height],
+                                      &outImg[width * height * 2],
+                                      &outImg[width * height * 3],
+                                      width, height,
+                                      OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyParallel(srcDesc, outDesc, 4));
+
+        OCIO_CHECK_ASSERT(outImg == refImg);
+    }
+
+    // 3. From a packed BGR uint8 image to a packed RGBA half image.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                  OCIO::BIT_DEPTH_F16,
+                                                  OCIO::OPTIMIZATION_DEFAULT));
+
+        std::vector<uint8_t> srcImg(width * height * 3);
+        for (size_t idx = 0; idx < srcImg.size(); ++idx)
+        {
+            srcImg[idx] = uint8_t(idx % 256);
+        }
+
+        const OCIO::PackedImageDesc srcDesc(&srcImg[0], width, height,
+                                            OCIO::CHANNEL_ORDERING_BGR,
+                                            OCIO::BIT_DEPTH_UINT8,
+                                            OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+
+        std::vector<half> refImg(width * height * 4);
+        OCIO::PackedImageDesc refDesc(&refImg[0], width, height,
+                                      OCIO::CHANNEL_ORDERING_RGBA,
+                                      OCIO::BIT_DEPTH_F16,
+                                      OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        std::vector<half> outImg(width * height * 4);
+        OCIO::PackedImageDesc outDesc(&outImg[0], width, height,
+                                      OCIO::CHANNEL_ORDERING_RGBA,
+                                      OCIO::BIT_DEPTH_F16,
+                                      OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyParallel(srcDesc, outDesc, 5));
+
+        for (size_t idx = 0; idx < outImg.size(); ++idx)
+        {
+            OCIO_CHECK_EQUAL(outImg[idx].bits(), refImg[idx].bits());
+        }
+    }
+
+    // 4. Dimension inconsistency is still detected.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+        const OCIO::PackedImageDesc srcDesc(&inImg[0], width, height, 4);
+
+        std::vector<float> outImg(width * height * 4);
+        OCIO::PackedImageDesc outDesc(&outImg[0], width, height - 1, 4);
+
+        OCIO_CHECK_THROW_WHAT(cpuProcessor->applyParallel(srcDesc, outDesc, 4),
+                              OCIO::Exception,
+                              "Dimension inconsistency between source and destination image buffers.");
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, reuse_scanline_buffers)
+{
+    // The unit test validates that the intermediate buffers kept by the processor from one
+    // apply call to the next give correct results whatever the image widths.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExponentTransformRcPtr transform = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.4, 2.6, 1.0 };
+    transform->setValue(exp4);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->reserveScanlineBuffers(16));
+    OCIO_CHECK_NO_THROW(cpuProcessor->reserveScanlineBuffers(16, 0));
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->reserveScanlineBuffers(-1),
+                          OCIO::Exception,
+                          "Invalid image width for the scanline buffers.");
+
+    // Packed RGB images need the intermediate RGBA buffers.
+    for (long width : { 5L, 33L, 7L, 64L, 1L })
+    {
+        constexpr long height = 3;
+
+        std::vector<float> inImg(width * height * 3);
+        for (size_t idx = 0; idx < inImg.size(); ++idx)
+        {
+            inImg[idx] = float(idx) / float(inImg.size());
+        }
+
+        std::vector<float> refImg(inImg);
+        for (long idx = 0; idx < width * height; ++idx)
+        {
+            float pixel[4] = { refImg[idx * 3], refImg[idx * 3 + 1], refImg[idx * 3 + 2], 1.0f };
+            cpuProcessor->applyRGBA(pixel);
+            std::copy(pixel, pixel + 3, &refImg[idx * 3]);
+        }
+
+        std::vector<float> outImg(inImg);
+        OCIO::PackedImageDesc outDesc(&outImg[0], width, height, 3);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(outDesc));
+        OCIO_CHECK_ASSERT(outImg == refImg);
+
+        std::fill(outImg.begin(), outImg.end(), 0.0f);
+        const OCIO::PackedImageDesc srcDesc(&inImg[0], width, height, 3);
+        OCIO::PackedImageDesc dstDesc(&outImg[0], width, height, 3);
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyParallel(srcDesc, dstDesc, 2));
+        OCIO_CHECK_ASSERT(outImg == refImg);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, block_size)
+{
+    // The unit test validates that processing the scanlines by blocks of pixels gives the
+    // same results whatever the block size.
+
+    constexpr long width  = 1100;
+    constexpr long height = 3;
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.4, 2.6, 1.0 };
+    exponent->setValue(exp4);
+    group->appendTransform(exponent);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.5, 0.2, 0.1, 0.0,
+                                 0.1, 0.6, 0.2, 0.0,
+                                 0.0, 0.1, 0.7, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+    group->appendTransform(matrix);
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    group->appendTransform(log);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::OPTIMIZATION_NONE));
+
+    OCIO_CHECK_EQUAL(cpuProcessor->getBlockSize(), 512);
+
+    std::vector<float> inImg(width * height * 4);
+    for (size_t idx = 0; idx < inImg.size(); ++idx)
+    {
+        inImg[idx] = float(idx) / float(inImg.size());
+    }
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->setBlockSize(0));
+    OCIO_CHECK_EQUAL(cpuProcessor->getBlockSize(), 0);
+
+    std::vector<float> refImg(inImg);
+    OCIO::PackedImageDesc refDesc(&refImg[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+    for (long blockSize : { 1L, 7L, 512L, 1100L, 4096L })
+    {
+        OCIO_CHECK_NO_THROW(cpuProcessor->setBlockSize(blockSize));
+        OCIO_CHECK_EQUAL(cpuProcessor->getBlockSize(), blockSize);
+
+        std::vector<float> outImg(inImg);
+        OCIO::PackedImageDesc outDesc(&outImg[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(outDesc));
+
+        OCIO_CHECK_ASSERT(outImg == refImg);
+    }
+
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->setBlockSize(-1),
+                          OCIO::Exception,
+                          "CPU Processor: the block size cannot be negative.");
+    OCIO_CHECK_EQUAL(cpuProcessor->getBlockSize(), 4096);
+
+    cpuProcessor->setBlockSize(512);
+}
+
+OCIO_ADD_TEST(CPUProcessor, op_timings)
+{
+    constexpr long width  = 1100;
+    constexpr long height = 3;
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.4, 2.6, 1.0 };
+    exponent->setValue(exp4);
+    group->appendTransform(exponent);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.5, 0.2, 0.1, 0.0,
+                                 0.1, 0.6, 0.2, 0.0,
+                                 0.0, 0.1, 0.7, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+    group->appendTransform(matrix);
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    group->appendTransform(log);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_NONE));
+
+    // The input conversion, the first two ops and the output conversion which also
+    // processes the last op (as the output is already F32).
+    OCIO_REQUIRE_EQUAL(cpuProcessor->getNumOpTimings(), 4);
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getOpTimingName(0)), "Input 16ui");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getOpTimingName(1)), "<ExponentOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getOpTimingName(2)), "<MatrixOffsetOp>");
+    OCIO_CHECK_EQUAL(std::string(cpuProcessor->getOpTimingName(3)), "Output 32f: <LogOp>");
+
+    std::vector<uint16_t> inImg(width * height * 4);
+    for (size_t idx = 0; idx < inImg.size(); ++idx)
+    {
+        inImg[idx] = uint16_t(idx);
+    }
+    std::vector<float> outImg(inImg.size());
+
+    OCIO::PackedImageDesc inDesc(&inImg[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                 OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc outDesc(&outImg[0], width, height, 4);
+
+    // The timing is disabled by default.
+
+    OCIO_CHECK_ASSERT(!cpuProcessor->isOpTimingEnabled());
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(inDesc, outDesc));
+    for (int idx = 0; idx < cpuProcessor->getNumOpTimings(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumCalls(idx), 0ULL);
+        OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumPixels(idx), 0ULL);
+        OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNanoseconds(idx), 0ULL);
+    }
+
+    const std::vector<float> refImg(outImg);
+
+    // The timing does not change the results.
+
+    OCIO::ConstCPUProcessorRcPtr defaultProcessor = cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getTimedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32,
+                                          OCIO::OPTIMIZATION_NONE));
+    OCIO_CHECK_ASSERT(cpuProcessor->isOpTimingEnabled());
+    OCIO_REQUIRE_EQUAL(cpuProcessor->getNumOpTimings(), 4);
+
+    std::fill(outImg.begin(), outImg.end(), 0.f);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(inDesc, outDesc));
+    OCIO_CHECK_ASSERT(outImg == refImg);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->applyParallel(inDesc, outDesc, 2));
+    OCIO_CHECK_ASSERT(outImg == refImg);
+
+    // The scanlines are processed by blocks of 512 pixels i.e. 3 blocks per scanline.
+
+    OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumCalls(0), 2ULL * height);
+    OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumCalls(1), 2ULL * height * 3);
+    OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumCalls(2), 2ULL * height * 3);
+    OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumCalls(3), 2ULL * height);
+
+    for (int idx = 0; idx < cpuProcessor->getNumOpTimings(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumPixels(idx), 2ULL * width * height);
+    }
+
+    // The timed instances are never shared i.e. neither with the cached processor nor
+    // between callers.
+
+    OCIO_CHECK_ASSERT(!defaultProcessor->isOpTimingEnabled());
+    OCIO_CHECK_EQUAL(defaultProcessor->getOpTimingNumCalls(1), 0ULL);
+
+    OCIO::ConstCPUProcessorRcPtr otherProcessor;
+    OCIO_CHECK_NO_THROW(otherProcessor
+        = processor->getTimedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32,
+                                          OCIO::OPTIMIZATION_NONE));
+    OCIO_CHECK_NE(otherProcessor.get(), cpuProcessor.get());
+    OCIO_CHECK_EQUAL(otherProcessor->getOpTimingNumCalls(1), 0ULL);
+    OCIO_CHECK_NO_THROW(otherProcessor->apply(inDesc, outDesc));
+    OCIO_CHECK_EQUAL(otherProcessor->getOpTimingNumCalls(1), 1ULL * height * 3);
+    OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumCalls(1), 2ULL * height * 3);
+
+    std::ostringstream oss;
+    OCIO_CHECK_NO_THROW(cpuProcessor->serializeOpTimings(oss));
+    const std::string report = oss.str();
+    OCIO_CHECK_NE(report.find("CPU Processor ops:\n"), std::string::npos);
+    OCIO_CHECK_NE(report.find("    Op 1: <MatrixOffsetOp>"), std::string::npos);
+    OCIO_CHECK_NE(report.find("CPU Processor op timings:\n"), std::string::npos);
+    OCIO_CHECK_NE(report.find("    <MatrixOffsetOp> calls:18 pixels:6600 ns:"), std::string::npos);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->resetOpTimings());
+    for (int idx = 0; idx < cpuProcessor->getNumOpTimings(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumCalls(idx), 0ULL);
+        OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNumPixels(idx), 0ULL);
+        OCIO_CHECK_EQUAL(cpuProcessor->getOpTimingNanoseconds(idx), 0ULL);
+    }
+
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->getOpTimingName(4),
+                          OCIO::Exception,
+                          "CPU Processor: invalid op timing index 4 where the number of op "
+                          "timings is 4.");
+}
+
+OCIO_ADD_TEST(CPUProcessor, separable_prefix_f32_accuracy)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exponent->setValue(exp4);
+    group->appendTransform(exponent);
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    group->appendTransform(log);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    float maxError = -1.f;
+    float maxErrorInput = -1.f;
+    bool replaced = true;
+
+    // The optimization is not part of the optimization levels.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::OPTIMIZATION_ALL));
+    OCIO_CHECK_ASSERT(!cpuProcessor->getSeparablePrefixF32Accuracy(maxError,
+                                                                    maxErrorInput,
+                                                                    replaced));
+
+    const OCIO::OptimizationFlags flags
+        = static_cast<OCIO::OptimizationFlags>(OCIO::OPTIMIZATION_DEFAULT
+                                               | OCIO::OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32);
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getOptimizedCPUProcessor(flags));
+    OCIO_CHECK_ASSERT(cpuProcessor->getSeparablePrefixF32Accuracy(maxError,
+                                                                   maxErrorInput,
+                                                                   replaced));
+    OCIO_CHECK_ASSERT(replaced);
+    OCIO_CHECK_ASSERT(maxError >= 0.f);
+    OCIO_CHECK_LE(maxError, 1e-4f);
+}
@@ -3,6 +3,12 @@
 
 
 #include <sys/stat.h>
+#include <thread>
+#ifndef _WIN32
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
 
 #include "Config.cpp"
 #include "utils/StringUtils.h"
@@ -3280,12 +3286,18 @@ OCIO_ADD_TEST(Config, inactive_color_space)
     OCIO_CHECK_EQUAL(config->getIndexForColorSpace("scene_linear"), 1);
     OCIO_CHECK_EQUAL(config->getIndexForColorSpace("lnh"), 1);
 
+    OCIO_CHECK_EQUAL(std::string(config->parseColorSpaceFromString("/a/cs2_cs1.exr")), "cs1");
+
 
     // Step 2 - Some inactive color spaces.
 
     OCIO_CHECK_NO_THROW(config->setInactiveColorSpaces("lnh, cs1"));
     OCIO_CHECK_EQUAL(config->getInactiveColorSpaces(), std::string("lnh, cs1"));
 
+    // Only the active color spaces are found in the strings.
+    OCIO_CHECK_EQUAL(std::string(config->parseColorSpaceFromString("/a/cs2_cs1.exr")), "cs2");
+    OCIO_CHECK_EQUAL(std::string(config->parseColorSpaceFromString("/a/cs1.exr")), "");
+
     OCIO_REQUIRE_EQUAL(config->getNumColorSpaces(OCIO::SEARCH_REFERENCE_SPACE_ALL,
                                                  OCIO::COLORSPACE_INACTIVE), 2);
     OCIO_REQUIRE_EQUAL(config->getNumColorSpaces(OCIO::SEARCH_REFERENCE_SPACE_ALL,
@@ -4671,3 +4683,533 @@ colorspaces:
         OCIO_CHECK_EQUAL(oss.str(), CONFIG_BUILTIN_TRANSFORMS);
     }
 }
+
+OCIO_ADD_TEST(Config, processor_cache)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+
+    auto cs = OCIO::ColorSpace::Create();
+    cs->setName("cs1");
+    auto mat = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0. };
+    mat->setOffset(offset);
+    cs->setTransform(mat, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    config->addColorSpace(cs);
+
+    OCIO_CHECK_ASSERT(config->isProcessorCacheEnabled());
+    OCIO_CHECK_EQUAL(config->getProcessorCacheSize(), 256);
+
+    // The same request returns the same processor.
+
+    OCIO::ConstProcessorRcPtr proc1 = config->getProcessor("raw", "cs1");
+    OCIO::ConstProcessorRcPtr proc2 = config->getProcessor("raw", "cs1");
+    OCIO_CHECK_EQUAL(proc1.get(), proc2.get());
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumMisses(), 1);
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumHits(), 1);
+
+    OCIO::ConstProcessorRcPtr proc3 = config->getProcessor("cs1", "raw");
+    OCIO_CHECK_NE(proc1.get(), proc3.get());
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumMisses(), 2);
+
+    // Requests using a transform.
+
+    proc1 = config->getProcessor(mat, OCIO::TRANSFORM_DIR_FORWARD);
+    proc2 = config->getProcessor(mat, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(proc1.get(), proc2.get());
+    proc2 = config->getProcessor(mat, OCIO::TRANSFORM_DIR_INVERSE);
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    auto mat2 = OCIO::DynamicPtrCast<OCIO::MatrixTransform>(mat->createEditableCopy());
+    proc2 = config->getProcessor(mat2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_EQUAL(proc1.get(), proc2.get());
+
+    // Any change of the transform or of its metadata is a different request.
+
+    const double offset2[4] = { 0.1, 0.2, 0.3 + 1e-12, 0. };
+    mat2->setOffset(offset2);
+    proc2 = config->getProcessor(mat2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    mat2 = OCIO::DynamicPtrCast<OCIO::MatrixTransform>(mat->createEditableCopy());
+    mat2->getFormatMetadata().addAttribute(OCIO::METADATA_ID, "id1");
+    proc2 = config->getProcessor(mat2, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+    OCIO_CHECK_EQUAL(std::string(proc2->getTransformFormatMetadata(0).getAttributeValue(0)),
+                     "id1");
+
+    // Editing the config invalidates the cached processors.
+
+    proc1 = config->getProcessor("raw", "cs1");
+    config->setDescription("new description");
+    proc2 = config->getProcessor("raw", "cs1");
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    // So does ClearAllCaches().
+
+    proc1 = config->getProcessor("raw", "cs1");
+    OCIO::ClearAllCaches();
+    proc2 = config->getProcessor("raw", "cs1");
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    // Processors with dynamic properties are never shared.
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->makeExposureDynamic();
+    proc1 = config->getProcessor(ec);
+    proc2 = config->getProcessor(ec);
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    ec = OCIO::ExposureContrastTransform::Create();
+    proc1 = config->getProcessor(ec);
+    proc2 = config->getProcessor(ec);
+    OCIO_CHECK_EQUAL(proc1.get(), proc2.get());
+
+    // LUT transforms are never cached.
+
+    auto lut = OCIO::Lut1DTransform::Create();
+    proc1 = config->getProcessor(lut);
+    lut->setValue(0, 0.5f, 0.5f, 0.5f);
+    proc2 = config->getProcessor(lut);
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+
+    OCIO_CHECK_THROW_WHAT(config->getProcessor(OCIO::ConstTransformRcPtr()),
+                          OCIO::Exception, "transform is null");
+
+    // Cache size and clear.
+
+    config->clearProcessorCache();
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumHits(), 0);
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumMisses(), 0);
+
+    config->setProcessorCacheSize(1);
+    OCIO_CHECK_EQUAL(config->getProcessorCacheSize(), 1);
+    proc1 = config->getProcessor("raw", "cs1");
+    proc2 = config->getProcessor("cs1", "raw");
+    proc3 = config->getProcessor("raw", "cs1");
+    OCIO_CHECK_NE(proc1.get(), proc3.get());
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumHits(), 0);
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumMisses(), 3);
+
+    // Disabled cache.
+
+    config->setProcessorCacheEnabled(false);
+    OCIO_CHECK_ASSERT(!config->isProcessorCacheEnabled());
+    proc1 = config->getProcessor("raw", "cs1");
+    proc2 = config->getProcessor("raw", "cs1");
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+    OCIO_CHECK_EQUAL(config->getProcessorCacheNumHits(), 0);
+
+    // Copies share the settings but not the cached processors.
+
+    OCIO::ConfigRcPtr copy = config->createEditableCopy();
+    OCIO_CHECK_ASSERT(!copy->isProcessorCacheEnabled());
+    OCIO_CHECK_EQUAL(copy->getProcessorCacheSize(), 1);
+}
+
+OCIO_ADD_TEST(Config, concurrent_reads)
+{
+    constexpr char SIMPLE_CONFIG[] { R"(
+        ocio_profile_version: 2
+
+        search_path: luts
+
+        roles:
+          default: raw
+
+        active_displays: [sRGB_B, sRGB_A]
+        active_views: [View_1, View_2]
+
+        displays:
+          sRGB_A:
+            - !<View> {name: View_3, colorspace: raw}
+            - !<View> {name: View_1, colorspace: raw}
+          sRGB_B:
+            - !<View> {name: View_2, colorspace: raw}
+            - !<View> {name: View_1, colorspace: raw}
+          sRGB_C:
+            - !<View> {name: View_1, colorspace: raw}
+
+        colorspaces:
+          - !<ColorSpace>
+            name: raw
+            allocation: uniform
+
+          - !<ColorSpace>
+            name: lut
+            from_reference: !<FileTransform> {src: lut1d_green.ctf}
+        )" };
+
+    std::istringstream is(SIMPLE_CONFIG);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO_REQUIRE_ASSERT(config);
+
+    // Compute the expected values with a copy so that the tested config starts with
+    // empty caches.
+
+    OCIO::ConstConfigRcPtr ref = config->createEditableCopy();
+
+    constexpr int numThreads = 8;
+
+    std::vector<OCIO::ConstContextRcPtr> contexts;
+    std::vector<std::string> refCacheIDs;
+    for (int idx = 0; idx < numThreads; ++idx)
+    {
+        OCIO::ContextRcPtr context = config->getCurrentContext()->createEditableCopy();
+        context->setStringVar("SHOT", std::to_string(idx % 4).c_str());
+        contexts.push_back(context);
+        refCacheIDs.push_back(ref->getCacheID(context));
+    }
+
+    OCIO_CHECK_EQUAL(refCacheIDs[0], refCacheIDs[4]);
+
+    OCIO_REQUIRE_EQUAL(ref->getNumDisplays(), 2);
+    OCIO_CHECK_EQUAL(std::string(ref->getDisplay(0)), "sRGB_B");
+    OCIO_CHECK_EQUAL(std::string(ref->getDisplay(1)), "sRGB_A");
+    OCIO_REQUIRE_EQUAL(ref->getNumViews("srgb_b"), 2);
+    OCIO_CHECK_EQUAL(std::string(ref->getView("sRGB_B", 0)), "View_1");
+    OCIO_CHECK_EQUAL(std::string(ref->getView("sRGB_B", 1)), "View_2");
+    OCIO_CHECK_EQUAL(ref->getNumViews("sRGB_A"), 1);
+    // Views of inactive displays are available.
+    OCIO_CHECK_EQUAL(ref->getNumViews("sRGB_C"), 1);
+    OCIO_CHECK_EQUAL(ref->getNumViews("sRGB_D"), 0);
+    OCIO_CHECK_EQUAL(std::string(ref->getView("sRGB_D", 0)), "");
+
+    // All the threads concurrently fill the caches of the same config.
+
+    std::vector<int> numErrors(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (int idx = 0; idx < numThreads; ++idx)
+    {
+        threads.emplace_back([&, idx]()
+        {
+            for (int iter = 0; iter < 100; ++iter)
+            {
+                const int ctxIdx = (idx + iter) % numThreads;
+                if (refCacheIDs[ctxIdx] != config->getCacheID(contexts[ctxIdx]))
+                {
+                    ++numErrors[idx];
+                }
+
+                if (config->getNumDisplays() != ref->getNumDisplays()
+                    || std::string(config->getDisplay(iter % 2)) != ref->getDisplay(iter % 2)
+                    || config->getNumViews("sRGB_B") != 2
+                    || std::string(config->getView("sRGB_B", iter % 2))
+                        != ref->getView("sRGB_B", iter % 2))
+                {
+                    ++numErrors[idx];
+                }
+            }
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int idx = 0; idx < numThreads; ++idx)
+    {
+        OCIO_CHECK_EQUAL(numErrors[idx], 0);
+    }
+
+    // The returned cache IDs stay valid while new ones are added.
+
+    const char * cacheID = config->getCacheID(contexts[0]);
+    OCIO::ContextRcPtr context = contexts[0]->createEditableCopy();
+    context->setStringVar("SHOT", "new");
+    OCIO_CHECK_EQUAL(std::string(config->getCacheID(context)), refCacheIDs[0]);
+    OCIO_CHECK_EQUAL(config->getCacheID(contexts[0]), cacheID);
+    OCIO_CHECK_EQUAL(std::string(cacheID), refCacheIDs[0]);
+
+    // A config change resets the snapshots.
+
+    OCIO::ConfigRcPtr editable = config->createEditableCopy();
+    const std::string cacheIDBefore = editable->getCacheID(contexts[0]);
+    OCIO_CHECK_EQUAL(cacheIDBefore, refCacheIDs[0]);
+    OCIO_CHECK_EQUAL(editable->getNumViews("sRGB_B"), 2);
+
+    editable->setActiveViews("View_2");
+    OCIO_CHECK_EQUAL(std::string(editable->getActiveViews()), "View_2");
+    OCIO_CHECK_NE(std::string(editable->getCacheID(contexts[0])), cacheIDBefore);
+    OCIO_REQUIRE_EQUAL(editable->getNumViews("sRGB_B"), 1);
+    OCIO_CHECK_EQUAL(std::string(editable->getView("sRGB_B", 0)), "View_2");
+
+    editable->setActiveDisplays("sRGB_C");
+    OCIO_CHECK_EQUAL(std::string(editable->getActiveDisplays()), "sRGB_C");
+    OCIO_REQUIRE_EQUAL(editable->getNumDisplays(), 1);
+    OCIO_CHECK_EQUAL(std::string(editable->getDisplay(0)), "sRGB_C");
+}
+
+OCIO_ADD_TEST(Config, display_cache_view_mutations)
+{
+    // Adding views to an existing display resets the display snapshot which holds pointers
+    // to the views.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO_CHECK_NO_THROW(config->addDisplayView("disp", "view_0", "raw", ""));
+
+    // Fill the display snapshot.
+    OCIO_REQUIRE_EQUAL(config->getNumViews("disp"), 1);
+    OCIO_CHECK_EQUAL(std::string(config->getView("disp", 0)), "view_0");
+
+    // Enough views to reallocate the view list of the display.
+    for (int idx = 1; idx < 39; ++idx)
+    {
+        const std::string view = "view_" + std::to_string(idx);
+        OCIO_CHECK_NO_THROW(config->addDisplayView("disp", view.c_str(), "raw", ""));
+
+        OCIO_REQUIRE_EQUAL(config->getNumViews("disp"), idx + 1);
+        OCIO_CHECK_EQUAL(std::string(config->getView("disp", idx)), view);
+    }
+
+    for (int idx = 0; idx < 39; ++idx)
+    {
+        OCIO_CHECK_EQUAL(std::string(config->getView("disp", idx)),
+                         "view_" + std::to_string(idx));
+    }
+
+    // Same with a shared view.
+
+    OCIO_CHECK_NO_THROW(config->addSharedView("shared", "", "raw", "", "", ""));
+    OCIO_CHECK_NO_THROW(config->addDisplaySharedView("disp", "shared"));
+    OCIO_REQUIRE_EQUAL(config->getNumViews("disp"), 40);
+    OCIO_CHECK_EQUAL(std::string(config->getView("disp", 39)), "shared");
+}
+
+OCIO_ADD_TEST(Config, prefetch_files)
+{
+    const std::string configStr =
+        "ocio_profile_version: 2\n"
+        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "displays:\n"
+        "  disp:\n"
+        "    - !<View> {name: view, colorspace: raw, looks: look}\n"
+        "looks:\n"
+        "  - !<Look>\n"
+        "    name: look\n"
+        "    process_space: raw\n"
+        "    transform: !<FileTransform> {src: lustre_33x33x33.3dl, interpolation: linear}\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs1\n"
+        "    from_reference: !<GroupTransform>\n"
+        "      children:\n"
+        "        - !<FileTransform> {src: lut1d_green.ctf}\n"
+        "        - !<FileTransform> {src: $SHOT.ctf}\n"
+        "        - !<FileTransform> {src: missing.ctf}\n";
+
+    std::istringstream is(configStr);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO_REQUIRE_ASSERT(config);
+
+    OCIO::ClearAllCaches();
+
+    // The unresolved & missing files are skipped.
+    std::future<void> done = config->prefetchFiles(OCIO::ConstContextRcPtr());
+    OCIO_CHECK_NO_THROW(done.get());
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumEntries(), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 2);
+
+    // The files are then read from the cache.
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor("raw", "disp", "view"));
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumHits(), 1);
+
+    // The context is used to resolve the file paths.
+    OCIO::ContextRcPtr context = config->getCurrentContext()->createEditableCopy();
+    context->setStringVar("SHOT", "lut1d_green");
+    done = config->prefetchFiles(context);
+    // The files are resolved in the background from a copy of the context.
+    context->setStringVar("SHOT", "missing");
+    done.wait();
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumEntries(), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumHits(), 3);
+
+    OCIO::ClearAllCaches();
+}
+
+#ifndef _WIN32
+namespace
+{
+std::vector<std::string> ListDirectory(const std::string & dirname)
+{
+    std::vector<std::string> filenames;
+    if (DIR * dir = opendir(dirname.c_str()))
+    {
+        while (const dirent * entry = readdir(dir))
+        {
+            const std::string filename(entry->d_name);
+            if (filename != "." && filename != "..")
+            {
+                filenames.push_back(filename);
+            }
+        }
+        closedir(dir);
+    }
+    return filenames;
+}
+}
+
+OCIO_ADD_TEST(Config, processor_disk_cache)
+{
+    const std::string configStr =
+        "ocio_profile_version: 2\n"
+        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "displays:\n"
+        "  disp:\n"
+        "    - !<View> {name: view, colorspace: raw}\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs1\n"
+        "    from_reference: !<GroupTransform>\n"
+        "      children:\n"
+        "        - !<FileTransform> {src: lut1d_green.ctf}\n"
+        "        - !<MatrixTransform> {offset: [0.1, 0.2, 0.3, 0]}\n";
+
+    char dirTemplate[] = "/tmp/ocio_proc_cache_XXXXXX";
+    OCIO_REQUIRE_ASSERT(mkdtemp(dirTemplate));
+    const std::string dirname(dirTemplate);
+
+    std::istringstream is(configStr);
+    OCIO::ConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is)->createEditableCopy());
+    OCIO_CHECK_EQUAL(std::string(config->getProcessorCacheDirectory()), "");
+    config->setProcessorCacheDirectory(dirname.c_str());
+    OCIO_CHECK_EQUAL(std::string(config->getProcessorCacheDirectory()), dirname);
+
+    OCIO::ClearAllCaches();
+
+    // A newly built processor is written to the directory.
+
+    OCIO::ConstProcessorRcPtr proc1;
+    OCIO_CHECK_NO_THROW(proc1 = config->getProcessor("raw", "cs1"));
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 1);
+
+    const std::vector<std::string> filenames = ListDirectory(dirname);
+    OCIO_REQUIRE_EQUAL(filenames.size(), 1);
+    OCIO_CHECK_ASSERT(StringUtils::EndsWith(filenames[0], ".ocioproc"));
+    const std::string filepath = pystring::os::path::join(dirname, filenames[0]);
+
+    // Another config instance (i.e. with an empty memory cache) reads it back without
+    // loading the LUT file.
+
+    OCIO::ClearAllCaches();
+
+    is.clear();
+    is.str(configStr);
+    OCIO::ConfigRcPtr config2;
+    OCIO_CHECK_NO_THROW(config2 = OCIO::Config::CreateFromStream(is)->createEditableCopy());
+    config2->setProcessorCacheDirectory(dirname.c_str());
+
+    OCIO::ConstProcessorRcPtr proc2;
+    OCIO_CHECK_NO_THROW(proc2 = config2->getProcessor("raw", "cs1"));
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 0);
+    OCIO_CHECK_EQUAL(std::string(proc1->getCacheID()), std::string(proc2->getCacheID()));
+    OCIO_CHECK_EQUAL(proc1->getNumTransforms(), proc2->getNumTransforms());
+    OCIO_CHECK_EQUAL(proc1->getProcessorMetadata()->getNumFiles(),
+                     proc2->getProcessorMetadata()->getNumFiles());
+
+    float pixel1[4] = { 0.25f, 0.5f, 0.75f, 1.f };
+    float pixel2[4] = { 0.25f, 0.5f, 0.75f, 1.f };
+    proc1->getDefaultCPUProcessor()->applyRGBA(pixel1);
+    proc2->getDefaultCPUProcessor()->applyRGBA(pixel2);
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        OCIO_CHECK_EQUAL(pixel1[idx], pixel2[idx]);
+    }
+
+    // The memory cache is still used first.
+    OCIO_CHECK_EQUAL(config2->getProcessor("raw", "cs1").get(), proc2.get());
+
+    // A corrupted file is ignored and replaced.
+
+    {
+        std::ofstream os(filepath, std::ios_base::out | std::ios_base::binary);
+        os << "OCIOBOPS garbage";
+    }
+
+    OCIO::ClearAllCaches();
+
+    OCIO::ConstProcessorRcPtr proc3;
+    OCIO_CHECK_NO_THROW(proc3 = config2->getProcessor("raw", "cs1"));
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 1);
+    OCIO_CHECK_EQUAL(std::string(proc1->getCacheID()), std::string(proc3->getCacheID()));
+
+    {
+        std::ifstream is(filepath, std::ios_base::in | std::ios_base::binary);
+        OCIO_CHECK_NO_THROW(proc3 = OCIO::Processor::CreateFromStream(is));
+        OCIO_CHECK_EQUAL(std::string(proc1->getCacheID()), std::string(proc3->getCacheID()));
+    }
+
+    // An unusable directory only disables the disk cache.
+
+    config2->setProcessorCacheDirectory((dirname + "/missing").c_str());
+    config2->clearProcessorCache();
+    OCIO_CHECK_NO_THROW(proc3 = config2->getProcessor("raw", "cs1"));
+    OCIO_CHECK_EQUAL(ListDirectory(dirname).size(), 1);
+    config2->setProcessorCacheDirectory(dirname.c_str());
+
+    std::remove(filepath.c_str());
+
+    // A file only referenced by the requested transform is part of the key.
+
+    const std::string lutPath = pystring::os::path::join(dirname, "request.spi1d");
+    const auto writeLut = [&lutPath](float maxValue, time_t mtime)
+    {
+        {
+            std::ofstream os(lutPath);
+            os << "Version 1\nFrom 0.0 1.0\nLength 2\nComponents 1\n{\n0.0\n"
+               << maxValue << "\n}\n";
+        }
+        struct utimbuf times;
+        times.actime  = mtime;
+        times.modtime = mtime;
+        utime(lutPath.c_str(), &times);
+    };
+
+    OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+    fileTransform->setSrc(lutPath.c_str());
+    fileTransform->setInterpolation(OCIO::INTERP_LINEAR);
+
+    writeLut(1.f, 1000000000);
+    OCIO::ClearAllCaches();
+
+    OCIO::ConstProcessorRcPtr proc4;
+    OCIO_CHECK_NO_THROW(proc4 = config2->getProcessor(fileTransform));
+    OCIO_CHECK_EQUAL(ListDirectory(dirname).size(), 2);
+
+    float pixel4[4] = { 1.f, 1.f, 1.f, 1.f };
+    proc4->getDefaultCPUProcessor()->applyRGBA(pixel4);
+    OCIO_CHECK_CLOSE(pixel4[0], 1.f, 1e-6f);
+
+    writeLut(0.5f, 1000000010);
+    OCIO::ClearAllCaches();
+
+    OCIO_CHECK_NO_THROW(proc4 = config2->getProcessor(fileTransform));
+    OCIO_CHECK_EQUAL(ListDirectory(dirname).size(), 3);
+
+    pixel4[0] = 1.f;
+    proc4->getDefaultCPUProcessor()->applyRGBA(pixel4);
+    OCIO_CHECK_CLOSE(pixel4[0], 0.5f, 1e-6f);
+
+    for (const auto & filename : ListDirectory(dirname))
+    {
+        std::remove(pystring::os::path::join(dirname, filename).c_str());
+    }
+    rmdir(dirname.c_str());
+
+    OCIO::ClearAllCaches();
+}
+#endif
@@ -3,6 +3,10 @@
 
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+#include <thread>
 
 #include "Context.cpp"
 
@@ -146,3 +150,90 @@ OCIO_ADD_TEST(Context, use_searchpaths_workingdir)
                              SanitizePath(res2.c_str()).c_str()) == 0);
 }
 
+
+#ifndef _WIN32
+OCIO_ADD_TEST(Context, resolve_directory_index)
+{
+    char dirTemplate[] = "/tmp/ocio_context_XXXXXX";
+    OCIO_REQUIRE_ASSERT(mkdtemp(dirTemplate));
+    const std::string dirname(dirTemplate);
+
+    const std::string dir1 = dirname + "/dir1";
+    const std::string dir2 = dirname + "/dir2";
+    const std::string subdir = dir2 + "/sub";
+    OCIO_REQUIRE_EQUAL(mkdir(dir1.c_str(), 0777), 0);
+    OCIO_REQUIRE_EQUAL(mkdir(dir2.c_str(), 0777), 0);
+    OCIO_REQUIRE_EQUAL(mkdir(subdir.c_str(), 0777), 0);
+
+    const std::string fileA = dir2 + "/a.lut";
+    const std::string fileB = dir1 + "/b.lut";
+    const std::string fileC = subdir + "/c.lut";
+    std::ofstream(fileA) << "a";
+    std::ofstream(fileC) << "c";
+
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    context->setWorkingDir(dirname.c_str());
+    context->addSearchPath("dir1");
+    context->addSearchPath(dir2.c_str());
+    context->addSearchPath("missing");
+
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation("a.lut")), fileA);
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation("sub/c.lut")), fileC);
+
+    // The error lists all the attempts.
+    OCIO_CHECK_THROW_WHAT(context->resolveFileLocation("b.lut"), OCIO::ExceptionMissingFile,
+                          "The following attempts were made: '" + fileB + "' : '"
+                          + dir2 + "/b.lut' : '" + dirname + "/missing/b.lut'.");
+
+    // The change of the directory is detected, and the new file has the priority.
+    std::ofstream(fileB) << "b";
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation("b.lut")), fileB);
+    std::ofstream(dir1 + "/a.lut") << "a";
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation("a.lut")), fileA);
+    context->setSearchPath((dir1 + ":" + dir2).c_str());
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation("a.lut")), dir1 + "/a.lut");
+
+    // Like the default file systems, the lookup is case-insensitive on macOS i.e. the search
+    // path order wins over an exact case match.
+    std::ofstream(dir1 + "/LUT.cube") << "d";
+    std::ofstream(dir2 + "/lut.cube") << "d";
+#ifdef __APPLE__
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation("lut.cube")), dir1 + "/lut.cube");
+#else
+    OCIO_CHECK_EQUAL(std::string(context->resolveFileLocation("lut.cube")), dir2 + "/lut.cube");
+#endif
+
+    // Resolve the same files from several threads.
+    context->setSearchPath(("missing:" + dir2 + ":" + dir1).c_str());
+    std::vector<std::string> results(8);
+    std::vector<std::thread> threads;
+    for (size_t idx = 0; idx < results.size(); ++idx)
+    {
+        threads.emplace_back([&context, &results, idx]()
+        {
+            results[idx] = std::string(context->resolveFileLocation("a.lut"))
+                           + context->resolveFileLocation("b.lut")
+                           + context->resolveFileLocation("sub/c.lut");
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto & result : results)
+    {
+        OCIO_CHECK_EQUAL(result, fileA + fileB + fileC);
+    }
+
+    std::remove(fileA.c_str());
+    std::remove(fileB.c_str());
+    std::remove(fileC.c_str());
+    std::remove((dir1 + "/a.lut").c_str());
+    std::remove((dir1 + "/LUT.cube").c_str());
+    std::remove((dir2 + "/lut.cube").c_str());
+    std::remove(subdir.c_str());
+    std::remove(dir1.c_str());
+    std::remove(dir2.c_str());
+    std::remove(dirname.c_str());
+}
+#endif
@@ -1300,3 +1300,145 @@ OCIO_ADD_TEST(FileRules, clone)
     OCIO_CHECK_NO_THROW(fileRules->setPattern(0, "*"));
     OCIO_CHECK_EQUAL(std::string(newFileRules->getPattern(0)), std::string(fileRules->getPattern(0)));
 }
+
+OCIO_ADD_TEST(FileRules, path_automaton)
+{
+    // The automaton gives the same results as std::regex for all the glob patterns and the
+    // simple regular expressions.
+    const std::vector<std::pair<std::string, std::string>> globs = {
+        { "*", "exr" }, { "", "" }, { "*/plates/*", "dpx" }, { "*Col?r*", "" },
+        { "*_[0-9][0-9][0-9][0-9]", "[eE][xX][rR]" }, { "*[!a-c]", "tif*" },
+        { "*.1.*", "exr" }, { "?*", "?" }, { "/mnt/[a-z]*/raw_*", "jpg" },
+        { "*[\\.\\?]*", "" }, { "*(x+y)*", "EXR" }, { "image^$", "dpx" }
+    };
+
+    const std::vector<std::string> regexes = {
+        ".*cs5.dpx", "^abc.*$", "(.*)(mine)(.*)", "[^/]+/[^/]+\\.exr",
+        "a?b+c*", "(a)(b)", "x\\.y[-_]z", "[a-]+", "[-a-c]+.*",
+        // Unsupported syntax, matched with std::regex.
+        "(.*)(\\bmine\\b|\\byours\\b)(.*)", "\\d+\\.exr", "(ab)*", "(a)(b)?", "a{2}.*",
+        ".*?exr"
+    };
+
+    const std::vector<std::string> paths = {
+        "", "a", "ab", "abc", "aabbc", "b", "x.y_z", "x.y-z", "xy_z", "a-a-b", "-a",
+        "/mnt/media/image.exr", "/mnt/media/image.EXR", "/mnt/media/image.eXr",
+        "/mnt/media/image.exr.bak", "/mnt/media/image_0001.exr", "/mnt/media/image_001.exr",
+        "/show/plates/shot.dpx", "/show/plates/shot.DPX", "/show/platesshot.dpx",
+        "/mnt/user/raw_image.jpg", "/mnt/User/raw_image.jpg", "/mnt/user/image.jpg",
+        "Color Management/marci.1.0v4.exr", "Colour/image.tif", "image.tiff", "image.tib",
+        "cs5.dpx", "/mnt/cs5xdpx", "line\nbreak.exr", "mine/yours.exr", "dir/file.exr",
+        "dir/sub/file.exr", "1234.exr", "image(x+y).EXR", "image^$.dpx", "a.b", "a?b.c",
+        "x.y\xc3\xa9z", "\xc3\xa9.exr"
+    };
+
+    std::vector<std::string> expressions;
+    for (const auto & glob : globs)
+    {
+        expressions.push_back(OCIO::BuildRegularExpression(glob.first.c_str(),
+                                                           glob.second.c_str()));
+    }
+    expressions.insert(expressions.end(), regexes.begin(), regexes.end());
+
+    size_t numUnsupported = 0;
+    for (const auto & exp : expressions)
+    {
+        OCIO::PathAutomaton automaton;
+        if (!automaton.add(exp, 3))
+        {
+            ++numUnsupported;
+            continue;
+        }
+        automaton.finalize();
+
+        const std::regex reg(exp);
+        for (const auto & path : paths)
+        {
+            const bool expected = std::regex_match(path.c_str(), reg);
+            OCIO_CHECK_EQUAL(automaton.match(path.c_str()), expected ? 3 : -1);
+        }
+    }
+    OCIO_CHECK_EQUAL(numUnsupported, 6);
+
+    // All the expressions at once give the first matching one.
+    OCIO::PathAutomaton automaton;
+    std::vector<int> ruleIndices;
+    for (size_t idx = 0; idx < expressions.size(); ++idx)
+    {
+        if (automaton.add(expressions[idx], (int)idx))
+        {
+            ruleIndices.push_back((int)idx);
+        }
+    }
+    automaton.finalize();
+
+    for (const auto & path : paths)
+    {
+        int expected = -1;
+        for (int idx : ruleIndices)
+        {
+            if (std::regex_match(path.c_str(), std::regex(expressions[idx])))
+            {
+                expected = idx;
+                break;
+            }
+        }
+        OCIO_CHECK_EQUAL(automaton.match(path.c_str()), expected);
+    }
+}
+
+OCIO_ADD_TEST(FileRules, batch_classification)
+{
+    std::istringstream is;
+    is.str(g_config);
+    OCIO::ConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is)->createEditableCopy());
+    auto rules = config->getFileRules()->createEditableCopy();
+    rules->insertRule(0, "pattern dpx file", "raw", "*cs2*", "dpx");
+    rules->insertRule(1, "regex rule", "cs2", "(.*)(\\bmine\\b)(.*)");
+    rules->insertRule(2, OCIO::FileRuleUtils::ParseName, nullptr, nullptr);
+    rules->insertRule(3, "exr file", "cs1", "", "exr");
+    config->setFileRules(rules);
+
+    const std::vector<const char *> paths = {
+        "/mnt/media/cs2.dpx", "/mnt/mine/image.dpx", "/mnt/media/img_other_cs1.dpx",
+        "/mnt/media/image.exr", "/mnt/media/image.jpg", "/mnt/media/cs2_image.tif"
+    };
+    const std::vector<size_t> expectedRules = { 0, 1, 2, 3, 4, 2 };
+    const std::vector<std::string> expectedColorSpaces = {
+        "raw", "cs2", "other_cs1", "cs1", OCIO::ROLE_DEFAULT, "cs2"
+    };
+
+    std::vector<const char *> colorSpaces(paths.size(), nullptr);
+    std::vector<size_t> ruleIndices(paths.size(), 0);
+    OCIO_CHECK_NO_THROW(config->getColorSpacesFromFilepaths(paths.data(), paths.size(),
+                                                            colorSpaces.data(),
+                                                            ruleIndices.data()));
+
+    for (size_t idx = 0; idx < paths.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(ruleIndices[idx], expectedRules[idx]);
+        OCIO_CHECK_EQUAL(std::string(colorSpaces[idx]), expectedColorSpaces[idx]);
+
+        size_t rulePos = 0;
+        const std::string colorSpace = config->getColorSpaceFromFilepath(paths[idx], rulePos);
+        OCIO_CHECK_EQUAL(rulePos, expectedRules[idx]);
+        OCIO_CHECK_EQUAL(colorSpace, expectedColorSpaces[idx]);
+    }
+
+    // The rule indices are optional.
+    std::fill(colorSpaces.begin(), colorSpaces.end(), nullptr);
+    OCIO_CHECK_NO_THROW(config->getColorSpacesFromFilepaths(paths.data(), paths.size(),
+                                                            colorSpaces.data(), nullptr));
+    OCIO_CHECK_EQUAL(std::string(colorSpaces[3]), "cs1");
+
+    OCIO_CHECK_THROW_WHAT(config->getColorSpacesFromFilepaths(nullptr, 2, colorSpaces.data(),
+                                                              nullptr),
+                          OCIO::Exception, "can't be null");
+
+    // A rule change is taken into account.
+    rules->removeRule(3);
+    config->setFileRules(rules);
+    OCIO_CHECK_EQUAL(std::string(config->getColorSpaceFromFilepath("/mnt/media/image.exr")),
+                     OCIO::ROLE_DEFAULT);
+}
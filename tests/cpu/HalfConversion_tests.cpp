@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "HalfConversion.cpp"
+
+#include "testutils/UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+OCIO_ADD_TEST(HalfConversion, half_to_float)
+{
+    // All the half values, plus a few ones to exercise the partial vector at the end.
+    std::vector<half> in(65536 + 5);
+    for (size_t idx = 0; idx < in.size(); ++idx)
+    {
+        in[idx].setBits((unsigned short)(idx & 0xFFFF));
+    }
+
+    std::vector<float> out(in.size());
+    OCIO::ConvertHalfToFloat(in.data(), out.data(), (long)in.size());
+
+    for (size_t idx = 0; idx < in.size(); ++idx)
+    {
+        const float expected = float(in[idx]);
+        if (std::isnan(expected))
+        {
+            OCIO_CHECK_ASSERT(std::isnan(out[idx]));
+        }
+        else
+        {
+            OCIO_CHECK_ASSERT(0 == memcmp(&expected, &out[idx], sizeof(float)));
+        }
+    }
+}
+
+OCIO_ADD_TEST(HalfConversion, float_to_half)
+{
+    std::vector<float> in;
+
+    // Values around the half limits and the rounding midpoints.
+    const float specials[] = {
+        0.f, -0.f, 1.f, -1.f, 0.1f, 0.18f, 65504.f, 65519.99f, 65520.f, -65520.f, 1e10f,
+        6.1035156e-05f, 5.9604645e-08f, 2.9802322e-08f, 2.9802326e-08f, 1e-10f, -1e-10f,
+        1.00048828125f, 1.00146484375f, 2049.f, 2051.f,
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min()
+    };
+    in.insert(in.end(), std::begin(specials), std::end(specials));
+
+    // Sweep across all the exponents of the half range and beyond.
+    for (float f = 1e-9f; f < 1e6f; f *= 1.0007f)
+    {
+        in.push_back(f);
+        in.push_back(-f);
+    }
+
+    std::vector<half> out(in.size());
+    OCIO::ConvertFloatToHalf(in.data(), out.data(), (long)in.size());
+
+    for (size_t idx = 0; idx < in.size(); ++idx)
+    {
+        const half expected(in[idx]);
+        if (expected.isNan())
+        {
+            OCIO_CHECK_ASSERT(out[idx].isNan());
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL(expected.bits(), out[idx].bits());
+        }
+    }
+}
+
+OCIO_ADD_TEST(HalfConversion, f16c)
+{
+    const OCIO::CPUInfo & cpu = OCIO::CPUInfo::Instance();
+
+#ifdef USE_F16C
+    OCIO_CHECK_EQUAL(cpu.m_hasF16C, OCIO::HasF16CHalfConversion());
+#else
+    (void)cpu;
+    OCIO_CHECK_ASSERT(!OCIO::HasF16CHalfConversion());
+#endif
+}
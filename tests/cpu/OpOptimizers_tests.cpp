@@ -1165,6 +1165,130 @@ OCIO_ADD_TEST(OpOptimizers, gamma_prefix)
     OCIO_CHECK_EQUAL(o2->data()->getType(), OCIO::OpData::GammaType);
 }
 
+OCIO_ADD_TEST(OpOptimizers, prefix_optimization_f32)
+{
+    // Test the half-domain LUT replacing a gamma & log prefix for F32 pixels.
+
+    OCIO::OpRcPtrVec originalOps;
+
+    OCIO::GammaOpData::Params params1 = {2.4};
+    OCIO::GammaOpData::Params paramsA = {1.};
+
+    OCIO::GammaOpDataRcPtr gamma1
+        = std::make_shared<OCIO::GammaOpData>(OCIO::GammaOpData::BASIC_MIRROR_FWD,
+                                              params1, params1, params1, paramsA);
+
+    OCIO_CHECK_NO_THROW(OCIO::CreateGammaOp(originalOps, gamma1, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLogOp(originalOps, 10.0, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(originalOps.finalize(OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(originalOps.size(), 2);
+
+    // None of the optimization levels include the F32 prefix optimization, even if
+    // OPTIMIZATION_ALL (and the values derived from it) have all the bits set.
+    OCIO_CHECK_EQUAL(OCIO::OPTIMIZATION_ALL, 0xFFFFFFFF);
+    OCIO::HalfDomainLutAccuracy accuracy;
+    OCIO::OpRcPtrVec optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(optimizedOps.optimizeForBitdepth(OCIO::BIT_DEPTH_F32,
+                                                         OCIO::BIT_DEPTH_F32,
+                                                         OCIO::OPTIMIZATION_ALL,
+                                                         &accuracy));
+    OCIO_CHECK_EQUAL(optimizedOps.size(), 2);
+    OCIO_CHECK_ASSERT(!accuracy.m_evaluated);
+
+    optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(optimizedOps.optimizeForBitdepth(
+        OCIO::BIT_DEPTH_F32,
+        OCIO::BIT_DEPTH_F32,
+        static_cast<OCIO::OptimizationFlags>(OCIO::OPTIMIZATION_DRAFT
+                                             & ~OCIO::OPTIMIZATION_NO_DYNAMIC_PROPERTIES),
+        &accuracy));
+    OCIO_CHECK_EQUAL(optimizedOps.size(), 2);
+    OCIO_CHECK_ASSERT(!accuracy.m_evaluated);
+
+    optimizedOps = originalOps.clone();
+    OCIO_CHECK_NO_THROW(optimizedOps.optimizeForBitdepth(OCIO::BIT_DEPTH_F32,
+                                                         OCIO::BIT_DEPTH_F32,
+                                                         OCIO::OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32,
+                                                         &accuracy));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1);
+
+    OCIO_CHECK_ASSERT(accuracy.m_evaluated);
+    OCIO_CHECK_ASSERT(accuracy.m_replaced);
+    OCIO_CHECK_EQUAL(accuracy.m_numOps, 2u);
+    OCIO_CHECK_LE(accuracy.m_maxError, 1e-4f);
+    OCIO_CHECK_ASSERT(accuracy.m_numSamples > 0);
+
+    OCIO::ConstOpRcPtr o1              = optimizedOps[0];
+    OCIO::ConstLut1DOpDataRcPtr oData1 = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o1->data());
+    OCIO_REQUIRE_ASSERT(oData1);
+    OCIO_CHECK_ASSERT(oData1->isInputHalfDomain());
+    OCIO_CHECK_EQUAL(oData1->getArray().getLength(), 65536);
+
+    OCIO_CHECK_NO_THROW(optimizedOps.finalize(OCIO::OPTIMIZATION_NONE));
+
+    // The interpolated LUT is close to the original ops.
+    const std::vector<float> input = { -4.1f, -0.5f, -0.0123f, 0.f,
+                                        0.001f, 0.18f, 0.5f,    1.f,
+                                        1.2345f, 3.3f, 7.77f,   15.f };
+
+    std::vector<float> exact = input;
+    for (const auto & op : originalOps)
+    {
+        op->apply(&exact[0], &exact[0], 3);
+    }
+
+    std::vector<float> approx = input;
+    optimizedOps[0]->apply(&approx[0], &approx[0], 3);
+
+    for (size_t idx = 0; idx < input.size(); ++idx)
+    {
+        OCIO_CHECK_ASSERT(OCIO::EqualWithSafeRelError(approx[idx], exact[idx], 1e-4f, 1.0f));
+    }
+
+    // A very steep power function is not accurate enough when interpolated, the ops are
+    // then kept.
+
+    OCIO::GammaOpData::Params params2 = {60.};
+
+    OCIO::GammaOpDataRcPtr gamma2
+        = std::make_shared<OCIO::GammaOpData>(OCIO::GammaOpData::BASIC_FWD,
+                                              params2, params2, params2, paramsA);
+
+    OCIO::OpRcPtrVec steepOps;
+    OCIO_CHECK_NO_THROW(OCIO::CreateGammaOp(steepOps, gamma2, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(steepOps.finalize(OCIO::OPTIMIZATION_DEFAULT));
+
+    OCIO_CHECK_NO_THROW(steepOps.optimizeForBitdepth(OCIO::BIT_DEPTH_F32,
+                                                     OCIO::BIT_DEPTH_F32,
+                                                     OCIO::OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32,
+                                                     &accuracy));
+    OCIO_REQUIRE_EQUAL(steepOps.size(), 1);
+    OCIO::ConstOpRcPtr o2 = steepOps[0];
+    OCIO_CHECK_EQUAL(o2->data()->getType(), OCIO::OpData::GammaType);
+
+    OCIO_CHECK_ASSERT(accuracy.m_evaluated);
+    OCIO_CHECK_ASSERT(!accuracy.m_replaced);
+    OCIO_CHECK_ASSERT(accuracy.m_maxError > 1e-4f);
+
+    // Only fast separable ops, nothing to do.
+
+    OCIO::MatrixOpDataRcPtr matrix = std::make_shared<OCIO::MatrixOpData>();
+    matrix->setArrayValue(0, 2.);
+
+    OCIO::OpRcPtrVec matrixOps;
+    OCIO_CHECK_NO_THROW(OCIO::CreateMatrixOp(matrixOps, matrix, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(matrixOps.finalize(OCIO::OPTIMIZATION_DEFAULT));
+
+    OCIO_CHECK_NO_THROW(matrixOps.optimizeForBitdepth(OCIO::BIT_DEPTH_F32,
+                                                      OCIO::BIT_DEPTH_F32,
+                                                      OCIO::OPTIMIZATION_COMP_SEPARABLE_PREFIX_F32,
+                                                      &accuracy));
+    OCIO_REQUIRE_EQUAL(matrixOps.size(), 1);
+    OCIO_CHECK_ASSERT(!accuracy.m_evaluated);
+    OCIO::ConstOpRcPtr o3 = matrixOps[0];
+    OCIO_CHECK_EQUAL(o3->data()->getType(), OCIO::OpData::MatrixType);
+}
+
 OCIO_ADD_TEST(OpOptimizers, multi_op_prefix)
 {
     // Test prefix optimization of a complex transform.
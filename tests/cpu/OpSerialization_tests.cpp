@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include "OpSerialization.cpp"
+
+#include "ops/noop/NoOps.h"
+#include "testutils/UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+void BuildAllOps(OCIO::OpRcPtrVec & ops)
+{
+    auto cdl = std::make_shared<OCIO::CDLOpData>();
+    cdl->setSlopeParams(OCIO::CDLOpData::ChannelParams(1.1, 1.2, 1.3));
+    cdl->setPowerParams(OCIO::CDLOpData::ChannelParams(0.9, 1.0, 1.1));
+    cdl->setSaturation(0.8);
+    cdl->setName("cdl");
+    cdl->getFormatMetadata().addChildElement(OCIO::METADATA_DESCRIPTION, "A grade");
+    OCIO::CreateOpVecFromOpData(ops, cdl, OCIO::TRANSFORM_DIR_FORWARD);
+
+    const double exp4[4] = { 1.2, 1.3, 1.4, 1.0 };
+    OCIO::CreateOpVecFromOpData(ops, std::make_shared<OCIO::ExponentOpData>(exp4),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+
+    auto ec = std::make_shared<OCIO::ExposureContrastOpData>(
+        OCIO::ExposureContrastOpData::STYLE_LOGARITHMIC);
+    ec->setExposure(0.5);
+    ec->setContrast(1.2);
+    ec->getExposureProperty()->makeDynamic();
+    OCIO::CreateOpVecFromOpData(ops, ec, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::CreateOpVecFromOpData(ops,
+                                std::make_shared<OCIO::FixedFunctionOpData>(
+                                    OCIO::FixedFunctionOpData::Params{ 0.78 },
+                                    OCIO::FixedFunctionOpData::REC2100_SURROUND_FWD),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::CreateOpVecFromOpData(ops,
+                                std::make_shared<OCIO::GammaOpData>(
+                                    OCIO::GammaOpData::MONCURVE_FWD,
+                                    OCIO::GammaOpData::Params{ 2.4, 0.055 },
+                                    OCIO::GammaOpData::Params{ 2.2, 0.1 },
+                                    OCIO::GammaOpData::Params{ 2.0, 0.05 },
+                                    OCIO::GammaOpData::Params{ 1.0, 0.0 }),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::CreateOpVecFromOpData(ops,
+                                std::make_shared<OCIO::LogOpData>(10.0,
+                                                                  OCIO::TRANSFORM_DIR_INVERSE),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+
+    auto lut1d = std::make_shared<OCIO::Lut1DOpData>(17);
+    auto & lut1dValues = lut1d->getArray().getValues();
+    for (size_t idx = 0; idx < lut1dValues.size(); ++idx)
+    {
+        lut1dValues[idx] = powf(lut1dValues[idx], 2.2f);
+    }
+    lut1d->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+    lut1d->setFileOutputBitDepth(OCIO::BIT_DEPTH_UINT10);
+    OCIO::CreateOpVecFromOpData(ops, lut1d, OCIO::TRANSFORM_DIR_FORWARD);
+
+    auto lut3d = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_TETRAHEDRAL, 5);
+    lut3d->getArray().getValues()[7] = 0.42f;
+    OCIO::CreateOpVecFromOpData(ops, lut3d, OCIO::TRANSFORM_DIR_FORWARD);
+
+    auto matrix = std::make_shared<OCIO::MatrixOpData>();
+    matrix->setArrayValue(1, 0.25);
+    const double offsets[4] = { 0.1, 0.2, 0.3, 0.0 };
+    matrix->setRGBAOffsets(offsets);
+    OCIO::CreateOpVecFromOpData(ops, matrix, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::CreateOpVecFromOpData(ops,
+                                std::make_shared<OCIO::RangeOpData>(
+                                    0., 1., 0.5, 1.5),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+
+    ops.getFormatMetadata().addAttribute(OCIO::METADATA_ID, "all_ops");
+    ops.finalize(OCIO::OPTIMIZATION_NONE);
+}
+
+}
+
+OCIO_ADD_TEST(OpSerialization, round_trip)
+{
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(BuildAllOps(ops));
+    OCIO_REQUIRE_EQUAL(ops.size(), 10);
+
+    OCIO::ProcessorMetadataRcPtr metadata = OCIO::ProcessorMetadata::Create();
+    metadata->addFile("lut.spi1d");
+    metadata->addLook("look");
+
+    std::ostringstream os;
+    OCIO_CHECK_NO_THROW(OCIO::WriteBinaryOps(os, ops, *metadata));
+
+    std::istringstream is(os.str());
+    OCIO::OpRcPtrVec readOps;
+    OCIO::ProcessorMetadataRcPtr readMetadata = OCIO::ProcessorMetadata::Create();
+    OCIO_CHECK_NO_THROW(OCIO::ReadBinaryOps(is, readOps, *readMetadata));
+    OCIO_REQUIRE_EQUAL(readOps.size(), ops.size());
+    OCIO_CHECK_NO_THROW(readOps.finalize(OCIO::OPTIMIZATION_NONE));
+
+    for (size_t idx = 0; idx < ops.size(); ++idx)
+    {
+        OCIO::ConstOpRcPtr op = ops[idx];
+        OCIO::ConstOpRcPtr readOp = readOps[idx];
+        OCIO_CHECK_ASSERT(*op->data() == *readOp->data());
+        OCIO_CHECK_EQUAL(op->getCacheID(), readOp->getCacheID());
+        OCIO_CHECK_ASSERT(op->data()->getFormatMetadata()
+                          == readOp->data()->getFormatMetadata());
+    }
+
+    OCIO::ConstOpRcPtr cdlOp = readOps[0];
+    OCIO_CHECK_EQUAL(cdlOp->data()->getName(), "cdl");
+    OCIO_CHECK_ASSERT(readOps[2]->isDynamic());
+    OCIO_CHECK_EQUAL(std::string(readOps.getFormatMetadata().getAttributeValue(OCIO::METADATA_ID)), "all_ops");
+
+    OCIO_REQUIRE_EQUAL(readMetadata->getNumFiles(), 1);
+    OCIO_CHECK_EQUAL(std::string(readMetadata->getFile(0)), "lut.spi1d");
+    OCIO_REQUIRE_EQUAL(readMetadata->getNumLooks(), 1);
+    OCIO_CHECK_EQUAL(std::string(readMetadata->getLook(0)), "look");
+}
+
+OCIO_ADD_TEST(OpSerialization, errors)
+{
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(BuildAllOps(ops));
+
+    OCIO::ProcessorMetadataRcPtr metadata = OCIO::ProcessorMetadata::Create();
+
+    std::ostringstream os;
+    OCIO_CHECK_NO_THROW(OCIO::WriteBinaryOps(os, ops, *metadata));
+    const std::string data = os.str();
+
+    {
+        std::istringstream is(data.substr(0, data.size() - 3));
+        OCIO::OpRcPtrVec readOps;
+        OCIO_CHECK_THROW_WHAT(OCIO::ReadBinaryOps(is, readOps, *metadata),
+                              OCIO::Exception, "truncated data");
+    }
+
+    {
+        std::string badMagic = data;
+        badMagic[0] = 'X';
+        std::istringstream is(badMagic);
+        OCIO::OpRcPtrVec readOps;
+        OCIO_CHECK_THROW_WHAT(OCIO::ReadBinaryOps(is, readOps, *metadata),
+                              OCIO::Exception, "not a binary op list");
+    }
+
+    {
+        // Corrupt the version of the library.
+        std::string badVersion = data;
+        badVersion[16] = char(badVersion[16] + 1);
+        std::istringstream is(badVersion);
+        OCIO::OpRcPtrVec readOps;
+        OCIO_CHECK_THROW_WHAT(OCIO::ReadBinaryOps(is, readOps, *metadata),
+                              OCIO::Exception, "written by another library version");
+    }
+
+    {
+        // Corrupt the number of files.
+        std::string badSize = data;
+        badSize[27] = char(0x7F);
+        std::istringstream is(badSize);
+        OCIO::OpRcPtrVec readOps;
+        OCIO_CHECK_THROW_WHAT(OCIO::ReadBinaryOps(is, readOps, *metadata),
+                              OCIO::Exception, "corrupted data");
+    }
+
+    // Out-of-range enum values are rejected.
+
+    OCIO::OpRcPtrVec emptyOps;
+    std::ostringstream emptyOs;
+    OCIO_CHECK_NO_THROW(OCIO::WriteBinaryOps(emptyOs, emptyOps, *metadata));
+    const size_t emptySize = emptyOs.str().size();
+
+    OCIO::OpRcPtrVec rangeOps;
+    OCIO::CreateOpVecFromOpData(rangeOps,
+                                std::make_shared<OCIO::RangeOpData>(0., 1., 0.5, 1.5),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+    std::ostringstream rangeOs;
+    OCIO_CHECK_NO_THROW(OCIO::WriteBinaryOps(rangeOs, rangeOps, *metadata));
+    const std::string rangeData = rangeOs.str();
+
+    {
+        // The op type directly follows the number of ops.
+        std::string badType = rangeData;
+        badType[emptySize] = char(0x7F);
+        std::istringstream is(badType);
+        OCIO::OpRcPtrVec readOps;
+        OCIO_CHECK_THROW_WHAT(OCIO::ReadBinaryOps(is, readOps, *metadata),
+                              OCIO::Exception, "corrupted data");
+    }
+
+    {
+        // The direction and the two bit-depths are followed by the four range values.
+        std::string badDirection = rangeData;
+        badDirection[rangeData.size() - 4 * sizeof(double) - 3 * sizeof(int32_t)] = char(0x7F);
+        std::istringstream is(badDirection);
+        OCIO::OpRcPtrVec readOps;
+        OCIO_CHECK_THROW_WHAT(OCIO::ReadBinaryOps(is, readOps, *metadata),
+                              OCIO::Exception, "corrupted data");
+    }
+
+    {
+        std::istringstream is(rangeData);
+        OCIO::OpRcPtrVec readOps;
+        OCIO_CHECK_NO_THROW(OCIO::ReadBinaryOps(is, readOps, *metadata));
+        OCIO_CHECK_EQUAL(readOps.size(), 1);
+    }
+
+    // Reference and no-op ops are not expected in a finalized op list.
+    OCIO::OpRcPtrVec noOps;
+    OCIO::CreateFileNoOp(noOps, "file.lut");
+    OCIO_CHECK_THROW_WHAT(OCIO::WriteBinaryOps(os, noOps, *metadata),
+                          OCIO::Exception, "can't be serialized");
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+#include <atomic>
+
+#include "ParallelUtils.cpp"
+
+#include "testutils/UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+OCIO_ADD_TEST(ParallelUtils, parallel_for)
+{
+    std::vector<int> values(1000, 0);
+    OCIO_CHECK_NO_THROW(OCIO::ParallelFor(4, (long)values.size(), 7,
+                                          [&values](unsigned, long begin, long end)
+    {
+        for (long idx = begin; idx < end; ++idx)
+        {
+            values[idx] += 1;
+        }
+    }));
+    OCIO_CHECK_ASSERT(std::all_of(values.begin(), values.end(), [](int v) { return v == 1; }));
+
+    OCIO_CHECK_THROW_WHAT(OCIO::ParallelFor(4, 100, 1, [](unsigned, long begin, long)
+                                            {
+                                                if (begin == 50)
+                                                {
+                                                    throw OCIO::Exception("Chunk 50.");
+                                                }
+                                            }),
+                          OCIO::Exception,
+                          "Chunk 50.");
+}
+
+OCIO_ADD_TEST(ParallelUtils, thread_reservation)
+{
+    const unsigned numHardwareThreads = OCIO::GetNumThreads(0);
+
+    {
+        // The concurrent internal steps share the hardware threads.
+        const OCIO::ThreadReservation threads;
+        OCIO_CHECK_EQUAL(threads.getNumThreads(), numHardwareThreads);
+
+        const OCIO::ThreadReservation otherThreads;
+        OCIO_CHECK_EQUAL(otherThreads.getNumThreads(), 1U);
+    }
+
+    {
+        // The threads are given back.
+        const OCIO::ThreadReservation threads(2);
+        OCIO_CHECK_EQUAL(threads.getNumThreads(), std::min(2U, numHardwareThreads));
+    }
+
+    {
+        // The limit of the calling thread applies.
+        OCIO::ThreadLimitGuard guard(1);
+        const OCIO::ThreadReservation threads;
+        OCIO_CHECK_EQUAL(threads.getNumThreads(), 1U);
+
+        // A nested guard could not raise the limit.
+        OCIO::ThreadLimitGuard nestedGuard(0);
+        const OCIO::ThreadReservation otherThreads;
+        OCIO_CHECK_EQUAL(otherThreads.getNumThreads(), 1U);
+    }
+
+    {
+        const OCIO::ThreadReservation threads;
+        OCIO_CHECK_EQUAL(threads.getNumThreads(), numHardwareThreads);
+    }
+
+    // The internal steps nested in a parallel loop run on the worker threads.
+    std::atomic<unsigned> maxNumThreads(0);
+    OCIO::ParallelFor(2, 2, 1, [&maxNumThreads](unsigned, long, long)
+    {
+        const OCIO::ThreadReservation threads;
+        unsigned current = maxNumThreads.load();
+        while (current < threads.getNumThreads()
+               && !maxNumThreads.compare_exchange_weak(current, threads.getNumThreads()))
+        {
+        }
+    });
+    OCIO_CHECK_EQUAL(maxNumThreads.load(), 1U);
+}
+
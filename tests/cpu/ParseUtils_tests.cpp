@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 #include "ParseUtils.cpp"
 
@@ -335,6 +338,217 @@ OCIO_ADD_TEST(ParseUtils, string_to_float)
     OCIO_CHECK_EQUAL(fval, 1.0f);
 }
 
+OCIO_ADD_TEST(ParseUtils, scan_number)
+{
+    const auto scanFloat = [](const std::string & str, float & val) -> size_t
+    {
+        const char * first = str.c_str();
+        return size_t(OCIO::ScanNumber(first, first + str.size(), val) - first);
+    };
+
+    float fval = 0.f;
+    OCIO_CHECK_EQUAL(scanFloat("", fval), 0);
+    OCIO_CHECK_EQUAL(scanFloat(" 1", fval), 0);
+    OCIO_CHECK_EQUAL(scanFloat("-", fval), 0);
+    OCIO_CHECK_EQUAL(scanFloat(".", fval), 0);
+    OCIO_CHECK_EQUAL(scanFloat("na", fval), 0);
+
+    OCIO_CHECK_EQUAL(scanFloat("0.5 1", fval), 3);
+    OCIO_CHECK_EQUAL(fval, 0.5f);
+    OCIO_CHECK_EQUAL(scanFloat("-.25", fval), 4);
+    OCIO_CHECK_EQUAL(fval, -0.25f);
+    OCIO_CHECK_EQUAL(scanFloat("+3.", fval), 3);
+    OCIO_CHECK_EQUAL(fval, 3.f);
+    OCIO_CHECK_EQUAL(scanFloat("1.5e-3x", fval), 6);
+    OCIO_CHECK_EQUAL(fval, 1.5e-3f);
+    OCIO_CHECK_EQUAL(scanFloat("2E+2", fval), 4);
+    OCIO_CHECK_EQUAL(fval, 200.f);
+    // The exponent needs at least one digit.
+    OCIO_CHECK_EQUAL(scanFloat("2e", fval), 1);
+    OCIO_CHECK_EQUAL(fval, 2.f);
+    OCIO_CHECK_EQUAL(scanFloat("-0", fval), 2);
+    OCIO_CHECK_ASSERT(fval == 0.f && std::signbit(fval));
+
+    // Like strtof(), the non-finite values are accepted and the overflows give infinity.
+    OCIO_CHECK_EQUAL(scanFloat("nan", fval), 3);
+    OCIO_CHECK_ASSERT(std::isnan(fval));
+    OCIO_CHECK_EQUAL(scanFloat("-NaN(1a_b) 1", fval), 10);
+    OCIO_CHECK_ASSERT(std::isnan(fval));
+    OCIO_CHECK_EQUAL(scanFloat("nan(1", fval), 3);
+    OCIO_CHECK_EQUAL(scanFloat("inf", fval), 3);
+    OCIO_CHECK_EQUAL(fval, std::numeric_limits<float>::infinity());
+    OCIO_CHECK_EQUAL(scanFloat("-Infinity", fval), 9);
+    OCIO_CHECK_EQUAL(fval, -std::numeric_limits<float>::infinity());
+    OCIO_CHECK_EQUAL(scanFloat("+infinit", fval), 4);
+    OCIO_CHECK_EQUAL(fval, std::numeric_limits<float>::infinity());
+    // Like strtof(), there is no dot before the non-finite values.
+    OCIO_CHECK_EQUAL(scanFloat(".inf", fval), 0);
+    OCIO_CHECK_EQUAL(scanFloat("-.nan", fval), 0);
+    OCIO_CHECK_EQUAL(scanFloat("+.infinity", fval), 0);
+    OCIO_CHECK_EQUAL(scanFloat("-1e50", fval), 5);
+    OCIO_CHECK_EQUAL(fval, -std::numeric_limits<float>::infinity());
+    // The decimal separator is always the dot whatever the locale.
+    OCIO_CHECK_EQUAL(scanFloat("0,5", fval), 1);
+    OCIO_CHECK_EQUAL(fval, 0.f);
+
+    // Values needing the slow path (i.e. long mantissa or large exponent).
+    OCIO_CHECK_EQUAL(scanFloat("0.1000000000000000000000000000001", fval), 33);
+    OCIO_CHECK_EQUAL(fval, 0.1f);
+    OCIO_CHECK_EQUAL(scanFloat("1e-40", fval), 5);
+    OCIO_CHECK_EQUAL(fval, std::strtof("1e-40", nullptr));
+    OCIO_CHECK_EQUAL(scanFloat("1e50", fval), 4);
+    OCIO_CHECK_EQUAL(fval, std::strtof("1e50", nullptr));
+    OCIO_CHECK_EQUAL(scanFloat("1e-50", fval), 5);
+    OCIO_CHECK_EQUAL(fval, std::strtof("1e-50", nullptr));
+
+    // The results must be identical to the strtof & strtod ones.
+    unsigned seed = 1;
+    for (int i = 0; i < 100000; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        const unsigned mantissa = seed % 100000000u;
+        seed = seed * 1103515245u + 12345u;
+        const int exponent = int(seed % 40u) - 25;
+
+        std::ostringstream oss;
+        oss << (i % 2 ? "-" : "") << mantissa << "e" << exponent;
+        const std::string str = oss.str();
+
+        OCIO_CHECK_EQUAL(scanFloat(str, fval), str.size());
+        OCIO_REQUIRE_EQUAL(fval, std::strtof(str.c_str(), nullptr));
+
+        double dval = 0.;
+        OCIO_CHECK_ASSERT(OCIO::ScanNumber(str.c_str(), str.c_str() + str.size(), dval));
+        OCIO_REQUIRE_EQUAL(dval, std::strtod(str.c_str(), nullptr));
+    }
+
+    const std::string ints("12 -7 2147483647 2147483648 -2147483648 1.5");
+    const char * ptr = ints.c_str();
+    const char * last = ptr + ints.size();
+
+    int ival[3] = { 0, 0, 0 };
+    ptr = OCIO::ScanNumbers(ptr, last, ival, 3);
+    OCIO_REQUIRE_ASSERT(ptr);
+    OCIO_CHECK_EQUAL(ival[0], 12);
+    OCIO_CHECK_EQUAL(ival[1], -7);
+    OCIO_CHECK_EQUAL(ival[2], 2147483647);
+    // Overflow.
+    OCIO_CHECK_ASSERT(!OCIO::ScanNumbers(ptr, last, ival, 1));
+    ptr = std::strstr(ptr, "-2147483648");
+    OCIO_CHECK_ASSERT(OCIO::ScanNumbers(ptr, last, ival, 1));
+    OCIO_CHECK_EQUAL(ival[0], -2147483647 - 1);
+    // Not an integer.
+    OCIO_CHECK_ASSERT(!OCIO::ScanNumbers(std::strstr(ptr, "1.5"), last, ival, 1));
+}
+
+OCIO_ADD_TEST(ParseUtils, format_fixed)
+{
+    auto formatFixed = [](float value, int precision)
+    {
+        char buffer[OCIO::FIXED_NUMBER_MAX_CHARS];
+        return std::string(buffer, OCIO::FormatFixed(buffer, value, precision));
+    };
+
+    OCIO_CHECK_EQUAL(formatFixed(0.f, 6), "0.000000");
+    OCIO_CHECK_EQUAL(formatFixed(-0.f, 6), "-0.000000");
+    OCIO_CHECK_EQUAL(formatFixed(-1e-9f, 6), "-0.000000");
+    OCIO_CHECK_EQUAL(formatFixed(1.f, 0), "1");
+    OCIO_CHECK_EQUAL(formatFixed(0.5f, 0), "0");
+    OCIO_CHECK_EQUAL(formatFixed(1.5f, 0), "2");
+    OCIO_CHECK_EQUAL(formatFixed(0.125f, 2), "0.12");
+    OCIO_CHECK_EQUAL(formatFixed(-123.456f, 3), "-123.456");
+    OCIO_CHECK_EQUAL(formatFixed(1e20f, 2), "100000002004087734272.00");
+    OCIO_CHECK_EQUAL(formatFixed(std::numeric_limits<float>::infinity(), 6), "inf");
+
+    // The results must be identical to the stream ones.
+    unsigned seed = 1;
+    for (int i = 0; i < 100000; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        const float mantissa = float(seed % 100000000u) / 1e8f;
+        seed = seed * 1103515245u + 12345u;
+        const float value = (i % 2 ? -1.f : 1.f) * std::ldexp(mantissa, int(seed % 40u) - 20);
+        const int precision = i % 10;
+
+        std::ostringstream oss;
+        oss.setf(std::ios::fixed, std::ios::floatfield);
+        oss.precision(precision);
+        oss << value;
+
+        OCIO_REQUIRE_EQUAL(formatFixed(value, precision), oss.str());
+    }
+
+    // The output does not depend on the number of threads.
+    std::vector<float> values(3 * 10000);
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = float(idx) / 7.f - 100.f;
+    }
+
+    std::ostringstream expected;
+    expected.setf(std::ios::fixed, std::ios::floatfield);
+    expected.precision(6);
+    for (size_t idx = 0; idx < values.size(); idx += 3)
+    {
+        expected << values[idx] << " " << values[idx + 1] << " " << values[idx + 2] << "\n";
+    }
+
+    for (unsigned numThreads : { 1U, 3U, 8U })
+    {
+        std::ostringstream oss;
+        OCIO::WriteFixedTriplets(oss, values.data(), long(values.size() / 3), 6, numThreads);
+        OCIO_CHECK_ASSERT(oss.str() == expected.str());
+    }
+}
+
+OCIO_ADD_TEST(ParseUtils, line_tokenizer)
+{
+    const std::string buffer("# comment\r\n\n  0.1  0.2 0.3 \r\n1 2\n4 5 6 7\n\t8 9 x");
+    OCIO::LineTokenizer lines(buffer.data(), buffer.data() + buffer.size());
+
+    float rgb[3];
+    std::vector<int> ints;
+
+    OCIO_REQUIRE_ASSERT(lines.nextLine());
+    OCIO_CHECK_EQUAL(lines.line(), "# comment");
+    OCIO_CHECK_ASSERT(!lines.getNumbers(rgb, 3));
+
+    OCIO_REQUIRE_ASSERT(lines.nextLine());
+    OCIO_CHECK_ASSERT(lines.lineEmpty());
+
+    OCIO_REQUIRE_ASSERT(lines.nextLine());
+    OCIO_CHECK_EQUAL(lines.line(), "0.1  0.2 0.3");
+    OCIO_REQUIRE_ASSERT(lines.getNumbers(rgb, 3));
+    OCIO_CHECK_EQUAL(rgb[0], 0.1f);
+    OCIO_CHECK_EQUAL(rgb[1], 0.2f);
+    OCIO_CHECK_EQUAL(rgb[2], 0.3f);
+    OCIO_CHECK_ASSERT(!lines.getNumbers(ints));
+
+    OCIO_REQUIRE_ASSERT(lines.nextLine());
+    OCIO_CHECK_ASSERT(!lines.getNumbers(rgb, 3));
+    OCIO_CHECK_ASSERT(lines.getNumbers(ints));
+    OCIO_CHECK_EQUAL(ints.size(), 2);
+
+    OCIO_REQUIRE_ASSERT(lines.nextLine());
+    OCIO_CHECK_ASSERT(!lines.getNumbers(rgb, 3));
+    OCIO_CHECK_ASSERT(lines.getNumbers(ints));
+    OCIO_CHECK_EQUAL(ints.size(), 4);
+    OCIO_CHECK_EQUAL(ints[3], 7);
+
+    OCIO_REQUIRE_ASSERT(lines.nextLine());
+    OCIO_CHECK_EQUAL(lines.line(), "8 9 x");
+    OCIO_CHECK_ASSERT(!lines.getNumbers(ints));
+
+    OCIO_CHECK_ASSERT(!lines.nextLine());
+    OCIO_CHECK_ASSERT(lines.lineEmpty());
+
+    // Read a whole stream.
+    std::istringstream iss(buffer);
+    std::string content;
+    OCIO::ReadStream(iss, content);
+    OCIO_CHECK_EQUAL(content, buffer);
+}
+
 OCIO_ADD_TEST(ParseUtils, float_double)
 {
     std::string resStr;
@@ -26,3 +26,89 @@ OCIO_ADD_TEST(PathUtils, env_expand)
     OCIO_CHECK_ASSERT( testresult == foo_result );
 }
 
+
+namespace
+{
+
+// The previous implementation, trying every name.
+int FindRightMostName(const std::vector<std::string> & names, const std::string & str)
+{
+    const std::string fullstr = StringUtils::Lower(str);
+
+    int rightMostColorPos = -1;
+    size_t rightMostLength = 0;
+    int rightMostIndex = -1;
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        const std::string csname = StringUtils::Lower(names[i]);
+
+        int colorspacePos = (int)StringUtils::ReverseFind(fullstr, csname);
+        if (csname.empty() || colorspacePos < 0) continue;
+
+        colorspacePos += (int)csname.size();
+
+        if ((colorspacePos > rightMostColorPos) ||
+            ((colorspacePos == rightMostColorPos) && (csname.size() > rightMostLength)))
+        {
+            rightMostColorPos = colorspacePos;
+            rightMostLength = csname.size();
+            rightMostIndex = (int)i;
+        }
+    }
+
+    return rightMostIndex;
+}
+
+} // anon.
+
+OCIO_ADD_TEST(PathUtils, color_space_name_matcher)
+{
+    const std::vector<std::string> names{ "lnh", "sRGB", "ACEScg", "ACES", "cg", "aces2065",
+                                          "rec709", "c709", "Linear Rec.709", "log", "",
+                                          "LogC", "ogc" };
+
+    const OCIO::ColorSpaceNameMatcher matcher(names);
+
+    const std::vector<std::string> paths{
+        "", "/no/match/here.exr", "/shots/plate_acescg.exr", "/shots/plate_ACES.exr",
+        "/srgb/shot_lnh_v001.exr", "/lnh/shot_srgb_v001.exr", "/aces2065/plate.exr",
+        "/plate_rec709_logc.dpx", "/plate_logc_rec709.dpx", "/plate_linear rec.709.exr",
+        "/a/acescgacescg", "/a/aces2065cg", "/a/c709", "/a/xlogcx", "/a/ogclog", "aces" };
+
+    for (const auto & path : paths)
+    {
+        const int expected = FindRightMostName(names, path);
+        OCIO_CHECK_EQUAL(matcher.findRightMost(path.c_str()), expected);
+    }
+
+    OCIO_CHECK_EQUAL(matcher.findRightMost("/shots/plate_acescg.exr"), 2);
+    OCIO_CHECK_EQUAL(std::string(matcher.getName(2)), "ACEScg");
+    OCIO_CHECK_EQUAL(matcher.findRightMost("/a/aces2065cg"), 4);
+    OCIO_CHECK_EQUAL(matcher.findRightMost("/a/xlogcx"), 11);
+    OCIO_CHECK_EQUAL(matcher.findRightMost(nullptr), -1);
+
+    // Exhaustively compare all the short strings over a small alphabet.
+
+    const std::vector<std::string> shortNames{ "ab", "b", "abc", "bca", "cab", "c", "aab" };
+    const OCIO::ColorSpaceNameMatcher shortMatcher(shortNames);
+
+    const char alphabet[] = { 'a', 'B', 'c', 'x' };
+    for (int length = 0; length <= 6; ++length)
+    {
+        int numStrings = 1;
+        for (int i = 0; i < length; ++i) numStrings *= 4;
+
+        for (int code = 0; code < numStrings; ++code)
+        {
+            std::string str;
+            for (int i = 0, c = code; i < length; ++i, c /= 4)
+            {
+                str += alphabet[c % 4];
+            }
+
+            OCIO_REQUIRE_EQUAL(shortMatcher.findRightMost(str.c_str()),
+                               FindRightMostName(shortNames, str));
+        }
+    }
+}
@@ -2,7 +2,9 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <set>
 
 #include "Platform.cpp"
@@ -152,3 +154,38 @@ OCIO_ADD_TEST(Platform, create_temp_filename)
     // Check that it only generates unique random strings.
     OCIO_CHECK_EQUAL(uids.size(), TestMax);
 }
+
+OCIO_ADD_TEST(Platform, mapped_file)
+{
+    const std::string filename = OCIO::Platform::CreateTempFilename(".txt");
+    const std::string content("SPILUT 1.0\n3 3\n2 2 2\n");
+
+    OCIO::Platform::MappedFile file;
+    OCIO_CHECK_ASSERT(!file.open(filename));
+    OCIO_CHECK_EQUAL(file.size(), 0);
+
+    {
+        std::ofstream outfile(filename, std::ios_base::binary);
+        outfile << content;
+    }
+
+    OCIO_REQUIRE_ASSERT(file.open(filename));
+    OCIO_CHECK_ASSERT(file.isMapped());
+    OCIO_REQUIRE_EQUAL(file.size(), content.size());
+    OCIO_CHECK_EQUAL(std::string(file.data(), file.size()), content);
+
+    file.close();
+    OCIO_CHECK_EQUAL(file.size(), 0);
+    OCIO_CHECK_ASSERT(!file.data());
+
+    // An empty file cannot be mapped but is still readable.
+    {
+        std::ofstream outfile(filename, std::ios_base::binary | std::ios_base::trunc);
+    }
+
+    OCIO_CHECK_ASSERT(file.open(filename));
+    OCIO_CHECK_ASSERT(!file.isMapped());
+    OCIO_CHECK_EQUAL(file.size(), 0);
+
+    std::remove(filename.c_str());
+}
@@ -272,3 +272,49 @@ OCIO_ADD_TEST(Processor, optimization_env_override_basic)
     OCIO_CHECK_EQUAL(OCIO::OPTIMIZATION_GOOD, OCIO::EnvironmentOverride(testFlag));
 }
 
+
+OCIO_ADD_TEST(Processor, serialize)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->getFormatMetadata().addAttribute(OCIO::METADATA_ID, "group");
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->setExposure(0.5);
+    ec->makeExposureDynamic();
+    group->appendTransform(ec);
+
+    auto mat = OCIO::MatrixTransform::Create();
+    const double offset[4]{ 0.1, 0.2, 0.3, 0.4 };
+    mat->setOffset(offset);
+    group->appendTransform(mat);
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor(group);
+
+    std::ostringstream os;
+    OCIO_CHECK_NO_THROW(processor->serialize(os));
+
+    std::istringstream is(os.str());
+    OCIO::ConstProcessorRcPtr readProcessor;
+    OCIO_CHECK_NO_THROW(readProcessor = OCIO::Processor::CreateFromStream(is));
+    OCIO_REQUIRE_ASSERT(readProcessor);
+
+    OCIO_CHECK_EQUAL(std::string(processor->getCacheID()),
+                     std::string(readProcessor->getCacheID()));
+    OCIO_CHECK_EQUAL(readProcessor->getNumTransforms(), 2);
+    const OCIO::FormatMetadata & metadata = readProcessor->getFormatMetadata();
+    OCIO_REQUIRE_EQUAL(metadata.getNumAttributes(), 1);
+    OCIO_CHECK_EQUAL(std::string(metadata.getAttributeValue(0)), "group");
+
+    // The dynamic properties are preserved.
+    OCIO_REQUIRE_ASSERT(readProcessor->hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO_CHECK_ASSERT(!readProcessor->hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+    auto dp = readProcessor->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE);
+    OCIO_CHECK_EQUAL(dp->getDoubleValue(), 0.5);
+
+    std::istringstream bad("not a processor");
+    OCIO_CHECK_THROW_WHAT(OCIO::Processor::CreateFromStream(bad), OCIO::Exception,
+                          "Binary ops: the data is not a binary op list");
+}
@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "SIMDKernels.cpp"
+
+#include "MathUtils.h"
+#include "testutils/UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+// An odd number of pixels so that the partial vectors at the end are exercised for all
+// the tiers.
+constexpr long NumPixels = 7;
+
+const float InputImage[NumPixels * 4] =
+{
+     0.10f,  0.50f,  0.90f,  1.00f,
+     0.00f,  1.00f,  2.00f,  0.50f,
+    -0.25f, -1.00f,  0.03f,  0.25f,
+     1e-4f,  0.18f,  4.00f, -1.00f,
+     0.75f,  0.33f,  0.01f,  0.00f,
+     3.00f, -0.50f,  0.60f,  2.00f,
+     0.02f,  0.80f, -2.00f,  0.75f,
+};
+
+std::vector<const OCIO::SIMDKernels *> GetAvailableKernels()
+{
+    std::vector<const OCIO::SIMDKernels *> kernels;
+    for (auto tier : { OCIO::SIMD_TIER_AVX2, OCIO::SIMD_TIER_AVX512 })
+    {
+        const OCIO::SIMDKernels * k = OCIO::GetSIMDKernels(tier);
+        if (k)
+        {
+            kernels.push_back(k);
+        }
+    }
+    return kernels;
+}
+
+void CheckImage(const OCIO::SIMDKernels * kernels,
+                const float * expected,
+                const float * actual,
+                float error,
+                unsigned line)
+{
+    for (long idx = 0; idx < NumPixels * 4; ++idx)
+    {
+        std::ostringstream oss;
+        oss << kernels->m_name << " kernel, index " << idx
+            << ": expected " << expected[idx] << " but got " << actual[idx];
+        // Absolute error for small values and relative error for large ones.
+        const float tol = error * std::max(1.f, std::fabs(expected[idx]));
+        OCIO_CHECK_ASSERT_MESSAGE_FROM(
+            OCIO::EqualWithAbsError(expected[idx], actual[idx], tol), oss.str(), line);
+    }
+}
+
+} // anon.
+
+OCIO_ADD_TEST(SIMDKernels, cpu_info)
+{
+    const OCIO::CPUInfo & cpu = OCIO::CPUInfo::Instance();
+
+    // The wider instruction sets imply the narrower ones.
+    OCIO_CHECK_ASSERT(!cpu.m_hasAVX2 || cpu.m_hasAVX);
+    OCIO_CHECK_ASSERT(!cpu.m_hasAVX512F || cpu.m_hasAVX2);
+
+    OCIO_CHECK_ASSERT(!OCIO::GetSIMDKernels(OCIO::SIMD_TIER_DEFAULT));
+
+    // The default kernels are the widest available ones.
+    const OCIO::SIMDKernels * best = OCIO::GetSIMDKernels();
+    if (OCIO::GetSIMDKernels(OCIO::SIMD_TIER_AVX512))
+    {
+        OCIO_CHECK_EQUAL(best, OCIO::GetSIMDKernels(OCIO::SIMD_TIER_AVX512));
+    }
+    else
+    {
+        OCIO_CHECK_EQUAL(best, OCIO::GetSIMDKernels(OCIO::SIMD_TIER_AVX2));
+    }
+}
+
+OCIO_ADD_TEST(SIMDKernels, scale_and_matrix)
+{
+    OCIO::ScaleKernelParams scale;
+    const float s[4] = { 2.f, 0.5f, -1.f, 3.f };
+    const float o[4] = { 0.1f, 0.f, 0.25f, -0.5f };
+    std::copy(s, s + 4, scale.m_scale);
+    std::copy(o, o + 4, scale.m_offset);
+
+    OCIO::MatrixKernelParams matrix;
+    const float m[16] = { 0.5f,  0.1f, 0.2f, 0.f,
+                          0.3f,  0.9f, 0.1f, 0.f,
+                          0.2f, -0.2f, 0.7f, 0.1f,
+                          0.0f,  0.1f, 0.f,  1.f };
+    for (int row = 0; row < 4; ++row)
+    {
+        for (int col = 0; col < 4; ++col)
+        {
+            matrix.m_column[col][row] = m[row * 4 + col];
+        }
+    }
+    std::copy(o, o + 4, matrix.m_offset);
+
+    float expectedScale[NumPixels * 4];
+    float expectedMatrix[NumPixels * 4];
+    for (long idx = 0; idx < NumPixels; ++idx)
+    {
+        const float * in = &InputImage[idx * 4];
+        for (int c = 0; c < 4; ++c)
+        {
+            expectedScale[idx * 4 + c] = in[c] * s[c] + o[c];
+            expectedMatrix[idx * 4 + c] = ((in[0] * m[c * 4 + 0] + in[1] * m[c * 4 + 1])
+                                          + (in[2] * m[c * 4 + 2] + in[3] * m[c * 4 + 3]))
+                                          + o[c];
+        }
+    }
+
+    for (auto kernels : GetAvailableKernels())
+    {
+        float out[NumPixels * 4];
+
+        kernels->m_scale(InputImage, out, NumPixels, scale);
+        CheckImage(kernels, expectedScale, out, 1e-6f, __LINE__);
+
+        kernels->m_matrix(InputImage, out, NumPixels, matrix);
+        CheckImage(kernels, expectedMatrix, out, 1e-6f, __LINE__);
+
+        // In-place processing.
+        std::copy(InputImage, InputImage + NumPixels * 4, out);
+        kernels->m_matrix(out, out, NumPixels, matrix);
+        CheckImage(kernels, expectedMatrix, out, 1e-6f, __LINE__);
+    }
+}
+
+OCIO_ADD_TEST(SIMDKernels, power)
+{
+    // Moncurve like parameters with a linear segment and a mirrored negative side.
+    OCIO::PowerKernelParams params;
+    const float gamma[4] = { 2.2f, 2.4f, 1.8f, 1.5f };
+    for (int c = 0; c < 4; ++c)
+    {
+        params.m_preScale[c]  = 0.9f;
+        params.m_preOffset[c] = 0.1f;
+        params.m_exponent[c]  = gamma[c];
+        params.m_breakPnt[c]  = 0.05f;
+        params.m_slope[c]     = 0.3f;
+    }
+
+    float expected[NumPixels * 4];
+    float out[NumPixels * 4];
+
+    for (bool mirror : { false, true })
+    {
+        for (bool keepAlpha : { false, true })
+        {
+            params.m_linearSegment = true;
+            params.m_mirror        = mirror;
+            params.m_keepAlpha     = keepAlpha;
+
+            for (long idx = 0; idx < NumPixels * 4; ++idx)
+            {
+                const int c = idx % 4;
+                const float in = InputImage[idx];
+                const float x = mirror ? std::fabs(in) : in;
+
+                float res = x > 0.05f ? std::pow(x * 0.9f + 0.1f, gamma[c]) : x * 0.3f;
+                res = mirror ? std::copysign(res, in) : res;
+
+                expected[idx] = (keepAlpha && c == 3) ? in : res;
+            }
+
+            for (auto kernels : GetAvailableKernels())
+            {
+                kernels->m_power(InputImage, out, NumPixels, params);
+                CheckImage(kernels, expected, out, 1e-4f * 16.f, __LINE__);
+            }
+        }
+    }
+
+    // Basic gamma: the negative values are clamped to zero.
+    OCIO::PowerKernelParams basic;
+    std::copy(gamma, gamma + 4, basic.m_exponent);
+
+    for (long idx = 0; idx < NumPixels * 4; ++idx)
+    {
+        const float in = InputImage[idx];
+        expected[idx] = in > 0.f ? std::pow(in, gamma[idx % 4]) : 0.f;
+    }
+
+    for (auto kernels : GetAvailableKernels())
+    {
+        kernels->m_power(InputImage, out, NumPixels, basic);
+        CheckImage(kernels, expected, out, 1e-4f * 16.f, __LINE__);
+    }
+}
+
+OCIO_ADD_TEST(SIMDKernels, log_and_antilog)
+{
+    // Camera log like parameters: the log side is used above the break point.
+    OCIO::LogKernelParams params;
+    for (int c = 0; c < 3; ++c)
+    {
+        params.m_preScale[c]   = 2.f;
+        params.m_preOffset[c]  = 0.05f;
+        params.m_postScale[c]  = 0.25f;
+        params.m_postOffset[c] = 0.5f;
+        params.m_breakPnt[c]   = 0.01f;
+        params.m_linScale[c]   = 4.f;
+        params.m_linOffset[c]  = 0.1f;
+    }
+    params.m_linearSegment = true;
+
+    float expectedLog[NumPixels * 4];
+    float expectedAntiLog[NumPixels * 4];
+    for (long idx = 0; idx < NumPixels * 4; ++idx)
+    {
+        const float in = InputImage[idx];
+        if (idx % 4 == 3)
+        {
+            expectedLog[idx] = expectedAntiLog[idx] = in;
+            continue;
+        }
+
+        const float minValue = std::numeric_limits<float>::min();
+
+        expectedLog[idx]
+            = in > 0.01f ? std::log2(std::max(minValue, in * 2.f + 0.05f)) * 0.25f + 0.5f
+                         : in * 4.f + 0.1f;
+
+        expectedAntiLog[idx]
+            = in > 0.01f ? (std::exp2((in + 0.05f) * 2.f) + 0.5f) * 0.25f
+                         : (in + 0.1f) * 4.f;
+    }
+
+    for (auto kernels : GetAvailableKernels())
+    {
+        float out[NumPixels * 4];
+
+        kernels->m_log(InputImage, out, NumPixels, params);
+        CheckImage(kernels, expectedLog, out, 1e-4f, __LINE__);
+
+        kernels->m_antiLog(InputImage, out, NumPixels, params);
+        CheckImage(kernels, expectedAntiLog, out, 1e-4f * 16.f, __LINE__);
+    }
+}
+
+OCIO_ADD_TEST(SIMDKernels, cdl)
+{
+    OCIO::CDLKernelParams params;
+    const float slope[4]  = { 1.1f, 0.9f, 1.2f, 1.f };
+    const float offset[4] = { 0.05f, -0.02f, 0.f, 0.f };
+    const float power[4]  = { 1.2f, 0.8f, 1.05f, 1.f };
+    std::copy(slope, slope + 4, params.m_slope);
+    std::copy(offset, offset + 4, params.m_offset);
+    std::copy(power, power + 4, params.m_power);
+    params.m_saturation = 0.7f;
+
+    const float weights[3] = { 0.2126f, 0.7152f, 0.0722f };
+
+    for (bool clamp : { true, false })
+    {
+        for (bool reverse : { false, true })
+        {
+            params.m_clamp   = clamp;
+            params.m_reverse = reverse;
+
+            const auto applyClamp = [clamp](float * pix)
+            {
+                for (int c = 0; c < 3 && clamp; ++c)
+                {
+                    pix[c] = OCIO::Clamp(pix[c], 0.f, 1.f);
+                }
+            };
+            const auto applyPower = [clamp, &power](float * pix)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    pix[c] = clamp ? std::pow(OCIO::Clamp(pix[c], 0.f, 1.f), power[c])
+                                   : (pix[c] < 0.f ? pix[c] : std::pow(pix[c], power[c]));
+                }
+            };
+            const auto applySat = [&params, &weights](float * pix)
+            {
+                const float luma = pix[0] * weights[0] + pix[1] * weights[1]
+                                 + pix[2] * weights[2];
+                for (int c = 0; c < 3; ++c)
+                {
+                    pix[c] = luma + params.m_saturation * (pix[c] - luma);
+                }
+            };
+
+            float expected[NumPixels * 4];
+            for (long idx = 0; idx < NumPixels; ++idx)
+            {
+                float * pix = &expected[idx * 4];
+                std::copy(&InputImage[idx * 4], &InputImage[idx * 4] + 4, pix);
+
+                if (!reverse)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        pix[c] = pix[c] * slope[c] + offset[c];
+                    }
+                    applyPower(pix);
+                    applySat(pix);
+                    applyClamp(pix);
+                }
+                else
+                {
+                    applyClamp(pix);
+                    applySat(pix);
+                    applyPower(pix);
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        pix[c] = (pix[c] + offset[c]) * slope[c];
+                    }
+                    applyClamp(pix);
+                }
+            }
+
+            for (auto kernels : GetAvailableKernels())
+            {
+                float out[NumPixels * 4];
+                kernels->m_cdl(InputImage, out, NumPixels, params);
+                CheckImage(kernels, expected, out, 1e-4f * 4.f, __LINE__);
+            }
+        }
+    }
+}
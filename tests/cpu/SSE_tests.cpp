@@ -4,6 +4,7 @@
 #ifdef USE_SSE
 
 
+#include <cmath>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -11,6 +12,7 @@
 #include "MathUtils.h"
 #include "SSE.h"
 #include "testutils/UnitTest.h"
+#include "UnitTestUtils.h"
 
 namespace OCIO = OCIO_NAMESPACE;
 
@@ -674,4 +676,89 @@ OCIO_ADD_TEST(SSE, scalar_sin_cos_test)
     }
 }
 
+namespace
+{
+
+// Check the precise functions against the scalar ones, including the sign of the zero
+// and infinite results.
+void CheckPrecise(const std::string & operation, float expected, float actual)
+{
+    if (std::isnan(expected))
+    {
+        OCIO_CHECK_ASSERT_MESSAGE(std::isnan(actual),
+                                  GetErrorMessage(operation, expected, actual));
+    }
+    else if (std::isinf(expected) || expected == 0.f)
+    {
+        OCIO_CHECK_ASSERT_MESSAGE(expected == actual
+                                  && std::signbit(expected) == std::signbit(actual),
+                                  GetErrorMessage(operation, expected, actual));
+    }
+    else
+    {
+        OCIO_CHECK_ASSERT_MESSAGE(OCIO::EqualWithSafeRelError(expected, actual, 1e-5f, 1.f),
+                                  GetErrorMessage(operation, expected, actual));
+    }
+}
+
+} // anon.
+
+OCIO_ADD_TEST(SSE, sse2_power_precise_test)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    const float bases[] = { 0.f, -0.f, 1e-40f, 1e-10f, 0.18f, 0.5f, 1.f, 2.f, 1e10f, inf,
+                            -1e-40f, -0.5f, -1.f, -2.f, -1e10f, -inf, nan };
+    const float exponents[] = { 0.f, -0.f, 0.333333333f, 1.f, 2.f, 3.f, 2.5f, 1e8f,
+                                -1.f, -2.f, -3.f, -2.5f, -1e8f, inf, -inf, nan };
+
+    // Evaluate different values in each lane.
+    for (float exponent : exponents)
+    {
+        const size_t numBases = sizeof(bases) / sizeof(bases[0]);
+        for (size_t idx = 0; idx < numBases; idx += 4)
+        {
+            float x[4];
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                x[lane] = bases[(idx + lane) % numBases];
+            }
+
+            float res[4];
+            _mm_storeu_ps(res, OCIO::ssePowerPrecise(_mm_loadu_ps(x), _mm_set1_ps(exponent)));
+
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                CheckPrecise(GetOperation("powPrecise", x[lane], exponent),
+                             powf(x[lane], exponent), res[lane]);
+            }
+        }
+    }
+}
+
+OCIO_ADD_TEST(SSE, sse2_atan2_precise_test)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    const float values[] = { 0.f, -0.f, 1e-40f, 0.25f, 1.f, 3.f, 1e30f, inf,
+                             -1e-40f, -0.25f, -1.f, -3.f, -1e30f, -inf, nan, 0.5f };
+
+    for (float y : values)
+    {
+        for (size_t idx = 0; idx < sizeof(values) / sizeof(values[0]); idx += 4)
+        {
+            float res[4];
+            _mm_storeu_ps(res, OCIO::sseAtan2Precise(_mm_set1_ps(y), _mm_loadu_ps(&values[idx])));
+
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                const float x = values[idx + lane];
+                CheckPrecise(GetOperation("atan2Precise", y, x), atan2f(y, x), res[lane]);
+            }
+        }
+    }
+}
+
 #endif
@@ -1016,6 +1016,78 @@ OCIO_ADD_TEST(FileFormatCTF, lut3d)
     OCIO_CHECK_CLOSE(array.getValues()[32], 987.0f / 4095.0f, tol);
 }
 
+OCIO_ADD_TEST(FileFormatCTF, lut3d_large)
+{
+    // The file is larger than the blocks given to the XML parser, and has numbers in
+    // various notations to check the direct fill of the array.
+    const unsigned long gridSize = 33;
+    const unsigned long numValues = gridSize * gridSize * gridSize * 3;
+
+    std::ostringstream oss;
+    oss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<ProcessList id=\"large\" compCLFversion=\"3\">\n"
+        << "    <LUT3D inBitDepth=\"32f\" outBitDepth=\"32f\">\n"
+        << "        <Array dim=\"33 33 33 3\">\n";
+
+    std::vector<std::string> strValues;
+    for (unsigned long idx = 0; idx < numValues; ++idx)
+    {
+        std::ostringstream value;
+        value.precision(idx % 3 == 0 ? 17 : 6);
+        if (idx % 7 == 0)
+        {
+            value << std::scientific;
+        }
+        value << (idx % 11 == 0 ? -1.0 : 1.0) * double(idx) / double(numValues - 1);
+        strValues.push_back(value.str());
+
+        oss << strValues.back() << (idx % 3 == 2 ? "\n" : (idx % 5 == 0 ? ", " : "  "));
+    }
+
+    oss << "        </Array>\n"
+        << "    </LUT3D>\n"
+        << "</ProcessList>\n";
+
+    const std::string clf = oss.str();
+    OCIO_REQUIRE_ASSERT(clf.size() > 1024 * 1024);
+
+    OCIO::LocalCachedFileRcPtr streamFile;
+    OCIO_CHECK_NO_THROW(streamFile = ParseString(clf));
+    OCIO_REQUIRE_ASSERT(streamFile);
+
+    OCIO::LocalFileFormat tester;
+    OCIO::LocalCachedFileRcPtr bufferFile;
+    OCIO_CHECK_NO_THROW(bufferFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(
+                            tester.readBuffer(clf.c_str(), clf.size(), "")));
+    OCIO_REQUIRE_ASSERT(bufferFile);
+
+    for (const auto & file : { streamFile, bufferFile })
+    {
+        const OCIO::ConstOpDataVec & opList = file->m_transform->getOps();
+        OCIO_REQUIRE_EQUAL(opList.size(), 1);
+        auto pLut = std::dynamic_pointer_cast<const OCIO::Lut3DOpData>(opList[0]);
+        OCIO_REQUIRE_ASSERT(pLut);
+
+        const OCIO::Array::Values & values = pLut->getArray().getValues();
+        OCIO_REQUIRE_EQUAL(values.size(), numValues);
+        for (unsigned long idx = 0; idx < numValues; ++idx)
+        {
+            OCIO_CHECK_EQUAL(values[idx], (float)strtod(strValues[idx].c_str(), nullptr));
+        }
+    }
+
+    // The errors are still detected.
+    std::string badClf = clf;
+    const size_t pos = badClf.find(strValues[numValues / 2]);
+    badClf.replace(pos, strValues[numValues / 2].size(), "0.5x");
+    OCIO_CHECK_THROW_WHAT(ParseString(badClf), OCIO::Exception, "Illegal values");
+
+    badClf = clf;
+    badClf.insert(badClf.find("        </Array>"), "0.5\n");
+    OCIO_CHECK_THROW_WHAT(ParseString(badClf), OCIO::Exception,
+                          "Expected 33x33x33x3 Array, found too many values");
+}
+
 OCIO_ADD_TEST(FileFormatCTF, lut3d_inv)
 {
     OCIO::LocalCachedFileRcPtr cachedFile;
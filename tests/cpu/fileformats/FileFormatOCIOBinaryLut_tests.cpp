@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <cstdio>
+#include <fstream>
+
+#include "fileformats/FileFormatOCIOBinaryLut.cpp"
+
+#include "ops/cdl/CDLOp.h"
+#include "Platform.h"
+#include "testutils/UnitTest.h"
+#include "UnitTestUtils.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+void BuildLutOps(OCIO::OpRcPtrVec & ops)
+{
+    auto lut1d = std::make_shared<OCIO::Lut1DOpData>(17);
+    auto & lut1dValues = lut1d->getArray().getValues();
+    for (size_t idx = 0; idx < lut1dValues.size(); ++idx)
+    {
+        lut1dValues[idx] = powf(lut1dValues[idx], 1.8f) + 0.01f * float(idx % 3);
+    }
+    lut1d->setInterpolation(OCIO::INTERP_LINEAR);
+    lut1d->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+    OCIO::CreateOpVecFromOpData(ops, lut1d, OCIO::TRANSFORM_DIR_FORWARD);
+
+    auto lut3d = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_TETRAHEDRAL, 5);
+    auto & lut3dValues = lut3d->getArray().getValues();
+    for (size_t idx = 0; idx < lut3dValues.size(); ++idx)
+    {
+        lut3dValues[idx] = lut3dValues[idx] * 0.9f + 0.05f;
+    }
+    OCIO::CreateOpVecFromOpData(ops, lut3d, OCIO::TRANSFORM_DIR_FORWARD);
+
+    auto matrix = std::make_shared<OCIO::MatrixOpData>();
+    matrix->setArrayValue(1, 0.25);
+    const double offsets[4] = { 0.1, 0.2, 0.3, 0.0 };
+    matrix->setRGBAOffsets(offsets);
+    OCIO::CreateOpVecFromOpData(ops, matrix, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::CreateOpVecFromOpData(ops,
+                                std::make_shared<OCIO::RangeOpData>(
+                                    0.1, OCIO::RangeOpData::EmptyValue(),
+                                    0.1, OCIO::RangeOpData::EmptyValue()),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+}
+
+OCIO::LocalCachedFileRcPtr ReadBuffer(const std::string & buffer)
+{
+    OCIO::LocalFileFormat tester;
+    OCIO::CachedFileRcPtr file = tester.readBuffer(buffer.data(), buffer.size(), "test.oblut");
+    return OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+}
+
+}
+
+OCIO_ADD_TEST(FileFormatOCIOBinaryLut, write_read)
+{
+    OCIO::OpRcPtrVec ops;
+    BuildLutOps(ops);
+    OCIO_REQUIRE_EQUAL(ops.size(), 4);
+
+    OCIO::LocalFileFormat tester;
+    OCIO::FormatMetadataImpl metadata(OCIO::METADATA_ROOT, "");
+
+    std::ostringstream os;
+    OCIO_CHECK_NO_THROW(tester.write(ops, metadata, OCIO::FILEFORMAT_BINARY_LUT, os));
+
+    const std::string buffer = os.str();
+    OCIO_CHECK_EQUAL(buffer.substr(0, 8), "OCIOBLUT");
+
+    OCIO::LocalCachedFileRcPtr cachedFile;
+    OCIO_CHECK_NO_THROW(cachedFile = ReadBuffer(buffer));
+    OCIO_REQUIRE_ASSERT(cachedFile);
+    OCIO_REQUIRE_EQUAL(cachedFile->m_ops.size(), ops.size());
+
+    for (size_t idx = 0; idx < ops.size(); ++idx)
+    {
+        OCIO::ConstOpRcPtr op = ops[idx];
+        OCIO_CHECK_ASSERT(*op->data() == *cachedFile->m_ops[idx]);
+    }
+
+    // The istream reader gives the same result.
+    std::istringstream is(buffer);
+    OCIO::CachedFileRcPtr file;
+    OCIO_CHECK_NO_THROW(file = tester.read(is, "test.oblut"));
+    auto streamFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+    OCIO_REQUIRE_ASSERT(streamFile);
+    OCIO_REQUIRE_EQUAL(streamFile->m_ops.size(), ops.size());
+    OCIO_CHECK_ASSERT(*streamFile->m_ops[1] == *cachedFile->m_ops[1]);
+
+    // The half variant stores the LUT values as half floats.
+    std::ostringstream osHalf;
+    OCIO_CHECK_NO_THROW(tester.write(ops, metadata, OCIO::FILEFORMAT_BINARY_LUT_HALF, osHalf));
+    OCIO_CHECK_ASSERT(osHalf.str().size() < buffer.size());
+
+    OCIO_CHECK_NO_THROW(cachedFile = ReadBuffer(osHalf.str()));
+    OCIO_REQUIRE_ASSERT(cachedFile);
+    OCIO_REQUIRE_EQUAL(cachedFile->m_ops.size(), ops.size());
+
+    for (size_t opIdx = 0; opIdx < 2; ++opIdx)
+    {
+        OCIO::ConstOpRcPtr op = ops[opIdx];
+        const auto & values = (opIdx == 0)
+            ? OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(op->data())->getArray().getValues()
+            : OCIO::DynamicPtrCast<const OCIO::Lut3DOpData>(op->data())->getArray().getValues();
+        const auto & halfValues = (opIdx == 0)
+            ? OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(
+                cachedFile->m_ops[opIdx])->getArray().getValues()
+            : OCIO::DynamicPtrCast<const OCIO::Lut3DOpData>(
+                cachedFile->m_ops[opIdx])->getArray().getValues();
+
+        OCIO_REQUIRE_EQUAL(values.size(), halfValues.size());
+        for (size_t idx = 0; idx < values.size(); ++idx)
+        {
+            OCIO_CHECK_EQUAL(float(half(values[idx])), halfValues[idx]);
+        }
+    }
+    OCIO::ConstOpRcPtr matrixOp = ops[2];
+    OCIO_CHECK_ASSERT(*matrixOp->data() == *cachedFile->m_ops[2]);
+    OCIO::ConstOpRcPtr rangeOp = ops[3];
+    OCIO_CHECK_ASSERT(*rangeOp->data() == *cachedFile->m_ops[3]);
+}
+
+OCIO_ADD_TEST(FileFormatOCIOBinaryLut, errors)
+{
+    OCIO::OpRcPtrVec ops;
+    BuildLutOps(ops);
+
+    OCIO::LocalFileFormat tester;
+    OCIO::FormatMetadataImpl metadata(OCIO::METADATA_ROOT, "");
+
+    std::ostringstream os;
+    OCIO_CHECK_THROW_WHAT(tester.write(ops, metadata, "foo", os), OCIO::Exception,
+                          "Unknown binary LUT file format name, 'foo'");
+
+    OCIO_CHECK_NO_THROW(tester.write(ops, metadata, OCIO::FILEFORMAT_BINARY_LUT, os));
+    const std::string buffer = os.str();
+
+    OCIO_CHECK_THROW_WHAT(ReadBuffer("OCIO"), OCIO::Exception,
+                          "The file is not a binary LUT");
+    OCIO_CHECK_THROW_WHAT(ReadBuffer("OCIOBLUX" + buffer.substr(8)), OCIO::Exception,
+                          "The file is not a binary LUT");
+    OCIO_CHECK_THROW_WHAT(ReadBuffer(buffer.substr(0, buffer.size() - 1)), OCIO::Exception,
+                          "The file is truncated");
+    OCIO_CHECK_THROW_WHAT(ReadBuffer(buffer + "x"), OCIO::Exception,
+                          "Unexpected data after the last op");
+
+    std::string badVersion = buffer;
+    badVersion[8] = 2;
+    OCIO_CHECK_THROW_WHAT(ReadBuffer(badVersion), OCIO::Exception, "Unsupported version 2");
+
+    // The first op type follows the 16 bytes of the header.
+    std::string badType = buffer;
+    badType[16] = 9;
+    OCIO_CHECK_THROW_WHAT(ReadBuffer(badType), OCIO::Exception, "Unknown op type 9");
+
+    // The 1D LUT interpolation is invalid.
+    std::string badInterpolation = buffer;
+    badInterpolation[21] = 100;
+    OCIO_CHECK_THROW_WHAT(ReadBuffer(badInterpolation), OCIO::Exception,
+                          "Error parsing binary LUT file (test.oblut)");
+
+    // Only the LUT, matrix and range ops are supported.
+    OCIO::OpRcPtrVec cdlOps;
+    auto cdl = std::make_shared<OCIO::CDLOpData>();
+    OCIO::CreateCDLOp(cdlOps, cdl, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_THROW_WHAT(tester.write(cdlOps, metadata, OCIO::FILEFORMAT_BINARY_LUT, os),
+                          OCIO::Exception,
+                          "The binary LUT file format does not support the op");
+}
+
+OCIO_ADD_TEST(FileFormatOCIOBinaryLut, bake_and_load)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    {
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName("input");
+        config->addColorSpace(cs);
+        config->setRole(OCIO::ROLE_REFERENCE, cs->getName());
+    }
+    {
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName("target");
+
+        // Set saturation to cause channel crosstalk, making a 3D LUT.
+        OCIO::CDLTransformRcPtr transform = OCIO::CDLTransform::Create();
+        transform->setSat(0.5f);
+        cs->setTransform(transform, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+        config->addColorSpace(cs);
+    }
+
+    OCIO::BakerRcPtr baker = OCIO::Baker::Create();
+    baker->setConfig(config);
+    baker->setFormat(OCIO::FILEFORMAT_BINARY_LUT);
+    baker->setInputSpace("input");
+    baker->setTargetSpace("target");
+    baker->setCubeSize(17);
+
+    std::ostringstream output;
+    OCIO_CHECK_NO_THROW(baker->bake(output));
+
+    OCIO::LocalCachedFileRcPtr cachedFile;
+    OCIO_CHECK_NO_THROW(cachedFile = ReadBuffer(output.str()));
+    OCIO_REQUIRE_ASSERT(cachedFile);
+    OCIO_REQUIRE_EQUAL(cachedFile->m_ops.size(), 1);
+    auto lut = OCIO::DynamicPtrCast<const OCIO::Lut3DOpData>(cachedFile->m_ops[0]);
+    OCIO_REQUIRE_ASSERT(lut);
+    OCIO_CHECK_EQUAL(lut->getArray().getLength(), 17);
+
+    // The baked file is usable by a FileTransform.
+    const std::string filename = OCIO::Platform::CreateTempFilename(".oblut");
+    {
+        std::ofstream file(filename, std::ios_base::out | std::ios_base::binary);
+        file << output.str();
+    }
+
+    OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+    fileTransform->setSrc(filename.c_str());
+    fileTransform->setInterpolation(OCIO::INTERP_LINEAR);
+
+    OCIO::ConstProcessorRcPtr fileProc;
+    OCIO_CHECK_NO_THROW(fileProc = config->getProcessor(fileTransform));
+    std::remove(filename.c_str());
+    OCIO_REQUIRE_ASSERT(fileProc);
+
+    OCIO::ConstProcessorRcPtr proc = config->getProcessor("input", "target");
+
+    float pixel[3] = { 0.25f, 0.5f, 0.75f };
+    float expected[3] = { 0.25f, 0.5f, 0.75f };
+    fileProc->getDefaultCPUProcessor()->applyRGB(pixel);
+    proc->getDefaultCPUProcessor()->applyRGB(expected);
+
+    OCIO_CHECK_CLOSE(pixel[0], expected[0], 1e-5f);
+    OCIO_CHECK_CLOSE(pixel[1], expected[1], 1e-5f);
+    OCIO_CHECK_CLOSE(pixel[2], expected[2], 1e-5f);
+}
@@ -54,7 +54,7 @@ OCIO_ADD_TEST(FileFormatSpi3D, test)
     OCIO_CHECK_EQUAL(0.175453f, lutArray[30950]);
 }
 
-void ReadSpi3d(const std::string & fileContent)
+OCIO::CachedFileRcPtr ReadSpi3d(const std::string & fileContent)
 {
     std::istringstream is;
     is.str(fileContent);
@@ -62,7 +62,7 @@ void ReadSpi3d(const std::string & fileContent)
     // Read file
     OCIO::LocalFileFormat tester;
     const std::string SAMPLE_NAME("Memory File");
-    OCIO::CachedFileRcPtr cachedFile = tester.read(is, SAMPLE_NAME);
+    return tester.read(is, SAMPLE_NAME);
 }
 
 OCIO_ADD_TEST(FileFormatSpi3D, read_failure)
@@ -181,3 +181,33 @@ OCIO_ADD_TEST(FileFormatSpi3D, read_failure)
     }
 }
 
+OCIO_ADD_TEST(FileFormatSpi3D, non_finite_values)
+{
+    // The non-finite values are read like strtof() does.
+    const std::string SAMPLE =
+        "SPILUT 1.0\n"
+        "3 3\n"
+        "2 2 2\n"
+        "0 0 0 0.0 0.0 0.0\n"
+        "0 0 1 nan inf -inf\n"
+        "0 1 0 0.0 0.7 0.0\n"
+        "0 1 1 0.0 0.8 0.8\n"
+        "1 0 0 0.7 0.0 0.1\n"
+        "1 0 1 0.7 0.6 0.1\n"
+        "1 1 0 0.6 0.7 0.1\n"
+        "1 1 1 NaN Infinity 1e50\n";
+
+    OCIO::CachedFileRcPtr file;
+    OCIO_CHECK_NO_THROW(file = ReadSpi3d(SAMPLE));
+    OCIO::LocalCachedFileRcPtr cachedFile = OCIO::DynamicPtrCast<OCIO::LocalCachedFile>(file);
+    OCIO_REQUIRE_ASSERT(cachedFile);
+    OCIO_REQUIRE_ASSERT(cachedFile->lut);
+
+    const OCIO::Array & lutArray = cachedFile->lut->getArray();
+    OCIO_CHECK_ASSERT(std::isnan(lutArray[3]));
+    OCIO_CHECK_EQUAL(lutArray[4], std::numeric_limits<float>::infinity());
+    OCIO_CHECK_EQUAL(lutArray[5], -std::numeric_limits<float>::infinity());
+    OCIO_CHECK_ASSERT(std::isnan(lutArray[21]));
+    OCIO_CHECK_EQUAL(lutArray[22], std::numeric_limits<float>::infinity());
+    OCIO_CHECK_EQUAL(lutArray[23], std::numeric_limits<float>::infinity());
+}
@@ -2,7 +2,9 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <cmath>
 #include <cstring>
+#include <vector>
 
 #include "ops/fixedfunction/FixedFunctionOpCPU.cpp"
 
@@ -417,3 +419,82 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, XYZ_TO_LUV)
     img = outputFrame;
     ApplyFixedFunction(&img[0], &inputFrame[0], 2, dataFInv, 1e-5f, __LINE__);
 }
+
+OCIO_ADD_TEST(FixedFunctionOpCPU, vectorized_vs_scalar)
+{
+    // The renderers process the pixels in blocks when SSE is available, and the last
+    // pixels one at a time. Check that both paths agree for all the styles.
+
+    const long numPixels = 4 * 64 + 3;
+
+    std::vector<float> input(numPixels * 4);
+    unsigned seed = 12345;
+    for (auto & val : input)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        val = -0.25f + 1.5f * float(seed >> 8) / float(1 << 24);
+    }
+    // A few gray and black pixels.
+    for (long idx = 0; idx < 3; ++idx)
+    {
+        input[idx * 20 + 0] = input[idx * 20 + 1] = input[idx * 20 + 2] = 0.1f * idx;
+    }
+    // The non-finite and large values must also give the scalar results.
+    const float specialValues[] = { std::numeric_limits<float>::quiet_NaN(),
+                                    std::numeric_limits<float>::infinity(),
+                                    -std::numeric_limits<float>::infinity(),
+                                    1e30f, -1e30f, 65504.f, -2.f, 10.f, 0.f, -0.f };
+    const size_t numSpecialValues = sizeof(specialValues) / sizeof(specialValues[0]);
+    for (size_t idx = 0; idx < 4 * numSpecialValues; ++idx)
+    {
+        input[100 + idx * 5] = specialValues[idx % numSpecialValues];
+    }
+
+    for (int style = OCIO::FixedFunctionOpData::ACES_RED_MOD_03_FWD;
+         style <= OCIO::FixedFunctionOpData::LUV_TO_XYZ; ++style)
+    {
+        const auto fnStyle = OCIO::FixedFunctionOpData::Style(style);
+
+        OCIO::FixedFunctionOpData::Params params;
+        if (fnStyle == OCIO::FixedFunctionOpData::REC2100_SURROUND_FWD
+            || fnStyle == OCIO::FixedFunctionOpData::REC2100_SURROUND_INV)
+        {
+            params.push_back(0.78);
+        }
+
+        OCIO::ConstFixedFunctionOpDataRcPtr fnData
+            = std::make_shared<OCIO::FixedFunctionOpData>(params, fnStyle);
+
+        OCIO::ConstOpCPURcPtr op;
+        OCIO_CHECK_NO_THROW(op = OCIO::GetFixedFunctionCPURenderer(fnData));
+
+        std::vector<float> all(input.size());
+        op->apply(input.data(), all.data(), numPixels);
+
+        std::vector<float> single(input.size());
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            op->apply(&input[idx * 4], &single[idx * 4], 1);
+        }
+
+        for (size_t idx = 0; idx < all.size(); ++idx)
+        {
+            if (std::isnan(single[idx]))
+            {
+                OCIO_CHECK_ASSERT_MESSAGE(std::isnan(all[idx]),
+                    std::string(OCIO::FixedFunctionOpData::ConvertStyleToString(fnStyle, false))
+                    + " - Index: " + std::to_string(idx) + " - NaN expected");
+            }
+            else if (all[idx] != single[idx]
+                     && !OCIO::EqualWithSafeRelError(all[idx], single[idx], 1e-5f, 1.0f))
+            {
+                std::ostringstream errorMsg;
+                errorMsg.precision(9);
+                errorMsg << OCIO::FixedFunctionOpData::ConvertStyleToString(fnStyle, false)
+                         << " - Index: " << idx
+                         << " - Values: " << all[idx] << " expected: " << single[idx];
+                OCIO_CHECK_ASSERT_MESSAGE(0, errorMsg.str());
+            }
+        }
+    }
+}
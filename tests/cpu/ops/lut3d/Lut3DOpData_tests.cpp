@@ -65,6 +65,26 @@ OCIO_ADD_TEST(Lut3DOpData, clone)
     OCIO_CHECK_ASSERT(pClone->getArray()==ref.getArray());
 }
 
+OCIO_ADD_TEST(Lut3DOpData, cache_id)
+{
+    OCIO::Lut3DOpData ref(17);
+    ref.finalize();
+
+    const std::string id = ref.getCacheID();
+    OCIO_CHECK_EQUAL(id, ref.getCacheID());
+
+    // A clone has the same cache identifier.
+    OCIO::Lut3DOpDataRcPtr pClone = ref.clone();
+    OCIO_CHECK_EQUAL(id, pClone->getCacheID());
+
+    // Any change to the array invalidates the memoized hash.
+    pClone->getArray()[1] = 0.1f;
+    OCIO_CHECK_NE(id, pClone->getCacheID());
+
+    pClone->getArray()[1] = ref.getArray()[1];
+    OCIO_CHECK_EQUAL(id, pClone->getCacheID());
+}
+
 OCIO_ADD_TEST(Lut3DOpData, not_supported_length)
 {
     OCIO_CHECK_NO_THROW(OCIO::Lut3DOpData{ OCIO::Lut3DOpData::maxSupportedLength });
@@ -310,6 +330,48 @@ OCIO_ADD_TEST(Lut3DOpData, inv_lut3d_lut_size)
     OCIO_CHECK_EQUAL(invFastLutData->getArray().getLength(), 48);
 }
 
+OCIO_ADD_TEST(Lut3DOpData, inv_lut3d_deterministic)
+{
+    // The inverse is computed from several threads so check that the result does not depend
+    // on how the domain is split.
+
+    const std::string fileName("clf/lut3d_17x17x17_10i_12i.clf");
+    OCIO::OpRcPtrVec ops;
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    OCIO_CHECK_NO_THROW(BuildOpsTest(ops, fileName, context,
+                                     OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(2, ops.size());
+
+    auto op1 = std::dynamic_pointer_cast<const OCIO::Op>(ops[1]);
+    OCIO_REQUIRE_ASSERT(op1);
+    auto fwdLutData = std::dynamic_pointer_cast<const OCIO::Lut3DOpData>(op1->data());
+    OCIO_REQUIRE_ASSERT(fwdLutData);
+    OCIO::ConstLut3DOpDataRcPtr invLutData = fwdLutData->inverse();
+
+    OCIO::Lut3DOpDataRcPtr invFast1 = MakeFastLut3DFromInverse(invLutData);
+    OCIO::Lut3DOpDataRcPtr invFast2 = MakeFastLut3DFromInverse(invLutData);
+    OCIO_CHECK_ASSERT(invFast1->getArray().getValues() == invFast2->getArray().getValues());
+
+    // Evaluate a few grid points one at a time.
+    const OCIO::Lut3DOpData domain(invFast1->getArray().getLength());
+    const OCIO::Array::Values & domainValues = domain.getArray().getValues();
+    const OCIO::Array::Values & invValues = invFast1->getArray().getValues();
+
+    OCIO::OpRcPtrVec invOps;
+    OCIO::Lut3DOpDataRcPtr invLut = invLutData->clone();
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut3DOp(invOps, invLut, OCIO::TRANSFORM_DIR_FORWARD));
+
+    const size_t numPixels = domainValues.size() / 3;
+    for (size_t idx = 0; idx < numPixels; idx += 4099)
+    {
+        float rgb[3];
+        OCIO::EvalTransform(&domainValues[3 * idx], rgb, 1, invOps);
+        OCIO_CHECK_EQUAL(rgb[0], invValues[3 * idx + 0]);
+        OCIO_CHECK_EQUAL(rgb[1], invValues[3 * idx + 1]);
+        OCIO_CHECK_EQUAL(rgb[2], invValues[3 * idx + 2]);
+    }
+}
+
 OCIO_ADD_TEST(Lut3DOpData, compose_inverse_luts)
 {
     OCIO::ConstLut3DOpDataRcPtr lutRef = std::make_shared<OCIO::Lut3DOpData>(5);
@@ -3,6 +3,7 @@
 
 
 #include <algorithm>
+#include <fstream>
 
 #include "transforms/FileTransform.cpp"
 
@@ -204,10 +205,10 @@ bool FormatExtensionFoundByName(const std::string & extension, const std::string
 OCIO_ADD_TEST(FileTransform, all_formats)
 {
     OCIO::FormatRegistry & formatRegistry = OCIO::FormatRegistry::GetInstance();
-    OCIO_CHECK_EQUAL(19, formatRegistry.getNumRawFormats());
-    OCIO_CHECK_EQUAL(24, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_READ));
-    OCIO_CHECK_EQUAL(10, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_BAKE));
-    OCIO_CHECK_EQUAL(2,  formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_WRITE));
+    OCIO_CHECK_EQUAL(20, formatRegistry.getNumRawFormats());
+    OCIO_CHECK_EQUAL(25, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_READ));
+    OCIO_CHECK_EQUAL(12, formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_BAKE));
+    OCIO_CHECK_EQUAL(4,  formatRegistry.getNumFormats(OCIO::FORMAT_CAPABILITY_WRITE));
 
     OCIO_CHECK_ASSERT(FormatNameFoundByExtension("3dl", "flame"));
     OCIO_CHECK_ASSERT(FormatNameFoundByExtension("cc", "ColorCorrection"));
@@ -298,3 +299,137 @@ OCIO_ADD_TEST(FileTransform, validate)
     tr->setSrc("");
     OCIO_CHECK_THROW(tr->validate(), OCIO::Exception);
 }
+
+OCIO_ADD_TEST(FileTransform, file_cache_lru)
+{
+    // A single shard makes the eviction order predictable.
+    OCIO::FileCache cache(1);
+    cache.setMaxSize(100);
+
+    auto a = cache.getResult("a");
+    cache.setResultSize("a", a, 40);
+    auto b = cache.getResult("b");
+    cache.setResultSize("b", b, 40);
+    OCIO_CHECK_EQUAL(cache.getSize(), 80);
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 2);
+
+    // 'a' becomes the most recently used item so 'b' is evicted.
+    OCIO_CHECK_ASSERT(cache.getResult("a") == a);
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 1);
+
+    auto c = cache.getResult("c");
+    cache.setResultSize("c", c, 40);
+    OCIO_CHECK_EQUAL(cache.getNumEntries(), 2);
+    OCIO_CHECK_EQUAL(cache.getSize(), 80);
+    OCIO_CHECK_EQUAL(cache.getNumEvictions(), 1);
+
+    OCIO_CHECK_ASSERT(cache.getResult("a") == a);
+    OCIO_CHECK_ASSERT(cache.getResult("b") != b);
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 2);
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 4);
+
+    // The size of an evicted item is not accounted.
+    cache.setResultSize("b", b, 40);
+    OCIO_CHECK_EQUAL(cache.getSize(), 80);
+
+    // An item larger than the budget is kept as long as it is the most recently used one.
+    auto d = cache.getResult("d");
+    cache.setResultSize("d", d, 1000);
+    OCIO_CHECK_EQUAL(cache.getNumEntries(), 1);
+    OCIO_CHECK_EQUAL(cache.getSize(), 1000);
+    OCIO_CHECK_ASSERT(cache.getResult("d") == d);
+
+    // Shrinking the budget evicts, no budget means no limit.
+    cache.setMaxSize(0);
+    cache.setResultSize("a", cache.getResult("a"), 40);
+    OCIO_CHECK_EQUAL(cache.getNumEntries(), 2);
+    cache.setMaxSize(500);
+    OCIO_CHECK_EQUAL(cache.getNumEntries(), 1);
+    OCIO_CHECK_EQUAL(cache.getSize(), 40);
+
+    cache.clear();
+    OCIO_CHECK_EQUAL(cache.getNumEntries(), 0);
+    OCIO_CHECK_EQUAL(cache.getSize(), 0);
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 0);
+    OCIO_CHECK_EQUAL(cache.getNumMisses(), 0);
+    OCIO_CHECK_EQUAL(cache.getNumEvictions(), 0);
+}
+
+OCIO_ADD_TEST(FileTransform, file_cache_lru_shards)
+{
+    // The budget applies to the whole cache, not to each shard.
+    OCIO::FileCache cache(16);
+    cache.setMaxSize(100);
+
+    std::vector<OCIO::FileCacheResultPtr> results;
+    for (int idx = 0; idx < 10; ++idx)
+    {
+        const std::string filepath = "file_" + std::to_string(idx);
+        results.push_back(cache.getResult(filepath));
+        cache.setResultSize(filepath, results.back(), 30);
+        OCIO_CHECK_LE(cache.getSize(), 100);
+    }
+
+    OCIO_CHECK_EQUAL(cache.getNumEntries(), 3);
+    OCIO_CHECK_EQUAL(cache.getSize(), 90);
+    OCIO_CHECK_EQUAL(cache.getNumEvictions(), 7);
+
+    // The least recently used items of all the shards are the evicted ones.
+    for (int idx = 7; idx < 10; ++idx)
+    {
+        OCIO_CHECK_ASSERT(cache.getResult("file_" + std::to_string(idx)) == results[idx]);
+    }
+    OCIO_CHECK_EQUAL(cache.getNumHits(), 3);
+}
+
+OCIO_ADD_TEST(FileTransform, file_cache)
+{
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheMaxSize(), 0);
+
+    const std::string lut1D(std::string(OCIO::getTestFilesDir()) + "/lut1d_green.ctf");
+    const std::string lut3D(std::string(OCIO::getTestFilesDir()) + "/lustre_33x33x33.3dl");
+
+    std::ifstream lutFile(lut3D, std::ios::binary | std::ios::ate);
+    const size_t lut3DSize = (size_t)lutFile.tellg();
+    OCIO_REQUIRE_ASSERT(lut3DSize > 0);
+
+    OCIO::FileFormat * format = nullptr;
+    OCIO::CachedFileRcPtr cachedFile;
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, cachedFile, lut3D));
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumEntries(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheSize(), lut3DSize);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumHits(), 0);
+
+    OCIO::CachedFileRcPtr cachedFile2;
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, cachedFile2, lut3D));
+    OCIO_CHECK_ASSERT(cachedFile == cachedFile2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumHits(), 1);
+
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, cachedFile2, lut1D));
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumEntries(), 2);
+    OCIO_CHECK_ASSERT(OCIO::GetFileTransformCacheSize() > lut3DSize);
+
+    // Failures are cached too.
+    const std::string missing(std::string(OCIO::getTestFilesDir()) + "/missing.ctf");
+    OCIO_CHECK_THROW_WHAT(OCIO::GetCachedFileAndFormat(format, cachedFile2, missing),
+                          OCIO::Exception, "could not be opened");
+    OCIO_CHECK_THROW_WHAT(OCIO::GetCachedFileAndFormat(format, cachedFile2, missing),
+                          OCIO::Exception, "could not be opened");
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumEntries(), 3);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumHits(), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumMisses(), 3);
+
+    // The smallest budget evicts the least recently used files until the cache fits.
+    OCIO::SetFileTransformCacheMaxSize(1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheMaxSize(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumEntries()
+                        + OCIO::GetFileTransformCacheNumEvictions(), 3);
+
+    OCIO::SetFileTransformCacheMaxSize(0);
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumEntries(), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheSize(), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetFileTransformCacheNumHits(), 0);
+}
@@ -108,11 +108,14 @@ END METADATA
         self.assertEqual(4, bakee.getShaperSize())
         bakee.setCubeSize(2)
         self.assertEqual(2, bakee.getCubeSize())
+        self.assertEqual(1, bakee.getNumThreads())
+        bakee.setNumThreads(4)
+        self.assertEqual(4, bakee.getNumThreads())
         output = bakee.bake()
         if self.useSSE == True:
             self.assertEqual(self.EXPECTED_LUT_SSE, output)
         else:
             self.assertEqual(self.EXPECTED_LUT_NONSSE, output)
-        self.assertEqual(10, bakee.getNumFormats())
+        self.assertEqual(12, bakee.getNumFormats())
         self.assertEqual("cinespace", bakee.getFormatNameByIndex(4))
         self.assertEqual("3dl", bakee.getFormatExtensionByIndex(1))
@@ -203,7 +203,7 @@ class TransformsTest(unittest.TestCase):
         self.assertEqual("foobar", ft.getCCCId())
         ft.setInterpolation(OCIO.INTERP_NEAREST)
         self.assertEqual(OCIO.INTERP_NEAREST, ft.getInterpolation())
-        self.assertEqual(24, ft.getNumFormats())
+        self.assertEqual(25, ft.getNumFormats())
         self.assertEqual("flame", ft.getFormatNameByIndex(0))
         self.assertEqual("3dl", ft.getFormatExtensionByIndex(0))
 